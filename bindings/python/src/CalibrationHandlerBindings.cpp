@@ -93,6 +93,27 @@ void CalibrationHandlerBindings::bind(pybind11::module& m, void* pCallstack) {
              py::arg("cam2") = dai::CameraBoardSocket::CAM_B,
              py::arg("useSpecTranslation") = true,
              DOC(dai, CalibrationHandler, getBaselineDistance))
+        .def("transformPoints",
+             &CalibrationHandler::transformPoints,
+             py::arg("srcCamera"),
+             py::arg("dstCamera"),
+             py::arg("points"),
+             py::arg("useSpecTranslation") = false,
+             DOC(dai, CalibrationHandler, transformPoints))
+        .def("projectPoints",
+             &CalibrationHandler::projectPoints,
+             py::arg("cameraId"),
+             py::arg("points"),
+             py::arg("resizeWidth") = -1,
+             py::arg("resizeHeight") = -1,
+             DOC(dai, CalibrationHandler, projectPoints))
+        .def("undistortPoints",
+             &CalibrationHandler::undistortPoints,
+             py::arg("cameraId"),
+             py::arg("points"),
+             py::arg("resizeWidth") = -1,
+             py::arg("resizeHeight") = -1,
+             DOC(dai, CalibrationHandler, undistortPoints))
 
         .def("getCameraToImuExtrinsics",
              &CalibrationHandler::getCameraToImuExtrinsics,
@@ -8,6 +8,7 @@
 
 // depthai
 #include "depthai/utility/CompilerWarnings.hpp"
+#include "depthai/xlink/LoopbackConnection.hpp"
 #include "depthai/xlink/XLinkConnection.hpp"
 #include "depthai/xlink/XLinkStream.hpp"
 
@@ -22,6 +23,8 @@ void XLinkBindings::bind(pybind11::module& m, void* pCallstack) {
     py::enum_<XLinkPlatform_t> xLinkPlatform(m, "XLinkPlatform");
     py::enum_<XLinkError_t> xLinkError(m, "XLinkError_t");
     py::class_<XLinkConnection, std::shared_ptr<XLinkConnection> > xLinkConnection(m, "XLinkConnection", DOC(dai, XLinkConnection));
+    py::class_<LoopbackConnection, XLinkConnection, std::shared_ptr<LoopbackConnection> > loopbackConnection(
+        m, "LoopbackConnection", DOC(dai, LoopbackConnection));
 
     // pybind11 limitation of having actual classes as exceptions
     // Possible but requires a larger workaround
@@ -131,6 +134,9 @@ void XLinkBindings::bind(pybind11::module& m, void* pCallstack) {
         .def_static("bootBootloader", &XLinkConnection::bootBootloader, py::arg("devInfo"))
         .def_static("getGlobalProfilingData", &XLinkConnection::getGlobalProfilingData, DOC(dai, XLinkConnection, getGlobalProfilingData));
 
+    loopbackConnection.def(py::init<std::size_t>(), py::arg("maxQueuedPackets") = 8, DOC(dai, LoopbackConnection, LoopbackConnection))
+        .def("close", &LoopbackConnection::close, DOC(dai, LoopbackConnection, close));
+
     xLinkError.value("X_LINK_SUCCESS", X_LINK_SUCCESS)
         .value("X_LINK_ALREADY_OPEN", X_LINK_ALREADY_OPEN)
         .value("X_LINK_COMMUNICATION_NOT_OPEN", X_LINK_COMMUNICATION_NOT_OPEN)
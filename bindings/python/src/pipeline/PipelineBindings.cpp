@@ -45,6 +45,7 @@
 #include <memory>
 
 #include "depthai/properties/GlobalProperties.hpp"
+#include "depthai/utility/Clock.hpp"
 #include "depthai/utility/RecordReplay.hpp"
 
 std::shared_ptr<dai::Node> createNode(dai::Pipeline& p, py::object class_) {
@@ -66,6 +67,11 @@ void PipelineBindings::bind(pybind11::module& m, void* pCallstack) {
     py::class_<GlobalProperties> globalProperties(m, "GlobalProperties", DOC(dai, GlobalProperties));
     py::class_<RecordConfig> recordConfig(m, "RecordConfig", DOC(dai, RecordConfig));
     py::class_<RecordConfig::VideoEncoding> recordVideoConfig(recordConfig, "VideoEncoding", DOC(dai, RecordConfig, VideoEncoding));
+    py::class_<PipelineClock, std::shared_ptr<PipelineClock>> pipelineClock(m, "PipelineClock", DOC(dai, PipelineClock));
+    py::class_<SteadyPipelineClock, PipelineClock, std::shared_ptr<SteadyPipelineClock>> steadyPipelineClock(
+        m, "SteadyPipelineClock", DOC(dai, SteadyPipelineClock));
+    py::class_<SimulatedPipelineClock, PipelineClock, std::shared_ptr<SimulatedPipelineClock>> simulatedPipelineClock(
+        m, "SimulatedPipelineClock", DOC(dai, SimulatedPipelineClock));
     py::class_<Pipeline> pipeline(m, "Pipeline", DOC(dai, Pipeline, 2));
 
     ///////////////////////////////////////////////////////////////////////
@@ -78,6 +84,16 @@ void PipelineBindings::bind(pybind11::module& m, void* pCallstack) {
     cb(m, pCallstack);
     // Actual bindings
     ///////////////////////////////////////////////////////////////////////
+
+    pipelineClock.def("now", &PipelineClock::now, DOC(dai, PipelineClock, now))
+        .def("sleepUntil", &PipelineClock::sleepUntil, py::arg("timePoint"), py::call_guard<py::gil_scoped_release>(), DOC(dai, PipelineClock, sleepUntil))
+        .def("sleepFor", &PipelineClock::sleepFor, py::arg("sleepDuration"), py::call_guard<py::gil_scoped_release>(), DOC(dai, PipelineClock, sleepFor))
+        .def("isSimulated", &PipelineClock::isSimulated, DOC(dai, PipelineClock, isSimulated))
+        .def_static("steady", &PipelineClock::steady, DOC(dai, PipelineClock, steady));
+    steadyPipelineClock.def(py::init<>());
+    simulatedPipelineClock.def(py::init<SimulatedPipelineClock::time_point>(), py::arg("start") = SimulatedPipelineClock::time_point{})
+        .def("advanceTo", &SimulatedPipelineClock::advanceTo, py::arg("timePoint"), DOC(dai, SimulatedPipelineClock, advanceTo))
+        .def("advance", &SimulatedPipelineClock::advance, py::arg("step"), DOC(dai, SimulatedPipelineClock, advance));
     ///////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////
 
@@ -138,7 +154,7 @@ void PipelineBindings::bind(pybind11::module& m, void* pCallstack) {
         .def("getDefaultDevice", &Pipeline::getDefaultDevice, DOC(dai, Pipeline, getDefaultDevice))
         .def("getGlobalProperties", &Pipeline::getGlobalProperties, DOC(dai, Pipeline, getGlobalProperties))
         //.def("create", &Pipeline::create<node::XLinkIn>)
-        .def("remove", &Pipeline::remove, py::arg("node"), DOC(dai, Pipeline, remove))
+        .def("remove", &Pipeline::remove, py::arg("node"), py::call_guard<py::gil_scoped_release>(), DOC(dai, Pipeline, remove))
         .def("getAllNodes", static_cast<std::vector<std::shared_ptr<Node>> (Pipeline::*)() const>(&Pipeline::getAllNodes), DOC(dai, Pipeline, getAllNodes))
         // .def("getAllNodes", static_cast<std::vector<std::shared_ptr< Node>> (Pipeline::*)()>(&Pipeline::getAllNodes),
         // py::return_value_policy::reference_internal, DOC(dai, Pipeline, getAllNodes))
@@ -257,6 +273,10 @@ void PipelineBindings::bind(pybind11::module& m, void* pCallstack) {
         .def("isRunning", &Pipeline::isRunning)
         .def("processTasks", &Pipeline::processTasks, py::arg("waitForTasks") = false, py::arg("timeoutSeconds") = -1.0)
         .def("enableHolisticRecord", &Pipeline::enableHolisticRecord, py::arg("recordConfig"), DOC(dai, Pipeline, enableHolisticRecord))
-        .def("enableHolisticReplay", &Pipeline::enableHolisticReplay, py::arg("recordingPath"), DOC(dai, Pipeline, enableHolisticReplay));
+        .def("enableHolisticReplay", &Pipeline::enableHolisticReplay, py::arg("recordingPath"), DOC(dai, Pipeline, enableHolisticReplay))
+        .def("setClock", &Pipeline::setClock, py::arg("clock"), DOC(dai, Pipeline, setClock))
+        .def("getClock", &Pipeline::getClock, DOC(dai, Pipeline, getClock))
+        .def("setHostNodeFusion", &Pipeline::setHostNodeFusion, py::arg("fuse"), DOC(dai, Pipeline, setHostNodeFusion))
+        .def("getHostNodeFusion", &Pipeline::getHostNodeFusion, DOC(dai, Pipeline, getHostNodeFusion));
     ;
 }
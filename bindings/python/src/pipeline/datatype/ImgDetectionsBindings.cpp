@@ -22,6 +22,9 @@ void bind_imgdetections(pybind11::module& m, void* pCallstack) {
     // py::class_<RawImgDetections, RawBuffer, std::shared_ptr<RawImgDetections>> rawImgDetections(m, "RawImgDetections", DOC(dai, RawImgDetections));
     py::class_<ImgDetections, Py<ImgDetections>, Buffer, std::shared_ptr<ImgDetections>> imgDetections(m, "ImgDetections", DOC(dai, ImgDetections));
     py::class_<ImgDetection> imgDetection(m, "ImgDetection", DOC(dai, ImgDetection));
+    py::class_<SegmentationMaskRLE> segmentationMaskRLE(m, "SegmentationMaskRLE", DOC(dai, SegmentationMaskRLE));
+    py::class_<SegmentationMaskRLE::Run> segmentationMaskRLERun(segmentationMaskRLE, "Run", DOC(dai, SegmentationMaskRLE, Run));
+    py::class_<SegmentationMaskBounds> segmentationMaskBounds(m, "SegmentationMaskBounds", DOC(dai, SegmentationMaskBounds));
 
     ///////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////
@@ -83,6 +86,22 @@ void bind_imgdetections(pybind11::module& m, void* pCallstack) {
         .def("getHeight", &dai::ImgDetection::getHeight)
         .def("getAngle", &dai::ImgDetection::getAngle);
 
+    segmentationMaskRLERun.def(py::init<>())
+        .def_readwrite("offset", &SegmentationMaskRLE::Run::offset, DOC(dai, SegmentationMaskRLE, Run, offset))
+        .def_readwrite("length", &SegmentationMaskRLE::Run::length, DOC(dai, SegmentationMaskRLE, Run, length))
+        .def_readwrite("value", &SegmentationMaskRLE::Run::value, DOC(dai, SegmentationMaskRLE, Run, value));
+    segmentationMaskRLE.def(py::init<>())
+        .def_readwrite("width", &SegmentationMaskRLE::width, DOC(dai, SegmentationMaskRLE, width))
+        .def_readwrite("height", &SegmentationMaskRLE::height, DOC(dai, SegmentationMaskRLE, height))
+        .def_readwrite("runs", &SegmentationMaskRLE::runs, DOC(dai, SegmentationMaskRLE, runs));
+    segmentationMaskBounds.def(py::init<>())
+        .def_readwrite("index", &SegmentationMaskBounds::index, DOC(dai, SegmentationMaskBounds, index))
+        .def_readwrite("x", &SegmentationMaskBounds::x, DOC(dai, SegmentationMaskBounds, x))
+        .def_readwrite("y", &SegmentationMaskBounds::y, DOC(dai, SegmentationMaskBounds, y))
+        .def_readwrite("width", &SegmentationMaskBounds::width, DOC(dai, SegmentationMaskBounds, width))
+        .def_readwrite("height", &SegmentationMaskBounds::height, DOC(dai, SegmentationMaskBounds, height))
+        .def_readwrite("area", &SegmentationMaskBounds::area, DOC(dai, SegmentationMaskBounds, area));
+
     // rawImgDetections
     //     .def(py::init<>())
     //     .def_readwrite("detections", &RawImgDetections::detections)
@@ -142,7 +161,13 @@ void bind_imgdetections(pybind11::module& m, void* pCallstack) {
              py::arg("frame"),
              DOC(dai, ImgDetectionsT, setSegmentationMask),
              py::return_value_policy::reference_internal)
+        .def("setSegmentationMask",
+             py::overload_cast<const SegmentationMaskRLE&>(&ImgDetections::setSegmentationMask),
+             py::arg("mask"),
+             DOC(dai, ImgDetectionsT, setSegmentationMask, 4))
         .def("getMaskData", &ImgDetections::getMaskData, DOC(dai, ImgDetectionsT, getMaskData))
+        .def("getSegmentationMaskRLE", &ImgDetections::getSegmentationMaskRLE, DOC(dai, ImgDetectionsT, getSegmentationMaskRLE))
+        .def("getSegmentationMaskBounds", &ImgDetections::getSegmentationMaskBounds, DOC(dai, ImgDetectionsT, getSegmentationMaskBounds))
         .def("getSegmentationMask", &ImgDetections::getSegmentationMask, DOC(dai, ImgDetectionsT, getSegmentationMask))
 #ifdef DEPTHAI_HAVE_OPENCV_SUPPORT
         .def("setCvSegmentationMask", &ImgDetections::setCvSegmentationMask, py::arg("mask"), DOC(dai, ImgDetectionsT, setCvSegmentationMask))
@@ -159,6 +184,10 @@ void bind_imgdetections(pybind11::module& m, void* pCallstack) {
             "getCvSegmentationMaskByClass",
             [](ImgDetections& self, uint8_t semanticClass) { return self.getCvSegmentationMaskByClass(semanticClass, &g_numpyAllocator); },
             py::arg("semantic_class"),
-            DOC(dai, ImgDetectionsT, getCvSegmentationMaskByClass));
+            DOC(dai, ImgDetectionsT, getCvSegmentationMaskByClass))
+        .def(
+            "getCvInstanceSegmentationMasks",
+            [](ImgDetections& self) { return self.getCvInstanceSegmentationMasks(&g_numpyAllocator); },
+            DOC(dai, ImgDetectionsT, getCvInstanceSegmentationMasks));
 #endif
 }
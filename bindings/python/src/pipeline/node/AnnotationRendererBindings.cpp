@@ -0,0 +1,40 @@
+#include "Common.hpp"
+#include "NodeBindings.hpp"
+#include "depthai/pipeline/ThreadedHostNode.hpp"
+#include "depthai/pipeline/node/host/AnnotationRenderer.hpp"
+
+extern py::handle daiNodeModule;
+
+void bind_annotationrenderer(pybind11::module& m, void* pCallstack) {
+    using namespace dai;
+    using namespace dai::node;
+
+    // declare upfront
+    auto annotationRendererNode = ADD_NODE_DERIVED(AnnotationRenderer, ThreadedHostNode);
+
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    // Call the rest of the type defines, then perform the actual bindings
+    Callstack* callstack = (Callstack*)pCallstack;
+    auto cb = callstack->top();
+    callstack->pop();
+    cb(m, pCallstack);
+    // Actual bindings
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////
+
+    // AnnotationRenderer Node
+    annotationRendererNode
+        .def_property_readonly(
+            "inputs", [](AnnotationRenderer& node) { return &node.inputs; }, py::return_value_policy::reference_internal)
+        .def_property_readonly(
+            "inputFrame", [](AnnotationRenderer& node) { return &node.inputFrame; }, py::return_value_policy::reference_internal)
+        .def_property_readonly(
+            "inputAnnotations", [](AnnotationRenderer& node) { return &node.inputAnnotations; }, py::return_value_policy::reference_internal)
+        .def_readonly("out", &AnnotationRenderer::out, DOC(dai, node, AnnotationRenderer, out))
+        .def("build", &AnnotationRenderer::build, py::arg("frames"), py::arg("annotations"), DOC(dai, node, AnnotationRenderer, build))
+        .def("setNumThreads", &AnnotationRenderer::setNumThreads, py::arg("numThreads"), DOC(dai, node, AnnotationRenderer, setNumThreads))
+        .def("setLabelFontSize", &AnnotationRenderer::setLabelFontSize, py::arg("fontSize"), DOC(dai, node, AnnotationRenderer, setLabelFontSize));
+}
@@ -36,6 +36,10 @@ void bind_edgedetector(pybind11::module& m, void* pCallstack) {
         .def_readonly("inputImage", &EdgeDetector::inputImage, DOC(dai, node, EdgeDetector, inputImage))
         .def_readonly("outputImage", &EdgeDetector::outputImage, DOC(dai, node, EdgeDetector, outputImage))
         .def("setNumFramesPool", &EdgeDetector::setNumFramesPool, DOC(dai, node, EdgeDetector, setNumFramesPool))
-        .def("setMaxOutputFrameSize", &EdgeDetector::setMaxOutputFrameSize, DOC(dai, node, EdgeDetector, setMaxOutputFrameSize));
+        .def("setMaxOutputFrameSize", &EdgeDetector::setMaxOutputFrameSize, DOC(dai, node, EdgeDetector, setMaxOutputFrameSize))
+        .def("setNumThreads", &EdgeDetector::setNumThreads, py::arg("numThreads"), DOC(dai, node, EdgeDetector, setNumThreads))
+        .def("getNumThreads", &EdgeDetector::getNumThreads, DOC(dai, node, EdgeDetector, getNumThreads))
+        .def("setRunOnHost", &EdgeDetector::setRunOnHost, py::arg("runOnHost"), DOC(dai, node, EdgeDetector, setRunOnHost))
+        .def("runOnHost", &EdgeDetector::runOnHost, DOC(dai, node, EdgeDetector, runOnHost));
     daiNodeModule.attr("EdgeDetector").attr("Properties") = edgeDetectorProperties;
 }
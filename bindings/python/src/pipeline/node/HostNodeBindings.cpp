@@ -38,6 +38,21 @@ class PyHostNode : public NodeCRTP<HostNode, PyHostNode> {
     std::shared_ptr<Buffer> processGroup(std::shared_ptr<dai::MessageGroup> in) override {
         PYBIND11_OVERRIDE_PURE(std::shared_ptr<Buffer>, HostNode, processGroup, in);
     }
+    std::vector<std::shared_ptr<Buffer>> processBatch(std::vector<std::shared_ptr<dai::MessageGroup>> groups) override {
+        // The GIL is taken and the overrides looked up once for the whole batch
+        py::gil_scoped_acquire gil;
+        if(py::function override = py::get_override(static_cast<const HostNode*>(this), "processBatch")) {
+            return override(groups).cast<std::vector<std::shared_ptr<Buffer>>>();
+        }
+        py::function override = py::get_override(static_cast<const HostNode*>(this), "processGroup");
+        if(!override) py::pybind11_fail("Tried to call pure virtual function \"HostNode::processGroup\"");
+        std::vector<std::shared_ptr<Buffer>> outputs;
+        outputs.reserve(groups.size());
+        for(auto& group : groups) {
+            outputs.push_back(override(group).cast<std::shared_ptr<Buffer>>());
+        }
+        return outputs;
+    }
     void onStart() override {
         PYBIND11_OVERRIDE(void, HostNode, onStart);
     }
@@ -109,6 +124,9 @@ void bind_hostnode(pybind11::module& m, void* pCallstack) {
             return node;
         }))
         .def("processGroup", &HostNode::processGroup)
+        .def("processBatch", &HostNode::processBatch, py::arg("groups"), DOC(dai, node, HostNode, processBatch))
+        .def("setMaxBatchSize", &HostNode::setMaxBatchSize, py::arg("size"), DOC(dai, node, HostNode, setMaxBatchSize))
+        .def("getMaxBatchSize", &HostNode::getMaxBatchSize, DOC(dai, node, HostNode, getMaxBatchSize))
         .def_property_readonly(
             "inputs", [](HostNode& node) { return &node.inputs; }, py::return_value_policy::reference_internal)
         .def_readonly("out", &HostNode::out, DOC(dai, node, HostNode, out))
@@ -139,9 +157,10 @@ void bind_hostnode(pybind11::module& m, void* pCallstack) {
             if cls.output_desc == inspect.Signature.empty:
                 cls.output_desc = None
 
+            process = members["process"]
+            argnames = tuple(cls.input_desc.keys())
             def processGroup(self, messageGroup):
-                return members["process"](self,
-                    *(messageGroup[argname] for argname in cls.input_desc.keys()))
+                return process(self, *[messageGroup[argname] for argname in argnames])
             cls.processGroup = processGroup
 
             def link_args(self, *args):
@@ -110,6 +110,13 @@ void bind_neuralnetwork(pybind11::module& m, void* pCallstack) {
         .def("setBackendProperties", &NeuralNetwork::setBackendProperties, py::arg("setBackendProperties"), DOC(dai, node, NeuralNetwork, setBackendProperties))
         .def("getNNArchive", &NeuralNetwork::getNNArchive, DOC(dai, node, NeuralNetwork, getNNArchive))
         .def("setModelFromDeviceZoo", &NeuralNetwork::setModelFromDeviceZoo, py::arg("model"), DOC(dai, node, NeuralNetwork, setModelFromDeviceZoo))
+        .def("setRunOnHost", &NeuralNetwork::setRunOnHost, py::arg("runOnHost"), DOC(dai, node, NeuralNetwork, setRunOnHost))
+        .def("runOnHost", &NeuralNetwork::runOnHost, DOC(dai, node, NeuralNetwork, runOnHost))
+        .def("setHostNumIntraOpThreads",
+             &NeuralNetwork::setHostNumIntraOpThreads,
+             py::arg("numThreads"),
+             DOC(dai, node, NeuralNetwork, setHostNumIntraOpThreads))
+        .def("setHostMaxBatchSize", &NeuralNetwork::setHostMaxBatchSize, py::arg("maxBatchSize"), DOC(dai, node, NeuralNetwork, setHostMaxBatchSize))
 
         .def_readonly("inputs", &NeuralNetwork::inputs, DOC(dai, node, NeuralNetwork, inputs))
         .def_readonly("passthroughs", &NeuralNetwork::passthroughs, DOC(dai, node, NeuralNetwork, passthroughs))
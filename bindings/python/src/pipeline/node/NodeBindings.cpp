@@ -161,6 +161,7 @@ void bind_imagefilters(pybind11::module& m, void* pCallstack);
 void bind_replay(pybind11::module& m, void* pCallstack);
 void bind_imagealign(pybind11::module& m, void* pCallstack);
 void bind_rgbd(pybind11::module& m, void* pCallstack);
+void bind_annotationrenderer(pybind11::module& m, void* pCallstack);
 void bind_rectification(pybind11::module& m, void* pCallstack);
 void bind_neuraldepth(pybind11::module& m, void* pCallstack);
 #ifdef DEPTHAI_HAVE_BASALT_SUPPORT
@@ -212,6 +213,7 @@ void NodeBindings::addToCallstack(std::deque<StackFunction>& callstack) {
     callstack.push_front(bind_replay);
     callstack.push_front(bind_imagealign);
     callstack.push_front(bind_rgbd);
+    callstack.push_front(bind_annotationrenderer);
     callstack.push_front(bind_rectification);
     callstack.push_front(bind_neuraldepth);
 #ifdef DEPTHAI_HAVE_BASALT_SUPPORT
@@ -242,11 +244,13 @@ void NodeBindings::bind(pybind11::module& m, void* pCallstack) {
     py::enum_<Node::Input::Type> nodeInputType(pyInput, "Type");
     py::class_<Node::Output, std::shared_ptr<Node::Output>> pyOutput(pyNode, "Output", DOC(dai, Node, Output));
     py::enum_<Node::Output::Type> nodeOutputType(pyOutput, "Type");
+    py::enum_<Node::Output::LinkPolicy> nodeOutputLinkPolicy(pyOutput, "LinkPolicy", DOC(dai, Node, Output, LinkPolicy));
+    py::class_<Node::Output::LinkStats> nodeOutputLinkStats(pyOutput, "LinkStats", DOC(dai, Node, Output, LinkStats));
     py::class_<Properties, std::shared_ptr<Properties>> pyProperties(m, "Properties", DOC(dai, Properties));
     py::class_<Node::DatatypeHierarchy> nodeDatatypeHierarchy(pyNode, "DatatypeHierarchy", DOC(dai, Node, DatatypeHierarchy));
 
     py::class_<InputQueue, std::shared_ptr<InputQueue>> pyInputQueue(m, "InputQueue", DOC(dai, InputQueue));
-    pyInputQueue.def("send", &InputQueue::send, py::arg("msg"), DOC(dai, InputQueue, send));
+    pyInputQueue.def("send", &InputQueue::send, py::arg("msg"), DOC(dai, InputQueue, send), py::call_guard<py::gil_scoped_release>());
 
     // Node::Id bindings
     py::class_<Node::Id>(pyNode, "Id", "Node identificator. Unique for every node on a single Pipeline");
@@ -349,6 +353,15 @@ void NodeBindings::bind(pybind11::module& m, void* pCallstack) {
 
     // Node::Output bindings
     nodeOutputType.value("MSender", Node::Output::Type::MSender).value("SSender", Node::Output::Type::SSender);
+    nodeOutputLinkPolicy.value("QUEUE_DEFAULT", Node::Output::LinkPolicy::QUEUE_DEFAULT)
+        .value("BLOCK", Node::Output::LinkPolicy::BLOCK)
+        .value("BLOCK_TIMEOUT", Node::Output::LinkPolicy::BLOCK_TIMEOUT)
+        .value("DROP_NEWEST", Node::Output::LinkPolicy::DROP_NEWEST)
+        .value("DROP_OLDEST", Node::Output::LinkPolicy::DROP_OLDEST)
+        .value("KEEP_LATEST", Node::Output::LinkPolicy::KEEP_LATEST);
+    nodeOutputLinkStats.def(py::init<>())
+        .def_readwrite("sent", &Node::Output::LinkStats::sent, DOC(dai, Node, Output, LinkStats, sent))
+        .def_readwrite("dropped", &Node::Output::LinkStats::dropped, DOC(dai, Node, Output, LinkStats, dropped));
     pyOutput
         .def(py::init([](Node& parent, const std::string& name, const std::string& group, std::vector<Node::DatatypeHierarchy> types) {
                  PyErr_WarnEx(PyExc_DeprecationWarning, "Constructing Output explicitly is deprecated, use createOutput method instead.", 1);
@@ -392,7 +405,15 @@ void NodeBindings::bind(pybind11::module& m, void* pCallstack) {
         .def("unlink", static_cast<void (Node::Output::*)(Node::Input&)>(&Node::Output::unlink), py::arg("input"), DOC(dai, Node, Output, unlink))
         .def("send", &Node::Output::send, py::arg("msg"), DOC(dai, Node, Output, send), py::call_guard<py::gil_scoped_release>())
         .def("getName", &Node::Output::getName, DOC(dai, Node, Output, getName))
-        .def("trySend", &Node::Output::trySend, py::arg("msg"), DOC(dai, Node, Output, trySend));
+        .def("trySend", &Node::Output::trySend, py::arg("msg"), DOC(dai, Node, Output, trySend))
+        .def("setLinkPolicy",
+             &Node::Output::setLinkPolicy,
+             py::arg("input"),
+             py::arg("policy"),
+             py::arg("timeout") = std::chrono::milliseconds(100),
+             DOC(dai, Node, Output, setLinkPolicy))
+        .def("getLinkPolicy", &Node::Output::getLinkPolicy, py::arg("input"), DOC(dai, Node, Output, getLinkPolicy))
+        .def("getLinkStats", &Node::Output::getLinkStats, py::arg("input"), DOC(dai, Node, Output, getLinkStats));
 
     nodeConnection.def_readwrite("outputId", &Node::Connection::outputId, DOC(dai, Node, Connection, outputId))
         .def_readwrite("outputName", &Node::Connection::outputName, DOC(dai, Node, Connection, outputName))
@@ -450,5 +471,6 @@ void NodeBindings::bind(pybind11::module& m, void* pCallstack) {
         .def("critical", [](dai::ThreadedNode& node, const std::string& msg) { node.pimpl->logger->critical(msg); })
         .def("isRunning", &ThreadedNode::isRunning, DOC(dai, ThreadedNode, isRunning))
         .def("setLogLevel", &ThreadedNode::setLogLevel, DOC(dai, ThreadedNode, setLogLevel))
-        .def("getLogLevel", &ThreadedNode::getLogLevel, DOC(dai, ThreadedNode, getLogLevel));
+        .def("getLogLevel", &ThreadedNode::getLogLevel, DOC(dai, ThreadedNode, getLogLevel))
+        .def("getClock", &ThreadedNode::getClock, DOC(dai, ThreadedNode, getClock));
 }
@@ -26,6 +26,7 @@ void bind_replay(pybind11::module& m, void* pCallstack) {
     replayVideo.def_readonly("out", &ReplayVideo::out, DOC(dai, node, ReplayVideo, out))
         .def("setReplayMetadataFile", &ReplayVideo::setReplayMetadataFile, py::arg("replayFile"), DOC(dai, node, ReplayVideo, setReplayMetadataFile))
         .def("setReplayVideoFile", &ReplayVideo::setReplayVideoFile, py::arg("replayVideoFile"), DOC(dai, node, ReplayVideo, setReplayVideoFile))
+        .def("setReplayArchive", &ReplayVideo::setReplayArchive, py::arg("replayArchive"), DOC(dai, node, ReplayVideo, setReplayArchive))
         .def("setOutFrameType", &ReplayVideo::setOutFrameType, py::arg("frameType"), DOC(dai, node, ReplayVideo, setOutFrameType))
         .def("setSize", py::overload_cast<int, int>(&ReplayVideo::setSize), py::arg("width"), py::arg("height"), DOC(dai, node, ReplayVideo, setSize))
         .def("setSize", py::overload_cast<std::tuple<int, int>>(&ReplayVideo::setSize), py::arg("size"), DOC(dai, node, ReplayVideo, setSize))
@@ -33,6 +34,7 @@ void bind_replay(pybind11::module& m, void* pCallstack) {
         .def("setLoop", &ReplayVideo::setLoop, py::arg("loop"), DOC(dai, node, ReplayVideo, setLoop))
         .def("getReplayMetadataFile", &ReplayVideo::getReplayMetadataFile, DOC(dai, node, ReplayVideo, getReplayMetadataFile))
         .def("getReplayVideoFile", &ReplayVideo::getReplayVideoFile, DOC(dai, node, ReplayVideo, getReplayVideoFile))
+        .def("getReplayArchive", &ReplayVideo::getReplayArchive, DOC(dai, node, ReplayVideo, getReplayArchive))
         .def("getOutFrameType", &ReplayVideo::getOutFrameType, DOC(dai, node, ReplayVideo, getOutFrameType))
         .def("getSize", &ReplayVideo::getSize, DOC(dai, node, ReplayVideo, getSize))
         .def("getFps", &ReplayVideo::getFps, DOC(dai, node, ReplayVideo, getFps))
@@ -40,9 +42,11 @@ void bind_replay(pybind11::module& m, void* pCallstack) {
 
     replayMessage.def_readonly("out", &ReplayMetadataOnly::out, DOC(dai, node, ReplayMetadataOnly, out))
         .def("setReplayFile", &ReplayMetadataOnly::setReplayFile, py::arg("replayFile"), DOC(dai, node, ReplayMetadataOnly, setReplayFile))
+        .def("setReplayArchive", &ReplayMetadataOnly::setReplayArchive, py::arg("replayArchive"), DOC(dai, node, ReplayMetadataOnly, setReplayArchive))
         .def("setFps", &ReplayMetadataOnly::setFps, py::arg("fps"), DOC(dai, node, ReplayMetadataOnly, setFps))
         .def("setLoop", &ReplayMetadataOnly::setLoop, py::arg("loop"), DOC(dai, node, ReplayMetadataOnly, setLoop))
         .def("getReplayFile", &ReplayMetadataOnly::getReplayFile, DOC(dai, node, ReplayMetadataOnly, getReplayFile))
+        .def("getReplayArchive", &ReplayMetadataOnly::getReplayArchive, DOC(dai, node, ReplayMetadataOnly, getReplayArchive))
         .def("getFps", &ReplayMetadataOnly::getFps, DOC(dai, node, ReplayMetadataOnly, getFps))
         .def("getLoop", &ReplayMetadataOnly::getLoop, DOC(dai, node, ReplayMetadataOnly, getLoop));
 }
@@ -0,0 +1,63 @@
+import time
+
+import depthai as dai
+
+NUM_MESSAGES = 20
+
+
+class Counter(dai.node.HostNode):
+    def __init__(self):
+        super().__init__()
+        self.processed = []
+
+    def process(self, buffer: dai.Buffer):
+        # The first message is slow, so that messages queue up behind it
+        if not self.processed:
+            time.sleep(0.2)
+        self.processed.append(buffer.getSequenceNum())
+        return buffer
+
+
+class BatchCounter(Counter):
+    def __init__(self):
+        super().__init__()
+        self.batches = []
+
+    def processBatch(self, groups):
+        self.batches.append(len(groups))
+        return [self.processGroup(group) for group in groups]
+
+
+def run(p, node):
+    node.setMaxBatchSize(8)
+    node.inputs["buffer"].setBlocking(True)
+    node.inputs["buffer"].setMaxSize(8)
+    input = node.inputs["buffer"].createInputQueue(NUM_MESSAGES, True)
+    output = node.out.createOutputQueue(NUM_MESSAGES, True)
+    p.start()
+    for i in range(NUM_MESSAGES):
+        buffer = dai.Buffer()
+        buffer.setSequenceNum(i)
+        input.send(buffer)
+    received = [output.get().getSequenceNum() for _ in range(NUM_MESSAGES)]
+    p.stop()
+    return received
+
+
+def test_batches_call_process_per_group():
+    with dai.Pipeline(False) as p:
+        node = Counter()
+        received = run(p, node)
+    assert received == list(range(NUM_MESSAGES))
+    assert node.processed == list(range(NUM_MESSAGES))
+
+
+def test_batches_call_process_batch_override():
+    with dai.Pipeline(False) as p:
+        node = BatchCounter()
+        received = run(p, node)
+    assert received == list(range(NUM_MESSAGES))
+    assert node.processed == list(range(NUM_MESSAGES))
+    assert sum(node.batches) == NUM_MESSAGES
+    assert max(node.batches) > 1
+    assert max(node.batches) <= 8
@@ -45,6 +45,9 @@ if(NOT CONFIG_MODE OR (CONFIG_MODE AND NOT DEPTHAI_SHARED_LIBS))
     if(DEPTHAI_ENABLE_KOMPUTE)
         find_package(kompute ${_QUIET} CONFIG REQUIRED)
     endif()
+    if(DEPTHAI_ENABLE_ONNXRUNTIME)
+        find_package(onnxruntime ${_QUIET} CONFIG REQUIRED)
+    endif()
     # libarchive for firmware packages
     find_package(LibArchive ${_QUIET}  REQUIRED)
     find_package(liblzma ${_QUIET} CONFIG REQUIRED)
@@ -17,6 +17,7 @@ option(DEPTHAI_ENABLE_APRIL_TAG "Enable AprilTag node (not available for Windows
 option(DEPTHAI_ENABLE_PROTOBUF "Enable Protobuf support" ON)
 option(DEPTHAI_ENABLE_CURL "Enable CURL support" ${DEPTHAI_DEFAULT_CURL_SUPPORT})
 option(DEPTHAI_ENABLE_KOMPUTE "Enable Kompute support" OFF)
+option(DEPTHAI_ENABLE_ONNXRUNTIME "Enable ONNX Runtime for running NeuralNetwork on host" OFF)
 option(DEPTHAI_ENABLE_MP4V2 "Enable video recording using the MP4V2 library" ON)
 
 # ---------- Optional Features (public) -------------
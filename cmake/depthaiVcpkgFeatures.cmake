@@ -38,6 +38,10 @@ if(DEPTHAI_ENABLE_KOMPUTE)
     list(APPEND VCPKG_MANIFEST_FEATURES "kompute-support")
 endif()
 
+if(DEPTHAI_ENABLE_ONNXRUNTIME)
+    list(APPEND VCPKG_MANIFEST_FEATURES "onnxruntime-support")
+endif()
+
 if(DEPTHAI_ENABLE_BACKWARD)
     list(APPEND VCPKG_MANIFEST_FEATURES "backward")
 endif()
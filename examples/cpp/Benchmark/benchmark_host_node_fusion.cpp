@@ -0,0 +1,65 @@
+// Compares the latency and CPU time of a chain of host nodes, each running its own thread,
+// with the same chain fused into a single thread by the pipeline.
+// Runs on host only, no device is needed.
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+
+constexpr int NUM_MESSAGES = 2000;
+constexpr int NUM_NODES = 8;
+
+class Passthrough : public dai::node::CustomNode<Passthrough> {
+   public:
+    std::shared_ptr<dai::Buffer> processGroup(std::shared_ptr<dai::MessageGroup> in) override {
+        return in->get<dai::Buffer>("in");
+    }
+};
+
+struct Result {
+    double latencyUs;
+    double cpuUs;
+};
+
+Result measure(bool fuse) {
+    dai::Pipeline pipeline(false);
+    pipeline.setHostNodeFusion(fuse);
+
+    std::vector<std::shared_ptr<Passthrough>> nodes;
+    for(int i = 0; i < NUM_NODES; i++) {
+        auto node = pipeline.create<Passthrough>();
+        if(!nodes.empty()) nodes.back()->out.link(node->inputs["in"]);
+        nodes.push_back(node);
+    }
+    auto input = nodes.front()->inputs["in"].createInputQueue();
+    auto output = nodes.back()->out.createOutputQueue();
+    pipeline.start();
+
+    // One message in flight at a time, so that the latency of the whole chain is measured
+    const auto cpuStart = std::clock();
+    const auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < NUM_MESSAGES; i++) {
+        input->send(std::make_shared<dai::Buffer>());
+        output->get<dai::Buffer>();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const auto cpu = std::clock() - cpuStart;
+    pipeline.stop();
+
+    Result result;
+    result.latencyUs = std::chrono::duration<double, std::micro>(elapsed).count() / NUM_MESSAGES;
+    result.cpuUs = 1e6 * static_cast<double>(cpu) / CLOCKS_PER_SEC / NUM_MESSAGES;
+    return result;
+}
+
+int main() {
+    for(const bool fuse : {false, true}) {
+        const auto result = measure(fuse);
+        std::cout << (fuse ? "Fused" : "Unfused") << " chain of " << NUM_NODES << " host nodes: " << result.latencyUs << " us latency, " << result.cpuUs
+                  << " us CPU time per message" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+// Measures the host XLink transport, XLinkOutHost -> XLinkInHost, over an in-process LoopbackConnection.
+// Small messages are sent one per transfer and coalesced, large frames one per transfer.
+// Runs on host only, no device is needed.
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include "depthai/depthai.hpp"
+#include "depthai/pipeline/node/internal/XLinkInHost.hpp"
+#include "depthai/pipeline/node/internal/XLinkOutHost.hpp"
+#include "depthai/xlink/LoopbackConnection.hpp"
+
+struct Result {
+    double messagesPerSecond;
+    double megabytesPerSecond;
+};
+
+Result measure(std::size_t messageSize, int numMessages, bool coalesce) {
+    auto conn = std::make_shared<dai::LoopbackConnection>();
+    Result result{};
+    {
+        dai::Pipeline pipeline(false);
+        auto xout = pipeline.create<dai::node::internal::XLinkOutHost>();
+        auto xin = pipeline.create<dai::node::internal::XLinkInHost>();
+        xout->setConnection(conn);
+        xout->setStreamName("benchmark");
+        xout->allowStreamResize(true);
+        if(coalesce) xout->setCoalescing(64 * 1024, std::chrono::microseconds(500));
+        xin->setConnection(conn);
+        xin->setStreamName("benchmark");
+
+        auto input = xout->in.createInputQueue(64, true);
+        auto output = xin->out.createOutputQueue(64, true);
+        pipeline.start();
+
+        const auto start = std::chrono::steady_clock::now();
+        std::thread sender([&]() {
+            for(int i = 0; i < numMessages; i++) {
+                auto buffer = std::make_shared<dai::Buffer>(messageSize);
+                buffer->setSequenceNum(i);
+                input->send(buffer);
+            }
+        });
+        for(int i = 0; i < numMessages; i++) {
+            output->get<dai::Buffer>();
+        }
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        sender.join();
+
+        pipeline.stop();
+        // Unblocks XLinkInHost, as closing the device would
+        conn->close();
+
+        result.messagesPerSecond = numMessages / seconds;
+        result.megabytesPerSecond = static_cast<double>(messageSize) * numMessages / seconds / (1024.0 * 1024.0);
+    }
+    return result;
+}
+
+int main() {
+    struct Case {
+        const char* name;
+        std::size_t messageSize;
+        int numMessages;
+        bool coalesce;
+    };
+    const Case cases[] = {
+        {"64 B messages", 64, 20000, false},
+        {"64 B messages, coalesced", 64, 20000, true},
+        {"1 MB frames", 1024 * 1024, 500, false},
+    };
+    for(const auto& c : cases) {
+        const auto result = measure(c.messageSize, c.numMessages, c.coalesce);
+        std::cout << c.name << ": " << result.messagesPerSecond << " messages/s, " << result.megabytesPerSecond << " MB/s" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+# Compares the per message overhead of a Python HostNode processing one group at a time
+# with the same node processing batches of groups under a single GIL acquisition.
+# Runs on host only, no device is needed.
+import time
+
+import depthai as dai
+
+NUM_MESSAGES = 2000
+NUM_NODES = 4
+
+
+class Source(dai.node.ThreadedHostNode):
+    def __init__(self):
+        super().__init__()
+        self.output = self.createOutput()
+
+    def run(self):
+        for i in range(NUM_MESSAGES):
+            if not self.isRunning():
+                break
+            buffer = dai.Buffer()
+            buffer.setSequenceNum(i)
+            self.output.send(buffer)
+
+
+class Counter(dai.node.HostNode):
+    def __init__(self):
+        super().__init__()
+        self.received = 0
+
+    def build(self, output):
+        self.link_args(output)
+        return self
+
+    def process(self, message: dai.Buffer):
+        self.received += 1
+
+
+class BatchCounter(Counter):
+    def processBatch(self, groups):
+        self.received += len(groups)
+        return [None] * len(groups)
+
+
+def measure(nodeClass, batchSize):
+    with dai.Pipeline(False) as pipeline:
+        counters = []
+        for _ in range(NUM_NODES):
+            source = pipeline.create(Source)
+            counter = pipeline.create(nodeClass).build(source.output)
+            counter.setMaxBatchSize(batchSize)
+            # Nothing is dropped, so every message is counted
+            counter.inputs["message"].setBlocking(True)
+            counter.inputs["message"].setMaxSize(64)
+            counters.append(counter)
+
+        start = time.monotonic()
+        pipeline.start()
+        while any(counter.received < NUM_MESSAGES for counter in counters):
+            time.sleep(0.001)
+        elapsed = time.monotonic() - start
+        pipeline.stop()
+    return elapsed / (NUM_MESSAGES * NUM_NODES)
+
+
+for name, nodeClass, batchSize in [
+    ("process, one group per call", Counter, 1),
+    ("process, batches of up to 16 groups", Counter, 16),
+    ("processBatch, batches of up to 16 groups", BatchCounter, 16),
+]:
+    print(f"{name}: {measure(nodeClass, batchSize) * 1e6:.1f} us per message")
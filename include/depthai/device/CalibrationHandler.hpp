@@ -1,13 +1,17 @@
 // IWYU pragma: private, include "depthai/depthai.hpp"
 #pragma once
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include "depthai/common/CameraBoardSocket.hpp"
 #include "depthai/common/EepromData.hpp"
 #include "depthai/common/Point2f.hpp"
+#include "depthai/common/Point3f.hpp"
 #include "depthai/common/Size2f.hpp"
+#include "depthai/utility/matrixOps.hpp"
 
 #ifdef DEPTHAI_HAVE_RTABMAP_SUPPORT
     #pragma push_macro("_res")
@@ -32,6 +36,10 @@ namespace dai {
 class CalibrationHandler {
    public:
     CalibrationHandler() = default;
+    CalibrationHandler(const CalibrationHandler& other);
+    CalibrationHandler(CalibrationHandler&& other) noexcept;
+    CalibrationHandler& operator=(const CalibrationHandler& other);
+    CalibrationHandler& operator=(CalibrationHandler&& other) noexcept;
 
     /**
      * Construct a new Calibration Handler object using the
@@ -154,6 +162,16 @@ class CalibrationHandler {
                                                         Point2f bottomRightPixelId = Point2f(),
                                                         bool keepAspectRatio = true) const;
 
+    /**
+     * Same as getCameraIntrinsics, but returns a fixed-size matrix, without allocating
+     */
+    matrix::Mat3f getCameraIntrinsicsMat3f(CameraBoardSocket cameraId,
+                                           int resizeWidth = -1,
+                                           int resizeHeight = -1,
+                                           Point2f topLeftPixelId = Point2f(),
+                                           Point2f bottomRightPixelId = Point2f(),
+                                           bool keepAspectRatio = true) const;
+
     /**
      * Get the Default Intrinsics object
      *
@@ -226,6 +244,12 @@ class CalibrationHandler {
      */
     std::vector<std::vector<float>> getCameraExtrinsics(CameraBoardSocket srcCamera, CameraBoardSocket dstCamera, bool useSpecTranslation = false) const;
 
+    /**
+     * Same as getCameraExtrinsics, but returns a fixed-size matrix.
+     * Transformations between all camera pairs are computed once, on first query, and reused until the calibration data is modified.
+     */
+    matrix::Mat4f getCameraExtrinsicsMat4f(CameraBoardSocket srcCamera, CameraBoardSocket dstCamera, bool useSpecTranslation = false) const;
+
     /**
      * Get the Camera translation vector between two cameras from the calibration data.
      *
@@ -264,6 +288,46 @@ class CalibrationHandler {
                               CameraBoardSocket cam2 = CameraBoardSocket::CAM_B,
                               bool useSpecTranslation = true) const;
 
+    /**
+     * Transform points from the coordinate system of one camera to the coordinate system of another
+     *
+     * @param srcCamera Camera Id of the camera in whose coordinate system the points are given
+     * @param dstCamera Camera Id of the camera to whose coordinate system the points are transformed
+     * @param points Points in centimeters
+     * @param useSpecTranslation Enabling this bool uses the translation information from the board design data
+     * @return transformed points in centimeters
+     */
+    std::vector<Point3f> transformPoints(CameraBoardSocket srcCamera,
+                                         CameraBoardSocket dstCamera,
+                                         const std::vector<Point3f>& points,
+                                         bool useSpecTranslation = false) const;
+
+    /**
+     * Project points given in the camera's coordinate system to distorted pixel coordinates, as cv::projectPoints
+     * (or cv::fisheye::projectPoints) would with the camera's intrinsics and distortion coefficients.
+     * Supports the Perspective (without tilt) and Fisheye camera models.
+     *
+     * @param cameraId Camera Id of the camera to project to
+     * @param points Points in the camera's coordinate system, in front of the camera
+     * @param resizeWidth Width of the image the pixel coordinates refer to, -1 for the calibrated width
+     * @param resizeHeight Height of the image the pixel coordinates refer to, -1 for the calibrated height
+     * @return pixel coordinates of the projected points
+     */
+    std::vector<Point2f> projectPoints(CameraBoardSocket cameraId, const std::vector<Point3f>& points, int resizeWidth = -1, int resizeHeight = -1) const;
+
+    /**
+     * Remove lens distortion from pixel coordinates, iteratively as cv::undistortPoints (or cv::fisheye::undistortPoints) does,
+     * with the camera's intrinsics used as the new camera matrix. Inverse of projectPoints, up to the solver's precision.
+     * Supports the Perspective (without tilt) and Fisheye camera models.
+     *
+     * @param cameraId Camera Id of the camera the points were captured with
+     * @param points Distorted pixel coordinates
+     * @param resizeWidth Width of the image the pixel coordinates refer to, -1 for the calibrated width
+     * @param resizeHeight Height of the image the pixel coordinates refer to, -1 for the calibrated height
+     * @return undistorted pixel coordinates
+     */
+    std::vector<Point2f> undistortPoints(CameraBoardSocket cameraId, const std::vector<Point2f>& points, int resizeWidth = -1, int resizeHeight = -1) const;
+
     /**
      * Get the Camera To Imu Extrinsics object
      * From the data loaded if there is a linked connection between IMU and the given camera then there relative rotation and translation from the camera to IMU
@@ -599,6 +663,15 @@ class CalibrationHandler {
      */
     // bool isCameraArrayConnected;
     dai::EepromData eepromData;
+
+    /// Transformations between all camera pairs, built on first extrinsics query. Immutable once built, and shared between copies.
+    struct ExtrinsicsCache;
+    mutable std::shared_ptr<const ExtrinsicsCache> extrinsicsCache;
+    std::shared_ptr<const ExtrinsicsCache> getExtrinsicsCache() const;
+    /// Must be called by anything that modifies eepromData.cameraData
+    void invalidateExtrinsicsCache();
+    std::vector<std::vector<float>> computeCameraExtrinsics(CameraBoardSocket srcCamera, CameraBoardSocket dstCamera, bool useSpecTranslation) const;
+
     std::vector<std::vector<float>> computeExtrinsicMatrix(CameraBoardSocket srcCamera, CameraBoardSocket dstCamera, bool useSpecTranslation = false) const;
     bool checkExtrinsicsLink(CameraBoardSocket srcCamera, CameraBoardSocket dstCamera) const;
     bool checkSrcLinks(CameraBoardSocket headSocket) const;
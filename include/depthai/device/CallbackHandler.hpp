@@ -1,27 +1,103 @@
 #pragma once
 
 // std
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 // project
 #include "depthai/pipeline/datatype/ADatatype.hpp"
 #include "depthai/xlink/XLinkConnection.hpp"
+#include "depthai/xlink/XLinkStream.hpp"
 
 namespace dai {
 
+/**
+ * Answers messages received over an XLink stream with the messages returned by a callback.
+ *
+ * Received messages are parsed and passed to the callback by a bounded pool of workers, so several callbacks can run at once,
+ * while the responses are written back in the order the messages were received. A callback returning nullptr sends no response.
+ * An exception thrown while reading, parsing, in the callback or while writing stops the handler; it is kept and available from getError().
+ */
 class CallbackHandler {
-    std::thread t;
-    std::atomic<bool> running{true};
-    std::shared_ptr<XLinkConnection> connection;
-    std::function<std::shared_ptr<ADatatype>(std::shared_ptr<ADatatype>)> callback;
-
    public:
-    void setCallback(std::function<std::shared_ptr<ADatatype>(std::shared_ptr<ADatatype>)> cb);
+    using Callback = std::function<std::shared_ptr<ADatatype>(std::shared_ptr<ADatatype>)>;
+
+    /**
+     * Answers messages on a single stream
+     * @param numWorkers Number of callbacks that may run at the same time
+     */
+    CallbackHandler(std::shared_ptr<XLinkConnection> conn, const std::string& streamName, Callback cb, unsigned numWorkers = 1);
+    /**
+     * Reads messages from one stream and writes the responses to another
+     * @param numWorkers Number of callbacks that may run at the same time
+     */
     CallbackHandler(std::shared_ptr<XLinkConnection> conn,
-                    const std::string& streamName,
-                    std::function<std::shared_ptr<ADatatype>(std::shared_ptr<ADatatype>)> cb);
+                    const std::string& inputStreamName,
+                    const std::string& outputStreamName,
+                    Callback cb,
+                    unsigned numWorkers = 1);
+    CallbackHandler(const CallbackHandler&) = delete;
+    CallbackHandler& operator=(const CallbackHandler&) = delete;
     ~CallbackHandler();
+
+    /**
+     * Replaces the callback, messages already being processed finish with the previous one
+     */
+    void setCallback(Callback cb);
+
+    /**
+     * Stops reading and waits for the callbacks in progress to return. Messages not yet passed to the callback are dropped.
+     * Must not be called from the callback.
+     */
+    void close();
+
+    /**
+     * @returns True until the handler is closed or stopped by an error
+     */
+    bool isRunning() const;
+
+    /**
+     * @returns Exception which stopped the handler, or nullptr
+     */
+    std::exception_ptr getError() const;
+
+   private:
+    struct Job {
+        std::uint64_t sequenceNum;
+        StreamPacketDesc packet;
+    };
+
+    void readerThread();
+    void workerThread();
+    void fail(std::exception_ptr exception);
+
+    std::shared_ptr<XLinkConnection> connection;
+    std::unique_ptr<XLinkStream> inputStream;
+    // Same as the input stream when not set
+    std::unique_ptr<XLinkStream> outputStream;
+    std::size_t maxQueuedJobs;
+
+    mutable std::mutex mtx;
+    std::condition_variable jobAvailable;
+    std::condition_variable jobTaken;
+    std::condition_variable writeTurn;
+    std::deque<Job> jobs;
+    std::uint64_t nextWrite = 0;
+    std::shared_ptr<const Callback> callback;
+    std::exception_ptr error;
+    std::atomic<bool> running{true};
+
+    std::thread reader;
+    std::vector<std::thread> workers;
 };
 
 }  // namespace dai
@@ -5,6 +5,7 @@
 #include <chrono>
 #include <condition_variable>
 #include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -402,6 +403,26 @@ class DeviceBase {
      */
     bool setIrFloodLightIntensity(float intensity, int mask = -1);
 
+    /**
+     * Asynchronous variant of setIrLaserDotProjectorIntensity. Returns once the request is sent,
+     * so it doesn't wait for other in-flight device calls to complete.
+     *
+     * @param intensity Intensity on range 0 to 1, that will determine brightness. 0 or negative to turn off
+     * @param mask Optional mask to modify only Left (0x1) or Right (0x2) sides on OAK-D-Pro-W-DEV
+     * @returns Future holding true on success, false if not found or other failure
+     */
+    std::future<bool> setIrLaserDotProjectorIntensityAsync(float intensity, int mask = -1);
+
+    /**
+     * Asynchronous variant of setIrFloodLightIntensity. Returns once the request is sent,
+     * so it doesn't wait for other in-flight device calls to complete.
+     *
+     * @param intensity Intensity on range 0 to 1, that will determine brightness, 0 or negative to turn off
+     * @param mask Optional mask to modify only Left (0x1) or Right (0x2) sides on OAK-D-Pro-W-DEV
+     * @returns Future holding true on success, false if not found or other failure
+     */
+    std::future<bool> setIrFloodLightIntensityAsync(float intensity, int mask = -1);
+
     /**
      * Retrieves detected IR laser/LED drivers.
      *
@@ -592,6 +613,41 @@ class DeviceBase {
      */
     CpuUsage getLeonMssCpuUsage();
 
+    /**
+     * Asynchronous variant of getDdrMemoryUsage
+     *
+     * @returns Future holding used, remaining and total ddr memory
+     */
+    std::future<MemoryInfo> getDdrMemoryUsageAsync();
+
+    /**
+     * Asynchronous variant of getCmxMemoryUsage
+     *
+     * @returns Future holding used, remaining and total cmx memory
+     */
+    std::future<MemoryInfo> getCmxMemoryUsageAsync();
+
+    /**
+     * Asynchronous variant of getChipTemperature
+     *
+     * @returns Future holding temperature of various onboard sensors
+     */
+    std::future<ChipTemperature> getChipTemperatureAsync();
+
+    /**
+     * Asynchronous variant of getLeonCssCpuUsage
+     *
+     * @returns Future holding average CPU usage and sampling duration
+     */
+    std::future<CpuUsage> getLeonCssCpuUsageAsync();
+
+    /**
+     * Asynchronous variant of getLeonMssCpuUsage
+     *
+     * @returns Future holding average CPU usage and sampling duration
+     */
+    std::future<CpuUsage> getLeonMssCpuUsageAsync();
+
     /**
      * Retrieves current Rss memory usage of the device process
      *
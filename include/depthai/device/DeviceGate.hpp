@@ -4,6 +4,8 @@
 #include <XLink/XLinkPublicDefines.h>
 
 #include <cstdint>
+#include <filesystem>
+#include <functional>
 #include <string>
 #include <thread>
 #include <type_traits>
@@ -27,11 +29,23 @@ class DeviceGate {
         std::vector<uint8_t> data;
         std::string filename;
     };
+
+    /**
+     * Reports the progress of a download, total is 0 if the gate didn't send the size up front
+     */
+    using ProgressCallback = std::function<void(std::uint64_t received, std::uint64_t total)>;
+
     /**
      * Connects to DepthAI Gate
      * @param deviceInfo Device to connect to
      */
     DeviceGate(const DeviceInfo& deviceInfo);
+    /**
+     * Connects to DepthAI Gate listening on a non default port
+     * @param deviceInfo Device to connect to
+     * @param port Gate's HTTP port
+     */
+    DeviceGate(const DeviceInfo& deviceInfo, int port);
     ~DeviceGate();
     bool isOkay();
     bool createSession(bool exclusive = true);
@@ -40,10 +54,29 @@ class DeviceGate {
     bool deleteSession();
     bool destroySession();
     SessionState getState();
+    /**
+     * Blocks until the session is no longer created, running or stopping.
+     * Follows the state changes the gate pushes as server-sent events, gates without the events endpoint are polled instead.
+     * @returns Final state of the session, ERROR_STATE if the gate couldn't be reached
+     */
+    SessionState waitForSessionExit();
     // Waits for the gate session to end and tries to get the logs and crash dump out
     std::optional<CrashDump> waitForSessionEnd();
 
-    std::optional<CrashDump> getCrashDump();
+    /**
+     * Downloads the crash dump into memory, waiting for the gate to finish generating it
+     */
+    std::optional<CrashDump> getCrashDump(ProgressCallback progress = nullptr);
+    /**
+     * Streams the crash dump into a file in the given directory, waiting for the gate to finish generating it
+     * @returns Path of the written file
+     */
+    std::optional<std::filesystem::path> saveCrashDump(const std::filesystem::path& directory, ProgressCallback progress = nullptr);
+    /**
+     * Streams the session logs into a file in the given directory
+     * @returns Path of the written file
+     */
+    std::optional<std::filesystem::path> saveLogs(const std::filesystem::path& directory, ProgressCallback progress = nullptr);
 
     struct VersionInfo {
         std::string gate, os;
@@ -59,7 +92,11 @@ class DeviceGate {
 
     std::thread stateMonitoringThread;
 
-    std::optional<std::vector<uint8_t>> getFile(const std::string& fileUrl, std::string& filename);
+    std::optional<std::vector<uint8_t>> getFile(const std::string& fileUrl, std::string& filename, const ProgressCallback& progress);
+    std::optional<std::filesystem::path> saveFile(const std::string& fileUrl,
+                                                  const std::filesystem::path& directory,
+                                                  const std::string& defaultFilename,
+                                                  const ProgressCallback& progress);
 
     // state of the session
     std::atomic_bool sessionCreated{false};
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
 #include <map>
 #include <memory>
 #include <vector>
 
 #include "depthai/pipeline/Assets.hpp"
+#include "depthai/utility/span.hpp"
 
 namespace dai {
 
@@ -26,6 +28,64 @@ class AssetsMutable : public Assets {
     void set(std::string, std::uint32_t offset, std::uint32_t size, std::uint32_t alignment);
 };
 
+/**
+ * @brief Asset storage described as a scatter list of (offset, span) entries, pointing into the original asset data.
+ * Bytes not covered by any entry (alignment padding) are zero.
+ * Keeps the referenced assets alive, but their data must not be modified while the list is in use.
+ */
+class AssetScatterList {
+   public:
+    struct Entry {
+        std::size_t offset;
+        span<const std::uint8_t> data;
+    };
+
+    /**
+     * Appends an asset, aligned to its alignment
+     * @returns Offset of the asset in the storage
+     */
+    std::size_t append(std::shared_ptr<const Asset> asset);
+
+    /**
+     * @returns Entries, ordered by offset
+     */
+    const std::vector<Entry>& getEntries() const;
+
+    /**
+     * @returns Size of the whole storage, including padding
+     */
+    std::size_t size() const;
+
+    bool empty() const;
+
+    void clear();
+
+    /**
+     * Copies the storage into a contiguous buffer of at least size() bytes
+     */
+    void copyTo(span<std::uint8_t> dst) const;
+
+    /**
+     * Copies the storage into a contiguous vector
+     */
+    std::vector<std::uint8_t> toVector() const;
+
+    /**
+     * Streams the storage as packets of exactly packetSize bytes (except the last one).
+     * Packets within a single asset point directly into its data, only packets spanning
+     * asset boundaries are gathered into a packet sized staging buffer.
+     *
+     * @param packetSize Size of the packets
+     * @param write Called for each packet, in order
+     */
+    void stream(std::size_t packetSize, const std::function<void(span<const std::uint8_t>)>& write) const;
+
+   private:
+    std::vector<Entry> entries;
+    std::vector<std::shared_ptr<const Asset>> owners;
+    std::size_t totalSize = 0;
+};
+
 // Subclass which has its own storage
 /**
  * @brief AssetManager can store assets and serialize
@@ -127,6 +187,9 @@ class AssetManager /*: public Assets*/ {
 
     /// Serializes
     void serialize(AssetsMutable& assets, std::vector<std::uint8_t>& assetStorage, std::string prefix = "") const;
+
+    /// Serializes without copying asset data, appending the assets to a scatter list
+    void serialize(AssetsMutable& assets, AssetScatterList& assetStorage, std::string prefix = "") const;
 };
 
 }  // namespace dai
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
 #include "depthai/pipeline/Node.hpp"
 #include "depthai/pipeline/ThreadedHostNode.hpp"
 
@@ -12,6 +16,11 @@ class InputQueue {
     /**
      * @brief Send a message to the connected input
      *
+     * Once the pipeline is started, the message is delivered straight into the connected input's queue from the calling thread.
+     * A blocking input queue waits while a blocking connected input is full. A non blocking one drops the oldest queued message instead,
+     * or the new message when other outputs send to the same input as well. A policy set on the link takes precedence.
+     * Messages sent before the pipeline is started are kept, up to maxSize, and delivered when it starts.
+     *
      * @param msg: Message to send
      */
     void send(const std::shared_ptr<ADatatype>& msg);
@@ -25,6 +34,10 @@ class InputQueue {
      */
     explicit InputQueue(unsigned int maxSize = 16, bool blocking = false);
 
+    /**
+     * Node representing the host side of the link in the pipeline, so that the regular linking (and XLink bridging) applies.
+     * It doesn't start a thread, messages are forwarded from send.
+     */
     class InputQueueNode : public node::ThreadedHostNode {
        public:
         /** Constructor*/
@@ -33,11 +46,26 @@ class InputQueue {
         /** Send message from host*/
         void send(const std::shared_ptr<ADatatype>& msg);
 
+        void start() override;
+        void stop() override;
         void run() override;
         const char* getName() const override;
 
+        /** Holds the messages sent before the pipeline is started */
         Node::Input input{*this, {"input", DEFAULT_GROUP, DEFAULT_BLOCKING, DEFAULT_QUEUE_SIZE, {{{DatatypeEnum::Buffer, true}}}, DEFAULT_WAIT_FOR_MESSAGE}};
         Node::Output output{*this, {"output", DEFAULT_GROUP, {{{DatatypeEnum::Buffer, true}}}}};
+
+       private:
+        void deliver(const std::shared_ptr<ADatatype>& msg);
+        // Delivery policy of the links without one set
+        Node::Output::LinkPolicy defaultPolicy() const;
+
+        bool blocking;
+        std::mutex startMtx;
+        std::condition_variable startCv;
+        std::atomic<bool> started{false};
+        // Set on start for a non blocking queue that is the only sender to its inputs
+        std::atomic<bool> dropOldest{false};
     };
 
     // Helper access functions
@@ -1,6 +1,8 @@
 #pragma once
 
 // std
+#include <chrono>
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -19,6 +21,18 @@ class MessageQueue : public std::enable_shared_from_this<MessageQueue> {
     /// Alias for callback id
     using CallbackId = int;
 
+    /// Behavior when full for sendWithPolicy, independent of the queue's own blocking setting
+    enum class OverflowPolicy {
+        /// Wait for space, up to the given timeout
+        BLOCK,
+        /// Discard the new message
+        DROP_NEWEST,
+        /// Discard the oldest queued messages to make space
+        DROP_OLDEST,
+        /// Discard all queued messages, leaving only the new one
+        KEEP_LATEST
+    };
+
     class QueueException : public std::runtime_error {
        public:
         explicit QueueException(const std::string& message) : std::runtime_error(message) {}
@@ -126,6 +140,14 @@ class MessageQueue : public std::enable_shared_from_this<MessageQueue> {
      */
     unsigned int getSize() const;
 
+    /**
+     * Waits until the queue is empty or closed
+     *
+     * @param timeout Maximum duration to wait
+     * @returns True if the queue is empty or closed, false if the timeout elapsed first
+     */
+    bool waitEmpty(std::chrono::milliseconds timeout);
+
     /**
      * Gets whether queue is full
      *
@@ -422,6 +444,17 @@ class MessageQueue : public std::enable_shared_from_this<MessageQueue> {
      * @param msg message to send
      */
     bool trySend(const std::shared_ptr<ADatatype>& msg);
+
+    /**
+     * Adds a message to the queue, handling a full queue as given by policy instead of the blocking setting.
+     * Callbacks are only called for a message that was added, or always for a queue with a maximum size of 0.
+     *
+     * @param msg Message to add to the queue
+     * @param policy What to do when the queue is full
+     * @param timeout Maximum duration to block for the BLOCK policy, a maximum duration waits without a timeout
+     * @returns Number of discarded messages, including the new one if it wasn't added
+     */
+    std::size_t sendWithPolicy(const std::shared_ptr<ADatatype>& msg, OverflowPolicy policy, std::chrono::milliseconds timeout = std::chrono::milliseconds::max());
 };
 
 }  // namespace dai
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <set>
@@ -111,6 +113,7 @@ class Node : public std::enable_shared_from_this<Node> {
 
     class Output {
         friend class PipelineImpl;
+        friend class InputQueue;
 
        public:
         struct QueueConnection {
@@ -121,11 +124,46 @@ class Node : public std::enable_shared_from_this<Node> {
             }
         };
         enum class Type { MSender, SSender };
+
+        /// How messages are delivered over a link when the linked input is full
+        enum class LinkPolicy {
+            /// Follow the input's blocking setting, BLOCK if it is blocking and DROP_OLDEST otherwise
+            QUEUE_DEFAULT,
+            /// Wait for space
+            BLOCK,
+            /// Wait for space up to the link's timeout, then discard the new message
+            BLOCK_TIMEOUT,
+            /// Discard the new message
+            DROP_NEWEST,
+            /// Discard the oldest queued messages to make space
+            DROP_OLDEST,
+            /// Discard all queued messages, leaving only the new one
+            KEEP_LATEST
+        };
+
+        /// Counters of a single link
+        struct LinkStats {
+            /// Messages delivered to the input
+            uint64_t sent = 0;
+            /// Messages discarded by the link policy, either the new one or already queued ones
+            uint64_t dropped = 0;
+        };
+
         virtual ~Output() = default;
 
        private:
+        struct LinkState;
+        struct Link {
+            MessageQueue* queue;
+            // Shared by the link lists replacing each other, so the policy and counters outlive a change of other links
+            std::shared_ptr<LinkState> state;
+        };
+
+        using Links = std::vector<Link>;
+
         std::reference_wrapper<Node> parent;
-        std::vector<MessageQueue*> connectedInputs;
+        // Replaced as a whole on each change, so that links can change while messages are being sent over them
+        std::shared_ptr<const Links> connectedInputs = std::make_shared<const Links>();
         std::vector<QueueConnection> queueConnections;
         Type type = Type::MSender;  // Slave sender not supported yet
         OutputDescription desc;
@@ -233,7 +271,8 @@ class Node : public std::enable_shared_from_this<Node> {
         static constexpr unsigned int OUTPUT_QUEUE_DEFAULT_MAX_SIZE = 16;
 
         /**
-         * @brief Construct and return a shared pointer to an output message queue
+         * @brief Construct and return a shared pointer to an output message queue.
+         * Once the pipeline is built, only outputs of host nodes can get new queues.
          *
          * @param maxSize: Maximum size of the output queue
          * @param blocking: Whether the output queue should block when full
@@ -244,19 +283,25 @@ class Node : public std::enable_shared_from_this<Node> {
                                                              bool blocking = OUTPUT_QUEUE_DEFAULT_BLOCKING);
 
        private:
-        void link(const std::shared_ptr<dai::MessageQueue>& queue) {
-            connectedInputs.push_back(queue.get());
-            queueConnections.push_back({this, queue});
-        }
-
-        void unlink(const std::shared_ptr<dai::MessageQueue>& queue) {
-            connectedInputs.erase(std::remove(connectedInputs.begin(), connectedInputs.end(), queue.get()), connectedInputs.end());
-            queueConnections.erase(std::remove(queueConnections.begin(), queueConnections.end(), QueueConnection{this, queue}), queueConnections.end());
-        }
+        void link(const std::shared_ptr<dai::MessageQueue>& queue);
+        void unlink(const std::shared_ptr<dai::MessageQueue>& queue);
+        void addLink(MessageQueue* queue);
+        void removeLink(const MessageQueue* queue);
+        std::shared_ptr<const Links> getLinks() const;
+        std::shared_ptr<LinkState> getLinkState(const MessageQueue& queue) const;
+        // Calls back once the link to the queue is unlinked and no message is being sent over it anymore
+        void notifyWhenReleased(const MessageQueue& queue, std::function<void()> callback);
+        void checkLinkEditable(const Input& in) const;
+        bool isLinked(const LinkState& state) const;
+        bool deliver(const Link& link, const std::shared_ptr<ADatatype>& msg, LinkPolicy policy, std::chrono::milliseconds timeout);
+        bool deliverIfRoom(const Link& link, const std::shared_ptr<ADatatype>& msg);
+        // Like trySend, links without a policy set use defaultPolicy, unless it is QUEUE_DEFAULT as well
+        bool trySendWithDefault(const std::shared_ptr<ADatatype>& msg, LinkPolicy defaultPolicy);
 
        public:
         /**
          * Link current output to input.
+         * While the pipeline is running, only outputs and inputs of host nodes can be linked.
          *
          * Throws an error if this output cannot be linked to given input,
          * or if they are already linked
@@ -268,7 +313,9 @@ class Node : public std::enable_shared_from_this<Node> {
         virtual void link(std::shared_ptr<Node> in);
 
         /**
-         * Unlink a previously linked connection
+         * Unlink a previously linked connection.
+         * While the pipeline is running, only outputs and inputs of host nodes can be unlinked,
+         * a message being sent while unlinking may still be delivered, or is dropped if the input was closed meanwhile.
          *
          * Throws an error if not linked.
          *
@@ -283,11 +330,36 @@ class Node : public std::enable_shared_from_this<Node> {
         void send(const std::shared_ptr<ADatatype>& msg);
 
         /**
-         * Try sending a message to all connected inputs
+         * Try sending a message to all connected inputs, without waiting on any of them
          * @param msg Message to send to all connected inputs
          * @returns True if ALL connected inputs got the message, false otherwise
          */
         bool trySend(const std::shared_ptr<ADatatype>& msg);
+
+        /**
+         * Set how messages are delivered to a linked input or output queue once it is full.
+         * Inputs that don't make the sender wait get each message first, so a slow consumer doesn't delay the others.
+         * Can be changed while the pipeline is running.
+         *
+         * Throws an error if not linked.
+         *
+         * @param in Linked input or output queue
+         * @param policy Behavior when full
+         * @param timeout Maximum duration to wait for the BLOCK_TIMEOUT policy
+         */
+        void setLinkPolicy(const MessageQueue& in, LinkPolicy policy, std::chrono::milliseconds timeout = std::chrono::milliseconds(100));
+
+        /**
+         * Get the delivery policy of a link
+         * @param in Linked input or output queue
+         */
+        LinkPolicy getLinkPolicy(const MessageQueue& in) const;
+
+        /**
+         * Get message counters of a link
+         * @param in Linked input or output queue
+         */
+        LinkStats getLinkStats(const MessageQueue& in) const;
     };
 
     struct PairHash {
@@ -327,6 +399,8 @@ class Node : public std::enable_shared_from_this<Node> {
     class Input : public MessageQueue {
         friend class Output;
         friend class OutputMap;
+        friend class PipelineImpl;
+        friend class InputQueue;
 
        public:
         enum class Type { SReceiver, MReceiver };  // TODO(Morato) - refactor, make the MReceiver a separate class (shouldn't inherit from MessageQueue)
@@ -439,7 +513,8 @@ class Node : public std::enable_shared_from_this<Node> {
         static constexpr unsigned int INPUT_QUEUE_DEFAULT_MAX_SIZE = 16;
 
         /**
-         * @brief Create an shared pointer to an input queue that can be used to send messages to this input from onhost
+         * @brief Create an shared pointer to an input queue that can be used to send messages to this input from onhost.
+         * Once the pipeline is built, only inputs of host nodes can get new queues, the queue is started by Pipeline::start.
          *
          * @param maxSize: Maximum size of the input queue
          * @param blocking: Whether the input queue should block when full
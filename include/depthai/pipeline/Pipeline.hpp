@@ -2,7 +2,10 @@
 #pragma once
 
 // standard
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <type_traits>
 #include <unordered_set>
 #include <utility>
@@ -16,6 +19,7 @@
 #include "depthai/device/Device.hpp"
 #include "depthai/openvino/OpenVINO.hpp"
 #include "depthai/utility/AtomicBool.hpp"
+#include "depthai/utility/Clock.hpp"
 
 // shared
 #include "depthai/device/BoardConfig.hpp"
@@ -69,6 +73,7 @@ class PipelineImpl : public std::enable_shared_from_this<PipelineImpl> {
     std::vector<std::shared_ptr<Node>> getSourceNodes();
 
     void serialize(PipelineSchema& schema, Assets& assets, std::vector<std::uint8_t>& assetStorage, SerializationType type = DEFAULT_SERIALIZATION_TYPE) const;
+    void serialize(PipelineSchema& schema, Assets& assets, AssetScatterList& assetStorage, SerializationType type = DEFAULT_SERIALIZATION_TYPE) const;
     nlohmann::json serializeToJson(bool includeAssets) const;
     void remove(std::shared_ptr<Node> node);
 
@@ -117,6 +122,32 @@ class PipelineImpl : public std::enable_shared_from_this<PipelineImpl> {
 
     // Output queues
     std::vector<std::shared_ptr<MessageQueue>> outputQueues;
+    std::mutex outputQueuesMtx;
+
+    // Nodes added while running, built and started by the next start call
+    std::vector<std::shared_ptr<Node>> pendingNodes;
+    // Links to nodes being removed while running, which senders still hold
+    struct HeldLinks {
+        std::mutex mtx;
+        std::condition_variable released;
+        int count = 0;
+    };
+    // Nodes removed while running which might still be referenced by messages being sent to them
+    struct RetiredNode {
+        std::shared_ptr<Node> node;
+        std::shared_ptr<HeldLinks> links;
+    };
+    std::vector<RetiredNode> retiredNodes;
+    // Nodes being removed while running, while the removal waits for them without holding stateMtx
+    std::unordered_set<const Node*> removingNodes;
+
+    // Clock of the host nodes
+    std::shared_ptr<PipelineClock> clock = PipelineClock::steady();
+
+    // Whether build fuses chains of host nodes into the thread of the first node
+    bool hostNodeFusion = false;
+    // Nodes fused by build, together with the sync nodes of the fused inputs
+    std::unordered_set<const Node*> fusedNodes;
 
     // parent
     Pipeline& parent;
@@ -127,8 +158,8 @@ class PipelineImpl : public std::enable_shared_from_this<PipelineImpl> {
     // was pipeline built
     AtomicBool isBuild{false};
 
-    // Add a mutex for any state change
-    std::mutex stateMtx;
+    // Add a mutex for any state change, recursive as building the pipeline adds nodes
+    mutable std::recursive_mutex stateMtx;
 
     // Calibration mutex
     mutable std::mutex calibMtx;
@@ -224,6 +255,15 @@ class PipelineImpl : public std::enable_shared_from_this<PipelineImpl> {
     void stop();
     void run();
 
+    // Changes of a running pipeline
+    void fuseHostNodes();
+    bool isFused(const Node& node) const;
+    void startPendingNodes();
+    bool isPending(const Node& node) const;
+    void removeWhileRunning(const std::shared_ptr<Node>& toRemove);
+    void releaseRetiredNodes();
+    static void unlinkFromOthers(const std::vector<std::shared_ptr<Node>>& group);
+
     // Reset connections
     void resetConnections();
     void disconnectXLinkHosts();
@@ -295,6 +335,11 @@ class Pipeline {
         impl()->serialize(schema, assets, assetStorage);
     }
 
+    /// Serializes the pipeline, with asset storage referencing the assets' data instead of copying it
+    void serialize(PipelineSchema& schema, Assets& assets, AssetScatterList& assetStorage) const {
+        impl()->serialize(schema, assets, assetStorage);
+    }
+
     /// Returns whole pipeline represented as JSON
     nlohmann::json serializeToJson(bool includeAssests = true) const {
         return impl()->serializeToJson(includeAssests);
@@ -311,13 +356,18 @@ class Pipeline {
     }
 
     /**
-     * Adds an existing node to the pipeline
+     * Adds an existing node to the pipeline.
+     * While the pipeline is running, the node is linked as usual and started by the next start call, it must run on host.
      */
     void add(std::shared_ptr<Node> node) {
         impl()->add(node);
     }
 
-    /// Removes a node from pipeline
+    /**
+     * Removes a node from pipeline.
+     * While the pipeline is running, only host nodes added directly to the pipeline can be removed. No new messages are sent to
+     * the node, it gets a moment to process the messages already sent to it, then it's stopped and unlinked from its outputs.
+     */
     void remove(std::shared_ptr<Node> node) {
         impl()->remove(node);
     }
@@ -477,6 +527,10 @@ class Pipeline {
     void build() {
         impl()->build();
     }
+    /**
+     * Builds the pipeline, if not built yet, and starts it.
+     * While the pipeline is running, builds and starts the host nodes added to it since, including input queues created since.
+     */
     void start() {
         impl()->start();
     }
@@ -503,6 +557,35 @@ class Pipeline {
         impl()->addTask(std::move(task));
     }
 
+    /**
+     * Sets the clock host nodes use for pacing and for the timestamps they generate, the steady clock by default.
+     * With a SimulatedPipelineClock, pipelines fed by Replay nodes run as fast as possible on the recorded time.
+     * @param clock Clock of the host nodes, can't be changed while the pipeline is running
+     */
+    void setClock(std::shared_ptr<PipelineClock> clock);
+
+    /// Gets the clock of the host nodes
+    std::shared_ptr<PipelineClock> getClock() const {
+        return impl()->clock;
+    }
+
+    /**
+     * Sets whether building the pipeline fuses linear chains of host nodes.
+     * A HostNode whose only input is fed only by another HostNode, which sends nowhere else, is then called
+     * from the thread of that node instead of running its own. Messages between fused nodes are never dropped,
+     * the sending node waits for the receiving one instead, regardless of the blocking and size settings of its input.
+     * An exception thrown by the receiving node stops only that node. While running, fused nodes can't be removed and
+     * their inputs can't be relinked. Only applies to user nodes derived from HostNode, none of the built-in nodes are.
+     * Disabled by default.
+     * @param fuse Whether to fuse, can't be changed once the pipeline is built
+     */
+    void setHostNodeFusion(bool fuse);
+
+    /// Gets whether building the pipeline fuses linear chains of host nodes
+    bool getHostNodeFusion() const {
+        return impl()->hostNodeFusion;
+    }
+
     /// Record and Replay
     void enableHolisticRecord(const RecordConfig& config);
     void enableHolisticReplay(const std::string& pathToRecording);
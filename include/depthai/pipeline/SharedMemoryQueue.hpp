@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "depthai/pipeline/MessageQueue.hpp"
+#include "depthai/pipeline/datatype/ADatatype.hpp"
+
+namespace dai {
+
+class SharedMemoryRing;
+
+/**
+ * Sending end of a queue between two processes on the same host, carried by a POSIX shared memory ring of fixed size slots.
+ *
+ * Each message is written into a slot as its payload followed by its serialized metadata, the same layout as on XLink.
+ * The receiving process parses the metadata and hands out messages whose payload references the slot, without copying it,
+ * until the message is released. The queue has one sender and one receiver.
+ * Only supported on Linux.
+ */
+class SharedMemoryQueueSender {
+   public:
+    /**
+     * Creates the shared memory ring, failing if one with the name already exists
+     * @param name Name of the queue, shared with the receiver
+     * @param numSlots Number of messages the ring holds
+     * @param slotSize Maximal size of a message, payload and metadata
+     */
+    explicit SharedMemoryQueueSender(const std::string& name, std::size_t numSlots = 4, std::size_t slotSize = 16 * 1024 * 1024);
+    ~SharedMemoryQueueSender();
+    SharedMemoryQueueSender(const SharedMemoryQueueSender&) = delete;
+    SharedMemoryQueueSender& operator=(const SharedMemoryQueueSender&) = delete;
+
+    /**
+     * Writes the message into the next slot, waiting for the receiver to release it.
+     * Throws MessageQueue::QueueException once the queue or the receiver is closed, or the receiving process exited.
+     * @param msg Message to send
+     * @param timeout Maximal time to wait for the slot
+     * @returns False if the slot wasn't released in time
+     */
+    bool send(const std::shared_ptr<ADatatype>& msg, std::chrono::milliseconds timeout = std::chrono::milliseconds::max());
+
+    /**
+     * Queue whose messages are sent by a thread of the sender, so that node outputs can be linked to the queue
+     */
+    std::shared_ptr<MessageQueue> getQueue();
+
+    /**
+     * Closes the queue. Messages already in the sender's queue are still sent, waiting up to a second for the receiver to take them.
+     * The receiver gets the messages already sent and then its queue is closed.
+     * The shared memory is unlinked, it's freed once the receiver closes as well.
+     */
+    void close();
+
+    bool isClosed() const;
+
+   private:
+    bool write(const std::shared_ptr<ADatatype>& msg, std::chrono::milliseconds timeout);
+    void forwardThread();
+
+    std::string name;
+    std::shared_ptr<SharedMemoryRing> ring;
+    std::shared_ptr<MessageQueue> queue;
+    std::thread forwarder;
+    std::atomic<bool> closed{false};
+    // Set once closed, the forwarder sends what is left in the queue until the deadline
+    std::atomic<bool> draining{false};
+    std::chrono::steady_clock::time_point drainDeadline;
+};
+
+/**
+ * Receiving end of a SharedMemoryQueueSender in another process.
+ * A thread of the receiver moves the messages into its queue, the slot of a message is released together with the message.
+ * One receiver is attached at a time. Another one can attach once it closed, or in place of one whose process exited,
+ * in which case the slots held by its messages are freed.
+ */
+class SharedMemoryQueueReceiver {
+   public:
+    /**
+     * Opens the shared memory ring of a sender and attaches to it, failing if another receiver is attached
+     * @param name Name of the queue
+     * @param maxSize Maximal number of messages in the receiving queue, the messages waiting there hold their slots
+     * @param timeout Maximal time to wait for the sender to create the ring
+     */
+    explicit SharedMemoryQueueReceiver(const std::string& name, unsigned int maxSize = 4, std::chrono::milliseconds timeout = std::chrono::seconds(1));
+    ~SharedMemoryQueueReceiver();
+    SharedMemoryQueueReceiver(const SharedMemoryQueueReceiver&) = delete;
+    SharedMemoryQueueReceiver& operator=(const SharedMemoryQueueReceiver&) = delete;
+
+    /**
+     * Queue receiving the messages, closed once the sender is closed or its process exited, and the remaining messages are received
+     */
+    std::shared_ptr<MessageQueue> getQueue();
+
+    /**
+     * Stops receiving and closes the queue. Messages already received stay valid.
+     */
+    void close();
+
+   private:
+    void attach(const std::string& path);
+    void receiveThread();
+
+    std::shared_ptr<SharedMemoryRing> ring;
+    std::shared_ptr<MessageQueue> queue;
+    std::thread receiver;
+    std::atomic<bool> running{true};
+    std::atomic<bool> closed{false};
+};
+
+}  // namespace dai
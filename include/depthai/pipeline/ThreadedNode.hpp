@@ -3,6 +3,7 @@
 #include "depthai/log/LogLevel.hpp"
 #include "depthai/pipeline/Node.hpp"
 #include "depthai/utility/AtomicBool.hpp"
+#include "depthai/utility/Clock.hpp"
 #include "depthai/utility/JoiningThread.hpp"
 #include "depthai/utility/spimpl.h"
 
@@ -59,6 +60,15 @@ class ThreadedNode : public Node {
      */
     virtual dai::LogLevel getLogLevel() const;
 
+    /**
+     * @brief Gets the clock of the pipeline the node is part of.
+     *
+     * Host nodes pace themselves and timestamp the messages they generate by this clock.
+     *
+     * @returns Clock of the parent pipeline, or the steady clock if the node isn't part of one
+     */
+    std::shared_ptr<PipelineClock> getClock() const;
+
     class Impl;
     spimpl::impl_ptr<Impl> pimpl;
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <optional>
 #include <vector>
 
@@ -7,6 +8,7 @@
 #include "depthai/common/optional.hpp"
 #include "depthai/pipeline/datatype/Buffer.hpp"
 #include "depthai/pipeline/datatype/ImgFrame.hpp"
+#include "depthai/utility/span.hpp"
 
 #ifdef DEPTHAI_HAVE_OPENCV_SUPPORT
     #include <opencv2/core/mat.hpp>
@@ -17,12 +19,47 @@
 
 namespace dai {
 
+/**
+ * Run-length encoded segmentation mask.
+ * Runs cover consecutive pixels of a single instance in row-major order and may continue over row ends.
+ * Background pixels (value 255) aren't stored.
+ */
+struct SegmentationMaskRLE {
+    struct Run {
+        /// Row-major index of the first pixel
+        std::uint32_t offset = 0;
+        std::uint32_t length = 0;
+        /// Instance index
+        std::uint8_t value = 0;
+    };
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+    std::vector<Run> runs;
+};
+
+/**
+ * Pixel bounds of a single instance in a segmentation mask
+ */
+struct SegmentationMaskBounds {
+    /// Instance index
+    std::uint8_t index = 0;
+    std::uint32_t x = 0;
+    std::uint32_t y = 0;
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+    /// Number of pixels belonging to the instance
+    std::uint32_t area = 0;
+};
+
 template <class DetectionT>
 class ImgDetectionsT : public Buffer {
    protected:
     size_t segmentationMaskWidth = 0;
     size_t segmentationMaskHeight = 0;
 
+    /// Throws if the mask data doesn't match the mask dimensions
+    void checkMaskSize(size_t size) const;
+
    public:
     std::vector<DetectionT> detections;
     std::optional<ImgTransformation> transformation;
@@ -50,17 +87,45 @@ class ImgDetectionsT : public Buffer {
      */
     void setSegmentationMask(const std::vector<std::uint8_t>& mask, size_t width, size_t height);
 
+    /*
+     * Sets the segmentation mask from a vector of bytes, taking over its storage without a copy.
+     * The size of the vector must be equal to width * height.
+     */
+    void setSegmentationMask(std::vector<std::uint8_t>&& mask, size_t width, size_t height);
+
     /*
      * Sets the segmentation mask from an ImgFrame.
      * @param frame Frame must be of type GRAY8
      */
     void setSegmentationMask(dai::ImgFrame& frame);
 
+    /*
+     * Sets the segmentation mask from its run-length encoding.
+     */
+    void setSegmentationMask(const SegmentationMaskRLE& mask);
+
     /*
      * Returns a copy of the segmentation mask data as a vector of bytes. If mask data is not set, returns std::nullopt.
      */
     std::optional<std::vector<std::uint8_t>> getMaskData() const;
 
+    /*
+     * Returns the segmentation mask data without copying it, empty if mask data is not set.
+     * The view is valid until the mask is changed or the message is destroyed.
+     */
+    span<const std::uint8_t> getMaskDataView() const;
+
+    /*
+     * Returns the run-length encoded segmentation mask. If mask data is not set, returns std::nullopt.
+     */
+    std::optional<SegmentationMaskRLE> getSegmentationMaskRLE() const;
+
+    /*
+     * Returns the pixel bounds of every instance present in the segmentation mask, ordered by instance index.
+     * Computed in a single pass over the mask, so that per instance work can be limited to the bounds.
+     */
+    std::vector<SegmentationMaskBounds> getSegmentationMaskBounds() const;
+
     /*
      * Returns the segmentation mask as an ImgFrame. If mask data is not set, returns std::nullopt.
      */
@@ -86,6 +151,12 @@ class ImgDetectionsT : public Buffer {
      */
     std::optional<cv::Mat> getCvSegmentationMask(cv::MatAllocator* allocator = nullptr);
 
+    /**
+     * Retrieves mask data as a cv::Mat referencing the message's data, without a copy. If mask data is not set, returns std::nullopt.
+     * The cv::Mat is valid until the mask is changed or the message is destroyed.
+     */
+    std::optional<cv::Mat> getCvSegmentationMaskView();
+
     /**
      * Returns a binary mask where pixels belonging to the instance index are set to 1, others to 0. If mask data is not set, returns std::nullopt.
      * @param index Instance index
@@ -100,6 +171,13 @@ class ImgDetectionsT : public Buffer {
      */
     std::optional<cv::Mat> getCvSegmentationMaskByClass(uint8_t semanticClass, cv::MatAllocator* allocator = nullptr);
 
+    /**
+     * Returns a binary mask for every detection, as getCvSegmentationMaskByIndex would for its index.
+     * The mask is scanned once and each instance only within its bounds. If mask data is not set, returns an empty vector.
+     * @param allocator Allows callers to supply a custom cv::MatAllocator for zero-copy/custom memory management; nullptr uses OpenCV’s default.
+     */
+    std::vector<cv::Mat> getCvInstanceSegmentationMasks(cv::MatAllocator* allocator = nullptr);
+
 #endif
 };
 
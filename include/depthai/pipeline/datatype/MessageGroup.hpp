@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
-#include <unordered_map>
+#include <mutex>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "depthai/common/ADatatypeSharedPtrSerialization.hpp"
@@ -9,12 +12,72 @@
 #include "depthai/pipeline/datatype/Buffer.hpp"
 #include "depthai/utility/Serialization.hpp"
 namespace dai {
+
+/**
+ * Named parts of a MessageGroup.
+ *
+ * A flat vector kept sorted by name, so that iteration and serialization match the std::map the parts used to be stored in.
+ * Lookups compare the hash of the name, computed once per part, before comparing the names themselves.
+ * Names must not be modified through the iterators.
+ */
+class MessageGroupParts {
+   public:
+    using value_type = std::pair<std::string, std::shared_ptr<ADatatype>>;
+    using iterator = std::vector<value_type>::iterator;
+    using const_iterator = std::vector<value_type>::const_iterator;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    std::size_t size() const;
+    bool empty() const;
+    void reserve(std::size_t capacity);
+    /// Removes the parts, keeping the allocated storage
+    void clear();
+
+    iterator find(const std::string& name);
+    const_iterator find(const std::string& name) const;
+    std::size_t count(const std::string& name) const;
+    /// Throws std::out_of_range if there is no part with the name
+    std::shared_ptr<ADatatype>& at(const std::string& name);
+    const std::shared_ptr<ADatatype>& at(const std::string& name) const;
+    /// Inserts an empty part if there is no part with the name
+    std::shared_ptr<ADatatype>& operator[](const std::string& name);
+    std::pair<iterator, bool> insert_or_assign(const std::string& name, std::shared_ptr<ADatatype> value);
+    std::size_t erase(const std::string& name);
+
+    /// Incremented by every call which gives mutable access to the parts
+    std::uint64_t getVersion() const {
+        return version;
+    }
+
+    // Same as std::map<std::string, std::shared_ptr<ADatatype>>
+    friend void to_json(nlohmann::json& j, const MessageGroupParts& parts) {
+        j = nlohmann::json::object();
+        for(const auto& part : parts.parts) j[part.first] = part.second;
+    }
+    friend void from_json(const nlohmann::json& j, MessageGroupParts& parts) {
+        parts.clear();
+        for(const auto& item : j.items()) parts.insert_or_assign(item.key(), item.value().get<std::shared_ptr<ADatatype>>());
+    }
+
+   private:
+    std::size_t indexOf(const std::string& name, std::size_t hash) const;
+    iterator insertAt(const std::string& name, std::size_t hash);
+
+    std::vector<value_type> parts;
+    std::vector<std::size_t> hashes;
+    std::uint64_t version = 0;
+};
+
 /**
  * MessageGroup message. Carries multiple messages in one.
  */
 class MessageGroup : public Buffer {
    public:
-    std::map<std::string, std::shared_ptr<ADatatype>> group;
+    MessageGroupParts group;
 
     virtual ~MessageGroup();
 
@@ -37,9 +100,14 @@ class MessageGroup : public Buffer {
     // }
     void add(const std::string& name, const std::shared_ptr<ADatatype>& value);
 
+    /**
+     * Removes all messages and resets the timestamps and sequence number, keeping the allocated storage
+     */
+    void clear();
+
     // Iterators
-    std::map<std::string, std::shared_ptr<ADatatype>>::iterator begin();
-    std::map<std::string, std::shared_ptr<ADatatype>>::iterator end();
+    MessageGroupParts::iterator begin();
+    MessageGroupParts::iterator end();
 
     /**
      * True if all messages in the group are in the interval
@@ -49,6 +117,7 @@ class MessageGroup : public Buffer {
 
     /**
      * Retrieves interval between the first and the last message in the group.
+     * Uses the current device timestamps of the messages, messages which aren't a Buffer are ignored.
      */
     int64_t getIntervalNs() const;
 
@@ -64,6 +133,90 @@ class MessageGroup : public Buffer {
         return DatatypeEnum::MessageGroup;
     }
     DEPTHAI_SERIALIZE(MessageGroup, group, Buffer::ts, Buffer::tsDevice, Buffer::sequenceNum);
+
+   private:
+    // Parts which are a Buffer, so their timestamps are read without a cast, valid while the parts are at buffersVersion
+    std::vector<const Buffer*> bufferParts;
+    std::uint64_t buffersVersion = 0;
+};
+
+/**
+ * Recycles MessageGroup objects, so that nodes sending a group per frame don't allocate the group and its parts each time.
+ * Groups return to the pool once the last reference is released, the pool may be destroyed before its groups.
+ */
+class MessageGroupPool {
+   public:
+    /**
+     * @param maxIdle Maximal number of released groups kept for reuse
+     */
+    explicit MessageGroupPool(std::size_t maxIdle = 8);
+
+    /// Returns an empty group, reusing a released one if available
+    std::shared_ptr<MessageGroup> acquire();
+
+    /// Number of released groups waiting to be reused
+    std::size_t getNumIdle() const;
+
+   private:
+    struct State {
+        std::mutex mtx;
+        std::vector<std::unique_ptr<MessageGroup>> idle;
+        std::size_t maxIdle;
+    };
+    std::shared_ptr<State> state;
 };
 
-}  // namespace dai
\ No newline at end of file
+}  // namespace dai
+
+namespace nop {
+// Same encoding as std::map<std::string, std::shared_ptr<dai::ADatatype>>, which the device expects
+template <>
+struct Encoding<dai::MessageGroupParts> : EncodingIO<dai::MessageGroupParts> {
+    using Type = dai::MessageGroupParts;
+
+    static constexpr EncodingByte Prefix(const Type& /* value */) {
+        return EncodingByte::Map;
+    }
+
+    static std::size_t Size(const Type& value) {
+        std::size_t size = BaseEncodingSize(EncodingByte::Map) + Encoding<SizeType>::Size(value.size());
+        for(const auto& part : value) size += Encoding<std::string>::Size(part.first) + Encoding<std::shared_ptr<dai::ADatatype>>::Size(part.second);
+        return size;
+    }
+
+    static constexpr bool Match(EncodingByte prefix) {
+        return prefix == EncodingByte::Map;
+    }
+
+    template <typename Writer>
+    static Status<void> WritePayload(EncodingByte /* prefix */, const Type& value, Writer* writer) {
+        auto status = Encoding<SizeType>::Write(value.size(), writer);
+        if(!status) return status;
+        for(const auto& part : value) {
+            status = Encoding<std::string>::Write(part.first, writer);
+            if(!status) return status;
+            status = Encoding<std::shared_ptr<dai::ADatatype>>::Write(part.second, writer);
+            if(!status) return status;
+        }
+        return {};
+    }
+
+    template <typename Reader>
+    static Status<void> ReadPayload(EncodingByte /* prefix */, Type* value, Reader* reader) {
+        SizeType size = 0;
+        auto status = Encoding<SizeType>::Read(&size, reader);
+        if(!status) return status;
+        value->clear();
+        for(SizeType i = 0; i < size; i++) {
+            std::string name;
+            std::shared_ptr<dai::ADatatype> part;
+            status = Encoding<std::string>::Read(&name, reader);
+            if(!status) return status;
+            status = Encoding<std::shared_ptr<dai::ADatatype>>::Read(&part, reader);
+            if(!status) return status;
+            value->insert_or_assign(name, std::move(part));
+        }
+        return {};
+    }
+};
+}  // namespace nop
@@ -2,17 +2,22 @@
 
 // standard
 #include <memory>
+#include <vector>
 
 // libraries
 #include <XLink/XLinkPublicDefines.h>
 
 // project
 #include "depthai/pipeline/datatype/ADatatype.hpp"
+#include "depthai/utility/span.hpp"
 #include "depthai/xlink/XLinkStream.hpp"
 
 // StreamPacket structure ->  || imgframepixels... , serialized_object, object_type, serialized_object_size ||
 // object_type -> DataType(int), serialized_object_size -> int
 
+// Coalesced StreamPacket structure -> || packet_0, ..., packet_n-1, packet_sizes, n, coalesced_marker ||
+// packet_i -> complete StreamPacket, packet_sizes -> n x uint32 LE, n -> uint32 LE
+
 namespace dai {
 class StreamMessageParser {
    public:
@@ -22,5 +27,33 @@ class StreamMessageParser {
     // static std::vector<std::uint8_t> serializeMessage(const ADatatype& data);
     static std::vector<std::uint8_t> serializeMetadata(const std::shared_ptr<const ADatatype>& data);
     static std::vector<std::uint8_t> serializeMetadata(const ADatatype& data);
+
+    /**
+     * Appends a message to a coalesced packet being built
+     * @param coalesced Packet being built
+     * @param sizes Sizes of the messages already in the packet, appended to
+     * @param data Message data
+     * @param metadata Message metadata, as returned by serializeMetadata
+     */
+    static void appendCoalesced(std::vector<std::uint8_t>& coalesced,
+                                std::vector<std::uint32_t>& sizes,
+                                span<const std::uint8_t> data,
+                                const std::vector<std::uint8_t>& metadata);
+    /**
+     * Completes a coalesced packet by appending its trailer
+     */
+    static void finalizeCoalesced(std::vector<std::uint8_t>& coalesced, const std::vector<std::uint32_t>& sizes);
+    /**
+     * Size of the trailer finalizeCoalesced appends for the given number of messages
+     */
+    static std::size_t getCoalescedTrailerSize(std::size_t numMessages);
+    /**
+     * Checks whether the packet holds multiple coalesced messages
+     */
+    static bool isCoalesced(const streamPacketDesc_t* packet);
+    /**
+     * Splits a coalesced packet and parses each of its messages, in order
+     */
+    static std::vector<std::shared_ptr<ADatatype>> parseCoalesced(streamPacketDesc_t* const packet);
 };
 }  // namespace dai
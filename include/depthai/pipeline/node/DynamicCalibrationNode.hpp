@@ -175,9 +175,8 @@ class DynamicCalibration : public DeviceNodeCRTP<DeviceNode, DynamicCalibration,
     std::pair<int, int> resolutionB;
     std::shared_ptr<::spdlog::async_logger> logger;
 
-    // std::chrono::milliseconds sleepingTime = 250ms;
-    // static constexpr std::chrono::milliseconds kSleepingTime{250};
-    std::chrono::milliseconds sleepingTime{250};
+    // Longest time the node blocks waiting for commands before checking whether it should stop
+    std::chrono::milliseconds maxWaitTime{250};
     // Time between loading consecutive images, in seconds.
     // Controls how frequently the system fetches a new frame.
     float loadImagePeriod = 0.5f;
@@ -187,7 +186,6 @@ class DynamicCalibration : public DeviceNodeCRTP<DeviceNode, DynamicCalibration,
     float calibrationPeriod = 5.0f;
     DynamicCalibrationControl::PerformanceMode performanceMode = DynamicCalibrationControl::PerformanceMode::DEFAULT;
     bool calibrationShouldRun = false;
-    bool slept = false;
 
     /**
      * Calibration state machine, which holds the state of Node and provide stabile enviroment;
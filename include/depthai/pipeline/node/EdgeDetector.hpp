@@ -16,7 +16,7 @@ namespace node {
 /**
  * @brief EdgeDetector node. Performs edge detection using 3x3 Sobel filter
  */
-class EdgeDetector : public DeviceNodeCRTP<DeviceNode, EdgeDetector, EdgeDetectorProperties> {
+class EdgeDetector : public DeviceNodeCRTP<DeviceNode, EdgeDetector, EdgeDetectorProperties>, public HostRunnable {
    public:
     constexpr static const char* NAME = "EdgeDetector";
     using DeviceNodeCRTP::DeviceNodeCRTP;
@@ -66,6 +66,35 @@ class EdgeDetector : public DeviceNodeCRTP<DeviceNode, EdgeDetector, EdgeDetecto
      * @param maxFrameSize Maximum frame size in bytes
      */
     void setMaxOutputFrameSize(int maxFrameSize);
+
+    /**
+     * Set number of threads used to filter a frame when running on host.
+     * Frame rows are split into this many tiles processed concurrently.
+     * @param numThreads Number of threads to use
+     */
+    void setNumThreads(int numThreads);
+
+    /**
+     * Get number of threads used to filter a frame when running on host.
+     */
+    int getNumThreads() const;
+
+    /**
+     * Specify whether to run on host or device
+     * By default, the node will run on device.
+     */
+    void setRunOnHost(bool runOnHost);
+
+    /**
+     * Check if the node is set to run on host
+     */
+    bool runOnHost() const override;
+
+    void run() override;
+
+   private:
+    bool runOnHostVar = false;
+    int numThreads = 1;
 };
 
 }  // namespace node
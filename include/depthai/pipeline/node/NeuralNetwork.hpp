@@ -21,7 +21,7 @@ namespace node {
 /**
  * @brief NeuralNetwork node. Runs a neural inference on input data.
  */
-class NeuralNetwork : public DeviceNodeCRTP<DeviceNode, NeuralNetwork, NeuralNetworkProperties> {
+class NeuralNetwork : public DeviceNodeCRTP<DeviceNode, NeuralNetwork, NeuralNetworkProperties>, public HostRunnable {
    public:
     constexpr static const char* NAME = "NeuralNetwork";
     using DeviceNodeCRTP::DeviceNodeCRTP;
@@ -195,6 +195,33 @@ class NeuralNetwork : public DeviceNodeCRTP<DeviceNode, NeuralNetwork, NeuralNet
      */
     void setModelFromDeviceZoo(DeviceModelZoo model);
 
+    /**
+     * Specify whether to run on host or device.
+     * On host, ONNX models are inferred on the CPU, which requires the library to be built with ONNX Runtime support.
+     * By default, the node will run on device.
+     */
+    void setRunOnHost(bool runOnHost);
+
+    /**
+     * Check if the node is set to run on host
+     */
+    bool runOnHost() const override;
+
+    /**
+     * Number of threads used within a single operator when running on host
+     * @param numThreads Number of threads, 0 lets the runtime decide
+     */
+    void setHostNumIntraOpThreads(int numThreads);
+
+    /**
+     * Maximum number of queued input messages inferred together when running on host.
+     * Only applies to models with a dynamic batch dimension.
+     * @param maxBatchSize Maximum batch size, 1 disables batching
+     */
+    void setHostMaxBatchSize(int maxBatchSize);
+
+    void run() override;
+
    private:
     void setNNArchiveBlob(const NNArchive& nnArchive);
     void setNNArchiveSuperblob(const NNArchive& nnArchive, int numShaves);
@@ -202,6 +229,9 @@ class NeuralNetwork : public DeviceNodeCRTP<DeviceNode, NeuralNetwork, NeuralNet
     NNArchive createNNArchive(NNModelDescription& modelDesc);
     ImgFrameCapability getFrameCapability(const NNArchive& nnArchive, std::optional<float> fps);
     std::optional<NNArchive> nnArchive;
+    bool runOnHostVar = false;
+    int hostNumIntraOpThreads = 0;
+    int hostMaxBatchSize = 1;
 };
 
 }  // namespace node
@@ -0,0 +1,70 @@
+#pragma once
+#include "depthai/pipeline/Subnode.hpp"
+#include "depthai/pipeline/ThreadedHostNode.hpp"
+#include "depthai/pipeline/datatype/MessageGroup.hpp"
+#include "depthai/pipeline/node/Sync.hpp"
+#include "depthai/utility/Pimpl.hpp"
+
+namespace dai {
+namespace node {
+
+/**
+ * @brief AnnotationRenderer node. Draws ImgAnnotations, ImgDetections, SpatialImgDetections and Tracklets into a copy of the frame they belong to,
+ * so that the result can be encoded or streamed.
+ *
+ * Frames are drawn on natively, without a conversion to BGR. Supported frame types are NV12 and GRAY8, other frames are forwarded unchanged.
+ * Messages are synced with the frame by timestamp. Besides inputAnnotations, any other input created in inputs is drawn as well, in the order of input names.
+ * Normalized coordinates are taken as relative to the frame.
+ */
+class AnnotationRenderer : public NodeCRTP<ThreadedHostNode, AnnotationRenderer> {
+   public:
+    constexpr static const char* NAME = "AnnotationRenderer";
+
+    AnnotationRenderer();
+    ~AnnotationRenderer();
+    Subnode<node::Sync> sync{*this, "sync"};
+    InputMap& inputs = sync->inputs;
+
+    std::string frameInputName = "inFrame";
+    std::string annotationsInputName = "inAnnotations";
+    /**
+     * Input frame, NV12 or GRAY8
+     */
+    Input& inputFrame = inputs[frameInputName];
+    /**
+     * Input ImgAnnotations, ImgDetections, SpatialImgDetections or Tracklets
+     */
+    Input& inputAnnotations = inputs[annotationsInputName];
+
+    /**
+     * Output frame with the annotations drawn in
+     */
+    Output out{*this, {"out", DEFAULT_GROUP, {{{DatatypeEnum::ImgFrame, false}}}}};
+
+    /**
+     * Link frames and annotations to the renderer
+     */
+    std::shared_ptr<AnnotationRenderer> build(Output& frames, Output& annotations);
+
+    /**
+     * @brief Number of horizontal tiles of the frame drawn concurrently
+     * @param numThreads Number of threads to use
+     */
+    void setNumThreads(uint32_t numThreads);
+
+    /**
+     * @brief Font size in pixels of the labels drawn for detections and tracklets
+     */
+    void setLabelFontSize(float fontSize);
+
+    void buildInternal() override;
+
+   private:
+    class Impl;
+    Pimpl<Impl> pimpl;
+    void run() override;
+    Input inSync{*this, {"inSync", DEFAULT_GROUP, false, 0, {{{DatatypeEnum::MessageGroup, true}}}}};
+};
+
+}  // namespace node
+}  // namespace dai
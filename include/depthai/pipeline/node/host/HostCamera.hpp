@@ -2,13 +2,93 @@
 
 #include <depthai/pipeline/ThreadedHostNode.hpp>
 #include <depthai/pipeline/datatype/ImgFrame.hpp>
+#include <filesystem>
+#include <optional>
+#include <tuple>
 
 namespace dai {
 namespace node {
+
+/**
+ * @brief Host side camera source. Captures frames from a camera attached to the host, a video file or image sequence,
+ * or generates a synthetic test pattern, and outputs them as ImgFrames.
+ */
 class HostCamera : public dai::NodeCRTP<ThreadedHostNode, HostCamera> {
    public:
-    Output out{*this, {DEFAULT_NAME, DEFAULT_GROUP, DEFAULT_TYPES}};
+    constexpr static const char* NAME = "HostCamera";
+
+    enum class SourceType {
+        /// Camera attached to the host, by index
+        DEVICE,
+        /// Video file, stream URL or image sequence pattern (eg. "frames/img_%04d.png")
+        FILE,
+        /// Moving color bars, doesn't require any capture device
+        SYNTHETIC
+    };
+
+    /**
+     * Outputs ImgFrame message of the configured size and type
+     */
+    Output out{*this, {"out", DEFAULT_GROUP, {{{DatatypeEnum::ImgFrame, false}}}}};
+
+    /**
+     * Capture from a camera attached to the host. Default is device 0.
+     */
+    HostCamera& setDeviceIndex(int index);
+    /**
+     * Capture from a video file, stream URL or image sequence pattern
+     */
+    HostCamera& setFile(const std::filesystem::path& path);
+    /**
+     * Generate a synthetic test pattern instead of capturing
+     */
+    HostCamera& setSynthetic();
+
+    /**
+     * Output size. Frames are resized if the source doesn't capture at this size.
+     * Defaults to the source's size, or 640x480 for the synthetic pattern.
+     */
+    HostCamera& setSize(int width, int height);
+    HostCamera& setSize(std::tuple<int, int> size);
+    /**
+     * Output frame type. Supported are BGR888i (default), RGB888i, GRAY8 and NV12.
+     */
+    HostCamera& setOutFrameType(ImgFrame::Type type);
+    /**
+     * Rate at which frames are output. Defaults to the rate of a video file, the pace of a camera,
+     * or 30 FPS for image sequences and the synthetic pattern.
+     */
+    HostCamera& setFps(float fps);
+    /**
+     * Restart a video file or image sequence once it ends, instead of stopping. Default is true.
+     */
+    HostCamera& setLoop(bool loop);
+    /**
+     * Number of output frames kept in a reusable pool. Default is 4.
+     */
+    HostCamera& setNumFramesPool(int num);
+
+    SourceType getSourceType() const;
+    int getDeviceIndex() const;
+    std::filesystem::path getFile() const;
+    std::optional<std::tuple<int, int>> getSize() const;
+    ImgFrame::Type getOutFrameType() const;
+    std::optional<float> getFps() const;
+    bool getLoop() const;
+    int getNumFramesPool() const;
+
     void run() override;
+
+   private:
+    SourceType sourceType = SourceType::DEVICE;
+    int deviceIndex = 0;
+    std::filesystem::path file;
+    std::optional<std::tuple<int, int>> size;
+    ImgFrame::Type outFrameType = ImgFrame::Type::BGR888i;
+    std::optional<float> fps;
+    bool loop = true;
+    int numFramesPool = 4;
 };
+
 }  // namespace node
-}  // namespace dai
\ No newline at end of file
+}  // namespace dai
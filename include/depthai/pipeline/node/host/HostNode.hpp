@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <string>
+#include <vector>
+
 #include <depthai/pipeline/Subnode.hpp>
 #include <depthai/pipeline/ThreadedHostNode.hpp>
 #include <depthai/pipeline/datatype/ImgFrame.hpp>
@@ -10,15 +14,31 @@
 #include "depthai/pipeline/datatype/Buffer.hpp"
 
 namespace dai {
+class PipelineImpl;
 namespace node {
 class HostNode : public ThreadedHostNode {
+    friend class dai::PipelineImpl;
+
    private:
     std::optional<bool> syncOnHost;
     bool sendProcessToPipeline = false;
+    std::size_t maxBatchSize = 1;
     Subnode<dai::node::Sync> sync{*this, "sync"};
     // Input input{*this, "in", Input::Type::SReceiver, true, 3, {{DatatypeEnum::MessageGroup, true}}};
     Input input{*this, {"in", DEFAULT_GROUP, DEFAULT_BLOCKING, DEFAULT_QUEUE_SIZE, {{{DatatypeEnum::MessageGroup, true}}}, DEFAULT_WAIT_FOR_MESSAGE}};
 
+    // Set when the pipeline fuses this node with the one it sends to, or receives from
+    HostNode* fusedNext = nullptr;
+    HostNode* fusedPrevious = nullptr;
+    std::string fusedInputName;
+    MessageGroupPool fusedGroups;
+
+    void runBatched();
+    // Passes an output to the fused node, or sends it
+    void emit(const std::shared_ptr<Buffer>& msg);
+    // Processes a message of the fused node before, in its thread
+    void processFused(const std::shared_ptr<Buffer>& in);
+
    protected:
     void buildStage1() override;
     void run() override;
@@ -29,6 +49,26 @@ class HostNode : public ThreadedHostNode {
     Output out{*this, {"out", DEFAULT_GROUP, {{{DatatypeEnum::Buffer, true}}}}};
     virtual std::shared_ptr<Buffer> processGroup(std::shared_ptr<dai::MessageGroup> in) = 0;
 
+    /**
+     * Processes several groups at once, called instead of processGroup when the maximal batch size is larger than one.
+     * The default implementation calls processGroup for each of the groups.
+     * @param groups Groups in the order they were received, at least one
+     * @returns Outputs to send, in order. Null outputs are skipped
+     */
+    virtual std::vector<std::shared_ptr<Buffer>> processBatch(std::vector<std::shared_ptr<dai::MessageGroup>> groups);
+
+    /**
+     * Sets the maximal number of groups passed to processBatch at once.
+     * A batch holds the groups already waiting when the first one is received, the node never waits to fill it.
+     * By default 1, processGroup is called for each group. The queue of synced groups grows to hold a whole batch.
+     */
+    void setMaxBatchSize(std::size_t size);
+
+    /**
+     * Gets the maximal number of groups passed to processBatch at once
+     */
+    std::size_t getMaxBatchSize() const;
+
     /**
      * @brief Send processing to pipeline. If set to true, it's important to call `pipeline.run()` in the main thread or `pipeline.processTasks()` in the main
      * thread. Otherwise, if set to false, such action is not needed.
@@ -28,6 +28,7 @@ class ReplayVideo : public NodeCRTP<ThreadedHostNode, ReplayVideo> {
     std::optional<float> fps;
     std::filesystem::path replayVideo;
     std::filesystem::path replayFile;
+    std::filesystem::path replayArchive;
     ImgFrame::Type outFrameType = ImgFrame::Type::YUV420p;
 
     bool loop = true;
@@ -46,6 +47,7 @@ class ReplayVideo : public NodeCRTP<ThreadedHostNode, ReplayVideo> {
 
     std::filesystem::path getReplayMetadataFile() const;
     std::filesystem::path getReplayVideoFile() const;
+    std::filesystem::path getReplayArchive() const;
     ImgFrame::Type getOutFrameType() const;
     std::tuple<int, int> getSize() const;
     float getFps() const;
@@ -53,6 +55,11 @@ class ReplayVideo : public NodeCRTP<ThreadedHostNode, ReplayVideo> {
 
     ReplayVideo& setReplayMetadataFile(const std::filesystem::path& replayFile);
     ReplayVideo& setReplayVideoFile(const std::filesystem::path& replayVideo);
+    /**
+     * Replay from within an uncompressed tar archive, such as a holistic recording, without extracting it.
+     * The metadata and video files are then names of files within the archive.
+     */
+    ReplayVideo& setReplayArchive(const std::filesystem::path& replayArchive);
     ReplayVideo& setOutFrameType(ImgFrame::Type outFrameType);
     ReplayVideo& setSize(std::tuple<int, int> size);
     ReplayVideo& setSize(int width, int height);
@@ -66,6 +73,7 @@ class ReplayVideo : public NodeCRTP<ThreadedHostNode, ReplayVideo> {
 class ReplayMetadataOnly : public NodeCRTP<ThreadedHostNode, ReplayMetadataOnly> {
    private:
     std::filesystem::path replayFile;
+    std::filesystem::path replayArchive;
 
     std::optional<float> fps;
     bool loop = true;
@@ -83,10 +91,16 @@ class ReplayMetadataOnly : public NodeCRTP<ThreadedHostNode, ReplayMetadataOnly>
     void run() override;
 
     std::filesystem::path getReplayFile() const;
+    std::filesystem::path getReplayArchive() const;
     float getFps() const;
     bool getLoop() const;
 
     ReplayMetadataOnly& setReplayFile(const std::filesystem::path& replayFile);
+    /**
+     * Replay from within an uncompressed tar archive, such as a holistic recording, without extracting it.
+     * The replay file is then the name of a file within the archive.
+     */
+    ReplayMetadataOnly& setReplayArchive(const std::filesystem::path& replayArchive);
     ReplayMetadataOnly& setFps(float fps);
     ReplayMetadataOnly& setLoop(bool loop);
 };
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 #include "depthai/pipeline/Node.hpp"
 #include "depthai/pipeline/ThreadedHostNode.hpp"
 #include "depthai/xlink/XLinkConnection.hpp"
@@ -16,6 +18,8 @@ class XLinkOutHost : public NodeCRTP<ThreadedHostNode, XLinkOutHost> {
     std::mutex mtx;
     bool isDisconnected = false;
     bool allowResize = false;
+    std::size_t coalescingMaxBytes = 0;
+    std::chrono::microseconds coalescingMaxLatency{0};
 
    public:
     constexpr static const char* NAME = "XLinkOutHost";
@@ -25,6 +29,13 @@ class XLinkOutHost : public NodeCRTP<ThreadedHostNode, XLinkOutHost> {
     void setStreamName(const std::string& name);
     void setConnection(std::shared_ptr<XLinkConnection> conn);
     void allowStreamResize(bool allow);
+    /**
+     * Packs multiple queued messages into a single transfer. The receiving end must split coalesced packets,
+     * as XLinkInHost does - device side XLinkIn nodes don't.
+     * @param maxBytes Maximum size of a coalesced transfer, 0 disables coalescing (default)
+     * @param maxLatency Maximum time the first message of a transfer waits for further messages
+     */
+    void setCoalescing(std::size_t maxBytes, std::chrono::microseconds maxLatency);
     void disconnect();
     void run() override;
 };
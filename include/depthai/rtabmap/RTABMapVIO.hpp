@@ -12,6 +12,7 @@
 #include "depthai/pipeline/datatype/TrackedFeatures.hpp"
 #include "depthai/pipeline/datatype/TransformData.hpp"
 #include "depthai/pipeline/node/Sync.hpp"
+#include "depthai/utility/TimestampedRingBuffer.hpp"
 #include "rtabmap/core/CameraModel.h"
 #include "rtabmap/core/Odometry.h"
 #include "rtabmap/core/OdometryInfo.h"
@@ -99,8 +100,10 @@ class RTABMapVIO : public NodeCRTP<ThreadedHostNode, RTABMapVIO> {
     rtabmap::Transform localTransform;
     rtabmap::Transform imuLocalTransform;
     std::map<std::string, std::string> rtabParams;
-    std::map<double, cv::Vec3f> accBuffer;
-    std::map<double, cv::Vec3f> gyroBuffer;
+    // Enough for a few seconds of IMU samples at the highest rates
+    static constexpr std::size_t IMU_BUFFER_SIZE = 4096;
+    utility::TimestampedRingBuffer<cv::Vec3f> accBuffer{IMU_BUFFER_SIZE};
+    utility::TimestampedRingBuffer<cv::Vec3f> gyroBuffer{IMU_BUFFER_SIZE};
     std::mutex imuMtx;
     float alphaScaling = -1.0;
     bool initialized = false;
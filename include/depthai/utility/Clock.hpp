@@ -1,9 +1,75 @@
 #pragma once
 
 #include <chrono>
+#include <memory>
+#include <mutex>
 
 namespace dai {
 
 using Clock = std::chrono::steady_clock;
 
+/**
+ * Time source of host nodes, distributed to them by the Pipeline.
+ * Host nodes use it for pacing and for the timestamps they generate, so that a pipeline may run on simulated time.
+ */
+class PipelineClock {
+   public:
+    using duration = Clock::duration;
+    using time_point = Clock::time_point;
+
+    virtual ~PipelineClock();
+
+    /// Current time of the clock
+    virtual time_point now() const = 0;
+
+    /// Blocks the calling thread until the clock reaches the time point
+    virtual void sleepUntil(time_point timePoint) = 0;
+
+    /// Blocks the calling thread for the duration of the clock
+    void sleepFor(duration sleepDuration);
+
+    /// True if the clock doesn't follow the real time
+    virtual bool isSimulated() const;
+
+    /// Clock following dai::Clock, the default of every pipeline
+    static std::shared_ptr<PipelineClock> steady();
+};
+
+/**
+ * PipelineClock following dai::Clock
+ */
+class SteadyPipelineClock : public PipelineClock {
+   public:
+    time_point now() const override;
+    void sleepUntil(time_point timePoint) override;
+};
+
+/**
+ * PipelineClock whose time only moves when advanced, either explicitly or by sleeping on it.
+ *
+ * Sleeping doesn't block, it advances the time to the end of the sleep instead. Nodes which pace themselves by the timestamps
+ * of the messages they replay therefore drive the clock by those timestamps and run as fast as they are able to, producing
+ * the same timestamps on every run. When several nodes sleep on the clock, it follows the one furthest ahead.
+ */
+class SimulatedPipelineClock : public PipelineClock {
+   public:
+    /**
+     * @param start Initial time of the clock
+     */
+    explicit SimulatedPipelineClock(time_point start = time_point{});
+
+    time_point now() const override;
+    void sleepUntil(time_point timePoint) override;
+    bool isSimulated() const override;
+
+    /// Moves the time forward to the time point, earlier time points are ignored
+    void advanceTo(time_point timePoint);
+    /// Moves the time forward by the duration
+    void advance(duration step);
+
+   private:
+    mutable std::mutex mtx;
+    time_point current;
+};
+
 }  // namespace dai
@@ -1,3 +1,5 @@
+#pragma once
+
 #include <cstdint>
 #include <filesystem>
 #include <string>
@@ -9,6 +11,59 @@ namespace utility {
 std::vector<uint8_t> deflate(uint8_t* data, size_t size, int compressionLevel = 6);
 std::vector<uint8_t> inflate(uint8_t* data, size_t size);
 
+/**
+ * Compresses data into the gzip format, eg. for HTTP uploads.
+ * @param data Data to compress
+ * @param size Size of the data in bytes
+ * @param compressionLevel zlib compression level, 0-9
+ * @return gzip stream
+ */
+std::vector<uint8_t> gzip(const uint8_t* data, size_t size, int compressionLevel = 6);
+
+/**
+ * Decompresses a gzip stream.
+ * @param data gzip stream
+ * @param size Size of the stream in bytes
+ * @return Decompressed data
+ */
+std::vector<uint8_t> gunzip(const uint8_t* data, size_t size);
+
+/**
+ * Location of a file stored within an uncompressed tar archive
+ */
+struct TarMember {
+    std::string name;
+    /// Offset of the file's data from the start of the archive
+    uint64_t offset = 0;
+    uint64_t size = 0;
+};
+
+/**
+ * Indexes the files within an uncompressed tar archive, reading only the headers.
+ * The index is cached next to the archive, as <archive>.index, and reused while the archive is unchanged.
+ * @param tarPath Path to the tar file to index
+ * @param useCache Whether to read and write the cached index
+ * @return Files within the archive, in archive order
+ * @throws std::runtime_error if the file isn't an uncompressed tar archive
+ */
+std::vector<TarMember> indexTar(const std::filesystem::path& tarPath, bool useCache = true);
+
+/**
+ * Reads a file from an uncompressed tar archive.
+ * @param tarPath Path to the tar file
+ * @param member File within the archive, as returned by indexTar
+ * @return File contents
+ */
+std::vector<uint8_t> readTarMember(const std::filesystem::path& tarPath, const TarMember& member);
+
+/**
+ * Copies a file out of an uncompressed tar archive.
+ * @param tarPath Path to the tar file
+ * @param member File within the archive, as returned by indexTar
+ * @param outPath Path where the file is written
+ */
+void extractTarMember(const std::filesystem::path& tarPath, const TarMember& member, const std::filesystem::path& outPath);
+
 /**
  * Gets a list of filenames contained within a tar archive.
  * @param tarPath Path to the tar file to read
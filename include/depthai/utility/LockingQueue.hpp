@@ -1,5 +1,7 @@
 #pragma once
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
 #include <functional>
 #include <limits>
 #include <mutex>
@@ -263,6 +265,51 @@ class LockingQueue {
         return true;
     }
 
+    /**
+     * Pushes regardless of the blocking setting, waiting up to timeout for space instead of removing elements.
+     * A maximum duration waits without a timeout.
+     * @returns False if the queue is still full after the timeout or was destroyed
+     */
+    template <typename Rep, typename Period>
+    bool waitForSpaceAndPush(T const& data, std::chrono::duration<Rep, Period> timeout) {
+        {
+            std::unique_lock<std::mutex> lock(guard);
+            if(maxSize == 0) return false;
+            const auto hasSpace = [this]() { return queue.size() < maxSize || destructed; };
+            if(timeout == std::chrono::duration<Rep, Period>::max()) {
+                signalPop.wait(lock, hasSpace);
+            } else if(!signalPop.wait_for(lock, timeout, hasSpace)) {
+                return false;
+            }
+            if(destructed) return false;
+
+            queue.push(data);
+        }
+        signalPush.notify_all();
+        return true;
+    }
+
+    /**
+     * Pushes regardless of the blocking setting, removing the oldest elements so that at most 'keep' of them remain besides the new one
+     * @returns Number of removed elements
+     */
+    std::size_t pushDroppingOldest(T const& data, unsigned keep = std::numeric_limits<unsigned>::max()) {
+        std::size_t removed = 0;
+        {
+            std::unique_lock<std::mutex> lock(guard);
+            const unsigned limit = keep < maxSize ? keep + 1 : maxSize;
+            while(!queue.empty() && queue.size() >= limit) {
+                queue.pop();
+                removed++;
+            }
+            if(limit == 0) return removed;
+
+            queue.push(data);
+        }
+        signalPush.notify_all();
+        return removed;
+    }
+
     bool empty() const {
         std::lock_guard<std::mutex> lock(guard);
         return queue.empty();
@@ -329,6 +376,12 @@ class LockingQueue {
         signalPop.wait(lock, [this]() { return queue.empty() || destructed; });
     }
 
+    template <typename Rep, typename Period>
+    bool waitEmpty(std::chrono::duration<Rep, Period> timeout) {
+        std::unique_lock<std::mutex> lock(guard);
+        return signalPop.wait_for(lock, timeout, [this]() { return queue.empty() || destructed; });
+    }
+
    private:
     unsigned maxSize = std::numeric_limits<unsigned>::max();
     bool blocking = true;
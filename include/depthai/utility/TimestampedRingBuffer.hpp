@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace dai {
+namespace utility {
+
+/**
+ * Fixed capacity buffer of timestamped samples, kept sorted by timestamp, eg. for IMU readings to be interpolated at frame timestamps.
+ * Storage is allocated once, appending in timestamp order is O(1) and lookups are binary searches.
+ * Once full, the oldest samples are overwritten. Not thread safe.
+ *
+ * T must support `a + t * (b - a)` with a float t, to be interpolated.
+ */
+template <typename T>
+class TimestampedRingBuffer {
+   public:
+    struct Sample {
+        double timestamp = 0;
+        T value{};
+    };
+
+    explicit TimestampedRingBuffer(std::size_t capacity) : samples(capacity) {
+        if(capacity == 0) throw std::invalid_argument("TimestampedRingBuffer capacity must be positive");
+    }
+
+    /**
+     * Add a sample. Samples older than the newest one are inserted in place, and samples with a timestamp
+     * already in the buffer are ignored. Returns false if the sample wasn't added.
+     */
+    bool push(double timestamp, const T& value) {
+        if(count == 0 || timestamp > back().timestamp) {
+            if(count == capacity()) popFront();
+            at(count) = {timestamp, value};
+            count++;
+            return true;
+        }
+        // Out of order
+        const std::size_t pos = lowerBound(timestamp);
+        if(pos < count && at(pos).timestamp == timestamp) return false;
+        if(count == capacity()) {
+            // Older than everything that would be kept
+            if(pos == 0) return false;
+            popFront();
+            insertAt(pos - 1, timestamp, value);
+        } else {
+            insertAt(pos, timestamp, value);
+        }
+        return true;
+    }
+
+    /**
+     * Value at the given timestamp, linearly interpolated between the neighbouring samples.
+     * Timestamps before the oldest sample get the oldest sample's value.
+     * Returns nothing if the buffer is empty or the timestamp is newer than the newest sample.
+     */
+    std::optional<T> interpolate(double timestamp) const {
+        if(count == 0 || timestamp > back().timestamp) return std::nullopt;
+        const std::size_t pos = lowerBound(timestamp);
+        const Sample& b = at(pos);
+        if(pos == 0 || b.timestamp == timestamp) return b.value;
+        const Sample& a = at(pos - 1);
+        const float t = static_cast<float>((timestamp - a.timestamp) / (b.timestamp - a.timestamp));
+        return a.value + t * (b.value - a.value);
+    }
+
+    /**
+     * Remove all samples older than the newest sample at or before the given timestamp, keeping what is needed
+     * to interpolate at timestamps from there on
+     */
+    void pruneBefore(double timestamp) {
+        const std::size_t pos = lowerBound(timestamp);
+        const std::size_t remove = pos == 0 ? 0 : pos - 1;
+        head = (head + remove) % capacity();
+        count -= remove;
+    }
+
+    /// Index of the first sample not older than the timestamp, size() if there is none
+    std::size_t lowerBound(double timestamp) const {
+        std::size_t first = 0;
+        std::size_t len = count;
+        while(len > 0) {
+            const std::size_t half = len / 2;
+            if(at(first + half).timestamp < timestamp) {
+                first += half + 1;
+                len -= half + 1;
+            } else {
+                len = half;
+            }
+        }
+        return first;
+    }
+
+    /// Sample by index, oldest first
+    const Sample& operator[](std::size_t index) const {
+        return at(index);
+    }
+    const Sample& front() const {
+        return at(0);
+    }
+    const Sample& back() const {
+        return at(count - 1);
+    }
+
+    std::size_t size() const {
+        return count;
+    }
+    bool empty() const {
+        return count == 0;
+    }
+    std::size_t capacity() const {
+        return samples.size();
+    }
+    void clear() {
+        head = 0;
+        count = 0;
+    }
+
+   private:
+    std::vector<Sample> samples;
+    std::size_t head = 0;
+    std::size_t count = 0;
+
+    Sample& at(std::size_t index) {
+        return samples[(head + index) % samples.size()];
+    }
+    const Sample& at(std::size_t index) const {
+        return samples[(head + index) % samples.size()];
+    }
+    void popFront() {
+        head = (head + 1) % capacity();
+        count--;
+    }
+    // Shifts the newer samples by one, which is cheap as out of order samples are near the end
+    void insertAt(std::size_t pos, double timestamp, const T& value) {
+        for(std::size_t i = count; i > pos; i--) at(i) = at(i - 1);
+        at(pos) = {timestamp, value};
+        count++;
+    }
+};
+
+}  // namespace utility
+}  // namespace dai
@@ -1,6 +1,7 @@
 #pragma once
 #define _USE_MATH_DEFINES
 
+#include <array>
 #include <cmath>
 #include <iostream>
 #include <vector>
@@ -17,5 +18,21 @@ std::vector<float> rotationMatrixToVector(const std::vector<std::vector<float>>&
 std::vector<std::vector<float>> rvecToRotationMatrix(const double rvec[3]);
 void printMatrix(std::vector<std::vector<float>>& matrix);
 
+/// Fixed-size, row-major matrices, for hot paths where the nested vector representation would allocate on every operation
+using Mat3f = std::array<std::array<float, 3>, 3>;
+using Mat4f = std::array<std::array<float, 4>, 4>;
+
+Mat3f identity3f();
+Mat4f identity4f();
+Mat3f matMul(const Mat3f& firstMatrix, const Mat3f& secondMatrix);
+Mat4f matMul(const Mat4f& firstMatrix, const Mat4f& secondMatrix);
+/// Inverse of a rigid transformation [R | t], as (R^T, -R^T t)
+Mat4f invertSe3(const Mat4f& matrix);
+/// Conversions from and to the nested vector representation. Throws if the input isn't of the expected size.
+Mat3f toMat3f(const std::vector<std::vector<float>>& matrix);
+Mat4f toMat4f(const std::vector<std::vector<float>>& matrix);
+std::vector<std::vector<float>> toVector(const Mat3f& matrix);
+std::vector<std::vector<float>> toVector(const Mat4f& matrix);
+
 }  // namespace matrix
-}  // namespace dai
\ No newline at end of file
+}  // namespace dai
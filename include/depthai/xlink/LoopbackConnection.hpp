@@ -0,0 +1,102 @@
+#pragma once
+
+// Std
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// libraries
+#include <XLink/XLinkTime.h>
+
+// project
+#include "depthai/utility/span.hpp"
+#include "depthai/xlink/XLinkConnection.hpp"
+
+namespace dai {
+
+class StreamPacketDesc;
+
+/**
+ * In-process stand-in for a single XLink stream of a LoopbackConnection.
+ * Packets written to the stream are read back from it in order, by any XLinkStream opened with the same name.
+ */
+class LoopbackStream {
+   public:
+    /// Waits indefinitely
+    static constexpr std::chrono::milliseconds INFINITE_TIMEOUT = std::chrono::milliseconds::max();
+
+    LoopbackStream(std::string name, std::size_t maxQueuedPackets);
+
+    /**
+     * Writes a packet consisting of data followed by data2, blocking while the stream holds maxQueuedPackets packets
+     * @param fd File descriptor passed along with the packet, -1 if none
+     * @param maxWriteSize Write size limit the writing XLinkStream was opened with
+     */
+    XLinkError_t write(span<const std::uint8_t> data,
+                       span<const std::uint8_t> data2,
+                       long fd,
+                       std::size_t maxWriteSize,
+                       std::chrono::milliseconds timeout = INFINITE_TIMEOUT);
+    XLinkError_t read(StreamPacketDesc& packet, std::chrono::milliseconds timeout = INFINITE_TIMEOUT);
+    void close();
+
+    const std::string& getName() const;
+
+   private:
+    struct Packet {
+        std::vector<std::uint8_t> data;
+        long fd;
+        XLinkTimespec tSent;
+    };
+
+    template <typename Predicate>
+    bool waitFor(std::unique_lock<std::mutex>& lock, std::condition_variable& condition, std::chrono::milliseconds timeout, Predicate predicate);
+
+    const std::string name;
+    const std::size_t maxQueuedPackets;
+    std::mutex mtx;
+    std::condition_variable canRead;
+    std::condition_variable canWrite;
+    std::deque<Packet> packets;
+    bool closed = false;
+};
+
+/**
+ * XLinkConnection without a device, which loops every stream back to the host.
+ *
+ * Streams of the same name share a FIFO of packets, so an XLinkOutHost and an XLinkInHost
+ * using the same stream name form a loopback. Write size limits and bounded buffering follow XLink,
+ * which allows testing and benchmarking the host transport without a device.
+ */
+class LoopbackConnection : public XLinkConnection {
+   public:
+    /**
+     * @param maxQueuedPackets Packets a stream buffers before writes block
+     */
+    explicit LoopbackConnection(std::size_t maxQueuedPackets = 8);
+    ~LoopbackConnection() override;
+
+    /**
+     * Gets the stream of the given name, creating it on first use. Streams stay open until the connection is closed.
+     */
+    std::shared_ptr<LoopbackStream> openStream(const std::string& name);
+
+    /**
+     * Closes all streams, failing pending and later reads and writes
+     */
+    void close() override;
+
+   private:
+    const std::size_t maxQueuedPackets;
+    std::mutex streamsMtx;
+    std::unordered_map<std::string, std::shared_ptr<LoopbackStream>> streams;
+    bool streamsClosed = false;
+};
+
+}  // namespace dai
@@ -99,7 +99,7 @@ class XLinkConnection {
     XLinkConnection(const DeviceInfo& deviceDesc, std::filesystem::path pathToMvcmd, XLinkDeviceState_t expectedState = X_LINK_BOOTED);
     explicit XLinkConnection(const DeviceInfo& deviceDesc, XLinkDeviceState_t expectedState = X_LINK_BOOTED);
 
-    ~XLinkConnection();
+    virtual ~XLinkConnection();
 
     void setRebootOnDestruction(bool reboot);
     bool getRebootOnDestruction() const;
@@ -111,7 +111,7 @@ class XLinkConnection {
      * @note This function does not need to be explicitly called
      * as destructor closes the connection automatically
      */
-    void close();
+    virtual void close();
 
     /**
      * Is the connection already closed (or disconnected)
@@ -129,6 +129,12 @@ class XLinkConnection {
      */
     ProfilingData getProfilingData();
 
+   protected:
+    /**
+     * Creates a connection which isn't backed by a device, for connections implementing their own transport
+     */
+    XLinkConnection();
+
    private:
     friend struct XLinkReadError;
     friend struct XLinkWriteError;
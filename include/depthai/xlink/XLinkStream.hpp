@@ -20,7 +20,13 @@
 
 namespace dai {
 
+class LoopbackStream;
+
 class StreamPacketDesc : public streamPacketDesc_t {
+    friend class LoopbackStream;
+    // Owns the data of packets read from a LoopbackStream, which weren't allocated by XLink
+    std::vector<std::uint8_t> loopbackData;
+
    public:
     StreamPacketDesc() noexcept : streamPacketDesc_t{nullptr, 0, -1, {}, {}} {};
     StreamPacketDesc(const StreamPacketDesc&) = delete;
@@ -58,6 +64,9 @@ class XLinkStream {
     std::shared_ptr<XLinkConnection> connection;
     std::string streamName;
     streamId_t streamId{INVALID_STREAM_ID};
+    // Set instead of streamId when opened on a LoopbackConnection
+    std::shared_ptr<LoopbackStream> loopback;
+    std::size_t maxWriteSize{0};
 
    public:
     XLinkStream(const std::shared_ptr<XLinkConnection> conn, const std::string& name, std::size_t maxWriteSize);
@@ -2,10 +2,14 @@
 
 #include "device/CalibrationHandler.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <unordered_set>
@@ -47,8 +51,212 @@ void invertSe3Matrix4x4InPlace(std::vector<std::vector<float>>& mat) {
     }
     for(int i = 0; i < 3; ++i) mat[i][3] = newTrans[i];
 }
+
+// Walks the extrinsics chain of the given camera to its origin, without logging, as failures are reported on query
+std::optional<CameraBoardSocket> findExtrinsicsOrigin(const EepromData& eepromData, CameraBoardSocket cameraId) {
+    std::vector<CameraBoardSocket> path{cameraId};
+    CameraBoardSocket currentCameraId = cameraId;
+    while(true) {
+        auto currentIt = eepromData.cameraData.find(currentCameraId);
+        if(currentIt == eepromData.cameraData.end()) return std::nullopt;
+        CameraBoardSocket nextCameraSocket = currentIt->second.extrinsics.toCameraSocket;
+        if(std::find(path.begin(), path.end(), nextCameraSocket) != path.end()) return std::nullopt;
+        if(nextCameraSocket == CameraBoardSocket::AUTO) return currentCameraId;
+        currentCameraId = nextCameraSocket;
+        path.push_back(currentCameraId);
+    }
+}
+
+// Intrinsics and distortion coefficients of a camera, in the layout the projection helpers need
+struct LensModel {
+    CameraModel model = CameraModel::Perspective;
+    double fx = 0, fy = 0, cx = 0, cy = 0, skew = 0;
+    // [k1,k2,p1,p2,k3,k4,k5,k6,s1,s2,s3,s4,τx,τy], or [k1,k2,k3,k4] for Fisheye
+    std::array<double, 14> d{};
+};
+
+LensModel getLensModel(const CalibrationHandler& calib, CameraBoardSocket cameraId, int resizeWidth, int resizeHeight) {
+    LensModel lens;
+    lens.model = calib.getDistortionModel(cameraId);
+    if(lens.model != CameraModel::Perspective && lens.model != CameraModel::Fisheye) {
+        throw std::runtime_error("Only the Perspective and Fisheye camera models are supported for projecting points");
+    }
+    const Mat3f intrinsics = calib.getCameraIntrinsicsMat3f(cameraId, resizeWidth, resizeHeight);
+    lens.fx = intrinsics[0][0];
+    lens.fy = intrinsics[1][1];
+    lens.cx = intrinsics[0][2];
+    lens.cy = intrinsics[1][2];
+    lens.skew = intrinsics[0][1];
+    const auto coefficients = calib.getDistortionCoefficients(cameraId);
+    std::copy_n(coefficients.begin(), std::min(coefficients.size(), lens.d.size()), lens.d.begin());
+    if(lens.model == CameraModel::Perspective && (lens.d[12] != 0 || lens.d[13] != 0)) {
+        throw std::runtime_error("Projecting points with a tilted sensor model is not supported");
+    }
+    return lens;
+}
+
+constexpr int UNDISTORT_ITERATIONS = 20;
+constexpr double UNDISTORT_EPSILON = 1e-9;
+
+// Maps normalized image coordinates to distorted normalized coordinates
+void distort(const LensModel& lens, double x, double y, double& xd, double& yd) {
+    const auto& d = lens.d;
+    if(lens.model == CameraModel::Fisheye) {
+        const double r = std::sqrt(x * x + y * y);
+        if(r < 1e-8) {
+            xd = x;
+            yd = y;
+            return;
+        }
+        const double theta = std::atan(r);
+        const double theta2 = theta * theta;
+        const double thetaD = theta * (1 + theta2 * (d[0] + theta2 * (d[1] + theta2 * (d[2] + theta2 * d[3]))));
+        xd = x * thetaD / r;
+        yd = y * thetaD / r;
+        return;
+    }
+    const double r2 = x * x + y * y;
+    const double r4 = r2 * r2;
+    const double r6 = r4 * r2;
+    const double radial = (1 + d[0] * r2 + d[1] * r4 + d[4] * r6) / (1 + d[5] * r2 + d[6] * r4 + d[7] * r6);
+    xd = x * radial + 2 * d[2] * x * y + d[3] * (r2 + 2 * x * x) + d[8] * r2 + d[9] * r4;
+    yd = y * radial + d[2] * (r2 + 2 * y * y) + 2 * d[3] * x * y + d[10] * r2 + d[11] * r4;
+}
+
+// Inverse of distort, solved iteratively as cv::undistortPoints and cv::fisheye::undistortPoints do
+void undistort(const LensModel& lens, double xd, double yd, double& x, double& y) {
+    const auto& d = lens.d;
+    if(lens.model == CameraModel::Fisheye) {
+        double thetaD = std::sqrt(xd * xd + yd * yd);
+        if(thetaD < 1e-8) {
+            x = xd;
+            y = yd;
+            return;
+        }
+        const double rD = thetaD;
+        thetaD = std::min(std::max(-M_PI / 2, thetaD), M_PI / 2);
+        double theta = thetaD;
+        for(int i = 0; i < UNDISTORT_ITERATIONS; i++) {
+            const double theta2 = theta * theta;
+            const double theta4 = theta2 * theta2;
+            const double theta6 = theta4 * theta2;
+            const double theta8 = theta6 * theta2;
+            const double fix = (theta * (1 + d[0] * theta2 + d[1] * theta4 + d[2] * theta6 + d[3] * theta8) - thetaD)
+                               / (1 + 3 * d[0] * theta2 + 5 * d[1] * theta4 + 7 * d[2] * theta6 + 9 * d[3] * theta8);
+            theta -= fix;
+            if(std::abs(fix) < UNDISTORT_EPSILON) break;
+        }
+        const double scale = std::tan(theta) / rD;
+        x = xd * scale;
+        y = yd * scale;
+        return;
+    }
+    x = xd;
+    y = yd;
+    for(int i = 0; i < UNDISTORT_ITERATIONS; i++) {
+        const double r2 = x * x + y * y;
+        const double icdist = (1 + ((d[7] * r2 + d[6]) * r2 + d[5]) * r2) / (1 + ((d[4] * r2 + d[1]) * r2 + d[0]) * r2);
+        if(icdist < 0) {
+            // Outside of the model's valid range
+            x = xd;
+            y = yd;
+            break;
+        }
+        const double deltaX = 2 * d[2] * x * y + d[3] * (r2 + 2 * x * x) + d[8] * r2 + d[9] * r2 * r2;
+        const double deltaY = d[2] * (r2 + 2 * y * y) + 2 * d[3] * x * y + d[10] * r2 + d[11] * r2 * r2;
+        const double nextX = (xd - deltaX) * icdist;
+        const double nextY = (yd - deltaY) * icdist;
+        const bool converged = std::abs(nextX - x) < UNDISTORT_EPSILON && std::abs(nextY - y) < UNDISTORT_EPSILON;
+        x = nextX;
+        y = nextY;
+        if(converged) break;
+    }
+}
+
 }  // namespace
 
+struct CalibrationHandler::ExtrinsicsCache {
+    std::vector<CameraBoardSocket> sockets;
+    // Indexed by useSpecTranslation, then by src * sockets.size() + dst. Empty where there is no valid transformation.
+    std::array<std::vector<std::optional<matrix::Mat4f>>, 2> pairs;
+
+    std::optional<matrix::Mat4f> get(CameraBoardSocket srcCamera, CameraBoardSocket dstCamera, bool useSpecTranslation) const {
+        auto src = std::find(sockets.begin(), sockets.end(), srcCamera);
+        auto dst = std::find(sockets.begin(), sockets.end(), dstCamera);
+        if(src == sockets.end() || dst == sockets.end()) return std::nullopt;
+        return pairs[useSpecTranslation ? 1 : 0][(src - sockets.begin()) * sockets.size() + (dst - sockets.begin())];
+    }
+};
+
+CalibrationHandler::CalibrationHandler(const CalibrationHandler& other)
+    : eepromData(other.eepromData), extrinsicsCache(std::atomic_load(&other.extrinsicsCache)) {}
+
+CalibrationHandler::CalibrationHandler(CalibrationHandler&& other) noexcept
+    : eepromData(std::move(other.eepromData)), extrinsicsCache(std::atomic_load(&other.extrinsicsCache)) {
+    other.invalidateExtrinsicsCache();
+}
+
+CalibrationHandler& CalibrationHandler::operator=(const CalibrationHandler& other) {
+    if(this != &other) {
+        eepromData = other.eepromData;
+        std::atomic_store(&extrinsicsCache, std::atomic_load(&other.extrinsicsCache));
+    }
+    return *this;
+}
+
+CalibrationHandler& CalibrationHandler::operator=(CalibrationHandler&& other) noexcept {
+    if(this != &other) {
+        eepromData = std::move(other.eepromData);
+        std::atomic_store(&extrinsicsCache, std::atomic_load(&other.extrinsicsCache));
+        other.invalidateExtrinsicsCache();
+    }
+    return *this;
+}
+
+void CalibrationHandler::invalidateExtrinsicsCache() {
+    std::atomic_store(&extrinsicsCache, std::shared_ptr<const ExtrinsicsCache>());
+}
+
+std::shared_ptr<const CalibrationHandler::ExtrinsicsCache> CalibrationHandler::getExtrinsicsCache() const {
+    auto cache = std::atomic_load(&extrinsicsCache);
+    if(cache) return cache;
+
+    // Concurrent queries might build it twice, which is harmless as both results are the same
+    auto newCache = std::make_shared<ExtrinsicsCache>();
+    for(const auto& kv : eepromData.cameraData) newCache->sockets.push_back(kv.first);
+    const auto numCameras = newCache->sockets.size();
+    std::vector<std::optional<CameraBoardSocket>> origins;
+    for(auto socket : newCache->sockets) origins.push_back(findExtrinsicsOrigin(eepromData, socket));
+
+    for(bool useSpecTranslation : {false, true}) {
+        // Same computation as getExtrinsicsToOrigin, done once per camera instead of once per query
+        std::vector<std::optional<matrix::Mat4f>> toOrigin(numCameras);
+        for(size_t i = 0; i < numCameras; i++) {
+            if(!origins[i]) continue;
+            if(*origins[i] == newCache->sockets[i]) {
+                toOrigin[i] = matrix::identity4f();
+                continue;
+            }
+            try {
+                toOrigin[i] = matrix::toMat4f(computeExtrinsicMatrix(newCache->sockets[i], *origins[i], useSpecTranslation));
+            } catch(const std::exception&) {
+                // Reported when the pair is queried
+            }
+        }
+        auto& pairs = newCache->pairs[useSpecTranslation ? 1 : 0];
+        pairs.resize(numCameras * numCameras);
+        for(size_t src = 0; src < numCameras; src++) {
+            for(size_t dst = 0; dst < numCameras; dst++) {
+                if(!toOrigin[src] || !toOrigin[dst] || *origins[src] != *origins[dst]) continue;
+                pairs[src * numCameras + dst] = matrix::matMul(matrix::invertSe3(*toOrigin[dst]), *toOrigin[src]);
+            }
+        }
+    }
+    cache = std::move(newCache);
+    std::atomic_store(&extrinsicsCache, cache);
+    return cache;
+}
+
 CalibrationHandler::CalibrationHandler(std::filesystem::path eepromDataPath) {
     std::ifstream jsonStream(eepromDataPath);
     // TODO(sachin): Check if the file exists first.
@@ -202,6 +410,11 @@ dai::EepromData CalibrationHandler::getEepromData() const {
 }
 
 std::vector<std::vector<float>> CalibrationHandler::getCameraIntrinsics(
+    CameraBoardSocket cameraId, int resizeWidth, int resizeHeight, Point2f topLeftPixelId, Point2f bottomRightPixelId, bool keepAspectRatio) const {
+    return toVector(getCameraIntrinsicsMat3f(cameraId, resizeWidth, resizeHeight, topLeftPixelId, bottomRightPixelId, keepAspectRatio));
+}
+
+Mat3f CalibrationHandler::getCameraIntrinsicsMat3f(
     CameraBoardSocket cameraId, int resizeWidth, int resizeHeight, Point2f topLeftPixelId, Point2f bottomRightPixelId, bool keepAspectRatio) const {
     if(eepromData.version < 4) {
         throw std::runtime_error("Your device contains old calibration which doesn't include Intrinsic data. Please recalibrate your device");
@@ -209,7 +422,12 @@ std::vector<std::vector<float>> CalibrationHandler::getCameraIntrinsics(
     if(eepromData.cameraData.at(cameraId).intrinsicMatrix.size() == 0 || eepromData.cameraData.at(cameraId).intrinsicMatrix[0][0] == 0) {
         throw std::runtime_error("There is no Intrinsic matrix available for the the requested cameraID");
     }
-    std::vector<std::vector<float>> intrinsicMatrix = eepromData.cameraData.at(cameraId).intrinsicMatrix;
+    Mat3f intrinsicMatrix = toMat3f(eepromData.cameraData.at(cameraId).intrinsicMatrix);
+    // Equivalent to multiplying with a diagonal scaling matrix from the left
+    auto scale = [&intrinsicMatrix](float scaleX, float scaleY) {
+        for(auto& v : intrinsicMatrix[0]) v *= scaleX;
+        for(auto& v : intrinsicMatrix[1]) v *= scaleY;
+    };
     if(resizeWidth != -1 || resizeHeight != -1) {
         if(resizeWidth == -1) {
             resizeWidth = static_cast<decltype(resizeWidth)>(eepromData.cameraData.at(cameraId).width * resizeHeight
@@ -220,7 +438,6 @@ std::vector<std::vector<float>> CalibrationHandler::getCameraIntrinsics(
                                                                / static_cast<float>(eepromData.cameraData.at(cameraId).width));
         }
 
-        std::vector<std::vector<float>> scaleMat;
         if(keepAspectRatio) {
             float originalRatio = eepromData.cameraData.at(cameraId).width / static_cast<float>(eepromData.cameraData.at(cameraId).height);
             float resizeRatio = resizeWidth / static_cast<float>(resizeHeight);
@@ -229,8 +446,7 @@ std::vector<std::vector<float>> CalibrationHandler::getCameraIntrinsics(
                 float scaleH = resizeHeight / static_cast<float>(eepromData.cameraData.at(cameraId).height);
 
                 scaleW = std::min(scaleW, scaleH);
-                scaleMat = {{scaleW, 0, 0}, {0, scaleW, 0}, {0, 0, 1}};
-                intrinsicMatrix = matMul(scaleMat, intrinsicMatrix);
+                scale(scaleW, scaleW);
 
                 if(scaleW * eepromData.cameraData.at(cameraId).height < resizeHeight) {
                     intrinsicMatrix[1][2] += static_cast<float>(resizeHeight - eepromData.cameraData.at(cameraId).height * scaleW) / 2.0f;
@@ -238,24 +454,22 @@ std::vector<std::vector<float>> CalibrationHandler::getCameraIntrinsics(
                     intrinsicMatrix[0][2] += static_cast<float>(resizeWidth - eepromData.cameraData.at(cameraId).width * scaleW) / 2.0f;
                 }
             } else {
-                float scale = resizeHeight / static_cast<float>(eepromData.cameraData.at(cameraId).height);
-                if(scale * eepromData.cameraData.at(cameraId).width < resizeWidth) {
-                    scale = resizeWidth / static_cast<float>(eepromData.cameraData.at(cameraId).width);
+                float scaleFactor = resizeHeight / static_cast<float>(eepromData.cameraData.at(cameraId).height);
+                if(scaleFactor * eepromData.cameraData.at(cameraId).width < resizeWidth) {
+                    scaleFactor = resizeWidth / static_cast<float>(eepromData.cameraData.at(cameraId).width);
                 }
 
-                scaleMat = {{scale, 0, 0}, {0, scale, 0}, {0, 0, 1}};
-                intrinsicMatrix = matMul(scaleMat, intrinsicMatrix);
-                if(scale * eepromData.cameraData.at(cameraId).height > resizeHeight) {
-                    intrinsicMatrix[1][2] -= (eepromData.cameraData.at(cameraId).height * scale - resizeHeight) / 2;
-                } else if(scale * eepromData.cameraData.at(cameraId).width > resizeWidth) {
-                    intrinsicMatrix[0][2] -= (eepromData.cameraData.at(cameraId).width * scale - resizeWidth) / 2;
+                scale(scaleFactor, scaleFactor);
+                if(scaleFactor * eepromData.cameraData.at(cameraId).height > resizeHeight) {
+                    intrinsicMatrix[1][2] -= (eepromData.cameraData.at(cameraId).height * scaleFactor - resizeHeight) / 2;
+                } else if(scaleFactor * eepromData.cameraData.at(cameraId).width > resizeWidth) {
+                    intrinsicMatrix[0][2] -= (eepromData.cameraData.at(cameraId).width * scaleFactor - resizeWidth) / 2;
                 }
             }
         } else {
             float scaleX = resizeWidth / static_cast<float>(eepromData.cameraData.at(cameraId).width);
             float scaleY = resizeHeight / static_cast<float>(eepromData.cameraData.at(cameraId).height);
-            scaleMat = {{scaleX, 0, 0}, {0, scaleY, 0}, {0, 0, 1}};
-            intrinsicMatrix = matMul(scaleMat, intrinsicMatrix);
+            scale(scaleX, scaleY);
         }
     }
     if(resizeWidth != -1 || resizeHeight != -1) {
@@ -357,6 +571,19 @@ CameraModel CalibrationHandler::getDistortionModel(CameraBoardSocket cameraId) c
 std::vector<std::vector<float>> CalibrationHandler::getCameraExtrinsics(CameraBoardSocket srcCamera,
                                                                         CameraBoardSocket dstCamera,
                                                                         bool useSpecTranslation) const {
+    return toVector(getCameraExtrinsicsMat4f(srcCamera, dstCamera, useSpecTranslation));
+}
+
+Mat4f CalibrationHandler::getCameraExtrinsicsMat4f(CameraBoardSocket srcCamera, CameraBoardSocket dstCamera, bool useSpecTranslation) const {
+    auto extrinsics = getExtrinsicsCache()->get(srcCamera, dstCamera, useSpecTranslation);
+    if(extrinsics) return *extrinsics;
+    // No valid transformation - the full computation reports why
+    return toMat4f(computeCameraExtrinsics(srcCamera, dstCamera, useSpecTranslation));
+}
+
+std::vector<std::vector<float>> CalibrationHandler::computeCameraExtrinsics(CameraBoardSocket srcCamera,
+                                                                            CameraBoardSocket dstCamera,
+                                                                            bool useSpecTranslation) const {
     /**
      * 1. Check if both camera ID exists.
      * 2. Check if the forward link exists from source and destination camera to origin camera.
@@ -478,6 +705,54 @@ float CalibrationHandler::getBaselineDistance(CameraBoardSocket cam1, CameraBoar
     return std::sqrt(sum);
 }
 
+std::vector<Point3f> CalibrationHandler::transformPoints(CameraBoardSocket srcCamera,
+                                                         CameraBoardSocket dstCamera,
+                                                         const std::vector<Point3f>& points,
+                                                         bool useSpecTranslation) const {
+    const Mat4f extrinsics = getCameraExtrinsicsMat4f(srcCamera, dstCamera, useSpecTranslation);
+    std::vector<Point3f> transformed;
+    transformed.reserve(points.size());
+    for(const auto& p : points) {
+        transformed.emplace_back(extrinsics[0][0] * p.x + extrinsics[0][1] * p.y + extrinsics[0][2] * p.z + extrinsics[0][3],
+                                 extrinsics[1][0] * p.x + extrinsics[1][1] * p.y + extrinsics[1][2] * p.z + extrinsics[1][3],
+                                 extrinsics[2][0] * p.x + extrinsics[2][1] * p.y + extrinsics[2][2] * p.z + extrinsics[2][3]);
+    }
+    return transformed;
+}
+
+std::vector<Point2f> CalibrationHandler::projectPoints(CameraBoardSocket cameraId,
+                                                       const std::vector<Point3f>& points,
+                                                       int resizeWidth,
+                                                       int resizeHeight) const {
+    const LensModel lens = getLensModel(*this, cameraId, resizeWidth, resizeHeight);
+    std::vector<Point2f> projected;
+    projected.reserve(points.size());
+    for(const auto& p : points) {
+        const double invZ = p.z != 0 ? 1.0 / p.z : 1.0;
+        double xd = 0, yd = 0;
+        distort(lens, p.x * invZ, p.y * invZ, xd, yd);
+        projected.emplace_back(static_cast<float>(lens.fx * xd + lens.skew * yd + lens.cx), static_cast<float>(lens.fy * yd + lens.cy));
+    }
+    return projected;
+}
+
+std::vector<Point2f> CalibrationHandler::undistortPoints(CameraBoardSocket cameraId,
+                                                         const std::vector<Point2f>& points,
+                                                         int resizeWidth,
+                                                         int resizeHeight) const {
+    const LensModel lens = getLensModel(*this, cameraId, resizeWidth, resizeHeight);
+    std::vector<Point2f> undistorted;
+    undistorted.reserve(points.size());
+    for(const auto& p : points) {
+        const double yd = (p.y - lens.cy) / lens.fy;
+        const double xd = (p.x - lens.cx - lens.skew * yd) / lens.fx;
+        double x = 0, y = 0;
+        undistort(lens, xd, yd, x, y);
+        undistorted.emplace_back(static_cast<float>(lens.fx * x + lens.skew * y + lens.cx), static_cast<float>(lens.fy * y + lens.cy));
+    }
+    return undistorted;
+}
+
 std::vector<std::vector<float>> CalibrationHandler::getCameraToImuExtrinsics(CameraBoardSocket cameraId, bool useSpecTranslation) const {
     std::vector<std::vector<float>> transformationMatrix = getImuToCameraExtrinsics(cameraId, useSpecTranslation);
     invertSe3Matrix4x4InPlace(transformationMatrix);
@@ -696,6 +971,7 @@ void CalibrationHandler::setCameraIntrinsics(CameraBoardSocket cameraId, std::ve
         throw std::runtime_error("Invalid Intrinsic Matrix entered!!");
     }
 
+    invalidateExtrinsicsCache();
     if(eepromData.cameraData.find(cameraId) == eepromData.cameraData.end()) {
         dai::CameraInfo camera_info;
         camera_info.height = height;
@@ -736,6 +1012,7 @@ void CalibrationHandler::setDistortionCoefficients(CameraBoardSocket cameraId, s
         }
     }
 
+    invalidateExtrinsicsCache();
     if(eepromData.cameraData.find(cameraId) == eepromData.cameraData.end()) {
         dai::CameraInfo camera_info;
         camera_info.distortionCoeff = distortionCoefficients;
@@ -747,6 +1024,7 @@ void CalibrationHandler::setDistortionCoefficients(CameraBoardSocket cameraId, s
 }
 
 void CalibrationHandler::setFov(CameraBoardSocket cameraId, float hfov) {
+    invalidateExtrinsicsCache();
     if(eepromData.cameraData.find(cameraId) == eepromData.cameraData.end()) {
         dai::CameraInfo camera_info;
         camera_info.specHfovDeg = hfov;
@@ -758,6 +1036,7 @@ void CalibrationHandler::setFov(CameraBoardSocket cameraId, float hfov) {
 }
 
 void CalibrationHandler::setLensPosition(CameraBoardSocket cameraId, uint8_t lensPosition) {
+    invalidateExtrinsicsCache();
     if(eepromData.cameraData.find(cameraId) == eepromData.cameraData.end()) {
         dai::CameraInfo camera_info;
         camera_info.lensPosition = lensPosition;
@@ -769,6 +1048,7 @@ void CalibrationHandler::setLensPosition(CameraBoardSocket cameraId, uint8_t len
 }
 
 void CalibrationHandler::setCameraType(CameraBoardSocket cameraId, CameraModel cameraModel) {
+    invalidateExtrinsicsCache();
     if(eepromData.cameraData.find(cameraId) == eepromData.cameraData.end()) {
         dai::CameraInfo camera_info;
         camera_info.cameraType = cameraModel;
@@ -800,6 +1080,7 @@ void CalibrationHandler::setCameraExtrinsics(CameraBoardSocket srcCameraId,
     extrinsics.specTranslation = dai::Point3f(specTranslation[0], specTranslation[1], specTranslation[2]);
     extrinsics.toCameraSocket = destCameraId;
 
+    invalidateExtrinsicsCache();
     if(eepromData.cameraData.find(srcCameraId) == eepromData.cameraData.end()) {
         dai::CameraInfo camera_info;
         camera_info.extrinsics = extrinsics;
@@ -1,52 +1,161 @@
 #include "depthai/device/CallbackHandler.hpp"
 
-#include <cassert>
+#include <algorithm>
+#include <chrono>
 
 // project
+#include "depthai/pipeline/datatype/StreamMessageParser.hpp"
 #include "depthai/xlink/XLinkConstants.hpp"
-#include "depthai/xlink/XLinkStream.hpp"
-#include "pipeline/datatype/StreamMessageParser.hpp"
+#include "utility/Logging.hpp"
+
 namespace dai {
 
-void CallbackHandler::setCallback(std::function<std::shared_ptr<ADatatype>(std::shared_ptr<ADatatype>)> cb) {
-    callback = std::move(cb);
+// XLinkReadData can't be unblocked, so reads wait with a timeout to notice the handler being closed
+constexpr std::chrono::milliseconds READ_TIMEOUT{100};
+
+CallbackHandler::CallbackHandler(std::shared_ptr<XLinkConnection> conn, const std::string& streamName, Callback cb, unsigned numWorkers)
+    : CallbackHandler(std::move(conn), streamName, streamName, std::move(cb), numWorkers) {}
+
+CallbackHandler::CallbackHandler(
+    std::shared_ptr<XLinkConnection> conn, const std::string& inputStreamName, const std::string& outputStreamName, Callback cb, unsigned numWorkers)
+    : connection(std::move(conn)), callback(std::make_shared<const Callback>(std::move(cb))) {
+    if(!*callback) throw std::invalid_argument("CallbackHandler requires a callback");
+    numWorkers = std::max(numWorkers, 1u);
+    // Enough to keep every worker busy while the next messages are read
+    maxQueuedJobs = numWorkers;
+
+    inputStream = std::make_unique<XLinkStream>(connection, inputStreamName, device::XLINK_USB_BUFFER_MAX_SIZE);
+    if(outputStreamName != inputStreamName) outputStream = std::make_unique<XLinkStream>(connection, outputStreamName, device::XLINK_USB_BUFFER_MAX_SIZE);
+
+    reader = std::thread(&CallbackHandler::readerThread, this);
+    for(unsigned i = 0; i < numWorkers; i++) workers.emplace_back(&CallbackHandler::workerThread, this);
 }
 
-CallbackHandler::CallbackHandler(std::shared_ptr<XLinkConnection> conn,
-                                 const std::string& streamName,
-                                 std::function<std::shared_ptr<ADatatype>(std::shared_ptr<ADatatype>)> cb)
-    : connection(std::move(conn)), callback(std::move(cb)) {
-    // creates a thread which reads from queue and writes to xlink
-    t = std::thread([this, streamName]() {
-        try {
-            // open stream with 1B write size (no writing will happen here)
-            XLinkStream stream(connection, streamName, device::XLINK_USB_BUFFER_MAX_SIZE);
+CallbackHandler::~CallbackHandler() {
+    close();
+}
 
-            while(running) {
-                // Blocking -- parse packet
-                auto packet = stream.readMove();
-                const auto data = StreamMessageParser::parseMessage(&packet);
+void CallbackHandler::setCallback(Callback cb) {
+    if(!cb) throw std::invalid_argument("CallbackHandler requires a callback");
+    std::lock_guard<std::mutex> lock(mtx);
+    callback = std::make_shared<const Callback>(std::move(cb));
+}
 
-                // CALLBACK
-                auto toSend = callback(std::move(data));
+void CallbackHandler::close() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        running = false;
+    }
+    jobAvailable.notify_all();
+    jobTaken.notify_all();
+    writeTurn.notify_all();
+    if(reader.joinable()) reader.join();
+    for(auto& worker : workers) {
+        if(worker.joinable()) worker.join();
+    }
+    workers.clear();
+    jobs.clear();
+}
 
-                auto serialized = StreamMessageParser::serializeMessage(toSend);
+bool CallbackHandler::isRunning() const {
+    return running;
+}
 
-                // Write packet back
-                stream.write(serialized);
-            }
+std::exception_ptr CallbackHandler::getError() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return error;
+}
 
-        } catch(const std::exception&) {
-            // TODO(themarpe) - throw an exception
-            assert(0 && "TODO");
+void CallbackHandler::fail(std::exception_ptr exception) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if(!running) return;
+        error = exception;
+        running = false;
+    }
+    try {
+        std::rethrow_exception(exception);
+    } catch(const std::exception& ex) {
+        logger::error("CallbackHandler stopped - {}", ex.what());
+    } catch(...) {
+        logger::error("CallbackHandler stopped - unknown exception");
+    }
+    jobAvailable.notify_all();
+    jobTaken.notify_all();
+    writeTurn.notify_all();
+}
+
+void CallbackHandler::readerThread() {
+    std::uint64_t sequenceNum = 0;
+    try {
+        while(running) {
+            StreamPacketDesc packet;
+            if(!inputStream->readMove(packet, READ_TIMEOUT)) continue;
+
+            // Wait for a worker to free up, so that a slow callback pushes back on the stream
+            std::unique_lock<std::mutex> lock(mtx);
+            jobTaken.wait(lock, [this]() { return !running || jobs.size() < maxQueuedJobs; });
+            if(!running) break;
+            jobs.push_back({sequenceNum++, std::move(packet)});
+            lock.unlock();
+            jobAvailable.notify_one();
         }
-    });
+    } catch(...) {
+        fail(std::current_exception());
+    }
 }
 
-CallbackHandler::~CallbackHandler() {
-    // detach from thread, because currently no way to unblock underlying XLinkReadData
-    running = false;
-    t.detach();
+void CallbackHandler::workerThread() {
+    auto& stream = outputStream ? *outputStream : *inputStream;
+    while(true) {
+        std::uint64_t sequenceNum = 0;
+        StreamPacketDesc packet;
+        std::shared_ptr<const Callback> cb;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            jobAvailable.wait(lock, [this]() { return !running || !jobs.empty(); });
+            if(!running) return;
+            sequenceNum = jobs.front().sequenceNum;
+            packet = std::move(jobs.front().packet);
+            jobs.pop_front();
+            cb = callback;
+        }
+        jobTaken.notify_one();
+
+        std::shared_ptr<ADatatype> response;
+        std::vector<std::uint8_t> metadata;
+        try {
+            response = (*cb)(StreamMessageParser::parseMessage(std::move(packet)));
+            if(response) metadata = StreamMessageParser::serializeMetadata(response);
+        } catch(...) {
+            fail(std::current_exception());
+            return;
+        }
+
+        // Responses are written in the order of the messages they answer
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            writeTurn.wait(lock, [this, sequenceNum]() { return !running || nextWrite == sequenceNum; });
+            if(!running) return;
+        }
+        try {
+            if(response) {
+                if(response->data->getSize() > 0) {
+                    stream.write(response->data->getData(), metadata);
+                } else {
+                    stream.write(metadata);
+                }
+            }
+        } catch(...) {
+            fail(std::current_exception());
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            nextWrite++;
+        }
+        writeTurn.notify_all();
+    }
 }
 
 }  // namespace dai
@@ -41,7 +41,6 @@
 #include "XLink/XLink.h"
 #include "XLink/XLinkTime.h"
 #include "nanorpc/core/client.h"
-#include "nanorpc/packer/nlohmann_msgpack.h"
 #include "spdlog/details/os.h"
 #include "spdlog/fmt/bin_to_hex.h"
 #include "spdlog/fmt/chrono.h"
@@ -49,6 +48,8 @@
 #include "spdlog/spdlog.h"
 #include "utility/LogCollection.hpp"
 #include "utility/Logging.hpp"
+#include "utility/RpcMsgpackPacker.hpp"
+#include "utility/RpcPipeline.hpp"
 #include "utility/spdlog-fmt.hpp"
 
 namespace {
@@ -284,9 +285,10 @@ class DeviceBase::Impl {
     DeviceLogger logger{"host", stdoutColorSink};
 
     // RPC
-    std::mutex rpcMutex;
     std::shared_ptr<XLinkStream> rpcStream;
-    std::unique_ptr<nanorpc::core::client<nanorpc::packer::nlohmann_msgpack>> rpcClient;
+    // Requests from all threads are pipelined over the single rpc stream
+    std::unique_ptr<utility::RpcPipeline> rpcPipeline;
+    std::unique_ptr<nanorpc::core::client<utility::RpcMsgpackPacker>> rpcClient;
 
     void setLogLevel(LogLevel level);
     LogLevel getLogLevel();
@@ -310,6 +312,34 @@ class DeviceBase::Impl {
         // ScopedRpcTimeout guard(std::nullopt);
         return rpcClient->call(name, std::forward<Args>(args)...);
     }
+
+    /*
+     * Asynchronous RPC call, returns as soon as the request is written.
+     * Uses the timeout of the enclosing ScopedRpcTimeout, RPC_READ_TIMEOUT otherwise.
+     */
+    template <typename T, typename... Args>
+    std::future<T> rpcCallAsync(std::string name, Args&&... args) {
+        auto promise = std::make_shared<std::promise<T>>();
+        auto future = promise->get_future();
+        auto request = utility::packRpcRequest(name, std::forward<Args>(args)...);
+        auto timeout = currentRpcTimeout().value_or(std::chrono::milliseconds{RPC_READ_TIMEOUT});
+        rpcPipeline->submit(std::move(request), timeout, [this, name, promise](std::vector<std::uint8_t> response, std::exception_ptr error) {
+            try {
+                if(error) {
+                    try {
+                        std::rethrow_exception(error);
+                    } catch(const std::exception& e) {
+                        logger.debug("RPC error: {}", e.what());
+                        throw std::system_error(std::make_error_code(std::errc::io_error), "Device already closed or disconnected");
+                    }
+                }
+                promise->set_value(utility::unpackRpcResponse<T>(name, std::move(response)));
+            } catch(...) {
+                promise->set_exception(std::current_exception());
+            }
+        });
+        return future;
+    }
 };
 
 void DeviceBase::Impl::setPattern(const std::string& pattern) {
@@ -528,9 +558,10 @@ void DeviceBase::closeImpl() {
         }
     }
 
-    // Close rpcStream
-    pimpl->rpcStream = nullptr;
+    // Close rpcStream - the connection is already closed, so the pipeline's reader is unblocked
     pimpl->rpcClient = nullptr;
+    pimpl->rpcPipeline = nullptr;
+    pimpl->rpcStream = nullptr;
 
     if(!dumpOnly) {
         auto timeout = getCrashdumpTimeout(deviceInfo.protocol);
@@ -793,29 +824,28 @@ void DeviceBase::init2(Config cfg, const std::filesystem::path& pathToMvcmd, boo
     pimpl->rpcStream = std::make_shared<XLinkStream>(connection, device::XLINK_CHANNEL_MAIN_RPC, device::XLINK_USB_BUFFER_MAX_SIZE);
     auto rpcStream = pimpl->rpcStream;
 
-    pimpl->rpcClient = std::make_unique<nanorpc::core::client<nanorpc::packer::nlohmann_msgpack>>([this, rpcStream](nanorpc::core::type::buffer request) {
-        // Lock for time of the RPC call, to not mix the responses between calling threads.
-        // Note: might cause issues on Windows on incorrect shutdown. To be investigated
-        std::unique_lock<std::mutex> lock(pimpl->rpcMutex);
-
-        // Log the request data
-        if(getLogOutputLevel() == LogLevel::TRACE) {
-            pimpl->logger.trace("RPC: {}", nlohmann::json::from_msgpack(request).dump());
-        }
-
-        try {
-            // Send request to device
+    pimpl->rpcPipeline = std::make_unique<utility::RpcPipeline>(
+        [this, rpcStream](std::vector<std::uint8_t> request) {
+            // Log the request data
+            if(getLogOutputLevel() == LogLevel::TRACE) {
+                pimpl->logger.trace("RPC: {}", nlohmann::json::from_msgpack(request).dump());
+            }
             rpcStream->write(std::move(request));
-
-            // Receive response back
-            // Send to nanorpc to parse
-            std::chrono::milliseconds timeout =
-                currentRpcTimeout().value_or(std::chrono::milliseconds{RPC_READ_TIMEOUT});  // if no timeout specified, defaults to RPC_READ_TIMEOUT
+        },
+        [rpcStream](std::chrono::milliseconds timeout) {
             if(timeout.count() > 0) {
                 return rpcStream->read(timeout);
             }
             logger::trace("Endless wait for RPC client.");
             return rpcStream->read();  // endless wait
+        });
+
+    pimpl->rpcClient = std::make_unique<nanorpc::core::client<utility::RpcMsgpackPacker>>([this](nanorpc::core::type::buffer request) {
+        // Other threads' requests may be in flight at the same time, responses are matched in order by the pipeline
+        std::chrono::milliseconds timeout =
+            currentRpcTimeout().value_or(std::chrono::milliseconds{RPC_READ_TIMEOUT});  // if no timeout specified, defaults to RPC_READ_TIMEOUT
+        try {
+            return pimpl->rpcPipeline->submit(std::move(request), timeout).get();
         } catch(const std::exception& e) {
             // If any exception is thrown, log it and rethrow
             pimpl->logger.debug("RPC error: {}", e.what());
@@ -1291,6 +1321,26 @@ CpuUsage DeviceBase::getLeonMssCpuUsage() {
     return pimpl->rpcCall("getLeonMssCpuUsage").as<CpuUsage>();
 }
 
+std::future<MemoryInfo> DeviceBase::getDdrMemoryUsageAsync() {
+    return pimpl->rpcCallAsync<MemoryInfo>("getDdrUsage");
+}
+
+std::future<MemoryInfo> DeviceBase::getCmxMemoryUsageAsync() {
+    return pimpl->rpcCallAsync<MemoryInfo>("getCmxUsage");
+}
+
+std::future<ChipTemperature> DeviceBase::getChipTemperatureAsync() {
+    return pimpl->rpcCallAsync<ChipTemperature>("getChipTemperature");
+}
+
+std::future<CpuUsage> DeviceBase::getLeonCssCpuUsageAsync() {
+    return pimpl->rpcCallAsync<CpuUsage>("getLeonCssCpuUsage");
+}
+
+std::future<CpuUsage> DeviceBase::getLeonMssCpuUsageAsync() {
+    return pimpl->rpcCallAsync<CpuUsage>("getLeonMssCpuUsage");
+}
+
 int64_t DeviceBase::getProcessMemoryUsage() {
     return pimpl->rpcClient->call("getProcessMemoryUsage").as<int64_t>();
 }
@@ -1367,6 +1417,14 @@ bool DeviceBase::setIrFloodLightIntensity(float intensity, int mask) {
     return pimpl->rpcCall("setIrFloodLightBrightness", intensity, mask, true);
 }
 
+std::future<bool> DeviceBase::setIrLaserDotProjectorIntensityAsync(float intensity, int mask) {
+    return pimpl->rpcCallAsync<bool>("setIrLaserDotProjectorBrightness", intensity, mask, true);
+}
+
+std::future<bool> DeviceBase::setIrFloodLightIntensityAsync(float intensity, int mask) {
+    return pimpl->rpcCallAsync<bool>("setIrFloodLightBrightness", intensity, mask, true);
+}
+
 std::vector<std::tuple<std::string, int, int>> DeviceBase::getIrDrivers() {
     return pimpl->rpcCall("getIrDrivers");
 }
@@ -1635,7 +1693,8 @@ bool DeviceBase::startPipelineImpl(const Pipeline& pipeline) {
     // Serialize the pipeline
     PipelineSchema schema;
     Assets assets;
-    std::vector<std::uint8_t> assetStorage;
+    // Asset storage is streamed directly from the assets' data
+    AssetScatterList assetStorage;
     pipeline.serialize(schema, assets, assetStorage);
 
     // if debug or lower
@@ -1672,12 +1731,7 @@ bool DeviceBase::startPipelineImpl(const Pipeline& pipeline) {
         const std::string streamAssetStorage = "__stream_asset_storage";
         std::thread t1([this, &streamAssetStorage, &assetStorage]() {
             XLinkStream stream(connection, streamAssetStorage, device::XLINK_USB_BUFFER_MAX_SIZE);
-            int64_t offset = 0;
-            do {
-                int64_t toTransfer = std::min(static_cast<int64_t>(device::XLINK_USB_BUFFER_MAX_SIZE), static_cast<int64_t>(assetStorage.size() - offset));
-                stream.write(&assetStorage[offset], toTransfer);
-                offset += toTransfer;
-            } while(offset < static_cast<int64_t>(assetStorage.size()));
+            assetStorage.stream(device::XLINK_USB_BUFFER_MAX_SIZE, [&stream](span<const std::uint8_t> packet) { stream.write(packet); });
         });
 
         logger::trace("Transfering assets of size {} with no timeout.", assetStorage.size());
@@ -67,7 +67,8 @@ std::vector<uint8_t> DeviceBootloader::createDepthaiApplicationPackage(
     // Serialize the pipeline
     PipelineSchema schema;
     Assets assets;
-    std::vector<std::uint8_t> assetStorage;
+    // Copied straight into the package below
+    AssetScatterList assetStorage;
     pipeline.serialize(schema, assets, assetStorage);
 
     // Get DeviceConfig
@@ -180,7 +181,7 @@ std::vector<uint8_t> DeviceBootloader::createDepthaiApplicationPackage(
     // Section, asset storage, name 'asset_storage'
     sbr_section_set_name(assetStorageSection, "asset_storage");
     sbr_section_set_size(assetStorageSection, static_cast<uint32_t>(assetStorage.size()));
-    sbr_section_set_checksum(assetStorageSection, sbr_compute_checksum(assetStorage.data(), static_cast<uint32_t>(assetStorage.size())));
+    // Checksum computed once the storage is copied into the package
     sbr_section_set_offset(assetStorageSection, getSectionAlignedOffsetSmall(assetsSection->offset + assetsSection->size));
 
     // Section, firmware version
@@ -201,6 +202,11 @@ std::vector<uint8_t> DeviceBootloader::createDepthaiApplicationPackage(
     std::vector<uint8_t> fwPackage;
     fwPackage.resize(lastSection->offset + lastSection->size);
 
+    // Asset storage, copied before serializing SBR as its checksum is computed in place
+    uint8_t* assetStorageData = fwPackage.data() + assetStorageSection->offset;
+    assetStorage.copyTo(span<uint8_t>(assetStorageData, assetStorage.size()));
+    sbr_section_set_checksum(assetStorageSection, sbr_compute_checksum(assetStorageData, static_cast<uint32_t>(assetStorage.size())));
+
     // Serialize SBR
     sbr_serialize(&sbr, fwPackage.data(), static_cast<uint32_t>(fwPackage.size()));
 
@@ -210,7 +216,6 @@ std::vector<uint8_t> DeviceBootloader::createDepthaiApplicationPackage(
     for(std::size_t i = 0; i < applicationName.size(); i++) fwPackage[appNameSection->offset + i] = applicationName[i];
     for(std::size_t i = 0; i < pipelineBinary.size(); i++) fwPackage[pipelineSection->offset + i] = pipelineBinary[i];
     for(std::size_t i = 0; i < assetsBinary.size(); i++) fwPackage[assetsSection->offset + i] = assetsBinary[i];
-    for(std::size_t i = 0; i < assetStorage.size(); i++) fwPackage[assetStorageSection->offset + i] = assetStorage[i];
 
     // Debug
     if(logger::get_level() == spdlog::level::debug) {
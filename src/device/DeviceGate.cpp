@@ -3,6 +3,8 @@
 #include <XLink/XLinkPublicDefines.h>
 
 // std
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <optional>
 #include <string>
@@ -26,17 +28,152 @@ namespace dai {
 const std::string API_ROOT{"/api/v1"};
 const auto sessionsEndpoint = API_ROOT + "/sessions";
 const int DEFAULT_PORT{11492};
+// Requests are answered right away, only downloads wait for the gate to compress the files before the first byte arrives
+constexpr int REQUEST_TIMEOUT_S{10};
+constexpr int DOWNLOAD_TIMEOUT_S{60};
+// Gates push a keep alive comment on the event stream more often than this
+constexpr int EVENTS_TIMEOUT_S{30};
+constexpr auto POLL_INTERVAL{std::chrono::seconds(1)};
+// How long the gate may take to start serving the crash dump once the session crashed
+constexpr auto CRASH_DUMP_READY_TIMEOUT{std::chrono::seconds(10)};
+
+namespace {
+
+std::optional<DeviceGate::SessionState> parseSessionState(const std::string& state) {
+    if(state == "CREATED") return DeviceGate::SessionState::CREATED;
+    if(state == "RUNNING") return DeviceGate::SessionState::RUNNING;
+    if(state == "STOPPED") return DeviceGate::SessionState::STOPPED;
+    if(state == "STOPPING") return DeviceGate::SessionState::STOPPING;
+    if(state == "CRASHED") return DeviceGate::SessionState::CRASHED;
+    if(state == "DESTROYED") return DeviceGate::SessionState::DESTROYED;
+    return std::nullopt;
+}
+
+bool isSessionActive(DeviceGate::SessionState state) {
+    return state == DeviceGate::SessionState::CREATED || state == DeviceGate::SessionState::RUNNING || state == DeviceGate::SessionState::STOPPING;
+}
+
+// Splits a text/event-stream into events, handing over the data of each
+class EventStreamParser {
+   public:
+    explicit EventStreamParser(std::function<bool(const std::string&)> onEvent) : onEvent(std::move(onEvent)) {}
+
+    bool feed(const char* data, size_t length) {
+        buffer.append(data, length);
+        size_t start = 0;
+        size_t end = 0;
+        while((end = buffer.find('\n', start)) != std::string::npos) {
+            auto line = buffer.substr(start, end - start);
+            start = end + 1;
+            if(!line.empty() && line.back() == '\r') line.pop_back();
+            if(line.empty()) {
+                // Blank line dispatches the event
+                if(hasData && !onEvent(eventData)) return false;
+                eventData.clear();
+                hasData = false;
+            } else if(line.rfind("data:", 0) == 0) {
+                auto value = line.substr(5);
+                if(!value.empty() && value.front() == ' ') value.erase(0, 1);
+                if(hasData) eventData += '\n';
+                eventData += value;
+                hasData = true;
+            }
+            // Comments (keep alives) and other fields are ignored
+        }
+        buffer.erase(0, start);
+        return true;
+    }
+
+   private:
+    std::function<bool(const std::string&)> onEvent;
+    std::string buffer;
+    std::string eventData;
+    bool hasData = false;
+};
+
+// Only the last path component of the name the gate sends is used
+std::string sanitizeFilename(const std::string& filename, const std::string& defaultFilename) {
+    auto name = std::filesystem::path(filename).filename().string();
+    if(name.empty() || name == "." || name == "..") return defaultFilename;
+    return name;
+}
+
+}  // namespace
 
 class DeviceGate::Impl {
    public:
     Impl() = default;
 
+    enum class FileStatus { OK, NOT_READY, FAILED };
+
     // Default Gate connection
     std::unique_ptr<httplib::Client> cli;
+    // Long lived connection for event streams and downloads
+    std::unique_ptr<httplib::Client> streamCli;
+    // Cleared once the gate answers that it doesn't have the events endpoint
+    bool eventsSupported = true;
+
+    /**
+     * Streams the body of a GET request. onResponse is called once the headers arrive and onData with every chunk of the body,
+     * either can cancel the download by returning false.
+     */
+    FileStatus streamFile(const std::string& url,
+                          const std::function<bool(const httplib::Response&)>& onResponse,
+                          const std::function<bool(const char*, size_t)>& onData,
+                          const ProgressCallback& progress) {
+        int status = 0;
+        std::string error;
+        streamCli->set_read_timeout(DOWNLOAD_TIMEOUT_S);
+        auto res = streamCli->Get(
+            url,
+            [&](const httplib::Response& response) {
+                status = response.status;
+                return status != 200 || onResponse(response);
+            },
+            [&](const char* data, size_t length) {
+                if(status == 200) return onData(data, length);
+                // Keep the start of an error message
+                if(error.size() < 512) error.append(data, std::min(length, 512 - error.size()));
+                return true;
+            },
+            [&](uint64_t current, uint64_t total) {
+                if(status == 200 && progress) progress(current, total);
+                return true;
+            });
+        if(!res) {
+            spdlog::warn("File download not successful - {}", httplib::to_string(res.error()));
+            return FileStatus::FAILED;
+        }
+        if(status == 404 || status == 503) {
+            spdlog::debug("File not available yet - status: {}", status);
+            return FileStatus::NOT_READY;
+        }
+        if(status != 200) {
+            spdlog::warn("File download not successful - status: {}, error: {}", status, error);
+            return FileStatus::FAILED;
+        }
+        return FileStatus::OK;
+    }
+
+    /**
+     * Retries the download while the gate is still preparing the file
+     */
+    FileStatus streamFileWhenReady(const std::function<FileStatus()>& download) {
+        const auto deadline = std::chrono::steady_clock::now() + CRASH_DUMP_READY_TIMEOUT;
+        auto delay = std::chrono::milliseconds(100);
+        while(true) {
+            auto status = download();
+            if(status != FileStatus::NOT_READY || std::chrono::steady_clock::now() + delay > deadline) return status;
+            std::this_thread::sleep_for(delay);
+            delay = std::min(delay * 2, std::chrono::milliseconds(1000));
+        }
+    }
 };
 DeviceGate::~DeviceGate() {}
 
-DeviceGate::DeviceGate(const DeviceInfo& deviceInfo) : deviceInfo(deviceInfo) {
+DeviceGate::DeviceGate(const DeviceInfo& deviceInfo) : DeviceGate(deviceInfo, DEFAULT_PORT) {}
+
+DeviceGate::DeviceGate(const DeviceInfo& deviceInfo, int port) : deviceInfo(deviceInfo) {
     if((deviceInfo.state != X_LINK_GATE) && (deviceInfo.state != X_LINK_GATE_SETUP)) {
         throw std::invalid_argument(
             "Device is already used by another application/process. Make sure to close all applications/processes using the device before starting a new one.");
@@ -53,9 +190,10 @@ DeviceGate::DeviceGate(const DeviceInfo& deviceInfo) : deviceInfo(deviceInfo) {
         throw std::runtime_error("Unknown platform");  // Should never happen
     }
     // Discover and connect
-    pimpl->cli = std::make_unique<httplib::Client>(deviceInfo.name, DEFAULT_PORT);
-    pimpl->cli->set_read_timeout(60);  // 60 seconds timeout to allow for compressing the crash dumps without async
+    pimpl->cli = std::make_unique<httplib::Client>(deviceInfo.name, port);
+    pimpl->cli->set_read_timeout(REQUEST_TIMEOUT_S);
     // pimpl->cli->set_connection_timeout(2);
+    pimpl->streamCli = std::make_unique<httplib::Client>(deviceInfo.name, port);
 }
 
 bool DeviceGate::isOkay() {
@@ -256,18 +394,8 @@ DeviceGate::SessionState DeviceGate::getState() {
         spdlog::trace("DeviceGate getState response: {}", resp.dump());
 
         std::string sessionStateStr = resp["state"];
-        if(sessionStateStr == "CREATED") {
-            sessionState = SessionState::CREATED;
-        } else if(sessionStateStr == "RUNNING") {
-            sessionState = SessionState::RUNNING;
-        } else if(sessionStateStr == "STOPPED") {
-            sessionState = SessionState::STOPPED;
-        } else if(sessionStateStr == "STOPPING") {
-            sessionState = SessionState::STOPPING;
-        } else if(sessionStateStr == "CRASHED") {
-            sessionState = SessionState::CRASHED;
-        } else if(sessionStateStr == "DESTROYED") {
-            sessionState = SessionState::DESTROYED;
+        if(auto parsed = parseSessionState(sessionStateStr)) {
+            sessionState = *parsed;
         } else {
             spdlog::warn("DeviceGate getState not successful - unknown session state: {}", sessionStateStr);
             sessionState = SessionState::ERROR_STATE;
@@ -279,80 +407,185 @@ DeviceGate::SessionState DeviceGate::getState() {
     return SessionState::ERROR_STATE;
 }
 
-std::optional<std::vector<uint8_t>> DeviceGate::getFile(const std::string& fileUrl, std::string& filename) {
-    // Send a GET request to the server
-    if(auto res = pimpl->cli->Get(fileUrl.c_str())) {
-        if(res->status == 200) {
-            filename = res->get_header_value("X-Filename");
-            // Convert the response body to a vector of uint8_t
-            std::vector<uint8_t> fileData(res->body.begin(), res->body.end());
+std::optional<std::vector<uint8_t>> DeviceGate::getFile(const std::string& fileUrl, std::string& filename, const ProgressCallback& progress) {
+    std::vector<uint8_t> fileData;
+    auto download = [&]() {
+        fileData.clear();
+        return pimpl->streamFile(
+            fileUrl,
+            [&](const httplib::Response& response) {
+                filename = response.get_header_value("X-Filename");
+                // Received straight into the final buffer, allocated once when the size is known
+                fileData.reserve(response.get_header_value_u64("Content-Length"));
+                return true;
+            },
+            [&](const char* data, size_t length) {
+                fileData.insert(fileData.end(), data, data + length);
+                return true;
+            },
+            progress);
+    };
+    if(pimpl->streamFileWhenReady(download) != Impl::FileStatus::OK) return std::nullopt;
+
+    spdlog::debug("File download successful. Filename: {}", filename);
+    return fileData;
+}
 
-            spdlog::debug("File download successful. Filename: {}", filename);
-            return fileData;
-        } else {
-            spdlog::warn("File download not successful - status: {}, error: {}", res->status, res->body);
-            return std::nullopt;
-        }
-    } else {
-        spdlog::warn("File download not successful - got no response");
+std::optional<std::filesystem::path> DeviceGate::saveFile(const std::string& fileUrl,
+                                                          const std::filesystem::path& directory,
+                                                          const std::string& defaultFilename,
+                                                          const ProgressCallback& progress) {
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if(ec) {
+        spdlog::warn("File download not successful - can't create directory {}: {}", directory.string(), ec.message());
         return std::nullopt;
     }
+
+    std::filesystem::path path;
+    std::filesystem::path partialPath;
+    std::ofstream file;
+    auto download = [&]() {
+        return pimpl->streamFile(
+            fileUrl,
+            [&](const httplib::Response& response) {
+                path = directory / sanitizeFilename(response.get_header_value("X-Filename"), defaultFilename);
+                partialPath = path;
+                partialPath += ".part";
+                file.open(partialPath, std::ios::binary | std::ios::trunc);
+                return file.is_open();
+            },
+            [&](const char* data, size_t length) {
+                file.write(data, static_cast<std::streamsize>(length));
+                return file.good();
+            },
+            progress);
+    };
+    const auto status = pimpl->streamFileWhenReady(download);
+    const bool written = file.is_open() && file.good();
+    file.close();
+    if(status != Impl::FileStatus::OK || !written) {
+        if(!partialPath.empty()) std::filesystem::remove(partialPath, ec);
+        if(status == Impl::FileStatus::OK) spdlog::warn("File download not successful - can't write {}", partialPath.string());
+        return std::nullopt;
+    }
+    std::filesystem::rename(partialPath, path, ec);
+    if(ec) {
+        spdlog::warn("File download not successful - can't rename {}: {}", partialPath.string(), ec.message());
+        std::filesystem::remove(partialPath, ec);
+        return std::nullopt;
+    }
+
+    spdlog::debug("File download successful. Saved to: {}", path.string());
+    return path;
+}
+
+DeviceGate::SessionState DeviceGate::waitForSessionExit() {
+    auto sessionState = getState();
+    while(isSessionActive(sessionState)) {
+        bool receivedEvents = false;
+        if(pimpl->eventsSupported) {
+            // Follow the state changes pushed by the gate, the stream ends when the session does or the connection drops
+            std::string url = fmt::format("{}/{}/events", sessionsEndpoint, sessionId);
+            int status = 0;
+            EventStreamParser parser([&](const std::string& event) {
+                receivedEvents = true;
+                auto json = nlohmann::json::parse(event, nullptr, false);
+                if(!json.is_object() || !json.contains("state") || !json["state"].is_string()) return true;
+                auto state = parseSessionState(json["state"].get<std::string>());
+                if(!state) return true;
+                sessionState = *state;
+                spdlog::trace("DeviceGate session state event: {}", event);
+                return isSessionActive(sessionState);
+            });
+            pimpl->streamCli->set_read_timeout(EVENTS_TIMEOUT_S);
+            auto res = pimpl->streamCli->Get(
+                url,
+                [&](const httplib::Response& response) {
+                    status = response.status;
+                    return true;
+                },
+                [&](const char* data, size_t length) { return status != 200 || parser.feed(data, length); });
+            if(!isSessionActive(sessionState)) break;
+            if(status == 404) {
+                spdlog::debug("DeviceGate doesn't stream session events, polling the session state instead");
+                pimpl->eventsSupported = false;
+            } else if(!res) {
+                spdlog::debug("DeviceGate session event stream ended - {}", httplib::to_string(res.error()));
+            }
+        }
+        // Polling, or the event stream ended without a final state - check the state directly before following it again
+        if(!receivedEvents) std::this_thread::sleep_for(POLL_INTERVAL);
+        sessionState = getState();
+    }
+    return sessionState;
 }
 
 std::optional<DeviceGate::CrashDump> DeviceGate::waitForSessionEnd() {
-    while(true) {
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-        auto sessionState = getState();
-        if(sessionState == SessionState::ERROR_STATE) {
+    auto sessionState = waitForSessionExit();
+    switch(sessionState) {
+        case SessionState::ERROR_STATE:
             spdlog::error("DeviceGate session state is in error state - exiting");
             return std::nullopt;
-        }
-        switch(sessionState) {
-            case SessionState::NOT_CREATED:
-            case SessionState::CREATED:
-            case SessionState::RUNNING:
-            case SessionState::STOPPING:
-                break;  // Nothing to do
-            case SessionState::ERROR_STATE:
-                spdlog::error("DeviceGate session state is in error state - exiting");
-                return std::nullopt;
-            case SessionState::STOPPED:
-                return std::nullopt;
-            case SessionState::CRASHED:
-            case SessionState::DESTROYED:
-                auto crashDumpPathStr = utility::getEnvAs<std::string>("DEPTHAI_CRASHDUMP", "");
-                if(crashDumpPathStr == "0") {
-                    spdlog::warn("Firmware crashed but DEPTHAI_CRASHDUMP is set to 0, the crash dump will not be saved.");
-                    return std::nullopt;
-                }
+        case SessionState::NOT_CREATED:
+        case SessionState::CREATED:
+        case SessionState::RUNNING:
+        case SessionState::STOPPING:
+        case SessionState::STOPPED:
+            return std::nullopt;
+        case SessionState::CRASHED:
+        case SessionState::DESTROYED:
+            break;
+    }
 
-                auto currentVersion = getVersion();
-                auto requiredVersion = Version(0, 0, 14);
-                if(currentVersion < requiredVersion) {
-                    spdlog::warn("FW crashed but the gate version does not support transfering over the crash dump. Current version {}, required is {}",
-                                 currentVersion.toString(),
-                                 requiredVersion.toString());
-                    return std::nullopt;
-                }
-                spdlog::warn("FW crashed - trying to get out the crash dump");
-                std::this_thread::sleep_for(std::chrono::seconds(3));  // Allow for the generation of the crash dump and the log file
-                std::string crashDumpName;
-                spdlog::warn("Getting the crash dump out - this can take up to a minute, because it first needs to be compressed.");
-                return getCrashDump();
-        }
+    auto crashDumpPathStr = utility::getEnvAs<std::string>("DEPTHAI_CRASHDUMP", "");
+    if(crashDumpPathStr == "0") {
+        spdlog::warn("Firmware crashed but DEPTHAI_CRASHDUMP is set to 0, the crash dump will not be saved.");
+        return std::nullopt;
+    }
+
+    auto currentVersion = getVersion();
+    auto requiredVersion = Version(0, 0, 14);
+    if(currentVersion < requiredVersion) {
+        spdlog::warn("FW crashed but the gate version does not support transfering over the crash dump. Current version {}, required is {}",
+                     currentVersion.toString(),
+                     requiredVersion.toString());
+        return std::nullopt;
     }
+    spdlog::warn("FW crashed - getting the crash dump out, this can take up to a minute, because it first needs to be compressed.");
+    auto lastReport = std::chrono::steady_clock::now();
+    return getCrashDump([&lastReport](std::uint64_t received, std::uint64_t total) {
+        auto now = std::chrono::steady_clock::now();
+        if(now - lastReport < std::chrono::seconds(1)) return;
+        lastReport = now;
+        if(total > 0) {
+            spdlog::info("Crash dump download: {} / {} kB", received / 1024, total / 1024);
+        } else {
+            spdlog::info("Crash dump download: {} kB", received / 1024);
+        }
+    });
 }
 
-std::optional<DeviceGate::CrashDump> DeviceGate::getCrashDump() {
+std::optional<DeviceGate::CrashDump> DeviceGate::getCrashDump(ProgressCallback progress) {
     std::string url = fmt::format("{}/{}/core_dump", sessionsEndpoint, sessionId);
     std::string filename;
-    auto fileData = DeviceGate::getFile(url, filename);
+    auto fileData = DeviceGate::getFile(url, filename, progress);
     if(fileData) {
         return CrashDump{std::move(*fileData), filename};
     }
     return std::nullopt;
 }
 
+std::optional<std::filesystem::path> DeviceGate::saveCrashDump(const std::filesystem::path& directory, ProgressCallback progress) {
+    std::string url = fmt::format("{}/{}/core_dump", sessionsEndpoint, sessionId);
+    return saveFile(url, directory, "crash_dump.tar.gz", progress);
+}
+
+std::optional<std::filesystem::path> DeviceGate::saveLogs(const std::filesystem::path& directory, ProgressCallback progress) {
+    std::string url = fmt::format("{}/{}/logs", sessionsEndpoint, sessionId);
+    return saveFile(url, directory, "session_logs.tar.gz", progress);
+}
+
 // TODO(themarpe) - get all sessions, check if only one and not protected
 bool DeviceGate::isBootedNonExclusive() {
     return true;
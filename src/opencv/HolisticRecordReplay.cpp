@@ -2,8 +2,10 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <filesystem>
 #include <memory>
+#include <optional>
 
 #include "../utility/Platform.hpp"
 #include "../utility/RecordReplayImpl.hpp"
@@ -189,12 +191,22 @@ bool setupHolisticReplay(Pipeline& pipeline,
     auto sources = pipeline.getSourceNodes();
     try {
         bool useTar = !platform::checkPathExists(replayPath, true);
+        // Uncompressed recordings are replayed in place, reading the files at their offsets within the archive
+        bool useIndex = false;
+        std::vector<TarMember> tarIndex;
         std::vector<std::string> tarNodenames;
         std::string tarRoot;
         std::filesystem::path rootPath = replayPath;
         if(useTar) {
             rootPath = platform::getDirFromPath(replayPath);
-            tarNodenames = filenamesInTar(replayPath);
+            try {
+                tarIndex = indexTar(replayPath);
+                useIndex = true;
+                for(const auto& member : tarIndex) tarNodenames.push_back(member.name);
+            } catch(const std::exception& e) {
+                spdlog::debug("Recording can't be replayed in place, extracting it: {}", e.what());
+                tarNodenames = filenamesInTar(replayPath);
+            }
             tarNodenames.erase(std::remove_if(tarNodenames.begin(),
                                               tarNodenames.end(),
                                               [](const std::string& path) {
@@ -241,16 +253,19 @@ bool setupHolisticReplay(Pipeline& pipeline,
                     inFiles.push_back(tarRoot + filename + ".mp4");
                     inFiles.push_back(tarRoot + filename + ".mcap");
                 }
+                if(useIndex) continue;
                 std::filesystem::path filePath = platform::joinPaths(rootPath, filename);
                 outFiles.push_back(std::filesystem::path(filePath).concat(".mp4"));
                 outFiles.push_back(std::filesystem::path(filePath).concat(".mcap"));
                 outFilenames[nodeName] = filePath;
             }
             if(useTar) inFiles.emplace_back(tarRoot + "record_config.json");
-            configPath = platform::joinPaths(rootPath, "record_config.json");
-            outFiles.push_back(configPath);
-            outFilenames["record_config"] = configPath;
-            if(useTar) untarFiles(replayPath, inFiles, outFiles);
+            if(!useIndex) {
+                configPath = platform::joinPaths(rootPath, "record_config.json");
+                outFiles.push_back(configPath);
+                outFilenames["record_config"] = configPath;
+            }
+            if(useTar && !useIndex) untarFiles(replayPath, inFiles, outFiles);
         } else {
             throw std::runtime_error("Recording does not match the pipeline configuration.");
             // For multi-device recordings, where devices are not the same
@@ -283,8 +298,17 @@ bool setupHolisticReplay(Pipeline& pipeline,
             // untarFiles(replayPath, inFiles, outFiles);
         }
 
-        std::ifstream file(configPath);
-        json j = json::parse(file);
+        json j;
+        if(useIndex) {
+            auto member = std::find_if(tarIndex.begin(), tarIndex.end(), [&](const TarMember& m) { return m.name == tarRoot + "record_config.json"; });
+            if(member == tarIndex.end()) {
+                throw std::runtime_error("Recording does not contain record_config.json");
+            }
+            j = json::parse(readTarMember(replayPath, *member));
+        } else {
+            std::ifstream file(configPath);
+            j = json::parse(file);
+        }
         recordConfig = j.get<RecordConfig>();
         recordConfig.state = RecordConfig::RecordReplayState::REPLAY;
 
@@ -299,13 +323,23 @@ bool setupHolisticReplay(Pipeline& pipeline,
             if(std::dynamic_pointer_cast<node::Camera>(node) != nullptr || std::dynamic_pointer_cast<node::ColorCamera>(node) != nullptr
                || std::dynamic_pointer_cast<node::MonoCamera>(node) != nullptr) {
                 auto replay = pipeline.create<dai::node::ReplayVideo>();
-                // replay->setReplayFile(platform::joinPaths(rootPath, (mxId + "_").append(nodeName).append(".mcap")));
-                replay->setReplayMetadataFile(platform::joinPaths(rootPath, nodeName + ".mcap"));
-                // replay->setReplayVideo(platform::joinPaths(rootPath, (mxId + "_").append(nodeName).append(".mp4")));
-                replay->setReplayVideoFile(platform::joinPaths(rootPath, nodeName + ".mp4"));
+                std::optional<std::tuple<uint32_t, uint32_t>> videoSize;
+                if(useIndex) {
+                    // Each replay node opens its files from the archive when it starts
+                    replay->setReplayArchive(replayPath);
+                    replay->setReplayMetadataFile(tarRoot + nodeName + ".mcap");
+                    replay->setReplayVideoFile(tarRoot + nodeName + ".mp4");
+                    auto member = std::find_if(tarIndex.begin(), tarIndex.end(), [&](const TarMember& m) { return m.name == tarRoot + nodeName + ".mcap"; });
+                    if(member != tarIndex.end()) videoSize = BytePlayer::getVideoSize(replayPath, *member);
+                } else {
+                    // replay->setReplayFile(platform::joinPaths(rootPath, (mxId + "_").append(nodeName).append(".mcap")));
+                    replay->setReplayMetadataFile(platform::joinPaths(rootPath, nodeName + ".mcap"));
+                    // replay->setReplayVideo(platform::joinPaths(rootPath, (mxId + "_").append(nodeName).append(".mp4")));
+                    replay->setReplayVideoFile(platform::joinPaths(rootPath, nodeName + ".mp4"));
+                    videoSize = BytePlayer::getVideoSize(replay->getReplayMetadataFile().string());
+                }
                 replay->setOutFrameType(legacy ? ImgFrame::Type::YUV420p : ImgFrame::Type::NV12);
 
-                auto videoSize = BytePlayer::getVideoSize(replay->getReplayMetadataFile().string());
                 if(videoSize.has_value()) {
                     auto [width, height] = videoSize.value();
                     if(std::dynamic_pointer_cast<node::Camera>(node) != nullptr) {
@@ -324,7 +358,12 @@ bool setupHolisticReplay(Pipeline& pipeline,
                 replay->out.link(nodeS->getReplayInput());
             } else {
                 auto replay = pipeline.create<dai::node::ReplayMetadataOnly>();
-                replay->setReplayFile(platform::joinPaths(rootPath, nodeName + ".mcap"));
+                if(useIndex) {
+                    replay->setReplayArchive(replayPath);
+                    replay->setReplayFile(tarRoot + nodeName + ".mcap");
+                } else {
+                    replay->setReplayFile(platform::joinPaths(rootPath, nodeName + ".mcap"));
+                }
                 replay->out.link(nodeS->getReplayInput());
             }
         }
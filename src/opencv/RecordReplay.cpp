@@ -6,6 +6,7 @@
 #include <optional>
 #include <stdexcept>
 
+#include "../utility/Platform.hpp"
 #include "../utility/RecordReplayImpl.hpp"
 
 namespace dai {
@@ -189,6 +190,26 @@ void VideoPlayer::init(const std::string& filePath) {
     initialized = true;
 }
 
+void VideoPlayer::init(const std::filesystem::path& archivePath, const TarMember& member) {
+    if(initialized) {
+        throw std::runtime_error("VideoPlayer already initialized");
+    }
+    cvReader = std::make_unique<cv::VideoCapture>();
+    // FFmpeg reads the member in place through its subfile protocol
+    const auto url = fmt::format("subfile,,start,{},end,{},,:{}", member.offset, member.offset + member.size, archivePath.string());
+    if(!cvReader->open(url, cv::CAP_FFMPEG)) {
+        // Other backends need a file of their own
+        extractedFile = platform::getTempPath() / std::filesystem::path(member.name).filename();
+        spdlog::debug("Video backend can't read {} from the archive in place, extracting it to {}", member.name, extractedFile.string());
+        extractTarMember(archivePath, member, extractedFile);
+        cvReader->open(extractedFile.string());
+    }
+    if(!cvReader->isOpened()) {
+        throw std::runtime_error("Failed to open video " + member.name + " from " + archivePath.string());
+    }
+    initialized = true;
+}
+
 void VideoPlayer::setSize(uint32_t width, uint32_t height) {
     this->width = width;
     this->height = height;
@@ -232,6 +253,11 @@ void VideoPlayer::close() {
     if(cvReader && cvReader->isOpened()) {
         cvReader->release();
     }
+    if(!extractedFile.empty()) {
+        std::error_code ec;
+        std::filesystem::remove(extractedFile, ec);
+        extractedFile.clear();
+    }
 }
 
 std::tuple<size_t, size_t> getVideoSize(const std::string& filePath) {
@@ -6,7 +6,9 @@
 #include "utility/spdlog-fmt.hpp"
 
 // std
+#include <algorithm>
 #include <fstream>
+#include <stdexcept>
 
 namespace dai {
 
@@ -174,6 +176,92 @@ void AssetManager::serialize(AssetsMutable& mutableAssets, std::vector<std::uint
     }
 }
 
+void AssetManager::serialize(AssetsMutable& mutableAssets, AssetScatterList& storage, std::string prefix) const {
+    if(prefix.empty()) {
+        prefix = rootPath;
+    }
+
+    for(auto& kv : assetMap) {
+        auto& a = *kv.second;
+        auto offset = storage.append(kv.second);
+        mutableAssets.set(prefix + a.key, static_cast<uint32_t>(offset), static_cast<uint32_t>(a.data.size()), a.alignment);
+    }
+}
+
+std::size_t AssetScatterList::append(std::shared_ptr<const Asset> asset) {
+    std::size_t offset = totalSize;
+    if(asset->alignment > 1 && offset % asset->alignment != 0) {
+        offset += asset->alignment - (offset % asset->alignment);
+    }
+    totalSize = offset + asset->data.size();
+    if(!asset->data.empty()) {
+        entries.push_back({offset, span<const std::uint8_t>(asset->data.data(), asset->data.size())});
+        owners.push_back(std::move(asset));
+    }
+    return offset;
+}
+
+const std::vector<AssetScatterList::Entry>& AssetScatterList::getEntries() const {
+    return entries;
+}
+
+std::size_t AssetScatterList::size() const {
+    return totalSize;
+}
+
+bool AssetScatterList::empty() const {
+    return totalSize == 0;
+}
+
+void AssetScatterList::clear() {
+    entries.clear();
+    owners.clear();
+    totalSize = 0;
+}
+
+void AssetScatterList::copyTo(span<std::uint8_t> dst) const {
+    if(dst.size() < totalSize) throw std::invalid_argument("Destination is smaller than the asset storage");
+    std::size_t pos = 0;
+    for(const auto& entry : entries) {
+        std::fill(dst.begin() + pos, dst.begin() + entry.offset, 0);
+        std::copy(entry.data.begin(), entry.data.end(), dst.begin() + entry.offset);
+        pos = entry.offset + entry.data.size();
+    }
+    std::fill(dst.begin() + pos, dst.begin() + totalSize, 0);
+}
+
+std::vector<std::uint8_t> AssetScatterList::toVector() const {
+    std::vector<std::uint8_t> storage(totalSize);
+    copyTo(storage);
+    return storage;
+}
+
+void AssetScatterList::stream(std::size_t packetSize, const std::function<void(span<const std::uint8_t>)>& write) const {
+    if(packetSize == 0) throw std::invalid_argument("Packet size must be positive");
+    std::vector<std::uint8_t> staging;
+    auto entry = entries.begin();
+    for(std::size_t pos = 0; pos < totalSize; pos += packetSize) {
+        const std::size_t end = std::min(pos + packetSize, totalSize);
+        // Skip entries ending before this packet
+        while(entry != entries.end() && entry->offset + entry->data.size() <= pos) ++entry;
+
+        if(entry != entries.end() && entry->offset <= pos && entry->offset + entry->data.size() >= end) {
+            // Packet fully within one asset
+            write(entry->data.subspan(pos - entry->offset, end - pos));
+            continue;
+        }
+
+        // Gather padding and pieces of the assets overlapping the packet
+        staging.assign(end - pos, 0);
+        for(auto it = entry; it != entries.end() && it->offset < end; ++it) {
+            const std::size_t from = std::max(pos, it->offset);
+            const std::size_t to = std::min(end, it->offset + it->data.size());
+            std::copy(it->data.begin() + (from - it->offset), it->data.begin() + (to - it->offset), staging.begin() + (from - pos));
+        }
+        write(span<const std::uint8_t>(staging.data(), staging.size()));
+    }
+}
+
 void AssetsMutable::set(std::string key, std::uint32_t offset, std::uint32_t size, std::uint32_t alignment) {
     AssetInternal internal = {};
     internal.offset = offset;
@@ -1,5 +1,7 @@
 #include "depthai/pipeline/InputQueue.hpp"
 
+#include "pipeline/ThreadedNodeImpl.hpp"
+
 namespace dai {
 
 void InputQueue::send(const std::shared_ptr<ADatatype>& msg) {
@@ -8,19 +10,71 @@ void InputQueue::send(const std::shared_ptr<ADatatype>& msg) {
 
 InputQueue::InputQueue(unsigned int maxSize, bool blocking) : inputQueueNode(std::make_shared<InputQueueNode>(maxSize, blocking)) {}
 
-InputQueue::InputQueueNode::InputQueueNode(unsigned int maxSize, bool blocking) : ThreadedHostNode() {
+InputQueue::InputQueueNode::InputQueueNode(unsigned int maxSize, bool blocking) : ThreadedHostNode(), blocking(blocking) {
     input.setBlocking(blocking);
     input.setMaxSize(maxSize);
+    pimpl->ownThread = false;
 }
 
-void InputQueue::InputQueueNode::run() {
-    while(isRunning()) {
-        output.send(input.get());
+void InputQueue::InputQueueNode::start() {
+    // Dropping the oldest message of an input that others send to as well would drop theirs
+    bool shared = false;
+    for(const auto& connection : output.getConnections()) {
+        shared |= connection.in->connectedOutputs.size() > 1;
+    }
+    dropOldest = !blocking && !shared;
+    // Runs onStart and marks the node as running, without starting a thread
+    ThreadedHostNode::start();
+    std::lock_guard<std::mutex> lock(startMtx);
+    // Flush what was sent before the start. Consumers may not be running yet, so this must not block.
+    std::shared_ptr<ADatatype> msg;
+    while((msg = input.tryGet()) != nullptr) {
+        if(!output.trySendWithDefault(msg, defaultPolicy())) {
+            pimpl->logger->warn("Input queue full at pipeline start, dropping a message sent before the start");
+        }
+    }
+    started = true;
+    startCv.notify_all();
+}
+
+void InputQueue::InputQueueNode::stop() {
+    {
+        std::lock_guard<std::mutex> lock(startMtx);
+        started = false;
+        // Closes the input, so sending afterwards throws like sending to any closed queue
+        ThreadedHostNode::stop();
     }
+    startCv.notify_all();
+}
+
+void InputQueue::InputQueueNode::run() {
+    // Not used, messages are delivered from send and no thread is started
 }
 
 void InputQueue::InputQueueNode::send(const std::shared_ptr<ADatatype>& msg) {
-    input.send(msg);
+    if(!started) {
+        std::unique_lock<std::mutex> lock(startMtx);
+        while(!started) {
+            // Throws once stopped, as the input is closed
+            if(input.trySend(msg)) return;
+            // Blocking and full, wait for the start to flush it
+            startCv.wait(lock);
+        }
+    }
+    deliver(msg);
+}
+
+void InputQueue::InputQueueNode::deliver(const std::shared_ptr<ADatatype>& msg) {
+    if(blocking) {
+        output.send(msg);
+    } else if(!output.trySendWithDefault(msg, defaultPolicy())) {
+        pimpl->logger->trace("Connected input is full, dropping the new message as set by its link policy");
+    }
+}
+
+Node::Output::LinkPolicy InputQueue::InputQueueNode::defaultPolicy() const {
+    // A full input makes room for the newest message, like the queue of a non blocking input would. Policies set explicitly are kept.
+    return dropOldest ? Output::LinkPolicy::DROP_OLDEST : Output::LinkPolicy::QUEUE_DEFAULT;
 }
 
 const char* InputQueue::InputQueueNode::getName() const {
@@ -3,6 +3,7 @@
 // std
 #include <chrono>
 #include <iostream>
+#include <limits>
 
 // project
 #include "depthai/pipeline/datatype/ADatatype.hpp"
@@ -66,6 +67,10 @@ unsigned int MessageQueue::getSize() const {
     return queue.getSize();
 }
 
+bool MessageQueue::waitEmpty(std::chrono::milliseconds timeout) {
+    return queue.waitEmpty(timeout);
+}
+
 unsigned int MessageQueue::isFull() const {
     return queue.isFull();
 }
@@ -133,6 +138,39 @@ bool MessageQueue::trySend(const std::shared_ptr<ADatatype>& msg) {
     return send(msg, std::chrono::milliseconds(0));
 }
 
+std::size_t MessageQueue::sendWithPolicy(const std::shared_ptr<ADatatype>& msg, OverflowPolicy policy, std::chrono::milliseconds timeout) {
+    if(!msg) throw std::invalid_argument("Message passed is not valid (nullptr)");
+    if(queue.isDestroyed()) {
+        throw QueueException(CLOSED_QUEUE_MESSAGE);
+    }
+    // A queue without room only feeds its callbacks, like send does
+    if(queue.getMaxSize() == 0) {
+        callCallbacks(msg);
+        return 0;
+    }
+    // Callbacks only see messages that made it into the queue
+    switch(policy) {
+        case OverflowPolicy::BLOCK:
+        case OverflowPolicy::DROP_NEWEST: {
+            const auto wait = policy == OverflowPolicy::BLOCK ? timeout : std::chrono::milliseconds(0);
+            if(queue.waitForSpaceAndPush(msg, wait)) {
+                callCallbacks(msg);
+                return 0;
+            }
+            // Closed while waiting
+            if(queue.isDestroyed()) throw QueueException(CLOSED_QUEUE_MESSAGE);
+            return 1;
+        }
+        case OverflowPolicy::DROP_OLDEST:
+        case OverflowPolicy::KEEP_LATEST: {
+            const auto dropped = queue.pushDroppingOldest(msg, policy == OverflowPolicy::KEEP_LATEST ? 0 : std::numeric_limits<unsigned>::max());
+            callCallbacks(msg);
+            return dropped;
+        }
+    }
+    return 0;
+}
+
 void MessageQueue::callCallbacks(std::shared_ptr<ADatatype> message) {
     // Lock first
     std::lock_guard<std::mutex> lock(callbacksMtx);
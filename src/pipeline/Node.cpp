@@ -1,5 +1,9 @@
 #include <depthai/pipeline/DeviceNode.hpp>
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 
 #include "depthai/pipeline/InputQueue.hpp"
 #include "depthai/pipeline/Pipeline.hpp"
@@ -8,6 +12,38 @@
 
 namespace dai {
 
+struct Node::Output::LinkState {
+    std::atomic<LinkPolicy> policy{LinkPolicy::QUEUE_DEFAULT};
+    std::atomic<std::chrono::milliseconds::rep> timeout{100};
+    std::atomic<uint64_t> sent{0};
+    std::atomic<uint64_t> dropped{0};
+    // Called once no link list holds the link anymore, set before unlinking it
+    std::function<void()> onReleased;
+
+    ~LinkState() {
+        if(onReleased) onReleased();
+    }
+};
+
+namespace {
+
+using LinkPolicy = Node::Output::LinkPolicy;
+
+LinkPolicy resolvePolicy(LinkPolicy policy, const MessageQueue& queue, LinkPolicy defaultPolicy = LinkPolicy::QUEUE_DEFAULT) {
+    if(policy != LinkPolicy::QUEUE_DEFAULT) return policy;
+    if(defaultPolicy != LinkPolicy::QUEUE_DEFAULT) return defaultPolicy;
+    return queue.getBlocking() ? LinkPolicy::BLOCK : LinkPolicy::DROP_OLDEST;
+}
+
+bool waitsWhenFull(LinkPolicy policy) {
+    return policy == LinkPolicy::BLOCK || policy == LinkPolicy::BLOCK_TIMEOUT;
+}
+
+// Serializes changes of links, sending doesn't take it
+std::mutex linkMtx;
+
+}  // namespace
+
 const Pipeline Node::getParentPipeline() const {
     auto impl = parent.lock();
     if(impl == nullptr) {
@@ -144,11 +180,35 @@ bool Node::Output::canConnect(const Input& in) {
     return true;
 }
 
+void Node::Output::checkLinkEditable(const Input& in) const {
+    auto pipeline = getParent().parent.lock();
+    if(pipeline == nullptr || !pipeline->isRunning()) return;
+    // Device nodes are connected through XLink bridges created when the pipeline is built.
+    // Nodes added since aren't built yet, they are checked once started
+    const auto isHost = [&pipeline](const Node& node) { return node.runOnHost() || pipeline->isPending(node); };
+    if(!isHost(getParent()) || !isHost(in.getParent())) {
+        throw std::runtime_error(fmt::format("Cannot change link '{}.{}' to '{}.{}' while the pipeline is running, only host nodes can be relinked",
+                                             getParent().getName(),
+                                             toString(),
+                                             in.getParent().getName(),
+                                             in.toString()));
+    }
+    if(pipeline->isFused(in.getParent())) {
+        throw std::runtime_error(fmt::format("Cannot change link '{}.{}' to '{}.{}' while the pipeline is running, fused host nodes keep their input links",
+                                             getParent().getName(),
+                                             toString(),
+                                             in.getParent().getName(),
+                                             in.toString()));
+    }
+}
+
 void Node::Output::link(Input& in) {
     // First check if can connect
     if(!canConnect(in)) {
         throw std::runtime_error(fmt::format("Cannot link '{}.{}' to '{}.{}'", getParent().getName(), toString(), in.getParent().getName(), in.toString()));
     }
+    checkLinkEditable(in);
+    std::lock_guard<std::mutex> lock(linkMtx);
 
     // Needed for serialization
     // Create 'Connection' object between 'out' and 'in'
@@ -163,27 +223,28 @@ void Node::Output::link(Input& in) {
     // Otherwise all is set to add a new connection
     parent.get().connections.insert(connection);
     // Add the shared_ptr to the input directly for host side
-    connectedInputs.push_back(&in);
+    addLink(&in);
     in.connectedOutputs.push_back(this);
 }
 
 std::shared_ptr<dai::MessageQueue> Node::Output::createOutputQueue(unsigned int maxSize, bool blocking) {
-    // Check if pipeline is already started - if so, throw an error
+    // Device outputs reach the host through XLink bridges, created when the pipeline is built
     auto pipelinePtr = parent.get().getParentPipeline();
-    if(pipelinePtr.isBuilt()) {
+    if(pipelinePtr.isBuilt() && !getParent().runOnHost() && !pipelinePtr.impl()->isPending(getParent())) {
         throw std::runtime_error("Cannot create queue after pipeline is built");
     }
     auto queue = std::make_shared<MessageQueue>(maxSize, blocking);
     link(queue);
 
     // No need to expose this on the public pipeline interface
+    std::lock_guard<std::mutex> lock(pipelinePtr.impl()->outputQueuesMtx);
     pipelinePtr.impl()->outputQueues.push_back(queue);
     return queue;
 }
 
 std::shared_ptr<InputQueue> Node::Input::createInputQueue(unsigned int maxSize, bool blocking) {
     auto pipelinePtr = parent.get().getParentPipeline();
-    if(pipelinePtr.isBuilt()) {
+    if(pipelinePtr.isBuilt() && !getParent().runOnHost() && !pipelinePtr.impl()->isPending(getParent())) {
         throw std::runtime_error("Cannot create input queue after pipeline is built");
     }
 
@@ -211,6 +272,8 @@ bool Node::ConnectionInternal::operator==(const Node::ConnectionInternal& rhs) c
 }
 
 void Node::Output::unlink(Input& in) {
+    checkLinkEditable(in);
+    std::lock_guard<std::mutex> lock(linkMtx);
     // Create 'Connection' object between 'out' and 'in'
     Node::ConnectionInternal connection(*this, in);
     if(parent.get().connections.count(connection) == 0) {
@@ -222,54 +285,162 @@ void Node::Output::unlink(Input& in) {
     parent.get().connections.erase(connection);
 
     // Remove the shared_ptr to the input directly for host side
-    connectedInputs.erase(std::remove(connectedInputs.begin(), connectedInputs.end(), &in), connectedInputs.end());
+    removeLink(&in);
     in.connectedOutputs.erase(std::remove(in.connectedOutputs.begin(), in.connectedOutputs.end(), this), in.connectedOutputs.end());
 }
 
+void Node::Output::link(const std::shared_ptr<dai::MessageQueue>& queue) {
+    std::lock_guard<std::mutex> lock(linkMtx);
+    addLink(queue.get());
+    queueConnections.push_back({this, queue});
+}
+
+void Node::Output::unlink(const std::shared_ptr<dai::MessageQueue>& queue) {
+    std::lock_guard<std::mutex> lock(linkMtx);
+    removeLink(queue.get());
+    queueConnections.erase(std::remove(queueConnections.begin(), queueConnections.end(), QueueConnection{this, queue}), queueConnections.end());
+}
+
+void Node::Output::addLink(MessageQueue* queue) {
+    auto links = std::make_shared<Links>(*getLinks());
+    links->push_back({queue, std::make_shared<LinkState>()});
+    std::atomic_store(&connectedInputs, std::shared_ptr<const Links>(std::move(links)));
+}
+
+void Node::Output::removeLink(const MessageQueue* queue) {
+    auto links = std::make_shared<Links>(*getLinks());
+    links->erase(std::remove_if(links->begin(), links->end(), [queue](const Link& link) { return link.queue == queue; }), links->end());
+    std::atomic_store(&connectedInputs, std::shared_ptr<const Links>(std::move(links)));
+}
+
+void Node::Output::notifyWhenReleased(const MessageQueue& queue, std::function<void()> callback) {
+    std::lock_guard<std::mutex> lock(linkMtx);
+    getLinkState(queue)->onReleased = std::move(callback);
+}
+
+std::shared_ptr<const Node::Output::Links> Node::Output::getLinks() const {
+    return std::atomic_load(&connectedInputs);
+}
+
+std::shared_ptr<Node::Output::LinkState> Node::Output::getLinkState(const MessageQueue& queue) const {
+    for(const auto& link : *getLinks()) {
+        if(link.queue == &queue) return link.state;
+    }
+    throw std::logic_error(fmt::format("'{}.{}' not linked to '{}'", getParent().getName(), toString(), queue.getName()));
+}
+
+bool Node::Output::isLinked(const LinkState& state) const {
+    const auto links = getLinks();
+    return std::any_of(links->begin(), links->end(), [&state](const Link& link) { return link.state.get() == &state; });
+}
+
+bool Node::Output::deliver(const Link& link, const std::shared_ptr<ADatatype>& msg, LinkPolicy policy, std::chrono::milliseconds timeout) {
+    using OverflowPolicy = MessageQueue::OverflowPolicy;
+    OverflowPolicy overflow = OverflowPolicy::BLOCK;
+    switch(policy) {
+        case LinkPolicy::QUEUE_DEFAULT:
+        case LinkPolicy::BLOCK:
+        case LinkPolicy::BLOCK_TIMEOUT:
+            overflow = OverflowPolicy::BLOCK;
+            break;
+        case LinkPolicy::DROP_NEWEST:
+            overflow = OverflowPolicy::DROP_NEWEST;
+            break;
+        case LinkPolicy::DROP_OLDEST:
+            overflow = OverflowPolicy::DROP_OLDEST;
+            break;
+        case LinkPolicy::KEEP_LATEST:
+            overflow = OverflowPolicy::KEEP_LATEST;
+            break;
+    }
+    std::size_t dropped = 0;
+    try {
+        dropped = link.queue->sendWithPolicy(msg, overflow, timeout);
+    } catch(const MessageQueue::QueueException&) {
+        // The input was unlinked and closed while this message was being sent to it
+        if(!isLinked(*link.state)) return false;
+        throw;
+    }
+    // Only these discard the new message, the others make space for it
+    const bool delivered = dropped == 0 || (overflow != OverflowPolicy::BLOCK && overflow != OverflowPolicy::DROP_NEWEST);
+    link.state->dropped += dropped;
+    if(delivered) link.state->sent++;
+    return delivered;
+}
+
+bool Node::Output::deliverIfRoom(const Link& link, const std::shared_ptr<ADatatype>& msg) {
+    std::size_t dropped = 0;
+    try {
+        dropped = link.queue->sendWithPolicy(msg, MessageQueue::OverflowPolicy::DROP_NEWEST, std::chrono::milliseconds(0));
+    } catch(const MessageQueue::QueueException&) {
+        // Nothing left to deliver to once the input was unlinked and closed
+        if(!isLinked(*link.state)) return true;
+        throw;
+    }
+    // A full input isn't counted as a drop, the message is delivered later
+    if(dropped > 0) return false;
+    link.state->sent++;
+    return true;
+}
+
 void Node::Output::send(const std::shared_ptr<ADatatype>& msg) {
-    // for(auto& conn : getConnections()) {
-    //     // Get node AND hold a reference to it.
-    //     auto node = conn.inputNode.lock();
-    //     // Safe, as long as we also hold 'node' shared_ptr
-    //     auto inputs = node->getInputRefs();
-    //     // Find the corresponding inputs
-    //     for(auto& input : inputs) {
-    //         if(input->group == conn.inputGroup && input->name == conn.inputName) {
-    //             // Corresponding input to a given connection
-    //             // Send the message
-    //             input->queue.send(msg);
-    //         }
-    //     }
-    // }
-    for(auto& messageQueue : connectedInputs) {
-        messageQueue->send(msg);
+    const auto start = std::chrono::steady_clock::now();
+    const auto remaining = [&start](const Link& link, LinkPolicy policy) {
+        if(policy == LinkPolicy::BLOCK) return std::chrono::milliseconds::max();
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        return std::max(std::chrono::milliseconds(link.state->timeout.load()) - elapsed, std::chrono::milliseconds(0));
+    };
+
+    // Full inputs that make the sender wait are served last, so that a slow consumer doesn't delay delivery to the others
+    const auto links = getLinks();
+    std::vector<std::pair<const Link*, LinkPolicy>> waiting;
+    for(const auto& link : *links) {
+        const auto policy = resolvePolicy(link.state->policy, *link.queue);
+        if(!waitsWhenFull(policy)) {
+            deliver(link, msg, policy, remaining(link, policy));
+        } else if(!deliverIfRoom(link, msg)) {
+            waiting.emplace_back(&link, policy);
+        }
+    }
+    for(const auto& entry : waiting) {
+        deliver(*entry.first, msg, entry.second, remaining(*entry.first, entry.second));
     }
 }
 
 bool Node::Output::trySend(const std::shared_ptr<ADatatype>& msg) {
-    bool success = true;
+    return trySendWithDefault(msg, LinkPolicy::QUEUE_DEFAULT);
+}
 
-    // for(auto& conn : getConnections()) {
-    //     // Get node AND hold a reference to it.
-    //     auto node = conn.inputNode.lock();
-    //     // Safe, as long as we also hold 'node' shared_ptr
-    //     auto inputs = node->getInputRefs();
-    //     // Find the corresponding inputs
-    //     for(auto& input : inputs) {
-    //         if(input->group == conn.inputGroup && input->name == conn.inputName) {
-    //             // Corresponding input to a given connection
-    //             // Send the message
-    //             success &= input->queue.trySend(msg);
-    //         }
-    //     }
-    // }
-    for(auto& messageQueue : connectedInputs) {
-        success &= messageQueue->trySend(msg);
+bool Node::Output::trySendWithDefault(const std::shared_ptr<ADatatype>& msg, LinkPolicy defaultPolicy) {
+    bool success = true;
+    const auto links = getLinks();
+    for(const auto& link : *links) {
+        auto policy = resolvePolicy(link.state->policy, *link.queue, defaultPolicy);
+        // Never waits, discarding the new message instead
+        if(waitsWhenFull(policy)) policy = LinkPolicy::DROP_NEWEST;
+        success &= deliver(link, msg, policy, std::chrono::milliseconds(0));
     }
-
     return success;
 }
 
+void Node::Output::setLinkPolicy(const MessageQueue& in, LinkPolicy policy, std::chrono::milliseconds timeout) {
+    const auto state = getLinkState(in);
+    state->timeout = timeout.count();
+    state->policy = policy;
+}
+
+Node::Output::LinkPolicy Node::Output::getLinkPolicy(const MessageQueue& in) const {
+    return getLinkState(in)->policy;
+}
+
+Node::Output::LinkStats Node::Output::getLinkStats(const MessageQueue& in) const {
+    const auto state = getLinkState(in);
+    LinkStats stats;
+    stats.sent = state->sent;
+    stats.dropped = state->dropped;
+    return stats;
+}
+
 void Node::Input::setWaitForMessage(bool newWaitForMessage) {
     waitForMessage = newWaitForMessage;
 }
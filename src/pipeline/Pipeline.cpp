@@ -8,8 +8,10 @@
 #include "depthai/pipeline/node/internal/XLinkInHost.hpp"
 #include "depthai/pipeline/node/internal/XLinkOut.hpp"
 #include "depthai/pipeline/node/internal/XLinkOutHost.hpp"
+#include "depthai/pipeline/node/host/HostNode.hpp"
 #include "depthai/utility/Initialization.hpp"
 #include "pipeline/datatype/ImgFrame.hpp"
+#include "pipeline/ThreadedNodeImpl.hpp"
 #include "pipeline/node/DetectionNetwork.hpp"
 #include "utility/Compression.hpp"
 #include "utility/Environment.hpp"
@@ -29,6 +31,7 @@
 #include <memory>
 #include <mutex>
 #include <stdexcept>
+#include <thread>
 #include <unordered_set>
 
 // libraries
@@ -91,6 +94,21 @@ std::shared_ptr<Node> PipelineImpl::getNode(Node::Id id) const {
     return nullptr;
 }
 
+namespace {
+
+// Nodes together with all their subnodes
+std::vector<std::shared_ptr<Node>> withSubnodes(const std::vector<std::shared_ptr<Node>>& nodes) {
+    std::vector<std::shared_ptr<Node>> allNodes;
+    for(const auto& node : nodes) {
+        allNodes.push_back(node);
+        auto subnodes = node->getAllNodes();
+        allNodes.insert(allNodes.end(), subnodes.begin(), subnodes.end());
+    }
+    return allNodes;
+}
+
+}  // namespace
+
 std::vector<std::shared_ptr<Node>> PipelineImpl::getAllNodes() const {
     std::vector<std::shared_ptr<Node>> allNodes;
     for(auto& node : nodes) {
@@ -114,6 +132,12 @@ std::vector<std::shared_ptr<Node>> PipelineImpl::getSourceNodes() {
 }
 
 void PipelineImpl::serialize(PipelineSchema& schema, Assets& assets, std::vector<std::uint8_t>& assetStorage, SerializationType type) const {
+    AssetScatterList scatterList;
+    serialize(schema, assets, scatterList, type);
+    assetStorage = scatterList.toVector();
+}
+
+void PipelineImpl::serialize(PipelineSchema& schema, Assets& assets, AssetScatterList& assetStorage, SerializationType type) const {
     // Set schema
     schema = getPipelineSchema(type);
 
@@ -371,6 +395,10 @@ BoardConfig PipelineImpl::getBoardConfig() const {
 
 // Remove node capability
 void PipelineImpl::remove(std::shared_ptr<Node> toRemove) {
+    if(isRunning()) {
+        removeWhileRunning(toRemove);
+        return;
+    }
     DAI_CHECK_V(!isBuilt(), "Cannot remove node from pipeline once it is built.");
     DAI_CHECK_V(toRemove->parent.lock() != nullptr, "Cannot remove a node that is not a part of any pipeline");
     DAI_CHECK_V(toRemove->parent.lock() == parent.pimpl, "Cannot remove a node that is not a part of this pipeline");
@@ -481,6 +509,7 @@ void PipelineImpl::add(std::shared_ptr<Node> node) {
     if(node == nullptr) {
         throw std::invalid_argument(fmt::format("Given node pointer is null"));
     }
+    std::lock_guard<std::recursive_mutex> lock(stateMtx);
 
     // First check if node has already been added
     auto localNodes = getAllNodes();
@@ -523,6 +552,9 @@ void PipelineImpl::add(std::shared_ptr<Node> node) {
 
     // Add to the map (node holds its children itself)
     nodes.push_back(node);
+    if(isRunning()) {
+        pendingNodes.push_back(node);
+    }
 }
 
 bool PipelineImpl::isRunning() const {
@@ -774,6 +806,10 @@ void PipelineImpl::build() {
             }
         }
     }
+    if(hostNodeFusion) {
+        fuseHostNodes();
+    }
+
     // Build
     if(!isHostOnly()) {
         // TODO(Morato) - handle multiple devices correctly, start pipeline on all of them
@@ -781,8 +817,58 @@ void PipelineImpl::build() {
     }
 }
 
+void PipelineImpl::fuseHostNodes() {
+    // Host nodes whose processing can be called from the thread of another node
+    const auto asFusable = [](Node& node) -> node::HostNode* {
+        auto* hostNode = dynamic_cast<node::HostNode*>(&node);
+        if(hostNode == nullptr || hostNode->sendProcessToPipeline) return nullptr;
+        return hostNode;
+    };
+
+    for(const auto& node : getAllNodes()) {
+        auto* consumer = asFusable(*node);
+        if(consumer == nullptr || consumer->maxBatchSize != 1 || !consumer->sync->runOnHost() || consumer->inputs.size() != 1) continue;
+        auto& in = consumer->inputs.begin()->second;
+        if(in.connectedOutputs.size() != 1) continue;
+        auto* output = in.connectedOutputs.front();
+        auto* producer = asFusable(output->getParent());
+        if(producer == nullptr || output != &producer->out || producer->out.getLinks()->size() != 1 || !producer->out.getQueueConnections().empty()) continue;
+
+        // A cycle of fused nodes would have no thread left to run it
+        bool cycle = false;
+        for(auto* previous = producer; previous != nullptr; previous = previous->fusedPrevious) {
+            if(previous == consumer) {
+                cycle = true;
+                break;
+            }
+        }
+        if(cycle) continue;
+
+        // The producer calls the consumer directly, neither the consumer nor its sync node run a thread
+        producer->out.unlink(in);
+        producer->fusedNext = consumer;
+        consumer->fusedPrevious = producer;
+        consumer->fusedInputName = consumer->inputs.begin()->first.second;
+        consumer->pimpl->ownThread = false;
+        consumer->sync->pimpl->ownThread = false;
+        fusedNodes.insert(producer);
+        fusedNodes.insert(consumer);
+        fusedNodes.insert(&*consumer->sync);
+        Logging::getInstance().logger.debug("Host node '{}' fused into the thread of '{}'", consumer->getName(), producer->getName());
+    }
+}
+
+bool PipelineImpl::isFused(const Node& node) const {
+    return fusedNodes.count(&node) > 0;
+}
+
 void PipelineImpl::start() {
-    std::lock_guard<std::mutex> lock(stateMtx);
+    std::lock_guard<std::recursive_mutex> lock(stateMtx);
+    if(running) {
+        releaseRetiredNodes();
+        startPendingNodes();
+        return;
+    }
     // TODO(themarpe) - add mutex and set running up ahead
 
     // TODO(Morato) - add back in when more nodes are tested
@@ -850,20 +936,25 @@ void PipelineImpl::wait() {
 }
 
 void PipelineImpl::stop() {
-    std::lock_guard<std::mutex> lock(stateMtx);
+    std::lock_guard<std::recursive_mutex> lock(stateMtx);
     if(!running) {
         return;
     }
-    // Stops the pipeline execution
+    // Stops the pipeline execution, nodes added since the start were never started
+    const auto pending = withSubnodes(pendingNodes);
+    pendingNodes.clear();
     for(const auto& node : getAllNodes()) {
-        if(node->runOnHost()) {
+        if(node->runOnHost() && std::find(pending.begin(), pending.end(), node) == pending.end()) {
             node->stop();
         }
     }
 
     // Close all the output queues
-    for(auto& queue : outputQueues) {
-        queue->close();
+    {
+        std::lock_guard<std::mutex> queuesLock(outputQueuesMtx);
+        for(auto& queue : outputQueues) {
+            queue->close();
+        }
     }
 
     // Close the task queue
@@ -878,6 +969,186 @@ void PipelineImpl::stop() {
     running = false;
 }
 
+void PipelineImpl::startPendingNodes() {
+    // Building may add further nodes
+    while(!pendingNodes.empty()) {
+        const auto added = pendingNodes;
+        const auto addedNodes = withSubnodes(added);
+        const auto forget = [this, &added]() {
+            for(const auto& node : added) {
+                pendingNodes.erase(std::remove(pendingNodes.begin(), pendingNodes.end(), node), pendingNodes.end());
+            }
+        };
+        try {
+            for(const auto& node : addedNodes) {
+                node->buildStage1();
+            }
+            for(const auto& node : addedNodes) {
+                node->buildStage2();
+            }
+            for(const auto& node : addedNodes) {
+                node->buildStage3();
+            }
+            for(const auto& node : addedNodes) {
+                if(!node->runOnHost()) {
+                    throw std::runtime_error(fmt::format("Cannot start device node '{}' on a running pipeline, only host nodes can be added", node->getName()));
+                }
+            }
+        } catch(const std::exception&) {
+            unlinkFromOthers(addedNodes);
+            forget();
+            for(const auto& node : added) {
+                nodes.erase(std::remove(nodes.begin(), nodes.end(), node), nodes.end());
+            }
+            throw;
+        }
+        forget();
+        for(const auto& node : addedNodes) {
+            node->start();
+        }
+    }
+}
+
+void PipelineImpl::unlinkFromOthers(const std::vector<std::shared_ptr<Node>>& group) {
+    const auto inGroup = [&group](const Node& node) {
+        return std::any_of(group.begin(), group.end(), [&node](const std::shared_ptr<Node>& n) { return n.get() == &node; });
+    };
+    for(const auto& node : group) {
+        for(auto* input : node->getInputRefs()) {
+            const auto outputs = input->connectedOutputs;
+            for(auto* output : outputs) {
+                if(!inGroup(output->getParent())) output->unlink(*input);
+            }
+        }
+        for(auto* output : node->getOutputRefs()) {
+            for(const auto& connection : output->getConnections()) {
+                if(!inGroup(connection.in->getParent())) output->unlink(*connection.in);
+            }
+            for(const auto& queueConnection : output->getQueueConnections()) {
+                output->unlink(queueConnection.queue);
+            }
+        }
+    }
+}
+
+bool PipelineImpl::isPending(const Node& node) const {
+    std::lock_guard<std::recursive_mutex> lock(stateMtx);
+    for(const auto& pending : withSubnodes(pendingNodes)) {
+        if(pending.get() == &node) return true;
+    }
+    return false;
+}
+
+void PipelineImpl::removeWhileRunning(const std::shared_ptr<Node>& toRemove) {
+    // Time the removed nodes get to process the messages already sent to them
+    constexpr auto DRAIN_TIMEOUT = std::chrono::seconds(1);
+
+    std::unique_lock<std::recursive_mutex> lock(stateMtx);
+    releaseRetiredNodes();
+    DAI_CHECK_V(std::find(nodes.begin(), nodes.end(), toRemove) != nodes.end(), "Only nodes added directly to the pipeline can be removed while it's running");
+    DAI_CHECK_V(removingNodes.count(toRemove.get()) == 0, "Node '{}' is already being removed", toRemove->getName());
+    const auto removed = withSubnodes({toRemove});
+    // Nodes added since the start aren't built or started yet
+    const bool started = std::find(pendingNodes.begin(), pendingNodes.end(), toRemove) == pendingNodes.end();
+    for(const auto& node : removed) {
+        DAI_CHECK_V(!started || node->runOnHost(), "Cannot remove device node '{}' while the pipeline is running", node->getName());
+        DAI_CHECK_V(!isFused(*node), "Cannot remove fused host node '{}' while the pipeline is running", node->getName());
+    }
+    const auto isRemoved = [&removed](const Node& node) {
+        return std::any_of(removed.begin(), removed.end(), [&node](const std::shared_ptr<Node>& n) { return n.get() == &node; });
+    };
+
+    // Stop new messages from reaching the removed nodes. Messages being sent already hold the previous links
+    auto heldLinks = std::make_shared<HeldLinks>();
+    for(const auto& node : removed) {
+        for(auto* input : node->getInputRefs()) {
+            const auto outputs = input->connectedOutputs;
+            for(auto* output : outputs) {
+                if(isRemoved(output->getParent())) continue;
+                {
+                    std::lock_guard<std::mutex> heldLock(heldLinks->mtx);
+                    heldLinks->count++;
+                }
+                output->notifyWhenReleased(*input, [heldLinks]() {
+                    std::lock_guard<std::mutex> heldLock(heldLinks->mtx);
+                    heldLinks->count--;
+                    heldLinks->released.notify_all();
+                });
+                output->unlink(*input);
+            }
+        }
+    }
+    std::vector<std::shared_ptr<MessageQueue>> removedQueues;
+    for(const auto& node : removed) {
+        for(auto* output : node->getOutputRefs()) {
+            for(const auto& queueConnection : output->getQueueConnections()) {
+                removedQueues.push_back(queueConnection.queue);
+            }
+        }
+    }
+
+    if(started) {
+        // Waiting doesn't hold up other changes of the pipeline
+        removingNodes.insert(toRemove.get());
+        lock.unlock();
+
+        // Let the removed nodes process the messages already sent to them
+        const auto deadline = std::chrono::steady_clock::now() + DRAIN_TIMEOUT;
+        {
+            std::unique_lock<std::mutex> heldLock(heldLinks->mtx);
+            heldLinks->released.wait_until(heldLock, deadline, [&heldLinks]() { return heldLinks->count == 0; });
+        }
+        for(const auto& node : removed) {
+            for(auto* input : node->getInputRefs()) {
+                const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+                input->waitEmpty(std::max(remaining, std::chrono::milliseconds(0)));
+            }
+        }
+
+        // Stop the removed nodes, the messages they are still sending are delivered
+        for(const auto& node : removed) {
+            node->stop();
+        }
+        // Nobody receives from these anymore, closing them also releases a removed node waiting on one
+        for(const auto& queue : removedQueues) {
+            queue->close();
+        }
+        for(const auto& node : removed) {
+            node->wait();
+        }
+
+        lock.lock();
+        removingNodes.erase(toRemove.get());
+    }
+
+    unlinkFromOthers(removed);
+    pendingNodes.erase(std::remove(pendingNodes.begin(), pendingNodes.end(), toRemove), pendingNodes.end());
+    {
+        std::lock_guard<std::mutex> queuesLock(outputQueuesMtx);
+        for(const auto& queue : removedQueues) {
+            outputQueues.erase(std::remove(outputQueues.begin(), outputQueues.end(), queue), outputQueues.end());
+        }
+    }
+    nodes.erase(std::remove(nodes.begin(), nodes.end(), toRemove), nodes.end());
+
+    std::lock_guard<std::mutex> heldLock(heldLinks->mtx);
+    if(heldLinks->count > 0) {
+        // A sender still holds the links to the removed inputs, so the nodes are kept alive until it lets go
+        Logging::getInstance().logger.warn("Node '{}' was removed while messages were still being sent to it", toRemove->getName());
+        retiredNodes.push_back({toRemove, heldLinks});
+    }
+}
+
+void PipelineImpl::releaseRetiredNodes() {
+    retiredNodes.erase(std::remove_if(retiredNodes.begin(),
+                                      retiredNodes.end(),
+                                      [](const RetiredNode& retired) {
+                                          std::lock_guard<std::mutex> heldLock(retired.links->mtx);
+                                          return retired.links->count == 0;
+                                      }),
+                       retiredNodes.end());
+}
+
 PipelineImpl::~PipelineImpl() {
     stop();
     wait();
@@ -1007,6 +1278,23 @@ std::vector<uint8_t> PipelineImpl::loadResourceCwd(fs::path uri, fs::path cwd, b
     throw std::invalid_argument(fmt::format("No handler specified for following ({}) URI", uri));
 }
 
+void Pipeline::setHostNodeFusion(bool fuse) {
+    if(this->isBuilt()) {
+        throw std::runtime_error("Cannot change host node fusion once pipeline is built");
+    }
+    impl()->hostNodeFusion = fuse;
+}
+
+void Pipeline::setClock(std::shared_ptr<PipelineClock> clock) {
+    if(clock == nullptr) {
+        throw std::invalid_argument("Pipeline clock can't be null");
+    }
+    if(this->isRunning()) {
+        throw std::runtime_error("Cannot change the clock while pipeline is running");
+    }
+    impl()->clock = std::move(clock);
+}
+
 // Record and Replay
 void Pipeline::enableHolisticRecord(const RecordConfig& config) {
     if(this->isRunning()) {
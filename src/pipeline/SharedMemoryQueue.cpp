@@ -0,0 +1,522 @@
+#include "depthai/pipeline/SharedMemoryQueue.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#if defined(__unix__) && !defined(__APPLE__)
+    #include <fcntl.h>
+    #include <pthread.h>
+    #include <signal.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <time.h>
+    #include <unistd.h>
+#endif
+
+// project
+#include "depthai/pipeline/datatype/StreamMessageParser.hpp"
+#include "depthai/utility/Memory.hpp"
+#include "utility/Logging.hpp"
+
+namespace dai {
+
+// Endpoints wake up this often to notice being closed or the other end being gone
+constexpr std::chrono::milliseconds POLL_INTERVAL{100};
+// Time the sender keeps sending the messages already in its queue once closed
+constexpr std::chrono::milliseconds CLOSE_DRAIN_TIMEOUT{1000};
+
+#if defined(__unix__) && !defined(__APPLE__)
+
+namespace {
+
+constexpr std::uint32_t RING_MAGIC = 0x44414951;  // "DAIQ"
+constexpr std::uint32_t RING_VERSION = 3;
+
+enum SlotState : std::uint32_t { SLOT_FREE = 0, SLOT_WRITING, SLOT_WRITTEN, SLOT_READING };
+
+// Layout of the start of the shared memory, followed by the slots
+struct RingHeader {
+    std::atomic<std::uint32_t> magic;
+    std::uint32_t version;
+    std::uint64_t numSlots;
+    std::uint64_t slotSize;
+    std::uint64_t slotStride;
+    pthread_mutex_t mutex;
+    pthread_cond_t changed;
+    std::uint64_t writeIndex;
+    std::uint64_t readIndex;
+    std::uint32_t closed;
+    // Process of the sender, which doesn't set closed if it dies
+    std::int32_t senderPid;
+    // Receiver attached to the ring, 0 before the first one attaches
+    std::int32_t receiverPid;
+    std::uint32_t receiverClosed;
+};
+
+struct SlotHeader {
+    std::uint32_t state;
+    std::uint32_t metadataSize;
+    std::uint64_t dataSize;
+};
+
+constexpr std::size_t align64(std::size_t size) {
+    return (size + 63) & ~static_cast<std::size_t>(63);
+}
+
+std::string shmName(const std::string& name) {
+    return name.empty() || name[0] != '/' ? "/" + name : name;
+}
+
+std::runtime_error systemError(const std::string& what) {
+    return std::runtime_error(fmt::format("SharedMemoryQueue: {} - {}", what, std::strerror(errno)));
+}
+
+bool isProcessAlive(pid_t pid) {
+    return kill(pid, 0) == 0 || errno == EPERM;
+}
+
+// A receiver that closed or died won't release its slots nor take new messages. Before one attaches, the ring fills up.
+bool isReceiverGone(const RingHeader& header) {
+    return header.receiverClosed != 0 || (header.receiverPid != 0 && !isProcessAlive(header.receiverPid));
+}
+
+timespec deadlineIn(std::chrono::steady_clock::duration timeout) {
+    timespec now{};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count();
+    const auto total = static_cast<std::int64_t>(now.tv_nsec) + ns % 1000000000;
+    timespec deadline{};
+    deadline.tv_sec = now.tv_sec + static_cast<time_t>(ns / 1000000000 + total / 1000000000);
+    deadline.tv_nsec = static_cast<long>(total % 1000000000);
+    return deadline;
+}
+
+}  // namespace
+
+/**
+ * Mapping of the shared memory, kept alive by the endpoints and by the received messages which reference its slots
+ */
+class SharedMemoryRing {
+   public:
+    SharedMemoryRing(void* base, std::size_t size) : base(static_cast<std::uint8_t*>(base)), size(size) {}
+    ~SharedMemoryRing() {
+        munmap(base, size);
+    }
+
+    RingHeader& header() {
+        return *reinterpret_cast<RingHeader*>(base);
+    }
+    SlotHeader& slot(std::uint64_t index) {
+        return *reinterpret_cast<SlotHeader*>(base + align64(sizeof(RingHeader)) + (index % header().numSlots) * header().slotStride);
+    }
+    std::uint8_t* slotData(std::uint64_t index) {
+        return reinterpret_cast<std::uint8_t*>(&slot(index)) + align64(sizeof(SlotHeader));
+    }
+
+    // Locks the mutex shared with the other process, recovering it if that process died holding it
+    class Lock {
+       public:
+        explicit Lock(SharedMemoryRing& ring) : mutex(&ring.header().mutex) {
+            const int result = pthread_mutex_lock(mutex);
+            if(result == EOWNERDEAD) {
+                pthread_mutex_consistent(mutex);
+            } else if(result != 0) {
+                throw std::runtime_error(fmt::format("SharedMemoryQueue: failed to lock the ring - {}", std::strerror(result)));
+            }
+        }
+        ~Lock() {
+            pthread_mutex_unlock(mutex);
+        }
+        Lock(const Lock&) = delete;
+        Lock& operator=(const Lock&) = delete;
+
+        // Waits for a change of the ring, false once the deadline passed
+        bool wait(SharedMemoryRing& ring, const timespec& deadline) {
+            const int result = pthread_cond_timedwait(&ring.header().changed, mutex, &deadline);
+            if(result == EOWNERDEAD) pthread_mutex_consistent(mutex);
+            return result != ETIMEDOUT;
+        }
+
+       private:
+        pthread_mutex_t* mutex;
+    };
+
+    void notify() {
+        pthread_cond_broadcast(&header().changed);
+    }
+
+    // Called from the destructor of received messages, so it doesn't throw
+    void release(std::uint64_t index) noexcept {
+        try {
+            Lock lock(*this);
+            slot(index).state = SLOT_FREE;
+        } catch(const std::exception& ex) {
+            logger::error("SharedMemoryQueue couldn't release a slot - {}", ex.what());
+            return;
+        }
+        notify();
+    }
+
+   private:
+    std::uint8_t* base;
+    std::size_t size;
+};
+
+namespace {
+
+// Payload of a received message, the slot is released together with it
+class SlotMemory : public Memory {
+   public:
+    SlotMemory(std::shared_ptr<SharedMemoryRing> ring, std::uint64_t index, std::size_t size)
+        : ring(std::move(ring)), index(index), data(this->ring->slotData(index)), size(size), maxSize(this->ring->header().slotSize) {}
+    ~SlotMemory() override {
+        ring->release(index);
+    }
+
+    span<std::uint8_t> getData() override {
+        return {data, size};
+    }
+    span<const std::uint8_t> getData() const override {
+        return {data, size};
+    }
+    std::size_t getMaxSize() const override {
+        return maxSize;
+    }
+    std::size_t getOffset() const override {
+        return 0;
+    }
+    void setSize(std::size_t newSize) override {
+        if(newSize > maxSize) throw std::invalid_argument("Shared memory slot too small for the given size");
+        size = newSize;
+    }
+
+   private:
+    std::shared_ptr<SharedMemoryRing> ring;
+    std::uint64_t index;
+    std::uint8_t* data;
+    std::size_t size;
+    std::size_t maxSize;
+};
+
+}  // namespace
+
+SharedMemoryQueueSender::SharedMemoryQueueSender(const std::string& name, std::size_t numSlots, std::size_t slotSize) : name(shmName(name)) {
+    if(numSlots == 0 || slotSize == 0) throw std::invalid_argument("SharedMemoryQueue requires at least one slot of non zero size");
+    const std::size_t slotStride = align64(sizeof(SlotHeader)) + align64(slotSize);
+    const std::size_t size = align64(sizeof(RingHeader)) + numSlots * slotStride;
+
+    const int fd = shm_open(this->name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if(fd < 0) throw systemError(fmt::format("couldn't create '{}'", this->name));
+    if(ftruncate(fd, static_cast<off_t>(size)) < 0) {
+        auto error = systemError(fmt::format("couldn't size '{}' to {} bytes", this->name, size));
+        ::close(fd);
+        shm_unlink(this->name.c_str());
+        throw error;
+    }
+    void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(base == MAP_FAILED) {
+        auto error = systemError(fmt::format("couldn't map '{}'", this->name));
+        shm_unlink(this->name.c_str());
+        throw error;
+    }
+    ring = std::make_shared<SharedMemoryRing>(base, size);
+
+    // The memory is zeroed, so all slots start out free
+    auto& header = ring->header();
+    header.version = RING_VERSION;
+    header.numSlots = numSlots;
+    header.slotSize = slotSize;
+    header.slotStride = slotStride;
+    header.senderPid = getpid();
+    pthread_mutexattr_t mutexAttr;
+    pthread_mutexattr_init(&mutexAttr);
+    pthread_mutexattr_setpshared(&mutexAttr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&mutexAttr, PTHREAD_MUTEX_ROBUST);
+    pthread_mutex_init(&header.mutex, &mutexAttr);
+    pthread_mutexattr_destroy(&mutexAttr);
+    pthread_condattr_t condAttr;
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setpshared(&condAttr, PTHREAD_PROCESS_SHARED);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    pthread_cond_init(&header.changed, &condAttr);
+    pthread_condattr_destroy(&condAttr);
+    // Receivers wait for the magic before touching the ring
+    header.magic.store(RING_MAGIC, std::memory_order_release);
+
+    queue = std::make_shared<MessageQueue>(this->name, 4, true);
+    forwarder = std::thread(&SharedMemoryQueueSender::forwardThread, this);
+}
+
+bool SharedMemoryQueueSender::send(const std::shared_ptr<ADatatype>& msg, std::chrono::milliseconds timeout) {
+    if(!msg) throw std::invalid_argument("Message passed is not valid (nullptr)");
+    if(closed) throw MessageQueue::QueueException("SharedMemoryQueue is closed");
+    return write(msg, timeout);
+}
+
+bool SharedMemoryQueueSender::write(const std::shared_ptr<ADatatype>& msg, std::chrono::milliseconds timeout) {
+    const auto metadata = StreamMessageParser::serializeMetadata(*msg);
+    span<const std::uint8_t> data;
+    if(msg->data) data = static_cast<const Memory&>(*msg->data).getData();
+    const auto slotSize = ring->header().slotSize;
+    if(data.size() + metadata.size() > slotSize) {
+        throw std::runtime_error(
+            fmt::format("SharedMemoryQueue: message of {} bytes doesn't fit into a slot of {} bytes", data.size() + metadata.size(), slotSize));
+    }
+
+    // Claims the next slot, once the receiver released it
+    constexpr std::chrono::hours FOREVER{24 * 365};
+    const auto deadline = std::chrono::steady_clock::now() + (timeout < FOREVER ? std::chrono::steady_clock::duration(timeout) : FOREVER);
+    std::uint64_t index = 0;
+    {
+        SharedMemoryRing::Lock lock(*ring);
+        auto& header = ring->header();
+        while(true) {
+            if(isReceiverGone(header)) throw MessageQueue::QueueException("SharedMemoryQueue receiver is gone");
+            if(ring->slot(header.writeIndex).state == SLOT_FREE) break;
+            const auto now = std::chrono::steady_clock::now();
+            // Once closed, only until the messages accepted before had their time to drain
+            if(now >= deadline || (draining && now >= drainDeadline)) return false;
+            // Wakes up regularly, a receiver that died doesn't notify
+            lock.wait(*ring, deadlineIn(std::min<std::chrono::steady_clock::duration>(deadline - now, POLL_INTERVAL)));
+        }
+        index = header.writeIndex++;
+        ring->slot(index).state = SLOT_WRITING;
+    }
+
+    // Copied outside of the lock, the receiver keeps going through the written slots meanwhile
+    auto& slot = ring->slot(index);
+    auto* slotData = ring->slotData(index);
+    if(!data.empty()) std::memcpy(slotData, data.data(), data.size());
+    std::memcpy(slotData + data.size(), metadata.data(), metadata.size());
+    {
+        SharedMemoryRing::Lock lock(*ring);
+        slot.dataSize = data.size();
+        slot.metadataSize = static_cast<std::uint32_t>(metadata.size());
+        slot.state = SLOT_WRITTEN;
+    }
+    ring->notify();
+    return true;
+}
+
+std::shared_ptr<MessageQueue> SharedMemoryQueueSender::getQueue() {
+    return queue;
+}
+
+void SharedMemoryQueueSender::forwardThread() {
+    while(true) {
+        std::shared_ptr<ADatatype> msg;
+        try {
+            if(draining) {
+                // Closing, done once the queue is empty
+                msg = queue->tryGet();
+                if(!msg) return;
+            } else {
+                bool timedOut = false;
+                msg = queue->get(POLL_INTERVAL, timedOut);
+                if(timedOut) continue;
+            }
+        } catch(const MessageQueue::QueueException&) {
+            return;
+        }
+        try {
+            if(!write(msg, std::chrono::milliseconds::max())) {
+                logger::warn("SharedMemoryQueue '{}' closed before the receiver took all queued messages", name);
+                return;
+            }
+        } catch(const MessageQueue::QueueException& ex) {
+            logger::warn("SharedMemoryQueue '{}' dropped the queued messages - {}", name, ex.what());
+            return;
+        } catch(const std::exception& ex) {
+            logger::error("SharedMemoryQueue '{}' dropped a message - {}", name, ex.what());
+        }
+    }
+}
+
+void SharedMemoryQueueSender::close() {
+    if(closed.exchange(true)) return;
+    // The messages already accepted by the queue are sent first
+    drainDeadline = std::chrono::steady_clock::now() + CLOSE_DRAIN_TIMEOUT;
+    draining = true;
+    if(forwarder.joinable()) forwarder.join();
+    queue->close();
+    {
+        SharedMemoryRing::Lock lock(*ring);
+        ring->header().closed = 1;
+    }
+    ring->notify();
+    if(forwarder.joinable()) forwarder.join();
+    shm_unlink(name.c_str());
+}
+
+bool SharedMemoryQueueSender::isClosed() const {
+    return closed;
+}
+
+SharedMemoryQueueSender::~SharedMemoryQueueSender() {
+    close();
+}
+
+SharedMemoryQueueReceiver::SharedMemoryQueueReceiver(const std::string& name, unsigned int maxSize, std::chrono::milliseconds timeout) {
+    const auto path = shmName(name);
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    // The sender may not have created or initialized the ring yet
+    while(true) {
+        const int fd = shm_open(path.c_str(), O_RDWR, 0);
+        if(fd >= 0) {
+            struct stat stats {};
+            if(fstat(fd, &stats) == 0 && static_cast<std::size_t>(stats.st_size) >= sizeof(RingHeader)) {
+                void* base = mmap(nullptr, stats.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                ::close(fd);
+                if(base == MAP_FAILED) throw systemError(fmt::format("couldn't map '{}'", path));
+                auto mapped = std::make_shared<SharedMemoryRing>(base, stats.st_size);
+                if(mapped->header().magic.load(std::memory_order_acquire) == RING_MAGIC) {
+                    if(mapped->header().version != RING_VERSION) {
+                        throw std::runtime_error(fmt::format("SharedMemoryQueue: '{}' has version {}, expected {}", path, mapped->header().version, RING_VERSION));
+                    }
+                    ring = std::move(mapped);
+                    attach(path);
+                    break;
+                }
+            } else {
+                ::close(fd);
+            }
+        } else if(errno != ENOENT) {
+            throw systemError(fmt::format("couldn't open '{}'", path));
+        }
+        if(std::chrono::steady_clock::now() > deadline) {
+            throw std::runtime_error(fmt::format("SharedMemoryQueue: '{}' wasn't created by a sender in time", path));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    queue = std::make_shared<MessageQueue>(path, maxSize, true);
+    receiver = std::thread(&SharedMemoryQueueReceiver::receiveThread, this);
+}
+
+void SharedMemoryQueueReceiver::attach(const std::string& path) {
+    {
+        SharedMemoryRing::Lock lock(*ring);
+        auto& header = ring->header();
+        if(header.receiverPid != 0 && !isReceiverGone(header)) {
+            throw std::runtime_error(fmt::format("SharedMemoryQueue: '{}' already has a receiver, process {}", path, header.receiverPid));
+        }
+        // Slots held by the messages of a receiver that died would never be released. Those of one that closed are, once its messages are gone.
+        if(header.receiverPid != 0 && !isProcessAlive(header.receiverPid)) {
+            for(std::uint64_t i = 0; i < header.numSlots; i++) {
+                if(ring->slot(i).state == SLOT_READING) ring->slot(i).state = SLOT_FREE;
+            }
+        }
+        header.receiverPid = getpid();
+        header.receiverClosed = 0;
+    }
+    ring->notify();
+}
+
+void SharedMemoryQueueReceiver::receiveThread() {
+    auto& header = ring->header();
+    while(running) {
+        std::uint64_t index = 0;
+        {
+            SharedMemoryRing::Lock lock(*ring);
+            while(running && ring->slot(header.readIndex).state != SLOT_WRITTEN) {
+                // Written slots are still received after the sender closed or died
+                if(header.closed || !isProcessAlive(header.senderPid)) {
+                    running = false;
+                    break;
+                }
+                lock.wait(*ring, deadlineIn(POLL_INTERVAL));
+            }
+            if(!running) break;
+            index = header.readIndex++;
+            ring->slot(index).state = SLOT_READING;
+        }
+
+        const auto& slot = ring->slot(index);
+        std::shared_ptr<ADatatype> msg;
+        try {
+            streamPacketDesc_t packet{};
+            packet.data = ring->slotData(index) + slot.dataSize;
+            packet.length = slot.metadataSize;
+            packet.fd = -1;
+            msg = StreamMessageParser::parseMessage(&packet);
+            msg->data = std::make_shared<SlotMemory>(ring, index, slot.dataSize);
+        } catch(const std::exception& ex) {
+            logger::error("SharedMemoryQueue dropped a message which couldn't be parsed - {}", ex.what());
+            ring->release(index);
+            continue;
+        }
+        try {
+            queue->send(msg);
+        } catch(const MessageQueue::QueueException&) {
+            break;
+        }
+    }
+    running = false;
+    // Messages already received are taken before the queue closes, closing the receiver ends the wait
+    while(!closed && !queue->waitEmpty(POLL_INTERVAL)) {
+    }
+    queue->close();
+}
+
+std::shared_ptr<MessageQueue> SharedMemoryQueueReceiver::getQueue() {
+    return queue;
+}
+
+void SharedMemoryQueueReceiver::close() {
+    if(closed.exchange(true)) return;
+    running = false;
+    queue->close();
+    {
+        // The sender stops waiting for slots
+        SharedMemoryRing::Lock lock(*ring);
+        if(ring->header().receiverPid == getpid()) ring->header().receiverClosed = 1;
+    }
+    ring->notify();
+    if(receiver.joinable()) receiver.join();
+}
+
+SharedMemoryQueueReceiver::~SharedMemoryQueueReceiver() {
+    close();
+}
+
+#else
+
+class SharedMemoryRing {};
+
+SharedMemoryQueueSender::SharedMemoryQueueSender(const std::string&, std::size_t, std::size_t) {
+    throw std::runtime_error("SharedMemoryQueue is only supported on Linux");
+}
+SharedMemoryQueueSender::~SharedMemoryQueueSender() = default;
+bool SharedMemoryQueueSender::send(const std::shared_ptr<ADatatype>&, std::chrono::milliseconds) {
+    return false;
+}
+std::shared_ptr<MessageQueue> SharedMemoryQueueSender::getQueue() {
+    return queue;
+}
+bool SharedMemoryQueueSender::write(const std::shared_ptr<ADatatype>&, std::chrono::milliseconds) {
+    return false;
+}
+void SharedMemoryQueueSender::forwardThread() {}
+void SharedMemoryQueueSender::close() {}
+bool SharedMemoryQueueSender::isClosed() const {
+    return true;
+}
+
+SharedMemoryQueueReceiver::SharedMemoryQueueReceiver(const std::string&, unsigned int, std::chrono::milliseconds) {
+    throw std::runtime_error("SharedMemoryQueue is only supported on Linux");
+}
+SharedMemoryQueueReceiver::~SharedMemoryQueueReceiver() = default;
+std::shared_ptr<MessageQueue> SharedMemoryQueueReceiver::getQueue() {
+    return queue;
+}
+void SharedMemoryQueueReceiver::attach(const std::string&) {}
+void SharedMemoryQueueReceiver::receiveThread() {}
+void SharedMemoryQueueReceiver::close() {}
+
+#endif
+
+}  // namespace dai
@@ -2,9 +2,11 @@
 
 #include <spdlog/spdlog.h>
 
+#include "depthai/pipeline/Pipeline.hpp"
 #include "pipeline/ThreadedNodeImpl.hpp"
 #include "utility/Environment.hpp"
 #include "utility/ErrorMacros.hpp"
+#include "utility/LogSinks.hpp"
 #include "utility/Logging.hpp"
 #include "utility/Platform.hpp"
 
@@ -28,9 +30,14 @@ void ThreadedNode::start() {
     DAI_CHECK_V(!isRunning(), "Node with id {} is already running. Cannot start it again. Node name: {}", id, getName());
 
     onStart();
+    // Named after the node from here on, the name isn't known yet when the node is constructed
+    const auto nodeName = fmt::format("{}({})", getName(), id);
+    pimpl->logger = std::static_pointer_cast<spdlog::async_logger>(pimpl->logger->clone(nodeName));
     // Start the thread
     running = true;
-    thread = std::thread([this]() {
+    if(!pimpl->ownThread) return;
+    thread = std::thread([this, nodeName]() {
+        LogContext::Scope nodeScope("node", nodeName);
         try {
             run();
         } catch(const MessageQueue::QueueException& ex) {
@@ -53,7 +60,7 @@ void ThreadedNode::start() {
             stopPipeline();
         }
     });
-    platform::setThreadName(thread, fmt::format("{}({})", getName(), id));
+    platform::setThreadName(thread, nodeName);
 }
 
 void ThreadedNode::wait() {
@@ -82,6 +89,14 @@ dai::LogLevel ThreadedNode::getLogLevel() const {
     return spdlogLevelToLogLevel(pimpl->logger->level(), LogLevel::WARN);
 }
 
+std::shared_ptr<PipelineClock> ThreadedNode::getClock() const {
+    auto pipeline = parent.lock();
+    if(pipeline == nullptr) {
+        return PipelineClock::steady();
+    }
+    return Pipeline(pipeline).getClock();
+}
+
 bool ThreadedNode::isRunning() const {
     return running;
 }
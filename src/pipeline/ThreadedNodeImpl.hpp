@@ -5,12 +5,16 @@
 #include <spdlog/spdlog.h>
 
 #include "depthai/pipeline/ThreadedNode.hpp"
+#include "utility/Logging.hpp"
 
 namespace dai {
 class ThreadedNode::Impl {
    public:
     static inline std::shared_ptr<spdlog::details::thread_pool> threadPool = std::make_shared<spdlog::details::thread_pool>(8192, 1);
-    std::shared_ptr<spdlog::async_logger> logger =
-        std::make_shared<spdlog::async_logger>("ThreadedNode", std::make_shared<spdlog::sinks::stdout_color_sink_mt>(), threadPool);
+    // Shares the sinks of the library logger, so node messages go through the same rate limiting and structured output
+    std::shared_ptr<spdlog::async_logger> logger = std::make_shared<spdlog::async_logger>(
+        "ThreadedNode", Logging::getInstance().logger.sinks().begin(), Logging::getInstance().logger.sinks().end(), threadPool);
+    // Cleared for nodes started and stopped without a thread of their own, like input queues and nodes fused into the thread of another node
+    bool ownThread = true;
 };
 }  // namespace dai
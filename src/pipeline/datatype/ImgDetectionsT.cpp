@@ -3,7 +3,9 @@
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include <limits>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "depthai/pipeline/datatype/ImgDetections.hpp"
@@ -11,6 +13,11 @@
 
 namespace dai {
 
+namespace {
+// Mask value of pixels not belonging to any instance
+constexpr std::uint8_t BACKGROUND = 255;
+}  // namespace
+
 template <class DetectionT>
 size_t ImgDetectionsT<DetectionT>::getSegmentationMaskWidth() const {
     return segmentationMaskWidth;
@@ -31,26 +38,129 @@ void ImgDetectionsT<DetectionT>::setSegmentationMask(const std::vector<std::uint
     this->segmentationMaskHeight = height;
 }
 
+template <class DetectionT>
+void ImgDetectionsT<DetectionT>::setSegmentationMask(std::vector<std::uint8_t>&& mask, size_t width, size_t height) {
+    if(mask.size() != width * height) {
+        throw std::runtime_error("SegmentationMask: data size does not match width*height");
+    }
+    setData(std::move(mask));
+    this->segmentationMaskWidth = width;
+    this->segmentationMaskHeight = height;
+}
+
 template <class DetectionT>
 void ImgDetectionsT<DetectionT>::setSegmentationMask(dai::ImgFrame& frame) {
     if(frame.getType() != dai::ImgFrame::Type::GRAY8) {
         throw std::runtime_error("SegmentationMask: ImgFrame type must be GRAY8");
     }
     auto dataSpan = frame.getData();
-    std::vector<std::uint8_t> vecMask(dataSpan.begin(), dataSpan.end());
-    setData(vecMask);
+    setData(std::vector<std::uint8_t>(dataSpan.begin(), dataSpan.end()));
     this->segmentationMaskWidth = frame.getWidth();
     this->segmentationMaskHeight = frame.getHeight();
 }
 
+template <class DetectionT>
+void ImgDetectionsT<DetectionT>::setSegmentationMask(const SegmentationMaskRLE& mask) {
+    std::vector<std::uint8_t> dense(static_cast<size_t>(mask.width) * mask.height, BACKGROUND);
+    for(const auto& run : mask.runs) {
+        if(static_cast<size_t>(run.offset) + run.length > dense.size()) {
+            throw std::runtime_error("SegmentationMask: run-length encoded run exceeds width*height");
+        }
+        std::fill_n(dense.begin() + run.offset, run.length, run.value);
+    }
+    setData(std::move(dense));
+    this->segmentationMaskWidth = mask.width;
+    this->segmentationMaskHeight = mask.height;
+}
+
 template <class DetectionT>
 std::optional<std::vector<std::uint8_t>> ImgDetectionsT<DetectionT>::getMaskData() const {
-    const auto& d = data->getData();
-    std::vector<std::uint8_t> vecMask(d.begin(), d.end());
-    if(vecMask.empty()) {
+    const auto view = getMaskDataView();
+    if(view.empty()) {
+        return std::nullopt;
+    }
+    return std::vector<std::uint8_t>(view.begin(), view.end());
+}
+
+template <class DetectionT>
+span<const std::uint8_t> ImgDetectionsT<DetectionT>::getMaskDataView() const {
+    return data->getData();
+}
+
+template <class DetectionT>
+std::optional<SegmentationMaskRLE> ImgDetectionsT<DetectionT>::getSegmentationMaskRLE() const {
+    const auto view = getMaskDataView();
+    if(view.empty()) {
         return std::nullopt;
     }
-    return vecMask;
+    checkMaskSize(view.size());
+    SegmentationMaskRLE rle;
+    rle.width = static_cast<std::uint32_t>(segmentationMaskWidth);
+    rle.height = static_cast<std::uint32_t>(segmentationMaskHeight);
+    for(size_t start = 0; start < view.size();) {
+        const std::uint8_t value = view[start];
+        size_t end = start + 1;
+        while(end < view.size() && view[end] == value) end++;
+        if(value != BACKGROUND) {
+            rle.runs.push_back({static_cast<std::uint32_t>(start), static_cast<std::uint32_t>(end - start), value});
+        }
+        start = end;
+    }
+    return rle;
+}
+
+template <class DetectionT>
+std::vector<SegmentationMaskBounds> ImgDetectionsT<DetectionT>::getSegmentationMaskBounds() const {
+    const auto view = getMaskDataView();
+    if(view.empty()) {
+        return {};
+    }
+    checkMaskSize(view.size());
+    struct Extent {
+        size_t minX = std::numeric_limits<size_t>::max();
+        size_t minY = std::numeric_limits<size_t>::max();
+        size_t maxX = 0;
+        size_t maxY = 0;
+        size_t area = 0;
+    };
+    std::array<Extent, BACKGROUND> extents{};
+    for(size_t y = 0; y < segmentationMaskHeight; y++) {
+        const std::uint8_t* row = view.data() + y * segmentationMaskWidth;
+        for(size_t x = 0; x < segmentationMaskWidth; x++) {
+            const std::uint8_t value = row[x];
+            if(value == BACKGROUND) continue;
+            auto& extent = extents[value];
+            extent.area++;
+            extent.minX = std::min(extent.minX, x);
+            extent.maxX = std::max(extent.maxX, x);
+            // Rows are visited in order
+            if(extent.minY == std::numeric_limits<size_t>::max()) extent.minY = y;
+            extent.maxY = y;
+        }
+    }
+
+    std::vector<SegmentationMaskBounds> bounds;
+    for(size_t index = 0; index < extents.size(); index++) {
+        const auto& extent = extents[index];
+        if(extent.area == 0) continue;
+        SegmentationMaskBounds instance;
+        instance.index = static_cast<std::uint8_t>(index);
+        instance.x = static_cast<std::uint32_t>(extent.minX);
+        instance.y = static_cast<std::uint32_t>(extent.minY);
+        instance.width = static_cast<std::uint32_t>(extent.maxX - extent.minX + 1);
+        instance.height = static_cast<std::uint32_t>(extent.maxY - extent.minY + 1);
+        instance.area = static_cast<std::uint32_t>(extent.area);
+        bounds.push_back(instance);
+    }
+    return bounds;
+}
+
+template <class DetectionT>
+void ImgDetectionsT<DetectionT>::checkMaskSize(size_t size) const {
+    if(size != segmentationMaskWidth * segmentationMaskHeight) {
+        throw std::runtime_error("Segmentation mask data size does not match the expected size, required "
+                                 + std::to_string(segmentationMaskWidth * segmentationMaskHeight) + ", actual " + std::to_string(size) + ".");
+    }
 }
 
 template <class DetectionT>
@@ -66,7 +176,7 @@ std::optional<dai::ImgFrame> ImgDetectionsT<DetectionT>::getSegmentationMask() c
     img.setSequenceNum(sequenceNum);
     img.setTimestamp(getTimestamp());
     img.setTimestampDevice(getTimestampDevice());
-    img.setData(*maskData);
+    img.setData(std::move(*maskData));
 
     return img;
 }
@@ -92,7 +202,7 @@ void ImgDetectionsT<DetectionT>::setCvSegmentationMask(cv::Mat mask) {
 }
 
 template <class DetectionT>
-std::optional<cv::Mat> ImgDetectionsT<DetectionT>::getCvSegmentationMask(cv::MatAllocator* allocator) {
+std::optional<cv::Mat> ImgDetectionsT<DetectionT>::getCvSegmentationMaskView() {
     if(data->getData().data() == nullptr) {
         return std::nullopt;
     }
@@ -110,25 +220,34 @@ std::optional<cv::Mat> ImgDetectionsT<DetectionT>::getCvSegmentationMask(cv::Mat
                                  + std::to_string(actualSize) + ".");
     }
 
-    cv::Mat mask;
-    mask = cv::Mat(size, type, data->getData().data());
-    CV_Assert(mask.type() == CV_8UC1);
+    return cv::Mat(size, type, data->getData().data());
+}
+
+template <class DetectionT>
+std::optional<cv::Mat> ImgDetectionsT<DetectionT>::getCvSegmentationMask(cv::MatAllocator* allocator) {
+    std::optional<cv::Mat> mask = getCvSegmentationMaskView();
+    if(!mask.has_value()) {
+        return std::nullopt;
+    }
 
     cv::Mat output;
     if(allocator != nullptr) {
         output.allocator = allocator;
     }
-    (mask).copyTo(output);
+    mask->copyTo(output);
     return output;
 }
 
 template <class DetectionT>
 std::optional<cv::Mat> ImgDetectionsT<DetectionT>::getCvSegmentationMaskByIndex(uint8_t index, cv::MatAllocator* allocator) {
-    std::optional<cv::Mat> mask = getCvSegmentationMask(allocator);
+    std::optional<cv::Mat> mask = getCvSegmentationMaskView();
     if(!mask.has_value()) {
         return std::nullopt;
     }
     cv::Mat classMask;
+    if(allocator != nullptr) {
+        classMask.allocator = allocator;
+    }
     cv::compare(*mask, index, classMask, cv::CmpTypes::CMP_EQ);
 
     return classMask;
@@ -136,25 +255,55 @@ std::optional<cv::Mat> ImgDetectionsT<DetectionT>::getCvSegmentationMaskByIndex(
 
 template <class DetectionT>
 std::optional<cv::Mat> ImgDetectionsT<DetectionT>::getCvSegmentationMaskByClass(uint8_t semanticClass, cv::MatAllocator* allocator) {
-    std::optional<cv::Mat> mask = getCvSegmentationMask(allocator);
+    std::optional<cv::Mat> mask = getCvSegmentationMaskView();
     if(!mask.has_value()) {
         return std::nullopt;
     }
-    cv::Mat classMask = cv::Mat::zeros((*mask).size(), CV_8UC1) + 255;
-
-    for(uint8_t idx = 0; idx < detections.size(); idx++) {
+    // Instances of the class map to 0 and everything else to 255, in a single pass over the mask
+    cv::Mat lut(1, 256, CV_8UC1, cv::Scalar(255));
+    for(size_t idx = 0; idx < detections.size() && idx < BACKGROUND; idx++) {
         if(detections[idx].label == semanticClass) {
-            std::optional<cv::Mat> indexMask = getCvSegmentationMaskByIndex(idx, allocator);
-            if(!indexMask.has_value()) {
-                return std::nullopt;
-            }
-            classMask.setTo(0, *indexMask);
+            lut.at<uint8_t>(static_cast<int>(idx)) = 0;
         }
     }
+    cv::Mat classMask;
+    if(allocator != nullptr) {
+        classMask.allocator = allocator;
+    }
+    cv::LUT(*mask, lut, classMask);
 
     return classMask;
 }
 
+template <class DetectionT>
+std::vector<cv::Mat> ImgDetectionsT<DetectionT>::getCvInstanceSegmentationMasks(cv::MatAllocator* allocator) {
+    std::vector<cv::Mat> masks;
+    std::optional<cv::Mat> mask = getCvSegmentationMaskView();
+    if(!mask.has_value()) {
+        return masks;
+    }
+    std::array<std::optional<cv::Rect>, BACKGROUND> rois;
+    for(const auto& bounds : getSegmentationMaskBounds()) {
+        rois[bounds.index] = cv::Rect(bounds.x, bounds.y, bounds.width, bounds.height);
+    }
+
+    masks.reserve(detections.size());
+    for(size_t idx = 0; idx < detections.size(); idx++) {
+        cv::Mat instanceMask;
+        if(allocator != nullptr) {
+            instanceMask.allocator = allocator;
+        }
+        instanceMask.create(mask->size(), CV_8UC1);
+        instanceMask.setTo(0);
+        if(idx < rois.size() && rois[idx].has_value()) {
+            cv::Mat roi = instanceMask(*rois[idx]);
+            cv::compare((*mask)(*rois[idx]), static_cast<double>(idx), roi, cv::CmpTypes::CMP_EQ);
+        }
+        masks.push_back(instanceMask);
+    }
+    return masks;
+}
+
 #endif
 
 template class ImgDetectionsT<dai::ImgDetection>;
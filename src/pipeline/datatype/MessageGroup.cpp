@@ -1,13 +1,114 @@
 #include "depthai/pipeline/datatype/MessageGroup.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <functional>
 #include <memory>
+#include <stdexcept>
 
 #include "depthai/pipeline/datatype/Buffer.hpp"
 #include "depthai/pipeline/datatype/DatatypeEnum.hpp"
 
 namespace dai {
 
+MessageGroupParts::iterator MessageGroupParts::begin() {
+    version++;
+    return parts.begin();
+}
+MessageGroupParts::iterator MessageGroupParts::end() {
+    version++;
+    return parts.end();
+}
+MessageGroupParts::const_iterator MessageGroupParts::begin() const {
+    return parts.begin();
+}
+MessageGroupParts::const_iterator MessageGroupParts::end() const {
+    return parts.end();
+}
+
+std::size_t MessageGroupParts::size() const {
+    return parts.size();
+}
+bool MessageGroupParts::empty() const {
+    return parts.empty();
+}
+void MessageGroupParts::reserve(std::size_t capacity) {
+    parts.reserve(capacity);
+    hashes.reserve(capacity);
+}
+void MessageGroupParts::clear() {
+    version++;
+    parts.clear();
+    hashes.clear();
+}
+
+std::size_t MessageGroupParts::indexOf(const std::string& name, std::size_t hash) const {
+    // Groups hold a handful of parts, a linear scan over the hashes beats a binary search over the names
+    for(std::size_t i = 0; i < hashes.size(); i++) {
+        if(hashes[i] == hash && parts[i].first == name) return i;
+    }
+    return parts.size();
+}
+
+MessageGroupParts::iterator MessageGroupParts::insertAt(const std::string& name, std::size_t hash) {
+    const auto position = std::lower_bound(parts.begin(), parts.end(), name, [](const value_type& part, const std::string& n) { return part.first < n; });
+    const auto index = position - parts.begin();
+    hashes.insert(hashes.begin() + index, hash);
+    return parts.insert(position, value_type(name, nullptr));
+}
+
+MessageGroupParts::iterator MessageGroupParts::find(const std::string& name) {
+    version++;
+    return parts.begin() + indexOf(name, std::hash<std::string>{}(name));
+}
+MessageGroupParts::const_iterator MessageGroupParts::find(const std::string& name) const {
+    return parts.begin() + indexOf(name, std::hash<std::string>{}(name));
+}
+std::size_t MessageGroupParts::count(const std::string& name) const {
+    return find(name) == end() ? 0 : 1;
+}
+
+std::shared_ptr<ADatatype>& MessageGroupParts::at(const std::string& name) {
+    auto it = find(name);
+    if(it == parts.end()) throw std::out_of_range("MessageGroup has no message named '" + name + "'");
+    return it->second;
+}
+const std::shared_ptr<ADatatype>& MessageGroupParts::at(const std::string& name) const {
+    auto it = find(name);
+    if(it == parts.end()) throw std::out_of_range("MessageGroup has no message named '" + name + "'");
+    return it->second;
+}
+
+std::shared_ptr<ADatatype>& MessageGroupParts::operator[](const std::string& name) {
+    version++;
+    const auto hash = std::hash<std::string>{}(name);
+    const auto index = indexOf(name, hash);
+    if(index < parts.size()) return parts[index].second;
+    return insertAt(name, hash)->second;
+}
+
+std::pair<MessageGroupParts::iterator, bool> MessageGroupParts::insert_or_assign(const std::string& name, std::shared_ptr<ADatatype> value) {
+    version++;
+    const auto hash = std::hash<std::string>{}(name);
+    const auto index = indexOf(name, hash);
+    if(index < parts.size()) {
+        parts[index].second = std::move(value);
+        return {parts.begin() + index, false};
+    }
+    auto it = insertAt(name, hash);
+    it->second = std::move(value);
+    return {it, true};
+}
+
+std::size_t MessageGroupParts::erase(const std::string& name) {
+    version++;
+    const auto index = indexOf(name, std::hash<std::string>{}(name));
+    if(index == parts.size()) return 0;
+    parts.erase(parts.begin() + index);
+    hashes.erase(hashes.begin() + index);
+    return 1;
+}
+
 MessageGroup::~MessageGroup() = default;
 
 void MessageGroup::serialize(std::vector<std::uint8_t>& metadata, DatatypeEnum& datatype) const {
@@ -18,29 +119,70 @@ void MessageGroup::serialize(std::vector<std::uint8_t>& metadata, DatatypeEnum&
 std::shared_ptr<ADatatype> MessageGroup::operator[](const std::string& name) {
     return group.at(name);
 }
+
+namespace {
+
+struct TimestampBounds {
+    std::chrono::steady_clock::time_point oldest, latest;
+    bool valid = false;
+
+    void extend(const Buffer& buffer) {
+        const auto ts = buffer.getTimestampDevice();
+        if(!valid || ts < oldest) oldest = ts;
+        if(!valid || ts > latest) latest = ts;
+        valid = true;
+    }
+};
+
+}  // namespace
+
 void MessageGroup::add(const std::string& name, const std::shared_ptr<ADatatype>& value) {
-    group[name] = value;
+    const bool replaced = group.count(name) > 0;
+    const bool buffersCurrent = buffersVersion == group.getVersion();
+    group.insert_or_assign(name, value);
+
+    // A replaced message may still be listed, so the list is rebuilt
+    if(!buffersCurrent || replaced) {
+        bufferParts.clear();
+        for(const auto& part : static_cast<const MessageGroupParts&>(group)) {
+            if(auto buffer = dynamic_cast<const Buffer*>(part.second.get())) bufferParts.push_back(buffer);
+        }
+    } else if(auto buffer = dynamic_cast<const Buffer*>(value.get())) {
+        bufferParts.push_back(buffer);
+    }
+    buffersVersion = group.getVersion();
+}
+
+void MessageGroup::clear() {
+    group.clear();
+    bufferParts.clear();
+    buffersVersion = group.getVersion();
+    ts = {};
+    tsDevice = {};
+    sequenceNum = 0;
+    if(data && data->getSize() > 0) data = std::make_shared<VectorMemory>(std::vector<uint8_t>());
 }
 
-std::map<std::string, std::shared_ptr<ADatatype>>::iterator MessageGroup::begin() {
+MessageGroupParts::iterator MessageGroup::begin() {
     return group.begin();
 }
-std::map<std::string, std::shared_ptr<ADatatype>>::iterator MessageGroup::end() {
+MessageGroupParts::iterator MessageGroup::end() {
     return group.end();
 }
 
 int64_t MessageGroup::getIntervalNs() const {
-    if(!group.empty()) {
-        auto oldest = std::dynamic_pointer_cast<Buffer>(group.begin()->second)->getTimestampDevice();
-        auto latest = oldest;
-        for(const auto& entry : group) {
-            auto ts = std::dynamic_pointer_cast<Buffer>(entry.second)->getTimestampDevice();
-            if(ts < oldest) oldest = ts;
-            if(ts > latest) latest = ts;
+    // Timestamps are read on each call, parts may be changed through their pointers after being added
+    TimestampBounds bounds;
+    if(buffersVersion == group.getVersion()) {
+        for(const auto* buffer : bufferParts) bounds.extend(*buffer);
+    } else {
+        // Parts changed other than through add(), such as parsed groups
+        for(const auto& part : group) {
+            if(auto buffer = dynamic_cast<const Buffer*>(part.second.get())) bounds.extend(*buffer);
         }
-        return std::chrono::duration_cast<std::chrono::nanoseconds>(latest - oldest).count();
     }
-    return {};
+    if(!bounds.valid) return {};
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(bounds.latest - bounds.oldest).count();
 }
 
 int64_t MessageGroup::getNumMessages() const {
@@ -60,4 +202,36 @@ bool MessageGroup::isSynced(int64_t thresholdNs) const {
     return getIntervalNs() <= thresholdNs;
 }
 
+MessageGroupPool::MessageGroupPool(std::size_t maxIdle) : state(std::make_shared<State>()) {
+    state->maxIdle = maxIdle;
+}
+
+std::shared_ptr<MessageGroup> MessageGroupPool::acquire() {
+    std::unique_ptr<MessageGroup> group;
+    {
+        std::lock_guard<std::mutex> lock(state->mtx);
+        if(!state->idle.empty()) {
+            group = std::move(state->idle.back());
+            state->idle.pop_back();
+        }
+    }
+    if(group == nullptr) group = std::make_unique<MessageGroup>();
+
+    std::weak_ptr<State> weakState = state;
+    return std::shared_ptr<MessageGroup>(group.release(), [weakState](MessageGroup* released) {
+        std::unique_ptr<MessageGroup> owned(released);
+        auto pool = weakState.lock();
+        if(pool == nullptr) return;
+        // Cleared outside of the lock, releasing the parts may release further groups
+        owned->clear();
+        std::lock_guard<std::mutex> lock(pool->mtx);
+        if(pool->idle.size() < pool->maxIdle) pool->idle.push_back(std::move(owned));
+    });
+}
+
+std::size_t MessageGroupPool::getNumIdle() const {
+    std::lock_guard<std::mutex> lock(state->mtx);
+    return state->idle.size();
+}
+
 }  // namespace dai
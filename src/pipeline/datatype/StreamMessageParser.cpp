@@ -61,6 +61,8 @@
 namespace dai {
 
 static constexpr std::array<uint8_t, 16> endOfPacketMarker = {0xAB, 0xCD, 0xEF, 0x01, 0x23, 0x45, 0x67, 0x89, 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0};
+static constexpr std::array<uint8_t, 16> endOfCoalescedPacketMarker = {
+    0xC0, 0xA1, 0xE5, 0xCE, 0xD0, 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0x0F, 0x1E, 0x2D};
 
 // Reads int from little endian format
 inline int readIntLE(uint8_t* data) {
@@ -299,6 +301,66 @@ std::shared_ptr<ADatatype> StreamMessageParser::parseMessage(StreamPacketDesc pa
     return parseMessage(&packet);
 }
 
+// Writes int in little endian format
+static void appendIntLE(std::vector<std::uint8_t>& buffer, std::uint32_t value) {
+    for(int i = 0; i < 4; i++) buffer.push_back((value >> (i * 8)) & 0xFF);
+}
+
+void StreamMessageParser::appendCoalesced(std::vector<std::uint8_t>& coalesced,
+                                          std::vector<std::uint32_t>& sizes,
+                                          span<const std::uint8_t> data,
+                                          const std::vector<std::uint8_t>& metadata) {
+    coalesced.insert(coalesced.end(), data.begin(), data.end());
+    coalesced.insert(coalesced.end(), metadata.begin(), metadata.end());
+    sizes.push_back(static_cast<std::uint32_t>(data.size() + metadata.size()));
+}
+
+void StreamMessageParser::finalizeCoalesced(std::vector<std::uint8_t>& coalesced, const std::vector<std::uint32_t>& sizes) {
+    coalesced.reserve(coalesced.size() + getCoalescedTrailerSize(sizes.size()));
+    for(auto size : sizes) appendIntLE(coalesced, size);
+    appendIntLE(coalesced, static_cast<std::uint32_t>(sizes.size()));
+    coalesced.insert(coalesced.end(), endOfCoalescedPacketMarker.begin(), endOfCoalescedPacketMarker.end());
+}
+
+std::size_t StreamMessageParser::getCoalescedTrailerSize(std::size_t numMessages) {
+    return 4 * numMessages + 4 + endOfCoalescedPacketMarker.size();
+}
+
+bool StreamMessageParser::isCoalesced(const streamPacketDesc_t* packet) {
+    if(packet->length < getCoalescedTrailerSize(0)) return false;
+    return memcmp(packet->data + packet->length - endOfCoalescedPacketMarker.size(), endOfCoalescedPacketMarker.data(), endOfCoalescedPacketMarker.size())
+           == 0;
+}
+
+std::vector<std::shared_ptr<ADatatype>> StreamMessageParser::parseCoalesced(streamPacketDesc_t* const packet) {
+    if(!isCoalesced(packet)) {
+        throw std::runtime_error("Bad coalesced packet, couldn't parse (marker mismatch)");
+    }
+    const std::size_t countOffset = packet->length - endOfCoalescedPacketMarker.size() - 4;
+    const std::size_t numMessages = static_cast<std::uint32_t>(readIntLE(packet->data + countOffset));
+    if(numMessages > countOffset / 4) {
+        throw std::runtime_error(fmt::format("Bad coalesced packet, couldn't parse (message count {} too large), total size {}", numMessages, packet->length));
+    }
+    const std::size_t sizesOffset = countOffset - 4 * numMessages;
+
+    std::vector<std::shared_ptr<ADatatype>> messages;
+    messages.reserve(numMessages);
+    std::size_t offset = 0;
+    for(std::size_t i = 0; i < numMessages; i++) {
+        const std::size_t size = static_cast<std::uint32_t>(readIntLE(packet->data + sizesOffset + 4 * i));
+        if(size > sizesOffset - offset) {
+            throw std::runtime_error(fmt::format("Bad coalesced packet, couldn't parse (message {} out of bounds), total size {}", i, packet->length));
+        }
+        streamPacketDesc_t message = *packet;
+        message.data = packet->data + offset;
+        message.length = static_cast<std::uint32_t>(size);
+        message.fd = -1;
+        messages.push_back(parseMessage(&message));
+        offset += size;
+    }
+    return messages;
+}
+
 std::vector<std::uint8_t> StreamMessageParser::serializeMetadata(const ADatatype& message) {
     // Serialization:
     // 1. fill vector with bytes from message.data
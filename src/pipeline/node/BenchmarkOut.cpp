@@ -24,6 +24,7 @@ bool BenchmarkOut::runOnHost() const {
 void BenchmarkOut::run() {
     using namespace std::chrono;
     auto& logger = pimpl->logger;
+    auto clock = getClock();
     logger->trace("Wait for the input message.");
     auto inMessage = input.get();
 
@@ -32,7 +33,7 @@ void BenchmarkOut::run() {
     auto frameDurationDouble = std::chrono::duration<double>(1.0 / static_cast<double>(properties.fps));
     auto frameDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(frameDurationDouble);
 
-    auto nextFrameTime = steady_clock::now();
+    auto nextFrameTime = clock->now();
     for(int i = 0; (i < properties.numMessages || properties.numMessages == -1) && isRunning(); i++) {
         auto imgMessage = std::dynamic_pointer_cast<dai::ImgFrame>(inMessage);
         if(imgMessage != nullptr) {
@@ -43,9 +44,9 @@ void BenchmarkOut::run() {
             newMessage->setMetadata(imgMessage);
             newMessage->data = imgMessage->data;
             if(runOnHostVar) {
-                newMessage->setTimestamp(steady_clock::now());
+                newMessage->setTimestamp(clock->now());
             } else {
-                newMessage->setTimestampDevice(steady_clock::now());
+                newMessage->setTimestampDevice(clock->now());
             }
             out.send(newMessage);
         } else {
@@ -56,10 +57,8 @@ void BenchmarkOut::run() {
         if(useTiming) {
             nextFrameTime += frameDuration;
 
-            auto now = steady_clock::now();
-            if(nextFrameTime > now) {
-                auto sleepTime = nextFrameTime - now;
-                std::this_thread::sleep_for(sleepTime);
+            if(nextFrameTime > clock->now()) {
+                clock->sleepUntil(nextFrameTime);
             }
         }
     }
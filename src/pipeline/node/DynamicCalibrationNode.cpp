@@ -1,5 +1,7 @@
 #include "depthai/pipeline/node/DynamicCalibrationNode.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <opencv2/opencv.hpp>
 #include <pipeline/ThreadedNodeImpl.hpp>
 
@@ -223,6 +225,34 @@ dcl::ImageData DclUtils::cvMatToImageData(const cv::Mat& mat) {
     return img;
 }
 
+dcl::ImageData DclUtils::imgFrameToImageData(ImgFrame& frame) {
+    const auto type = frame.getType();
+    if(type != ImgFrame::Type::GRAY8 && type != ImgFrame::Type::RAW8 && type != ImgFrame::Type::BGR888i) {
+        return cvMatToImageData(frame.getCvFrame());
+    }
+
+    dcl::ImageData img;
+    img.width = frame.getWidth();
+    img.height = frame.getHeight();
+    img.format = type == ImgFrame::Type::BGR888i ? dcl::DCL_8UC3 : dcl::DCL_8UC1;
+    const std::size_t rowSize = static_cast<std::size_t>(img.width) * (type == ImgFrame::Type::BGR888i ? 3 : 1);
+    const std::size_t stride = frame.getStride();
+    const auto data = frame.getData();
+    if(img.width == 0 || img.height == 0 || stride < rowSize || data.size() < stride * (img.height - 1) + rowSize) {
+        throw std::runtime_error("ImgFrame is empty or its buffer is smaller than its size");
+    }
+    if(stride == rowSize) {
+        img.data.assign(data.data(), data.data() + rowSize * img.height);
+    } else {
+        img.data.reserve(rowSize * img.height);
+        for(unsigned int row = 0; row < img.height; row++) {
+            const auto* rowData = data.data() + row * stride;
+            img.data.insert(img.data.end(), rowData, rowData + rowSize);
+        }
+    }
+    return img;
+}
+
 dai::CalibrationQuality calibQualityfromDCL(const dcl::CalibrationDifference& src) {
     dai::CalibrationQuality quality;
 
@@ -317,7 +347,6 @@ DynamicCalibration::ErrorCode DynamicCalibration::runLoadImage(const bool blocki
     if(!blocking) {
         inSyncGroup = syncInput.tryGet<dai::MessageGroup>();
     } else {
-        slept = true;
         inSyncGroup = syncInput.get<dai::MessageGroup>();
     }
     if(!inSyncGroup) {
@@ -332,8 +361,6 @@ DynamicCalibration::ErrorCode DynamicCalibration::runLoadImage(const bool blocki
     }
 
     dcl::timestamp_t timestamp = leftFrame->getTimestamp().time_since_epoch().count();
-    auto leftCvFrame = leftFrame->getCvFrame();
-    auto rightCvFrame = rightFrame->getCvFrame();
 
     logger->info("Loaded stereo image pair: {}x{} and {}x{} @ timestamp={}",
                  leftFrame->getWidth(),
@@ -342,12 +369,16 @@ DynamicCalibration::ErrorCode DynamicCalibration::runLoadImage(const bool blocki
                  rightFrame->getHeight(),
                  timestamp);
 
-    pimplDCL->dynCalibImpl.loadStereoImagePair(DclUtils::cvMatToImageData(leftCvFrame),
-                                               DclUtils::cvMatToImageData(rightCvFrame),
+    auto loadStart = std::chrono::steady_clock::now();
+    pimplDCL->dynCalibImpl.loadStereoImagePair(DclUtils::imgFrameToImageData(*leftFrame),
+                                               DclUtils::imgFrameToImageData(*rightFrame),
                                                pimplDCL->deviceName,
                                                pimplDCL->socketA,
                                                pimplDCL->socketB,
                                                timestamp);
+    logger->debug("Stereo image pair loaded in {}ms, {}ms after capture",
+                  std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - loadStart).count(),
+                  std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - leftFrame->getTimestamp()).count());
 
     return DynamicCalibration::ErrorCode::OK;
 }
@@ -513,7 +544,21 @@ DynamicCalibration::ErrorCode DynamicCalibration::evaluateCommand(const std::sha
 
 DynamicCalibration::ErrorCode DynamicCalibration::doWork(std::chrono::steady_clock::time_point& previousLoadingAndCalibrationTime) {
     auto error = ErrorCode::OK;  // Expect everything is ok
-    auto calibrationCommand = inputControl.tryGet<DynamicCalibrationControl>();
+
+    // Wait for commands until the next image is due, or for at most maxWaitTime so that stopping is noticed
+    auto timeout = std::chrono::duration_cast<std::chrono::steady_clock::duration>(maxWaitTime);
+    if(calibrationShouldRun) {
+        auto nextLoadingTime = previousLoadingAndCalibrationTime
+                               + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(loadImagePeriod));
+        timeout = std::clamp(nextLoadingTime - std::chrono::steady_clock::now(), std::chrono::steady_clock::duration::zero(), timeout);
+    }
+    std::shared_ptr<DynamicCalibrationControl> calibrationCommand;
+    if(timeout > std::chrono::steady_clock::duration::zero()) {
+        bool timedOut = false;
+        calibrationCommand = inputControl.get<DynamicCalibrationControl>(timeout, timedOut);
+    } else {
+        calibrationCommand = inputControl.tryGet<DynamicCalibrationControl>();
+    }
     if(calibrationCommand) {
         error = evaluateCommand(calibrationCommand);
     }
@@ -559,12 +604,7 @@ void DynamicCalibration::run() {
     auto previousLoadingTime = std::chrono::time_point_cast<std::chrono::steady_clock::duration>(previousLoadingTimeFloat);
     initializePipeline(device);
     while(isRunning()) {
-        slept = false;
         doWork(previousLoadingTime);
-        if(!slept) {
-            // sleep to prevent 100% CPU utilization
-            std::this_thread::sleep_for(sleepingTime);
-        }
     }
 }
 
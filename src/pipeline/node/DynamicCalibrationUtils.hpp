@@ -6,6 +6,8 @@
 #include <depthai/pipeline/node/Sync.hpp>
 #include <depthai/properties/DynamicCalibrationProperties.hpp>
 
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+
 namespace dai {
 namespace node {
 struct DclUtils {
@@ -31,6 +33,12 @@ struct DclUtils {
 
     static dcl::ImageData cvMatToImageData(const cv::Mat& mat);
 
+    /**
+     * Copies the frame straight out of its buffer for GRAY8, RAW8 and BGR888i frames, without an intermediate cv::Mat.
+     * Other types are converted to BGR first.
+     */
+    static dcl::ImageData imgFrameToImageData(ImgFrame& frame);
+
     static dcl::PerformanceMode daiPerformanceModeToDclPerformanceMode(const dai::DynamicCalibrationControl::PerformanceMode mode);
 };
 
@@ -1,6 +1,9 @@
 #include "depthai/pipeline/node/EdgeDetector.hpp"
 
+#include "pipeline/ThreadedNodeImpl.hpp"
 #include "spdlog/fmt/fmt.h"
+#include "utility/EdgeDetectorImpl.hpp"
+#include "utility/MemoryPool.hpp"
 
 namespace dai {
 namespace node {
@@ -22,5 +25,85 @@ void EdgeDetector::setMaxOutputFrameSize(int maxFrameSize) {
     properties.outputFrameSize = maxFrameSize;
 }
 
+void EdgeDetector::setNumThreads(int numThreads) {
+    this->numThreads = numThreads;
+}
+
+int EdgeDetector::getNumThreads() const {
+    return numThreads;
+}
+
+void EdgeDetector::setRunOnHost(bool runOnHost) {
+    runOnHostVar = runOnHost;
+}
+
+bool EdgeDetector::runOnHost() const {
+    return runOnHostVar;
+}
+
+void EdgeDetector::run() {
+    auto& logger = pimpl->logger;
+
+    impl::SobelFilter filter;
+    filter.setKernels(initialConfig->config.sobelFilterHorizontalKernel, initialConfig->config.sobelFilterVerticalKernel);
+    utility::MemoryPool pool(properties.numFramesPool);
+
+    while(isRunning()) {
+        std::shared_ptr<EdgeDetectorConfig> config;
+        if(inputConfig.getWaitForMessage()) {
+            config = inputConfig.get<EdgeDetectorConfig>();
+        } else {
+            config = inputConfig.tryGet<EdgeDetectorConfig>();
+        }
+        if(config != nullptr) {
+            try {
+                filter.setKernels(config->config.sobelFilterHorizontalKernel, config->config.sobelFilterVerticalKernel);
+                logger->debug("EdgeDetector: New config applied, separable kernels: {}", filter.isSeparable());
+            } catch(const std::invalid_argument& e) {
+                logger->error("EdgeDetector: Ignoring config - {}", e.what());
+            }
+        }
+
+        auto inputImg = inputImage.get<ImgFrame>();
+        if(inputImg == nullptr) continue;
+
+        const auto type = inputImg->getType();
+        // For NV12 (and other planar YUV types) only the luma plane is filtered, as on device
+        if(type != ImgFrame::Type::GRAY8 && type != ImgFrame::Type::RAW8 && type != ImgFrame::Type::NV12 && type != ImgFrame::Type::YUV420p) {
+            logger->error("EdgeDetector: Frame type {} is not supported, expected GRAY8 or NV12", static_cast<int>(type));
+            continue;
+        }
+
+        const unsigned int width = inputImg->getWidth();
+        const unsigned int height = inputImg->getHeight();
+        // Stride of the luma plane, not derived from the bytes per pixel of the whole frame
+        const unsigned int srcStride = inputImg->fb.stride != 0 ? inputImg->fb.stride : width;
+        const auto src = inputImg->getData();
+        const std::size_t requiredSize = height == 0 ? 0 : inputImg->fb.p1Offset + static_cast<std::size_t>(srcStride) * (height - 1) + width;
+        if(srcStride < width || src.size() < requiredSize) {
+            logger->warn("EdgeDetector: frame data doesn't match its size, skipping the frame");
+            continue;
+        }
+        const std::size_t outSize = static_cast<std::size_t>(width) * height;
+        if(outSize > static_cast<std::size_t>(properties.outputFrameSize)) {
+            logger->warn("EdgeDetector: Output frame size {} exceeds max output frame size {}", outSize, properties.outputFrameSize);
+        }
+
+        auto outputImg = std::make_shared<ImgFrame>();
+        outputImg->setMetadata(*inputImg);
+        outputImg->data = pool.acquire(outSize);
+        outputImg->setType(ImgFrame::Type::GRAY8);
+        outputImg->setStride(width);
+        outputImg->fb.p1Offset = 0;
+        outputImg->fb.p2Offset = 0;
+        outputImg->fb.p3Offset = 0;
+
+        filter.apply(src.data() + inputImg->fb.p1Offset, srcStride, outputImg->getData().data(), width, width, height, numThreads);
+
+        outputImage.send(outputImg);
+        passthroughInputImage.send(inputImg);
+    }
+}
+
 }  // namespace node
 }  // namespace dai
@@ -10,7 +10,11 @@
 #include "nn_archive/NNArchive.hpp"
 #include "openvino/BlobReader.hpp"
 #include "openvino/OpenVINO.hpp"
+#include "pipeline/ThreadedNodeImpl.hpp"
 #include "utility/ErrorMacros.hpp"
+#ifdef DEPTHAI_ENABLE_ONNXRUNTIME
+    #include "utility/OnnxRuntimeInference.hpp"
+#endif
 
 namespace dai {
 namespace node {
@@ -278,5 +282,77 @@ void NeuralNetwork::setModelFromDeviceZoo(DeviceModelZoo model) {
     properties.deviceModel = model;
 }
 
+void NeuralNetwork::setRunOnHost(bool runOnHost) {
+    runOnHostVar = runOnHost;
+}
+
+bool NeuralNetwork::runOnHost() const {
+    return runOnHostVar;
+}
+
+void NeuralNetwork::setHostNumIntraOpThreads(int numThreads) {
+    DAI_CHECK_V(numThreads >= 0, "Number of threads must be non-negative");
+    hostNumIntraOpThreads = numThreads;
+}
+
+void NeuralNetwork::setHostMaxBatchSize(int maxBatchSize) {
+    DAI_CHECK_V(maxBatchSize >= 1, "Max batch size must be at least 1");
+    hostMaxBatchSize = maxBatchSize;
+}
+
+void NeuralNetwork::run() {
+#ifdef DEPTHAI_ENABLE_ONNXRUNTIME
+    auto& logger = pimpl->logger;
+
+    auto model = assetManager.get("__model");
+    DAI_CHECK_V(model != nullptr, "NeuralNetwork on host requires an ONNX model, set with setModelPath, setOtherModelFormat or setNNArchive");
+
+    std::map<std::string, impl::HostInferencePreprocessing> preprocessing;
+    if(nnArchive && nnArchive->getVersionedConfig().getVersion() == NNArchiveConfigVersion::V1) {
+        for(const auto& modelInput : nnArchive->getConfig<nn_archive::v1::Config>().model.inputs) {
+            impl::HostInferencePreprocessing pre;
+            const auto& block = modelInput.preprocessing;
+            if(block.mean) pre.mean.assign(block.mean->begin(), block.mean->end());
+            if(block.scale) pre.scale.assign(block.scale->begin(), block.scale->end());
+            pre.reverseChannels = block.reverseChannels.value_or(false);
+            pre.layout = modelInput.layout.value_or("");
+            preprocessing[modelInput.name] = std::move(pre);
+        }
+    }
+
+    impl::OnnxRuntimeInference inference(span<const std::uint8_t>(model->data.data(), model->data.size()), hostNumIntraOpThreads, std::move(preprocessing));
+    const auto maxBatchSize = static_cast<std::size_t>(std::min(hostMaxBatchSize, inference.getMaxBatchSize()));
+    logger->debug("NeuralNetwork: Running on host, max batch size {}", maxBatchSize);
+
+    std::vector<std::shared_ptr<Buffer>> batch;
+    while(isRunning()) {
+        batch.clear();
+        auto first = input.get<Buffer>();
+        if(first == nullptr) continue;
+        batch.push_back(first);
+        // Batch whatever is already queued, without waiting for more
+        while(batch.size() < maxBatchSize) {
+            auto next = input.tryGet<Buffer>();
+            if(next == nullptr) break;
+            batch.push_back(next);
+        }
+
+        std::vector<std::shared_ptr<NNData>> results;
+        try {
+            results = inference.infer(batch);
+        } catch(const std::exception& e) {
+            logger->error("NeuralNetwork: Inference failed - {}", e.what());
+            continue;
+        }
+        for(std::size_t i = 0; i < results.size(); i++) {
+            out.send(results[i]);
+            passthrough.send(batch[i]);
+        }
+    }
+#else
+    throw std::runtime_error("NeuralNetwork can only run on host if the library is built with DEPTHAI_ENABLE_ONNXRUNTIME");
+#endif
+}
+
 }  // namespace node
 }  // namespace dai
@@ -50,6 +50,9 @@ void Sync::run() {
     auto syncThresholdNs = properties.syncThresholdNs;
     logger->trace("Sync threshold: {}", syncThresholdNs);
 
+    // Groups released by the consumers are reused for the following outputs
+    MessageGroupPool groupPool;
+
     while(isRunning()) {
         auto tAbsoluteBeginning = steady_clock::now();
         std::unordered_map<std::string, std::shared_ptr<dai::Buffer>> inputFrames;
@@ -118,7 +121,7 @@ void Sync::run() {
             attempts++;
         }
         auto tBeforeSend = steady_clock::now();
-        auto outputGroup = std::make_shared<dai::MessageGroup>();
+        auto outputGroup = groupPool.acquire();
         dai::Buffer* newestFrame = inputFrames.begin()->second.get();
         for(const auto& name : inputNames) {
             logger->trace("Sending output: {}", name);
@@ -0,0 +1,229 @@
+#include "depthai/pipeline/node/host/AnnotationRenderer.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "depthai/pipeline/datatype/ImgAnnotations.hpp"
+#include "depthai/pipeline/datatype/ImgDetections.hpp"
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+#include "depthai/pipeline/datatype/SpatialImgDetections.hpp"
+#include "depthai/pipeline/datatype/Tracklets.hpp"
+#include "pipeline/ThreadedNodeImpl.hpp"
+#include "utility/AnnotationRasterizer.hpp"
+#include "utility/PimplImpl.hpp"
+
+namespace dai {
+namespace node {
+
+class AnnotationRenderer::Impl {
+   public:
+    int numThreads = 1;
+    float labelFontSize = 16.f;
+
+    /**
+     * Records the message's annotations
+     * @returns False if the message type isn't supported
+     */
+    bool add(const ADatatype& message) {
+        if(const auto* annotations = dynamic_cast<const ImgAnnotations*>(&message)) {
+            add(*annotations);
+        } else if(const auto* detections = dynamic_cast<const ImgDetections*>(&message)) {
+            for(const auto& detection : detections->detections) addDetection(detection, {});
+        } else if(const auto* spatialDetections = dynamic_cast<const SpatialImgDetections*>(&message)) {
+            for(const auto& detection : spatialDetections->detections) {
+                addDetection(detection, fmt::format("Z: {:.0f} mm", detection.spatialCoordinates.z));
+            }
+        } else if(const auto* tracklets = dynamic_cast<const Tracklets*>(&message)) {
+            for(const auto& tracklet : tracklets->tracklets) {
+                if(tracklet.status == Tracklet::TrackingStatus::REMOVED) continue;
+                const auto roi = tracklet.roi.denormalize(width, height);
+                addBox(Point2f(roi.x, roi.y), Point2f(roi.x + roi.width, roi.y + roi.height), tracklet.label, fmt::format("ID {}", tracklet.id));
+            }
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    void render(ImgFrame& frame) {
+        auto data = frame.getData();
+        impl::AnnotationRasterizer::Canvas canvas;
+        canvas.format = frame.getType() == ImgFrame::Type::NV12 ? impl::AnnotationRasterizer::Format::NV12 : impl::AnnotationRasterizer::Format::GRAY8;
+        canvas.width = static_cast<int>(frame.getWidth());
+        canvas.height = static_cast<int>(frame.getHeight());
+        canvas.luma = data.data();
+        canvas.lumaStride = frame.getStride();
+        if(canvas.format == impl::AnnotationRasterizer::Format::NV12) {
+            canvas.chroma = data.data() + frame.getPlaneStride();
+            canvas.chromaStride = frame.getStride();
+        }
+        rasterizer.render(canvas, numThreads);
+    }
+
+    void reset(int frameWidth, int frameHeight) {
+        rasterizer.clear();
+        width = frameWidth;
+        height = frameHeight;
+    }
+
+   private:
+    impl::AnnotationRasterizer rasterizer;
+    int width = 0;
+    int height = 0;
+
+    Point2f toPixels(const Point2f& point) const {
+        if(point.isNormalized()) return Point2f(point.x * width, point.y * height);
+        return point;
+    }
+
+    static Color labelColor(uint32_t label) {
+        static const std::array<Color, 8> palette{Color(0.f, 1.f, 0.f, 1.f),
+                                                  Color(1.f, 0.5f, 0.f, 1.f),
+                                                  Color(0.f, 0.6f, 1.f, 1.f),
+                                                  Color(1.f, 0.f, 1.f, 1.f),
+                                                  Color(1.f, 1.f, 0.f, 1.f),
+                                                  Color(0.f, 1.f, 1.f, 1.f),
+                                                  Color(1.f, 0.f, 0.f, 1.f),
+                                                  Color(0.6f, 0.4f, 1.f, 1.f)};
+        return palette[label % palette.size()];
+    }
+
+    // Box with the label text above it, or inside it when there is no room above
+    void addBox(Point2f topLeft, Point2f bottomRight, uint32_t label, const std::string& text) {
+        const auto color = labelColor(label);
+        rasterizer.drawRectangle(topLeft, bottomRight, 2.f, color);
+        const auto lineHeight = impl::AnnotationRasterizer::getLineHeight(labelFontSize);
+        const auto numLines = static_cast<int>(std::count(text.begin(), text.end(), '\n')) + 1;
+        float y = topLeft.y - static_cast<float>(lineHeight * numLines) - 1.f;
+        if(y < 0.f) y = topLeft.y + 2.f;
+        rasterizer.drawText(Point2f(topLeft.x, y), text, labelFontSize, Color(1.f, 1.f, 1.f, 1.f), color);
+    }
+
+    void addDetection(const ImgDetection& detection, const std::string& extra) {
+        auto text = detection.labelName.empty() ? std::to_string(detection.label) : detection.labelName;
+        text += fmt::format(" {:.0f}%", detection.confidence * 100.f);
+        if(!extra.empty()) text += "\n" + extra;
+        addBox(Point2f(detection.xmin * width, detection.ymin * height), Point2f(detection.xmax * width, detection.ymax * height), detection.label, text);
+    }
+
+    void add(const ImgAnnotations& message) {
+        for(const auto& annotation : message.annotations) {
+            for(const auto& circle : annotation.circles) {
+                // The diameter is normalized to the frame width along with the position
+                const float diameter = circle.position.isNormalized() ? circle.diameter * width : circle.diameter;
+                rasterizer.drawCircle(toPixels(circle.position), diameter / 2.f, circle.thickness, circle.outlineColor, circle.fillColor);
+            }
+            for(const auto& points : annotation.points) add(points);
+            for(const auto& text : annotation.texts) {
+                rasterizer.drawText(toPixels(text.position), text.text, text.fontSize, text.textColor, text.backgroundColor);
+            }
+        }
+    }
+
+    void add(const PointsAnnotation& annotation) {
+        std::vector<Point2f> points;
+        points.reserve(annotation.points.size());
+        for(const auto& point : annotation.points) points.push_back(toPixels(point));
+        const bool perPointColors = annotation.outlineColors.size() == points.size();
+        const auto colorAt = [&](std::size_t i) -> const Color& { return perPointColors ? annotation.outlineColors[i] : annotation.outlineColor; };
+
+        switch(annotation.type) {
+            case PointsAnnotationType::UNKNOWN:
+            case PointsAnnotationType::POINTS:
+                for(std::size_t i = 0; i < points.size(); i++) {
+                    rasterizer.drawCircle(points[i], std::max(annotation.thickness, 1.f) / 2.f, 1.f, Color{}, colorAt(i));
+                }
+                break;
+            case PointsAnnotationType::LINE_LOOP:
+                rasterizer.fillPolygon(points, annotation.fillColor);
+                [[fallthrough]];
+            case PointsAnnotationType::LINE_STRIP: {
+                const bool closed = annotation.type == PointsAnnotationType::LINE_LOOP;
+                if(!perPointColors) {
+                    rasterizer.drawPolyline(points, closed, annotation.thickness, annotation.outlineColor);
+                    break;
+                }
+                for(std::size_t i = 0; i + 1 < points.size(); i++) rasterizer.drawLine(points[i], points[i + 1], annotation.thickness, colorAt(i));
+                if(closed && points.size() > 2) rasterizer.drawLine(points.back(), points.front(), annotation.thickness, colorAt(points.size() - 1));
+            } break;
+            case PointsAnnotationType::LINE_LIST:
+                for(std::size_t i = 0; i + 1 < points.size(); i += 2) rasterizer.drawLine(points[i], points[i + 1], annotation.thickness, colorAt(i));
+                break;
+        }
+    }
+};
+
+AnnotationRenderer::AnnotationRenderer() = default;
+
+AnnotationRenderer::~AnnotationRenderer() = default;
+
+void AnnotationRenderer::buildInternal() {
+    sync->out.link(inSync);
+    sync->setRunOnHost(true);
+    inputFrame.setBlocking(false);
+    inputFrame.setMaxSize(4);
+    inputAnnotations.setBlocking(false);
+    inputAnnotations.setMaxSize(4);
+    inSync.setBlocking(false);
+    inSync.setMaxSize(4);
+}
+
+std::shared_ptr<AnnotationRenderer> AnnotationRenderer::build(Output& frames, Output& annotations) {
+    frames.link(inputFrame);
+    annotations.link(inputAnnotations);
+    return std::static_pointer_cast<AnnotationRenderer>(shared_from_this());
+}
+
+void AnnotationRenderer::setNumThreads(uint32_t numThreads) {
+    pimpl->numThreads = static_cast<int>(std::max(numThreads, 1u));
+}
+
+void AnnotationRenderer::setLabelFontSize(float fontSize) {
+    pimpl->labelFontSize = fontSize;
+}
+
+void AnnotationRenderer::run() {
+    auto& logger = ThreadedNode::pimpl->logger;
+    while(isRunning()) {
+        auto group = inSync.get<MessageGroup>();
+        if(group == nullptr) continue;
+        auto frame = group->get<ImgFrame>(frameInputName);
+        if(frame == nullptr) {
+            logger->warn("AnnotationRenderer: no frame in the synced group");
+            continue;
+        }
+        const auto type = frame->getType();
+        if(type != ImgFrame::Type::NV12 && type != ImgFrame::Type::GRAY8) {
+            logger->warn("AnnotationRenderer: unsupported frame type {}, forwarding the frame unchanged", static_cast<int>(type));
+            out.send(frame);
+            continue;
+        }
+        const std::size_t stride = frame->getStride();
+        std::size_t requiredSize = stride * frame->getHeight();
+        if(type == ImgFrame::Type::NV12) requiredSize = frame->getPlaneStride() + stride * ((frame->getHeight() + 1) / 2);
+        if(stride < frame->getWidth() || frame->getData().size() < requiredSize) {
+            logger->warn("AnnotationRenderer: frame data doesn't match its size, forwarding the frame unchanged");
+            out.send(frame);
+            continue;
+        }
+
+        pimpl->reset(static_cast<int>(frame->getWidth()), static_cast<int>(frame->getHeight()));
+        for(const auto& [name, message] : *group) {
+            if(name == frameInputName || message == nullptr) continue;
+            if(!pimpl->add(*message)) logger->warn("AnnotationRenderer: input '{}' has an unsupported message type", name);
+        }
+
+        // Draw into a copy, the input frame may be shared with other nodes
+        auto output = std::make_shared<ImgFrame>();
+        output->setMetadata(frame);
+        output->copyDataFrom(*frame);
+        pimpl->render(*output);
+        out.send(output);
+    }
+}
+
+}  // namespace node
+}  // namespace dai
@@ -1,39 +1,293 @@
 #include "depthai/pipeline/node/host/HostCamera.hpp"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
 #include <opencv2/opencv.hpp>
+#include <stdexcept>
 #include <thread>
 
+#include "pipeline/ThreadedNodeImpl.hpp"
+#include "spdlog/fmt/fmt.h"
+#include "utility/MemoryPool.hpp"
+
 namespace dai {
 namespace node {
 
+namespace {
+
+constexpr int SYNTHETIC_DEFAULT_WIDTH = 640;
+constexpr int SYNTHETIC_DEFAULT_HEIGHT = 480;
+constexpr float DEFAULT_FPS = 30.0f;
+
+// Vertical color bars scrolling by a few pixels every frame, so that consecutive frames differ
+void drawColorBars(cv::Mat& frame, int64_t seqNum) {
+    static const std::array<cv::Vec3b, 8> colors = {cv::Vec3b{255, 255, 255},
+                                                     cv::Vec3b{0, 255, 255},
+                                                     cv::Vec3b{255, 255, 0},
+                                                     cv::Vec3b{0, 255, 0},
+                                                     cv::Vec3b{255, 0, 255},
+                                                     cv::Vec3b{0, 0, 255},
+                                                     cv::Vec3b{255, 0, 0},
+                                                     cv::Vec3b{0, 0, 0}};
+    const int barWidth = std::max(1, frame.cols / static_cast<int>(colors.size()));
+    const int shift = static_cast<int>((seqNum * 4) % frame.cols);
+    auto* row = frame.ptr<cv::Vec3b>(0);
+    for(int x = 0; x < frame.cols; x++) {
+        row[x] = colors[((x + shift) % frame.cols) / barWidth % colors.size()];
+    }
+    for(int y = 1; y < frame.rows; y++) {
+        frame.row(0).copyTo(frame.row(y));
+    }
+}
+
+std::size_t frameSize(ImgFrame::Type type, int width, int height) {
+    const auto pixels = static_cast<std::size_t>(width) * height;
+    switch(type) {
+        case ImgFrame::Type::GRAY8:
+            return pixels;
+        case ImgFrame::Type::NV12:
+            return pixels * 3 / 2;
+        default:
+            return pixels * 3;
+    }
+}
+
+// Converts a BGR frame of the output size into the output frame's data, without intermediate copies where possible
+void convertInto(const cv::Mat& bgr, ImgFrame::Type type, uint8_t* dst, cv::Mat& scratch) {
+    const int width = bgr.cols;
+    const int height = bgr.rows;
+    switch(type) {
+        case ImgFrame::Type::BGR888i: {
+            cv::Mat out(height, width, CV_8UC3, dst);
+            bgr.copyTo(out);
+        } break;
+        case ImgFrame::Type::RGB888i: {
+            cv::Mat out(height, width, CV_8UC3, dst);
+            cv::cvtColor(bgr, out, cv::COLOR_BGR2RGB);
+        } break;
+        case ImgFrame::Type::GRAY8: {
+            cv::Mat out(height, width, CV_8UC1, dst);
+            cv::cvtColor(bgr, out, cv::COLOR_BGR2GRAY);
+        } break;
+        case ImgFrame::Type::NV12: {
+            // OpenCV has no BGR to NV12 conversion - convert to I420 and interleave the chroma planes
+            cv::cvtColor(bgr, scratch, cv::COLOR_BGR2YUV_I420);
+            const std::size_t ySize = static_cast<std::size_t>(width) * height;
+            const std::size_t uvSize = ySize / 4;
+            std::memcpy(dst, scratch.ptr(), ySize);
+            cv::Mat u(height / 2, width / 2, CV_8UC1, scratch.ptr() + ySize);
+            cv::Mat v(height / 2, width / 2, CV_8UC1, scratch.ptr() + ySize + uvSize);
+            cv::Mat uv(height / 2, width / 2, CV_8UC2, dst + ySize);
+            cv::merge(std::vector<cv::Mat>{u, v}, uv);
+        } break;
+        default:
+            throw std::runtime_error("HostCamera: unsupported output frame type");
+    }
+}
+
+}  // namespace
+
+HostCamera& HostCamera::setDeviceIndex(int index) {
+    sourceType = SourceType::DEVICE;
+    deviceIndex = index;
+    return *this;
+}
+
+HostCamera& HostCamera::setFile(const std::filesystem::path& path) {
+    sourceType = SourceType::FILE;
+    file = path;
+    return *this;
+}
+
+HostCamera& HostCamera::setSynthetic() {
+    sourceType = SourceType::SYNTHETIC;
+    return *this;
+}
+
+HostCamera& HostCamera::setSize(int width, int height) {
+    if(width <= 0 || height <= 0) throw std::invalid_argument("HostCamera: size must be positive");
+    size = std::make_tuple(width, height);
+    return *this;
+}
+
+HostCamera& HostCamera::setSize(std::tuple<int, int> size) {
+    return setSize(std::get<0>(size), std::get<1>(size));
+}
+
+HostCamera& HostCamera::setOutFrameType(ImgFrame::Type type) {
+    if(type != ImgFrame::Type::BGR888i && type != ImgFrame::Type::RGB888i && type != ImgFrame::Type::GRAY8 && type != ImgFrame::Type::NV12) {
+        throw std::invalid_argument("HostCamera: output frame type must be one of BGR888i, RGB888i, GRAY8 or NV12");
+    }
+    outFrameType = type;
+    return *this;
+}
+
+HostCamera& HostCamera::setFps(float fps) {
+    if(fps <= 0.0f) throw std::invalid_argument("HostCamera: FPS must be positive");
+    this->fps = fps;
+    return *this;
+}
+
+HostCamera& HostCamera::setLoop(bool loop) {
+    this->loop = loop;
+    return *this;
+}
+
+HostCamera& HostCamera::setNumFramesPool(int num) {
+    if(num < 1) throw std::invalid_argument("HostCamera: frame pool must hold at least one frame");
+    numFramesPool = num;
+    return *this;
+}
+
+HostCamera::SourceType HostCamera::getSourceType() const {
+    return sourceType;
+}
+
+int HostCamera::getDeviceIndex() const {
+    return deviceIndex;
+}
+
+std::filesystem::path HostCamera::getFile() const {
+    return file;
+}
+
+std::optional<std::tuple<int, int>> HostCamera::getSize() const {
+    return size;
+}
+
+ImgFrame::Type HostCamera::getOutFrameType() const {
+    return outFrameType;
+}
+
+std::optional<float> HostCamera::getFps() const {
+    return fps;
+}
+
+bool HostCamera::getLoop() const {
+    return loop;
+}
+
+int HostCamera::getNumFramesPool() const {
+    return numFramesPool;
+}
+
 void HostCamera::run() {
-    // Open a opencv camera
-    cv::VideoCapture cap(0);
-    if(!cap.isOpened()) {
-        throw std::runtime_error("Couldn't open camera");
+    using namespace std::chrono;
+    auto& logger = pimpl->logger;
+
+    cv::VideoCapture cap;
+    float targetFps = fps.value_or(0.0f);
+    if(sourceType == SourceType::DEVICE) {
+        if(!cap.open(deviceIndex)) {
+            throw std::runtime_error(fmt::format("HostCamera: couldn't open camera {}", deviceIndex));
+        }
+        // Hints only - frames are resized below if the camera doesn't support them
+        if(size.has_value()) {
+            cap.set(cv::CAP_PROP_FRAME_WIDTH, std::get<0>(*size));
+            cap.set(cv::CAP_PROP_FRAME_HEIGHT, std::get<1>(*size));
+        }
+        if(fps.has_value()) cap.set(cv::CAP_PROP_FPS, *fps);
+    } else if(sourceType == SourceType::FILE) {
+        if(file.empty()) throw std::runtime_error("HostCamera: file source requires a path");
+        if(!cap.open(file.string())) {
+            throw std::runtime_error(fmt::format("HostCamera: couldn't open '{}'", file.string()));
+        }
+        // Play video files at their own rate
+        if(!fps.has_value()) {
+            const auto fileFps = static_cast<float>(cap.get(cv::CAP_PROP_FPS));
+            targetFps = fileFps > 0.0f ? fileFps : DEFAULT_FPS;
+        }
+    } else if(!fps.has_value()) {
+        targetFps = DEFAULT_FPS;
+    }
+
+    int width = SYNTHETIC_DEFAULT_WIDTH;
+    int height = SYNTHETIC_DEFAULT_HEIGHT;
+    if(size.has_value()) {
+        std::tie(width, height) = *size;
+    } else if(sourceType != SourceType::SYNTHETIC) {
+        width = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_WIDTH));
+        height = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_HEIGHT));
     }
+    auto checkSize = [this](int w, int h) {
+        if(outFrameType == ImgFrame::Type::NV12 && (w % 2 != 0 || h % 2 != 0)) {
+            throw std::runtime_error(fmt::format("HostCamera: NV12 output requires even dimensions, got {}x{}", w, h));
+        }
+    };
+    // Some backends only know the size once the first frame is read
+    if(width > 0 && height > 0) checkSize(width, height);
+
+    utility::MemoryPool pool(numFramesPool);
+    cv::Mat captured, resized, scratch;
+    if(sourceType == SourceType::SYNTHETIC) captured.create(height, width, CV_8UC3);
+
+    const auto period = targetFps > 0.0f ? duration_cast<steady_clock::duration>(duration<double>(1.0 / targetFps)) : steady_clock::duration::zero();
+    auto nextFrame = steady_clock::now();
     int64_t seqNum = 0;
     while(isRunning()) {
-        cv::Mat frame;
-        auto success = cap.read(frame);
-        if(frame.empty() || !success) {
-            throw std::runtime_error("Couldn't capture frame");
+        if(sourceType == SourceType::SYNTHETIC) {
+            drawColorBars(captured, seqNum);
+        } else if(!cap.read(captured) || captured.empty()) {
+            if(sourceType != SourceType::FILE || seqNum == 0) throw std::runtime_error("HostCamera: couldn't capture frame");
+            if(!loop) {
+                logger->info("HostCamera: end of file '{}'", file.string());
+                break;
+            }
+            // Rewind by reopening, as image sequences can't seek
+            cap.open(file.string());
+            if(!cap.read(captured) || captured.empty()) throw std::runtime_error("HostCamera: couldn't restart file");
         }
-        cv::Mat frameResized;
-        cv::resize(frame, frameResized, cv::Size(640, 480));
+
+        // Pacing - the schedule is reset rather than bursting when frames fall behind
+        if(period != steady_clock::duration::zero()) {
+            auto now = steady_clock::now();
+            if(now > nextFrame + period) {
+                nextFrame = now;
+            } else {
+                std::this_thread::sleep_until(nextFrame);
+            }
+            nextFrame += period;
+        }
+        const auto timestamp = steady_clock::now();
+
+        if(captured.channels() == 1) {
+            cv::cvtColor(captured, captured, cv::COLOR_GRAY2BGR);
+        } else if(captured.channels() == 4) {
+            cv::cvtColor(captured, captured, cv::COLOR_BGRA2BGR);
+        }
+        if(width <= 0 || height <= 0) {
+            width = captured.cols;
+            height = captured.rows;
+            checkSize(width, height);
+        }
+        const cv::Mat* bgr = &captured;
+        if(captured.cols != width || captured.rows != height) {
+            cv::resize(captured, resized, cv::Size(width, height));
+            bgr = &resized;
+        }
+
         auto imgFrame = std::make_shared<ImgFrame>();
-        imgFrame->setFrame(frameResized);
-        imgFrame->setTimestamp(std::chrono::steady_clock::now());
+        imgFrame->data = pool.acquire(frameSize(outFrameType, width, height));
+        convertInto(*bgr, outFrameType, imgFrame->getData().data(), scratch);
+        imgFrame->setType(outFrameType);
+        imgFrame->setSize(width, height);
+        imgFrame->setStride(outFrameType == ImgFrame::Type::BGR888i || outFrameType == ImgFrame::Type::RGB888i ? width * 3 : width);
+        imgFrame->fb.p1Offset = 0;
+        imgFrame->fb.p2Offset = outFrameType == ImgFrame::Type::NV12 ? width * height : 0;
+        imgFrame->fb.p3Offset = imgFrame->fb.p2Offset;
+        imgFrame->setSourceSize(width, height);
+        imgFrame->setTimestamp(timestamp);
+        imgFrame->setTimestampDevice(timestamp);
         imgFrame->setSequenceNum(seqNum++);
-        imgFrame->setType(ImgFrame::Type::RGB888i);
-        imgFrame->setWidth(frameResized.cols);
-        imgFrame->setHeight(frameResized.rows);
 
-        cv::imshow("HostCameraPreview", imgFrame->getCvFrame());
-        // Send message
         out.send(imgFrame);
     }
+    if(pool.getNumMisses() > 0) {
+        logger->debug("HostCamera: {} frames were allocated outside of the pool, consider increasing the pool size", pool.getNumMisses());
+    }
 }
 
 }  // namespace node
-}  // namespace dai
\ No newline at end of file
+}  // namespace dai
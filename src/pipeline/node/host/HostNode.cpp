@@ -1,8 +1,13 @@
 #include "depthai/pipeline/node/host/HostNode.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include "depthai/pipeline/Pipeline.hpp"
+#include "pipeline/ThreadedNodeImpl.hpp"
 
 namespace dai {
 namespace node {
@@ -16,7 +21,89 @@ void HostNode::buildStage1() {
     sync->out.link(input);
 }
 
+std::vector<std::shared_ptr<Buffer>> HostNode::processBatch(std::vector<std::shared_ptr<dai::MessageGroup>> groups) {
+    std::vector<std::shared_ptr<Buffer>> outputs;
+    outputs.reserve(groups.size());
+    for(auto& group : groups) {
+        outputs.push_back(processGroup(group));
+    }
+    return outputs;
+}
+
+void HostNode::setMaxBatchSize(std::size_t size) {
+    if(size == 0) throw std::invalid_argument("HostNode batch size must be at least 1");
+    maxBatchSize = size;
+    // Room for a whole batch of synced groups to wait
+    input.setMaxSize(std::max<std::size_t>(size, DEFAULT_QUEUE_SIZE));
+}
+
+std::size_t HostNode::getMaxBatchSize() const {
+    return maxBatchSize;
+}
+
+void HostNode::emit(const std::shared_ptr<Buffer>& msg) {
+    if(fusedNext) {
+        fusedNext->processFused(msg);
+    }
+    // Links added while running are still served
+    out.send(msg);
+}
+
+void HostNode::processFused(const std::shared_ptr<Buffer>& in) {
+    // Stopped, or failed on an earlier message
+    if(!isRunning()) return;
+
+    // Grouped the same way as by the sync node of a single input
+    auto group = fusedGroups.acquire();
+    group->add(fusedInputName, in);
+    group->setTimestamp(in->getTimestamp());
+    group->setTimestampDevice(in->getTimestampDevice());
+    group->setSequenceNum(in->getSequenceNum());
+    // Only this node stops on its exceptions, the node whose thread it runs in keeps going
+    try {
+        auto out = processGroup(std::move(group));
+        if(out) {
+            emit(out);
+        }
+    } catch(const MessageQueue::QueueException& ex) {
+        pimpl->logger->trace("Node stopped with a queue exception: {}", ex.what());
+        stop();
+    } catch(const std::runtime_error& ex) {
+        pimpl->logger->error("Node threw exception, stopping the node. Exception message: {}", ex.what());
+        stop();
+    }
+}
+
+void HostNode::runBatched() {
+    while(isRunning()) {
+        // Wait for the first group, then take the ones already queued behind it
+        std::vector<std::shared_ptr<dai::MessageGroup>> groups{input.get<dai::MessageGroup>()};
+        while(groups.size() < maxBatchSize) {
+            auto next = input.tryGet<dai::MessageGroup>();
+            if(!next) break;
+            groups.push_back(std::move(next));
+        }
+        auto processAndSendBatch = [self = std::static_pointer_cast<HostNode>(shared_from_this()), groups = std::move(groups)]() mutable {
+            for(auto& out : self->processBatch(std::move(groups))) {
+                if(out) {
+                    self->emit(out);
+                }
+            }
+        };
+
+        if(sendProcessToPipeline) {
+            getParentPipeline().addTask(std::move(processAndSendBatch));
+        } else {
+            processAndSendBatch();
+        }
+    }
+}
+
 void HostNode::run() {
+    if(maxBatchSize > 1) {
+        runBatched();
+        return;
+    }
     while(isRunning()) {
         // Get input
         auto in = input.get<dai::MessageGroup>();
@@ -28,7 +115,7 @@ void HostNode::run() {
 
             // Send the output, if there is any
             if(out) {
-                self->out.send(out);
+                self->emit(out);
             }
         };
 
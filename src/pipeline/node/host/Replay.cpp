@@ -6,6 +6,7 @@
 #define _USE_MATH_DEFINES
 #include <chrono>
 #include <cmath>
+#include <algorithm>
 #include <cstdio>
 #include <filesystem>
 #include <memory>
@@ -30,6 +31,16 @@ namespace dai {
 namespace node {
 
 #ifdef DEPTHAI_ENABLE_PROTOBUF
+// Finds a file within an archive set with setReplayArchive
+inline utility::TarMember findArchiveMember(const std::filesystem::path& archive, const std::filesystem::path& name) {
+    const auto members = utility::indexTar(archive);
+    const auto it = std::find_if(members.begin(), members.end(), [&](const auto& member) { return member.name == name.generic_string(); });
+    if(it == members.end()) {
+        throw std::runtime_error("File " + name.generic_string() + " not found in " + archive.string());
+    }
+    return *it;
+}
+
 // Video Message
 inline std::shared_ptr<Buffer> getVideoMessage(const proto::img_frame::ImgFrame& metadata, ImgFrame::Type outFrameType, std::vector<uint8_t>& frame) {
     auto imgFrame = std::make_shared<ImgFrame>();
@@ -186,7 +197,11 @@ void ReplayVideo::run() {
     bool hasVideo = !replayVideo.empty();
     bool hasMetadata = !replayFile.empty();
     if(!replayVideo.empty()) try {
-            videoPlayer.init(replayVideo.string());
+            if(replayArchive.empty()) {
+                videoPlayer.init(replayVideo.string());
+            } else {
+                videoPlayer.init(replayArchive, findArchiveMember(replayArchive, replayVideo));
+            }
             if(size.has_value()) {
                 const auto& [width, height] = size.value();
                 videoPlayer.setSize(width, height);
@@ -196,7 +211,8 @@ void ReplayVideo::run() {
             if(logger) logger->warn("Video not replaying: {}", e.what());
         }
     if(!replayFile.empty()) try {
-            auto schemaName = bytePlayer.init(replayFile.string());
+            auto schemaName = replayArchive.empty() ? bytePlayer.init(replayFile.string())
+                                                    : bytePlayer.init(replayArchive, findArchiveMember(replayArchive, replayFile));
             datatype = utility::schemaNameToDatatype(schemaName);
         } catch(const std::exception& e) {
             hasMetadata = false;
@@ -205,11 +221,17 @@ void ReplayVideo::run() {
     if(!hasVideo) {
         throw std::runtime_error("Video file not found or could not be opened");
     }
+    // Replayed messages pace the clock, so that a simulated clock follows the recorded time
+    auto clock = getClock();
     bool first = true;
-    auto start = std::chrono::steady_clock::now();
+    auto start = clock->now();
     uint64_t index = 0;
-    auto loopStart = std::chrono::steady_clock::now();
-    auto prevMsgTs = loopStart;
+    // Messages are due relative to the first message of the current pass through the recording, not to when the previous one was sent.
+    // Time spent sending doesn't add up, and on a clock shared with other nodes their sleeps don't shift this node's schedule.
+    auto passStart = start;
+    auto firstMsgTs = start;
+    bool newPass = true;
+    auto due = start;
     while(isRunning()) {
         std::shared_ptr<proto::img_frame::ImgFrame> metadata;
         std::vector<uint8_t> frame;
@@ -227,6 +249,8 @@ void ReplayVideo::run() {
                     if(hasVideo) {
                         videoPlayer.restart();
                     }
+                    passStart = due;
+                    newPass = true;
                     continue;
                 }
                 break;
@@ -245,6 +269,8 @@ void ReplayVideo::run() {
                         bytePlayer.restart();
                     }
                     videoPlayer.restart();
+                    passStart = due;
+                    newPass = true;
                     continue;
                 }
                 break;
@@ -263,7 +289,7 @@ void ReplayVideo::run() {
 
         if(!hasMetadata) {
             ImgFrame frame;
-            auto time = std::chrono::steady_clock::now() - start;
+            auto time = clock->now() - start;
             const auto& [width, height] = videoPlayer.size();
             frame.setWidth(width);
             frame.setHeight(height);
@@ -282,23 +308,26 @@ void ReplayVideo::run() {
 
         auto buffer = getVideoMessage(*metadata, outFrameType, frame);
 
-        if(first) prevMsgTs = buffer->getTimestampDevice();
+        if(newPass) {
+            firstMsgTs = buffer->getTimestampDevice();
+            newPass = false;
+        }
 
         if(hasMetadata && !(fps.has_value() && fps.value() > 0.1f)) {
-            std::this_thread::sleep_until(loopStart + (buffer->getTimestampDevice() - prevMsgTs));
+            due = passStart + (buffer->getTimestampDevice() - firstMsgTs);
+            clock->sleepUntil(due);
         }
 
         if(buffer) out.send(buffer);
 
         if(fps.has_value() && fps.value() > 0.1f) {
-            std::this_thread::sleep_until(loopStart + std::chrono::milliseconds((uint32_t)roundf(1000.f / fps.value())));
+            due += std::chrono::milliseconds((uint32_t)roundf(1000.f / fps.value()));
+            clock->sleepUntil(due);
         } else if(!hasMetadata) {
-            std::this_thread::sleep_until(loopStart + std::chrono::milliseconds(1000 / 30));
+            due += std::chrono::milliseconds(1000 / 30);
+            clock->sleepUntil(due);
         }
 
-        loopStart = std::chrono::steady_clock::now();
-        prevMsgTs = buffer->getTimestampDevice();
-
         first = false;
     }
     logger->info("Replay finished - stopping the pipeline!");
@@ -325,7 +354,8 @@ void ReplayMetadataOnly::run() {
     DatatypeEnum datatype = DatatypeEnum::Buffer;
     bool hasMetadata = !replayFile.empty();
     if(!replayFile.empty()) try {
-            auto schemaName = bytePlayer.init(replayFile.string());
+            auto schemaName = replayArchive.empty() ? bytePlayer.init(replayFile.string())
+                                                    : bytePlayer.init(replayArchive, findArchiveMember(replayArchive, replayFile));
             datatype = utility::schemaNameToDatatype(schemaName);
         } catch(const std::exception& e) {
             hasMetadata = false;
@@ -334,9 +364,13 @@ void ReplayMetadataOnly::run() {
     if(!hasMetadata) {
         throw std::runtime_error("Metadata file not found");
     }
+    auto clock = getClock();
     bool first = true;
-    auto loopStart = std::chrono::steady_clock::now();
-    auto prevMsgTs = loopStart;
+    // Paced like ReplayVideo, relative to the first message of the current pass through the recording
+    auto passStart = clock->now();
+    auto firstMsgTs = passStart;
+    bool newPass = true;
+    auto due = passStart;
     while(isRunning()) {
         std::shared_ptr<google::protobuf::Message> metadata;
         std::vector<uint8_t> frame;
@@ -350,6 +384,8 @@ void ReplayMetadataOnly::run() {
             // End of file
             if(loop) {
                 bytePlayer.restart();
+                passStart = due;
+                newPass = true;
                 continue;
             }
             break;
@@ -358,21 +394,23 @@ void ReplayMetadataOnly::run() {
         }
         auto buffer = getMessage(metadata, datatype);
 
-        if(first) prevMsgTs = buffer->getTimestampDevice();
+        if(newPass) {
+            firstMsgTs = buffer->getTimestampDevice();
+            newPass = false;
+        }
 
         if(!(fps.has_value() && fps.value() > 0.1f)) {
-            std::this_thread::sleep_until(loopStart + (buffer->getTimestampDevice() - prevMsgTs));
+            due = passStart + (buffer->getTimestampDevice() - firstMsgTs);
+            clock->sleepUntil(due);
         }
 
         if(buffer) out.send(buffer);
 
         if(fps.has_value() && fps.value() > 0.1f) {
-            std::this_thread::sleep_until(loopStart + std::chrono::milliseconds((uint32_t)roundf(1000.f / fps.value())));
+            due += std::chrono::milliseconds((uint32_t)roundf(1000.f / fps.value()));
+            clock->sleepUntil(due);
         }
 
-        loopStart = std::chrono::steady_clock::now();
-        prevMsgTs = buffer->getTimestampDevice();
-
         first = false;
     }
     try {
@@ -396,6 +434,10 @@ std::filesystem::path ReplayVideo::getReplayVideoFile() const {
     return replayVideo;
 }
 
+std::filesystem::path ReplayVideo::getReplayArchive() const {
+    return replayArchive;
+}
+
 ImgFrame::Type ReplayVideo::getOutFrameType() const {
     return outFrameType;
 }
@@ -422,6 +464,11 @@ ReplayVideo& ReplayVideo::setReplayVideoFile(const std::filesystem::path& replay
     return *this;
 }
 
+ReplayVideo& ReplayVideo::setReplayArchive(const std::filesystem::path& replayArchive) {
+    this->replayArchive = replayArchive;
+    return *this;
+}
+
 ReplayVideo& ReplayVideo::setOutFrameType(ImgFrame::Type outFrameType) {
     this->outFrameType = outFrameType;
     return *this;
@@ -446,6 +493,9 @@ ReplayVideo& ReplayVideo::setLoop(bool loop) {
 std::filesystem::path ReplayMetadataOnly::getReplayFile() const {
     return replayFile;
 }
+std::filesystem::path ReplayMetadataOnly::getReplayArchive() const {
+    return replayArchive;
+}
 float ReplayMetadataOnly::getFps() const {
     return fps.value_or(0.0f);
 }
@@ -457,6 +507,10 @@ ReplayMetadataOnly& ReplayMetadataOnly::setReplayFile(const std::filesystem::pat
     this->replayFile = replayFile;
     return *this;
 }
+ReplayMetadataOnly& ReplayMetadataOnly::setReplayArchive(const std::filesystem::path& replayArchive) {
+    this->replayArchive = replayArchive;
+    return *this;
+}
 ReplayMetadataOnly& ReplayMetadataOnly::setFps(float fps) {
     this->fps = fps;
     return *this;
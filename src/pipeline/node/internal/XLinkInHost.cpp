@@ -9,6 +9,7 @@
 
 // libraries
 #include "depthai/pipeline/datatype/MessageGroup.hpp"
+#include "utility/LogSinks.hpp"
 #include "utility/Logging.hpp"
 
 namespace dai {
@@ -33,6 +34,7 @@ void XLinkInHost::disconnect() {
 }
 
 void XLinkInHost::run() {
+    LogContext::Scope streamScope("stream", streamName);
     // Create a stream for the connection
     bool reconnect = true;
     while(reconnect) {
@@ -43,6 +45,16 @@ void XLinkInHost::run() {
                 // Blocking -- parse packet and gather timing information
                 auto packet = stream.readMove();
                 const auto t1Parse = std::chrono::steady_clock::now();
+                // Multiple messages packed into a single transfer by a coalescing XLinkOutHost
+                if(StreamMessageParser::isCoalesced(&packet)) {
+                    auto msgs = StreamMessageParser::parseCoalesced(&packet);
+                    logger::trace("Received {} coalesced messages ({}) - parsing time: {}",
+                                  msgs.size(),
+                                  streamName,
+                                  std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t1Parse));
+                    for(auto& msg : msgs) out.send(msg);
+                    continue;
+                }
                 const auto msg = StreamMessageParser::parseMessage(std::move(packet));
                 if(std::dynamic_pointer_cast<MessageGroup>(msg) != nullptr) {
                     auto msgGrp = std::static_pointer_cast<MessageGroup>(msg);
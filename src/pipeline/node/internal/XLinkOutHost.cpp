@@ -1,5 +1,7 @@
 #include "depthai/pipeline/node/internal/XLinkOutHost.hpp"
 
+#include <algorithm>
+
 #include "depthai/pipeline/datatype/StreamMessageParser.hpp"
 #include "depthai/xlink/XLinkConnection.hpp"
 #include "depthai/xlink/XLinkConstants.hpp"
@@ -9,6 +11,7 @@
 
 // libraries
 #include "depthai/pipeline/datatype/MessageGroup.hpp"
+#include "utility/LogSinks.hpp"
 #include "utility/Logging.hpp"
 #include "utility/SharedMemory.hpp"
 
@@ -37,44 +40,103 @@ void XLinkOutHost::allowStreamResize(bool allow) {
     allowResize = allow;
 }
 
+void XLinkOutHost::setCoalescing(std::size_t maxBytes, std::chrono::microseconds maxLatency) {
+    coalescingMaxBytes = maxBytes;
+    coalescingMaxLatency = maxLatency;
+}
+
 void XLinkOutHost::run() {
-    // // Create a stream for the connection
-    // TODO(Morato) - automatically increase the buffer size lazily
+    LogContext::Scope streamScope("stream", streamName);
+    using namespace std::chrono;
     bool reconnect = true;
     while(reconnect) {
         reconnect = false;
-        auto currentMaxSize = device::XLINK_USB_BUFFER_MAX_SIZE + device::XLINK_MESSAGE_METADATA_MAX_SIZE;
+        // Sized for the usual messages and for whole coalesced transfers, so that the stream is only reopened for larger ones
+        std::size_t currentMaxSize =
+            std::max<std::size_t>(device::XLINK_USB_BUFFER_MAX_SIZE + device::XLINK_MESSAGE_METADATA_MAX_SIZE, coalescingMaxBytes);
         XLinkStream stream(conn, streamName, currentMaxSize);
-        auto increaseBufferSize = [&stream, &currentMaxSize, this](const std::size_t& maxSize) {
+        auto ensureBufferSize = [&stream, &currentMaxSize, this](std::size_t size) {
+            if(size <= currentMaxSize) return;
             if(!this->allowResize) {
                 logger::error("Data size exceeds the maximum buffer size - please increase the buffer size");
                 throw std::runtime_error("Data size exceeds the maximum buffer size");
             }
-            stream = XLinkStream(this->conn, this->streamName, maxSize);
-            currentMaxSize = maxSize;
+            // Grow geometrically, so that slowly increasing sizes don't reopen the stream on every message
+            auto newSize = std::max(size, 2 * currentMaxSize);
+            stream = XLinkStream(this->conn, this->streamName, newSize);
+            currentMaxSize = newSize;
         };
+        auto writeMessage = [&stream, &ensureBufferSize](const std::shared_ptr<ADatatype>& msg, const std::vector<std::uint8_t>& metadata) {
+            ensureBufferSize(msg->data->getSize() + metadata.size());
+            if(msg->data->getSize() > 0) {
+                auto sharedMemory = std::dynamic_pointer_cast<SharedMemory>(msg->data);
+                if(sharedMemory && sharedMemory->getFd() > 0) {
+                    stream.write(sharedMemory->getFd(), metadata);
+                } else {
+                    stream.write(msg->data->getData(), metadata);
+                }
+            } else {
+                stream.write(metadata);
+            }
+        };
+        // Messages which can share a transfer - groups are followed by their parts and fd backed data can't be copied
+        auto canCoalesce = [this](const std::shared_ptr<ADatatype>& msg, const std::vector<std::uint8_t>& metadata) {
+            if(coalescingMaxBytes == 0 || std::dynamic_pointer_cast<MessageGroup>(msg) != nullptr) return false;
+            auto sharedMemory = std::dynamic_pointer_cast<SharedMemory>(msg->data);
+            if(sharedMemory && sharedMemory->getFd() > 0) return false;
+            return msg->data->getSize() + metadata.size() + StreamMessageParser::getCoalescedTrailerSize(1) <= coalescingMaxBytes;
+        };
+
+        std::vector<std::uint8_t> coalesced;
+        std::vector<std::uint32_t> coalescedSizes;
+        // Message taken from the queue that didn't fit into the previous transfer
+        std::shared_ptr<ADatatype> carried;
         while(isRunning()) {
             try {
-                auto outgoing = in.get();
+                auto outgoing = carried ? std::move(carried) : in.get();
+                carried = nullptr;
                 auto metadata = StreamMessageParser::serializeMetadata(outgoing);
 
-                using namespace std::chrono;
                 // Blocking
                 auto t1 = steady_clock::now();
-                auto outgoingDataSize = outgoing->data->getSize();
-                if(outgoingDataSize > currentMaxSize - metadata.size()) {
-                    increaseBufferSize(outgoingDataSize + metadata.size());
-                }
-                if(outgoing->data->getSize() > 0) {
-                    auto sharedMemory = std::dynamic_pointer_cast<SharedMemory>(outgoing->data);
-                    if(sharedMemory && sharedMemory->getFd() > 0) {
-                        stream.write(sharedMemory->getFd(), metadata);
-                    } else {
-                        stream.write(outgoing->data->getData(), metadata);
+                if(canCoalesce(outgoing, metadata)) {
+                    coalesced.clear();
+                    coalescedSizes.clear();
+                    StreamMessageParser::appendCoalesced(coalesced, coalescedSizes, outgoing->data->getData(), metadata);
+                    const auto deadline = t1 + coalescingMaxLatency;
+                    while(true) {
+                        std::shared_ptr<ADatatype> next;
+                        const auto remaining = deadline - steady_clock::now();
+                        if(remaining > steady_clock::duration::zero()) {
+                            bool timedOut = false;
+                            next = in.get(remaining, timedOut);
+                        } else {
+                            next = in.tryGet();
+                        }
+                        if(next == nullptr) break;
+
+                        auto nextMetadata = StreamMessageParser::serializeMetadata(next);
+                        const auto totalSize = coalesced.size() + next->data->getSize() + nextMetadata.size()
+                                               + StreamMessageParser::getCoalescedTrailerSize(coalescedSizes.size() + 1);
+                        if(!canCoalesce(next, nextMetadata) || totalSize > coalescingMaxBytes) {
+                            carried = std::move(next);
+                            break;
+                        }
+                        StreamMessageParser::appendCoalesced(coalesced, coalescedSizes, next->data->getData(), nextMetadata);
                     }
-                } else {
-                    stream.write(metadata);
+                    StreamMessageParser::finalizeCoalesced(coalesced, coalescedSizes);
+                    ensureBufferSize(coalesced.size());
+                    stream.write(coalesced);
+                    auto t2 = steady_clock::now();
+                    logger::trace("Sent {} coalesced messages to device ({}) - size: {}, sending time: {}",
+                                  coalescedSizes.size(),
+                                  stream.getStreamName(),
+                                  coalesced.size(),
+                                  duration_cast<microseconds>(t2 - t1));
+                    continue;
                 }
+
+                writeMessage(outgoing, metadata);
                 auto t2 = steady_clock::now();
                 // Log
                 if(spdlog::get_level() == spdlog::level::trace) {
@@ -90,16 +152,7 @@ void XLinkOutHost::run() {
                     logger::trace("Sending group message to device with {} messages", msgGroupPtr->group.size());
                     for(auto& msg : msgGroupPtr->group) {
                         logger::trace("Sending part of a group message: {}", msg.first);
-                        auto metadata = StreamMessageParser::serializeMetadata(msg.second);
-                        outgoingDataSize = msg.second->data->getSize();
-                        if(outgoingDataSize > currentMaxSize - metadata.size()) {
-                            increaseBufferSize(outgoingDataSize + metadata.size());
-                        }
-                        if(msg.second->data->getSize() > 0) {
-                            stream.write(msg.second->data->getData(), metadata);
-                        } else {
-                            stream.write(metadata);
-                        }
+                        writeMessage(msg.second, StreamMessageParser::serializeMetadata(msg.second));
                     }
                 }
             } catch(const std::exception& ex) {
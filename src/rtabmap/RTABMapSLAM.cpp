@@ -115,12 +115,13 @@ void RTABMapSLAM::odomPoseCB(std::shared_ptr<dai::ADatatype> data) {
 
 void RTABMapSLAM::run() {
     auto& logger = pimpl->logger;
+    auto clock = getClock();
     while(isRunning()) {
         if(!initialized) {
             continue;
         } else {
             rtabmap::Statistics stats;
-            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            auto now = clock->now();
             if(now - lastProcessTime > std::chrono::milliseconds(int(1000.0f / freq))) {
                 lastProcessTime = now;
                 bool success = rtabmap.process(sensorData, currPose);
@@ -154,11 +155,11 @@ void RTABMapSLAM::run() {
             }
         }
         // save database periodically if set
-        if(saveDatabasePeriodically && std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() > databaseSaveInterval) {
+        if(saveDatabasePeriodically && std::chrono::duration<double>(clock->now() - startTime).count() > databaseSaveInterval) {
             rtabmap.close(true, databasePath);
             rtabmap.init(rtabParams, databasePath);
             logger->info("Database saved at {}", databasePath);
-            startTime = std::chrono::steady_clock::now();
+            startTime = clock->now();
         }
     }
 }
@@ -174,7 +175,7 @@ void RTABMapSLAM::publishGridMap(const std::map<int, rtabmap::Transform>& optimi
         cv::flip(map8U, map8U, 0);
 
         auto mapMsg = std::make_shared<dai::ImgFrame>();
-        mapMsg->setTimestamp(std::chrono::steady_clock::now());
+        mapMsg->setTimestamp(getClock()->now());
         mapMsg->setCvFrame(map8U, ImgFrame::Type::GRAY8);
         occupancyGridMap.send(mapMsg);
     }
@@ -208,8 +209,8 @@ void RTABMapSLAM::initialize(dai::Pipeline& pipeline, int instanceNum, int width
     } else {
         rtabmap.init(rtabParams);
     }
-    lastProcessTime = std::chrono::steady_clock::now();
-    startTime = std::chrono::steady_clock::now();
+    lastProcessTime = getClock()->now();
+    startTime = lastProcessTime;
     occupancyGrid = std::make_unique<rtabmap::OccupancyGrid>(localMaps.get(), rtabParams);
     cloudMap = std::make_unique<rtabmap::CloudMap>(localMaps.get(), rtabParams);
     initialized = true;
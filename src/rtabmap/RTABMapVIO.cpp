@@ -49,8 +49,8 @@ void RTABMapVIO::imuCB(std::shared_ptr<dai::ADatatype> msg) {
         auto& gyroValues = imuPacket.gyroscope;
         double accStamp = std::chrono::duration<double>(acceleroValues.getTimestampDevice().time_since_epoch()).count();
         double gyroStamp = std::chrono::duration<double>(gyroValues.getTimestampDevice().time_since_epoch()).count();
-        accBuffer.emplace_hint(accBuffer.end(), accStamp, cv::Vec3f(acceleroValues.x, acceleroValues.y, acceleroValues.z));
-        gyroBuffer.emplace_hint(gyroBuffer.end(), gyroStamp, cv::Vec3f(gyroValues.x, gyroValues.y, gyroValues.z));
+        accBuffer.push(accStamp, cv::Vec3f(acceleroValues.x, acceleroValues.y, acceleroValues.z));
+        gyroBuffer.push(gyroStamp, cv::Vec3f(gyroValues.x, gyroValues.y, gyroValues.z));
     }
 }
 
@@ -81,38 +81,13 @@ void RTABMapVIO::syncCB(std::shared_ptr<dai::ADatatype> data) {
                 sensorData.setFeatures(keypoints, std::vector<cv::Point3f>(), cv::Mat());
             }
             std::lock_guard<std::mutex> lock(imuMtx);
-            cv::Vec3d acc, gyro;
-            std::map<double, cv::Vec3f>::const_iterator iterA, iterB;
-
-            if(!accBuffer.empty() && !gyroBuffer.empty() && accBuffer.rbegin()->first >= stamp && gyroBuffer.rbegin()->first >= stamp) {
-                // acc
-                iterB = accBuffer.lower_bound(stamp);
-                if(iterB != accBuffer.end()) {
-                    iterA = iterB;
-                    if(iterA != accBuffer.begin()) --iterA;
-                    if(iterA == iterB || stamp == iterB->first) {
-                        acc = iterB->second;
-                    } else if(stamp > iterA->first && stamp < iterB->first) {
-                        float t = (stamp - iterA->first) / (iterB->first - iterA->first);
-                        acc = iterA->second + t * (iterB->second - iterA->second);
-                    }
-                    accBuffer.erase(accBuffer.begin(), iterB);
-                }
-
-                // gyro
-                iterB = gyroBuffer.lower_bound(stamp);
-                if(iterB != gyroBuffer.end()) {
-                    iterA = iterB;
-                    if(iterA != gyroBuffer.begin()) --iterA;
-                    if(iterA == iterB || stamp == iterB->first) {
-                        gyro = iterB->second;
-                    } else if(stamp > iterA->first && stamp < iterB->first) {
-                        float t = (stamp - iterA->first) / (iterB->first - iterA->first);
-                        gyro = iterA->second + t * (iterB->second - iterA->second);
-                    }
-                    gyroBuffer.erase(gyroBuffer.begin(), iterB);
-                }
-                sensorData.setIMU(rtabmap::IMU(gyro, cv::Mat::eye(3, 3, CV_64FC1), acc, cv::Mat::eye(3, 3, CV_64FC1), imuLocalTransform));
+            auto acc = accBuffer.interpolate(stamp);
+            auto gyro = gyroBuffer.interpolate(stamp);
+            if(acc && gyro) {
+                accBuffer.pruneBefore(stamp);
+                gyroBuffer.pruneBefore(stamp);
+                sensorData.setIMU(rtabmap::IMU(
+                    cv::Vec3d(*gyro), cv::Mat::eye(3, 3, CV_64FC1), cv::Vec3d(*acc), cv::Mat::eye(3, 3, CV_64FC1), imuLocalTransform));
             }
             rtabmap::OdometryInfo info;
             auto pose = odom->process(sensorData, &info);
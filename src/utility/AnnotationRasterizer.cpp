@@ -0,0 +1,481 @@
+#include "AnnotationRasterizer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace dai {
+namespace impl {
+
+namespace {
+
+constexpr int GLYPH_COLUMNS = 5;
+constexpr int GLYPH_ROWS = 7;
+constexpr int CELL_WIDTH = 6;
+constexpr int CELL_HEIGHT = 8;
+constexpr char FIRST_GLYPH = ' ';
+constexpr char LAST_GLYPH = '~';
+constexpr int MAX_SCALE = 32;
+
+// Printable ASCII, one byte per row with the leftmost column in bit 4
+constexpr std::array<std::array<std::uint8_t, GLYPH_ROWS>, LAST_GLYPH - FIRST_GLYPH + 1> FONT{{
+    {{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},  // space
+    {{0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04}},  // !
+    {{0x0A, 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00}},  // "
+    {{0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A}},  // #
+    {{0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04}},  // $
+    {{0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03}},  // %
+    {{0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D}},  // &
+    {{0x04, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00}},  // '
+    {{0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02}},  // (
+    {{0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08}},  // )
+    {{0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00}},  // *
+    {{0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00}},  // +
+    {{0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08}},  // ,
+    {{0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00}},  // -
+    {{0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C}},  // .
+    {{0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00}},  // /
+    {{0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}},  // 0
+    {{0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}},  // 1
+    {{0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}},  // 2
+    {{0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}},  // 3
+    {{0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}},  // 4
+    {{0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}},  // 5
+    {{0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}},  // 6
+    {{0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}},  // 7
+    {{0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}},  // 8
+    {{0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}},  // 9
+    {{0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00}},  // :
+    {{0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08}},  // ;
+    {{0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02}},  // <
+    {{0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00}},  // =
+    {{0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08}},  // >
+    {{0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}},  // ?
+    {{0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E}},  // @
+    {{0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}},  // A
+    {{0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}},  // B
+    {{0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}},  // C
+    {{0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C}},  // D
+    {{0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}},  // E
+    {{0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}},  // F
+    {{0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F}},  // G
+    {{0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}},  // H
+    {{0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}},  // I
+    {{0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}},  // J
+    {{0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}},  // K
+    {{0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}},  // L
+    {{0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11}},  // M
+    {{0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}},  // N
+    {{0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}},  // O
+    {{0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}},  // P
+    {{0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}},  // Q
+    {{0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}},  // R
+    {{0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}},  // S
+    {{0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}},  // T
+    {{0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}},  // U
+    {{0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}},  // V
+    {{0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A}},  // W
+    {{0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}},  // X
+    {{0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04}},  // Y
+    {{0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}},  // Z
+    {{0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E}},  // [
+    {{0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00}},  // backslash
+    {{0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E}},  // ]
+    {{0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00}},  // ^
+    {{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F}},  // _
+    {{0x08, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00}},  // `
+    {{0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F}},  // a
+    {{0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E}},  // b
+    {{0x00, 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E}},  // c
+    {{0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F}},  // d
+    {{0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E}},  // e
+    {{0x06, 0x09, 0x08, 0x1C, 0x08, 0x08, 0x08}},  // f
+    {{0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x0E}},  // g
+    {{0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11}},  // h
+    {{0x04, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x0E}},  // i
+    {{0x02, 0x00, 0x06, 0x02, 0x02, 0x12, 0x0C}},  // j
+    {{0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12}},  // k
+    {{0x0C, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}},  // l
+    {{0x00, 0x00, 0x1A, 0x15, 0x15, 0x11, 0x11}},  // m
+    {{0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11}},  // n
+    {{0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E}},  // o
+    {{0x00, 0x00, 0x1E, 0x11, 0x1E, 0x10, 0x10}},  // p
+    {{0x00, 0x00, 0x0D, 0x13, 0x0F, 0x01, 0x01}},  // q
+    {{0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10}},  // r
+    {{0x00, 0x00, 0x0E, 0x10, 0x0E, 0x01, 0x1E}},  // s
+    {{0x08, 0x08, 0x1C, 0x08, 0x08, 0x09, 0x06}},  // t
+    {{0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D}},  // u
+    {{0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04}},  // v
+    {{0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A}},  // w
+    {{0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11}},  // x
+    {{0x00, 0x00, 0x11, 0x11, 0x0F, 0x01, 0x0E}},  // y
+    {{0x00, 0x00, 0x1F, 0x02, 0x04, 0x08, 0x1F}},  // z
+    {{0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02}},  // {
+    {{0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}},  // |
+    {{0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08}},  // }
+    {{0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00}},  // ~
+}};
+
+std::uint8_t toByte(float value) {
+    return static_cast<std::uint8_t>(std::lround(std::clamp(value, 0.f, 255.f)));
+}
+
+inline void blend(std::uint8_t& dst, std::uint8_t src, unsigned alpha) {
+    dst = static_cast<std::uint8_t>((dst * (255u - alpha) + src * alpha + 127u) / 255u);
+}
+
+// Pixel centers are at integer coordinates, as in OpenCV. A span [from, to) covers the pixels from firstPixel(from) to firstPixel(to) - 1.
+inline int firstPixel(float x) {
+    return static_cast<int>(std::ceil(x));
+}
+
+}  // namespace
+
+AnnotationRasterizer::Paint AnnotationRasterizer::makePaint(const Color& color) {
+    const float r = color.r * 255.f;
+    const float g = color.g * 255.f;
+    const float b = color.b * 255.f;
+    Paint paint;
+    paint.gray = toByte(0.299f * r + 0.587f * g + 0.114f * b);
+    paint.y = toByte(16.f + (65.481f * r + 128.553f * g + 24.966f * b) / 255.f);
+    paint.u = toByte(128.f + (-37.797f * r - 74.203f * g + 112.f * b) / 255.f);
+    paint.v = toByte(128.f + (112.f * r - 93.786f * g - 18.214f * b) / 255.f);
+    paint.alpha = toByte(color.a * 255.f);
+    return paint;
+}
+
+int AnnotationRasterizer::getScale(float fontSize) {
+    return std::clamp(static_cast<int>(std::lround(fontSize / CELL_HEIGHT)), 1, MAX_SCALE);
+}
+
+int AnnotationRasterizer::getLineHeight(float fontSize) {
+    return CELL_HEIGHT * getScale(fontSize);
+}
+
+int AnnotationRasterizer::getTextWidth(const std::string& text, float fontSize) {
+    return CELL_WIDTH * getScale(fontSize) * static_cast<int>(text.size());
+}
+
+const AnnotationRasterizer::GlyphAtlas& AnnotationRasterizer::getAtlas(int scale) {
+    static std::mutex mtx;
+    static std::map<int, std::unique_ptr<GlyphAtlas>> atlases;
+
+    std::lock_guard<std::mutex> lock(mtx);
+    auto& atlas = atlases[scale];
+    if(atlas) return *atlas;
+
+    atlas = std::make_unique<GlyphAtlas>();
+    atlas->cellWidth = CELL_WIDTH * scale;
+    atlas->cellHeight = CELL_HEIGHT * scale;
+    atlas->stride = static_cast<std::size_t>(atlas->cellWidth) * FONT.size();
+    atlas->pixels.assign(atlas->stride * atlas->cellHeight, 0);
+    for(std::size_t glyph = 0; glyph < FONT.size(); glyph++) {
+        for(int row = 0; row < GLYPH_ROWS; row++) {
+            for(int column = 0; column < GLYPH_COLUMNS; column++) {
+                if(!(FONT[glyph][row] & (0x10 >> column))) continue;
+                for(int y = row * scale; y < (row + 1) * scale; y++) {
+                    auto* dst = atlas->pixels.data() + y * atlas->stride + glyph * atlas->cellWidth + column * scale;
+                    std::fill(dst, dst + scale, 1);
+                }
+            }
+        }
+    }
+    return *atlas;
+}
+
+void AnnotationRasterizer::clear() {
+    primitives.clear();
+    edges.clear();
+    lines.clear();
+}
+
+std::size_t AnnotationRasterizer::size() const {
+    return primitives.size();
+}
+
+void AnnotationRasterizer::addContour(const Point2f* points, std::size_t count) {
+    for(std::size_t i = 0; i < count; i++) {
+        edges.push_back({points[i], points[(i + 1) % count]});
+    }
+}
+
+void AnnotationRasterizer::addPolygon(const Paint& paint, std::size_t firstEdge) {
+    if(paint.alpha == 0 || edges.size() == firstEdge) {
+        edges.resize(firstEdge);
+        return;
+    }
+    float top = edges[firstEdge].from.y;
+    float bottom = top;
+    for(std::size_t i = firstEdge; i < edges.size(); i++) {
+        top = std::min(top, edges[i].from.y);
+        bottom = std::max(bottom, edges[i].from.y);
+    }
+    Primitive primitive;
+    primitive.shape = Shape::POLYGON;
+    primitive.paint = paint;
+    primitive.top = firstPixel(top);
+    primitive.bottom = firstPixel(bottom);
+    primitive.first = firstEdge;
+    primitive.count = edges.size() - firstEdge;
+    if(primitive.top >= primitive.bottom) {
+        edges.resize(firstEdge);
+        return;
+    }
+    primitives.push_back(primitive);
+}
+
+void AnnotationRasterizer::addQuad(Point2f from, Point2f to, float thickness, const Paint& paint) {
+    const float half = std::max(thickness, 1.f) / 2.f;
+    const float dx = to.x - from.x;
+    const float dy = to.y - from.y;
+    const float length = std::hypot(dx, dy);
+    // Direction along the segment and its normal, both half the thickness long. Ends are extended by the same amount (square caps).
+    const float ux = length > 0.f ? dx / length * half : half;
+    const float uy = length > 0.f ? dy / length * half : 0.f;
+    const std::array<Point2f, 4> corners{Point2f(from.x - ux - uy, from.y - uy + ux),
+                                         Point2f(to.x + ux - uy, to.y + uy + ux),
+                                         Point2f(to.x + ux + uy, to.y + uy - ux),
+                                         Point2f(from.x - ux + uy, from.y - uy - ux)};
+    const auto firstEdge = edges.size();
+    addContour(corners.data(), corners.size());
+    addPolygon(paint, firstEdge);
+}
+
+void AnnotationRasterizer::drawLine(Point2f from, Point2f to, float thickness, const Color& color) {
+    addQuad(from, to, thickness, makePaint(color));
+}
+
+void AnnotationRasterizer::drawPolyline(const std::vector<Point2f>& points, bool closed, float thickness, const Color& color) {
+    const auto paint = makePaint(color);
+    if(points.size() == 1) {
+        addQuad(points.front(), points.front(), thickness, paint);
+        return;
+    }
+    for(std::size_t i = 0; i + 1 < points.size(); i++) {
+        addQuad(points[i], points[i + 1], thickness, paint);
+    }
+    if(closed && points.size() > 2) addQuad(points.back(), points.front(), thickness, paint);
+}
+
+void AnnotationRasterizer::fillPolygon(const std::vector<Point2f>& points, const Color& color) {
+    if(points.size() < 3) return;
+    const auto firstEdge = edges.size();
+    addContour(points.data(), points.size());
+    addPolygon(makePaint(color), firstEdge);
+}
+
+void AnnotationRasterizer::drawRectangle(Point2f topLeft, Point2f bottomRight, float thickness, const Color& outline, const Color& fill) {
+    const auto rectangle = [](float left, float top, float right, float bottom) {
+        return std::array<Point2f, 4>{Point2f(left, top), Point2f(right, top), Point2f(right, bottom), Point2f(left, bottom)};
+    };
+    const float left = std::min(topLeft.x, bottomRight.x);
+    const float right = std::max(topLeft.x, bottomRight.x);
+    const float top = std::min(topLeft.y, bottomRight.y);
+    const float bottom = std::max(topLeft.y, bottomRight.y);
+
+    auto firstEdge = edges.size();
+    const auto inside = rectangle(left, top, right, bottom);
+    addContour(inside.data(), inside.size());
+    addPolygon(makePaint(fill), firstEdge);
+
+    // Outline centered on the border, a frame between two contours
+    const float half = std::max(thickness, 1.f) / 2.f;
+    firstEdge = edges.size();
+    const auto outer = rectangle(left - half, top - half, right + half, bottom + half);
+    addContour(outer.data(), outer.size());
+    if(right - left > 2 * half && bottom - top > 2 * half) {
+        const auto inner = rectangle(left + half, top + half, right - half, bottom - half);
+        addContour(inner.data(), inner.size());
+    }
+    addPolygon(makePaint(outline), firstEdge);
+}
+
+void AnnotationRasterizer::drawCircle(Point2f center, float radius, float thickness, const Color& outline, const Color& fill) {
+    const auto add = [this, center](const Paint& paint, float outerRadius, float innerRadius) {
+        if(paint.alpha == 0 || outerRadius <= 0.f) return;
+        Primitive primitive;
+        primitive.shape = Shape::RING;
+        primitive.paint = paint;
+        primitive.cx = center.x;
+        primitive.cy = center.y;
+        primitive.outerRadius = outerRadius;
+        primitive.innerRadius = innerRadius;
+        primitive.top = firstPixel(center.y - outerRadius);
+        primitive.bottom = firstPixel(center.y + outerRadius);
+        if(primitive.top < primitive.bottom) primitives.push_back(primitive);
+    };
+    const float half = std::max(thickness, 1.f) / 2.f;
+    add(makePaint(fill), radius, -1.f);
+    add(makePaint(outline), radius + half, radius - half);
+}
+
+void AnnotationRasterizer::drawText(Point2f position, const std::string& text, float fontSize, const Color& color, const Color& background) {
+    const auto& atlas = getAtlas(getScale(fontSize));
+    const auto paint = makePaint(color);
+    const auto backgroundPaint = makePaint(background);
+    const int x = firstPixel(position.x);
+    int y = firstPixel(position.y);
+
+    std::size_t lineStart = 0;
+    while(lineStart <= text.size()) {
+        auto lineEnd = text.find('\n', lineStart);
+        if(lineEnd == std::string::npos) lineEnd = text.size();
+        const auto count = lineEnd - lineStart;
+        if(count > 0) {
+            if(backgroundPaint.alpha != 0) {
+                const float left = static_cast<float>(x);
+                const float top = static_cast<float>(y);
+                const std::array<Point2f, 4> box{Point2f(left, top),
+                                                 Point2f(left + atlas.cellWidth * count, top),
+                                                 Point2f(left + atlas.cellWidth * count, top + atlas.cellHeight),
+                                                 Point2f(left, top + atlas.cellHeight)};
+                const auto firstEdge = edges.size();
+                addContour(box.data(), box.size());
+                addPolygon(backgroundPaint, firstEdge);
+            }
+            if(paint.alpha != 0) {
+                Primitive primitive;
+                primitive.shape = Shape::TEXT;
+                primitive.paint = paint;
+                primitive.top = y;
+                primitive.bottom = y + atlas.cellHeight;
+                primitive.x = x;
+                primitive.atlas = &atlas;
+                primitive.first = lines.size();
+                lines.push_back(text.substr(lineStart, count));
+                primitives.push_back(primitive);
+            }
+        }
+        y += atlas.cellHeight;
+        lineStart = lineEnd + 1;
+    }
+}
+
+void AnnotationRasterizer::spans(const Primitive& primitive, int y, int width, std::vector<Span>& out, std::vector<float>& scratch) const {
+    out.clear();
+    const auto add = [&out, width](int begin, int end) {
+        begin = std::max(begin, 0);
+        end = std::min(end, width);
+        if(begin < end) out.push_back({begin, end});
+    };
+    const float center = static_cast<float>(y);
+
+    switch(primitive.shape) {
+        case Shape::POLYGON: {
+            scratch.clear();
+            for(std::size_t i = primitive.first; i < primitive.first + primitive.count; i++) {
+                const auto& edge = edges[i];
+                if((edge.from.y <= center) == (edge.to.y <= center)) continue;
+                scratch.push_back(edge.from.x + (center - edge.from.y) * (edge.to.x - edge.from.x) / (edge.to.y - edge.from.y));
+            }
+            std::sort(scratch.begin(), scratch.end());
+            for(std::size_t i = 0; i + 1 < scratch.size(); i += 2) {
+                add(firstPixel(scratch[i]), firstPixel(scratch[i + 1]));
+            }
+        } break;
+
+        case Shape::RING: {
+            const float dy = center - primitive.cy;
+            if(std::abs(dy) >= primitive.outerRadius) break;
+            const float outer = std::sqrt(primitive.outerRadius * primitive.outerRadius - dy * dy);
+            if(std::abs(dy) < primitive.innerRadius) {
+                const float inner = std::sqrt(primitive.innerRadius * primitive.innerRadius - dy * dy);
+                add(firstPixel(primitive.cx - outer), firstPixel(primitive.cx - inner));
+                add(firstPixel(primitive.cx + inner), firstPixel(primitive.cx + outer));
+            } else {
+                add(firstPixel(primitive.cx - outer), firstPixel(primitive.cx + outer));
+            }
+        } break;
+
+        case Shape::TEXT: {
+            const auto& atlas = *primitive.atlas;
+            const auto& line = lines[primitive.first];
+            const auto* row = atlas.pixels.data() + static_cast<std::size_t>(y - primitive.top) * atlas.stride;
+            for(std::size_t i = 0; i < line.size(); i++) {
+                const int cellX = primitive.x + static_cast<int>(i) * atlas.cellWidth;
+                if(cellX >= width) break;
+                if(cellX + atlas.cellWidth <= 0) continue;
+                char c = line[i];
+                if(c < FIRST_GLYPH || c > LAST_GLYPH) c = '?';
+                const auto* glyph = row + static_cast<std::size_t>(c - FIRST_GLYPH) * atlas.cellWidth;
+                for(int x = 0; x < atlas.cellWidth; x++) {
+                    if(!glyph[x]) continue;
+                    int end = x + 1;
+                    while(end < atlas.cellWidth && glyph[end]) end++;
+                    add(cellX + x, cellX + end);
+                    x = end;
+                }
+            }
+        } break;
+    }
+}
+
+void AnnotationRasterizer::renderRows(const Canvas& canvas, int rowStart, int rowEnd) const {
+    const bool nv12 = canvas.format == Format::NV12;
+    const int chromaWidth = (canvas.width + 1) / 2;
+    std::vector<Span> rowSpans;
+    std::vector<float> scratch;
+    std::vector<std::uint8_t> covered(nv12 ? chromaWidth : 0, 0);
+
+    for(const auto& primitive : primitives) {
+        const int top = std::max(primitive.top, rowStart);
+        const int bottom = std::min(primitive.bottom, rowEnd);
+        if(top >= bottom) continue;
+        const auto& paint = primitive.paint;
+        const std::uint8_t value = nv12 ? paint.y : paint.gray;
+
+        // A chroma sample is painted once if any of its four luma pixels is covered
+        int first = chromaWidth;
+        int last = -1;
+        for(int y = top; y < bottom; y++) {
+            spans(primitive, y, canvas.width, rowSpans, scratch);
+            auto* row = canvas.luma + static_cast<std::size_t>(y) * canvas.lumaStride;
+            for(const auto& span : rowSpans) {
+                for(int x = span.begin; x < span.end; x++) blend(row[x], value, paint.alpha);
+            }
+            if(!nv12) continue;
+
+            for(const auto& span : rowSpans) {
+                std::fill(covered.begin() + span.begin / 2, covered.begin() + (span.end - 1) / 2 + 1, 1);
+                first = std::min(first, span.begin / 2);
+                last = std::max(last, (span.end - 1) / 2);
+            }
+            if(y % 2 == 0 && y + 1 < bottom) continue;
+            auto* chromaRow = canvas.chroma + static_cast<std::size_t>(y / 2) * canvas.chromaStride;
+            for(int x = first; x <= last; x++) {
+                if(!covered[x]) continue;
+                blend(chromaRow[2 * x], paint.u, paint.alpha);
+                blend(chromaRow[2 * x + 1], paint.v, paint.alpha);
+                covered[x] = 0;
+            }
+            first = chromaWidth;
+            last = -1;
+        }
+    }
+}
+
+void AnnotationRasterizer::render(const Canvas& canvas, int numThreads) const {
+    if(canvas.width <= 0 || canvas.height <= 0 || primitives.empty()) return;
+
+    // Tiles start on even rows so that no chroma row is shared between tiles
+    const int pairs = (canvas.height + 1) / 2;
+    const int numTiles = std::max(1, std::min(numThreads, pairs));
+    const int rowsPerTile = pairs / numTiles * 2;
+
+    // Process first tile on the calling thread
+    std::vector<std::future<void>> futures;
+    for(int t = 1; t < numTiles; t++) {
+        const int rowStart = t * rowsPerTile;
+        const int rowEnd = (t == numTiles - 1) ? canvas.height : (rowStart + rowsPerTile);
+        futures.emplace_back(std::async(std::launch::async, [this, &canvas, rowStart, rowEnd]() { renderRows(canvas, rowStart, rowEnd); }));
+    }
+    renderRows(canvas, 0, numTiles == 1 ? canvas.height : rowsPerTile);
+    for(auto& future : futures) future.get();
+}
+
+}  // namespace impl
+}  // namespace dai
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "depthai/common/Color.hpp"
+#include "depthai/common/Point2f.hpp"
+
+namespace dai {
+namespace impl {
+
+/**
+ * Draws annotation primitives directly into 8 bit YUV image planes, GRAY8 (luma only) or NV12 (luma and interleaved
+ * half resolution chroma), without converting the frame to BGR. Colors are converted once per primitive, to full range luma for GRAY8
+ * and to BT.601 limited range YUV for NV12.
+ *
+ * Primitives are recorded in pixel coordinates first and composited by render() in horizontal tiles. Each tile draws the primitives
+ * overlapping it in recording order, so tiles can be processed concurrently and the result doesn't depend on the number of threads.
+ * Pixel centers are at integer coordinates, as in OpenCV. Coverage is binary (pixel centers inside the shape), alpha comes from the color only.
+ *
+ * Text uses a built in 5x7 bitmap font in 6x8 cells, scaled by an integer factor closest to fontSize / 8.
+ * The scaled glyphs are rasterized once and kept in a glyph atlas per scale.
+ */
+class AnnotationRasterizer {
+   public:
+    enum class Format { GRAY8, NV12 };
+
+    /**
+     * Image planes to draw into. For NV12 the chroma plane is interleaved UV with half the width and height of the luma plane.
+     */
+    struct Canvas {
+        Format format = Format::GRAY8;
+        int width = 0;
+        int height = 0;
+        std::uint8_t* luma = nullptr;
+        std::size_t lumaStride = 0;
+        std::uint8_t* chroma = nullptr;
+        std::size_t chromaStride = 0;
+    };
+
+    /// Height of a text line in pixels for the given font size
+    static int getLineHeight(float fontSize);
+    /// Width of a single line of text in pixels for the given font size
+    static int getTextWidth(const std::string& text, float fontSize);
+
+    /**
+     * Removes all primitives
+     */
+    void clear();
+
+    /**
+     * Number of recorded primitives
+     */
+    std::size_t size() const;
+
+    void drawLine(Point2f from, Point2f to, float thickness, const Color& color);
+    void drawPolyline(const std::vector<Point2f>& points, bool closed, float thickness, const Color& color);
+    void fillPolygon(const std::vector<Point2f>& points, const Color& color);
+    void drawRectangle(Point2f topLeft, Point2f bottomRight, float thickness, const Color& outline, const Color& fill = {});
+    void drawCircle(Point2f center, float radius, float thickness, const Color& outline, const Color& fill = {});
+    /**
+     * Draws text with its top left corner at position. Lines are separated by '\n', characters outside of printable ASCII are drawn as '?'.
+     */
+    void drawText(Point2f position, const std::string& text, float fontSize, const Color& color, const Color& background = {});
+
+    /**
+     * Composites all recorded primitives into the canvas
+     * @param numThreads Number of tiles processed concurrently
+     */
+    void render(const Canvas& canvas, int numThreads = 1) const;
+
+   private:
+    struct Paint {
+        std::uint8_t gray = 0;
+        std::uint8_t y = 16;
+        std::uint8_t u = 128;
+        std::uint8_t v = 128;
+        std::uint8_t alpha = 0;
+    };
+
+    struct GlyphAtlas {
+        int cellWidth = 0;
+        int cellHeight = 0;
+        std::size_t stride = 0;
+        /// All glyphs next to each other, one byte per pixel
+        std::vector<std::uint8_t> pixels;
+    };
+
+    enum class Shape { POLYGON, RING, TEXT };
+
+    struct Primitive {
+        Shape shape = Shape::POLYGON;
+        Paint paint;
+        /// Rows covered, [top, bottom)
+        int top = 0;
+        int bottom = 0;
+        /// POLYGON edges as [first, first + count), or TEXT line index
+        std::size_t first = 0;
+        std::size_t count = 0;
+        /// RING center and radii, a filled circle has innerRadius < 0
+        float cx = 0.f;
+        float cy = 0.f;
+        float outerRadius = 0.f;
+        float innerRadius = -1.f;
+        /// TEXT origin and glyphs
+        int x = 0;
+        const GlyphAtlas* atlas = nullptr;
+    };
+
+    struct Edge {
+        Point2f from;
+        Point2f to;
+    };
+
+    struct Span {
+        int begin;
+        int end;
+    };
+
+    static Paint makePaint(const Color& color);
+    static int getScale(float fontSize);
+    static const GlyphAtlas& getAtlas(int scale);
+
+    /// Adds a closed contour to the polygon being built, filled with the even-odd rule
+    void addContour(const Point2f* points, std::size_t count);
+    void addPolygon(const Paint& paint, std::size_t firstEdge);
+    void addQuad(Point2f from, Point2f to, float thickness, const Paint& paint);
+    void spans(const Primitive& primitive, int y, int width, std::vector<Span>& out, std::vector<float>& scratch) const;
+    void renderRows(const Canvas& canvas, int rowStart, int rowEnd) const;
+
+    std::vector<Primitive> primitives;
+    std::vector<Edge> edges;
+    std::vector<std::string> lines;
+};
+
+}  // namespace impl
+}  // namespace dai
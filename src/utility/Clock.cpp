@@ -0,0 +1,56 @@
+#include "depthai/utility/Clock.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace dai {
+
+PipelineClock::~PipelineClock() = default;
+
+void PipelineClock::sleepFor(duration sleepDuration) {
+    sleepUntil(now() + sleepDuration);
+}
+
+bool PipelineClock::isSimulated() const {
+    return false;
+}
+
+std::shared_ptr<PipelineClock> PipelineClock::steady() {
+    static const auto steadyClock = std::make_shared<SteadyPipelineClock>();
+    return steadyClock;
+}
+
+SteadyPipelineClock::time_point SteadyPipelineClock::now() const {
+    return Clock::now();
+}
+
+void SteadyPipelineClock::sleepUntil(time_point timePoint) {
+    std::this_thread::sleep_until(timePoint);
+}
+
+SimulatedPipelineClock::SimulatedPipelineClock(time_point start) : current(start) {}
+
+SimulatedPipelineClock::time_point SimulatedPipelineClock::now() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return current;
+}
+
+void SimulatedPipelineClock::sleepUntil(time_point timePoint) {
+    advanceTo(timePoint);
+}
+
+bool SimulatedPipelineClock::isSimulated() const {
+    return true;
+}
+
+void SimulatedPipelineClock::advanceTo(time_point timePoint) {
+    std::lock_guard<std::mutex> lock(mtx);
+    current = std::max(current, timePoint);
+}
+
+void SimulatedPipelineClock::advance(duration step) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if(step > duration::zero()) current += step;
+}
+
+}  // namespace dai
@@ -3,9 +3,14 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <nlohmann/json.hpp>
+#include <optional>
 #include <stdexcept>
 
 #include "archive.h"
@@ -70,6 +75,60 @@ std::vector<uint8_t> inflate(span<uint8_t>& data) {
     return result;
 }
 
+namespace {
+// zlib's windowBits to read and write the gzip wrapper instead of the zlib one
+constexpr int GZIP_WINDOW_BITS = 15 + 16;
+constexpr size_t GZIP_CHUNK_SIZE = 64 * 1024;
+}  // namespace
+
+std::vector<uint8_t> gzip(const uint8_t* data, size_t size, int compressionLevel) {
+    z_stream stream{};
+    int ret = deflateInit2(&stream, compressionLevel, Z_DEFLATED, GZIP_WINDOW_BITS, 8, Z_DEFAULT_STRATEGY);
+    if(ret != Z_OK) {
+        throw std::runtime_error("deflateInit2 failed with error code " + std::to_string(ret) + ".");
+    }
+    std::vector<uint8_t> result(deflateBound(&stream, size));
+    stream.next_in = const_cast<uint8_t*>(data);
+    stream.avail_in = static_cast<uInt>(size);
+    stream.next_out = result.data();
+    stream.avail_out = static_cast<uInt>(result.size());
+    ret = deflate(&stream, Z_FINISH);
+    deflateEnd(&stream);
+    if(ret != Z_STREAM_END) {
+        throw std::runtime_error("Could not finish gzip compression.");
+    }
+    result.resize(stream.total_out);
+    return result;
+}
+
+std::vector<uint8_t> gunzip(const uint8_t* data, size_t size) {
+    z_stream stream{};
+    int ret = inflateInit2(&stream, GZIP_WINDOW_BITS);
+    if(ret != Z_OK) {
+        throw std::runtime_error("inflateInit2 failed with error code " + std::to_string(ret) + ".");
+    }
+    std::vector<uint8_t> result;
+    stream.next_in = const_cast<uint8_t*>(data);
+    stream.avail_in = static_cast<uInt>(size);
+    do {
+        result.resize(result.size() + GZIP_CHUNK_SIZE);
+        stream.next_out = result.data() + stream.total_out;
+        stream.avail_out = static_cast<uInt>(GZIP_CHUNK_SIZE);
+        ret = inflate(&stream, Z_NO_FLUSH);
+        if(ret != Z_OK && ret != Z_STREAM_END) {
+            inflateEnd(&stream);
+            throw std::runtime_error("gunzip failed with error code " + std::to_string(ret) + ".");
+        }
+        if(ret == Z_OK && stream.avail_in == 0 && stream.avail_out != 0) {
+            inflateEnd(&stream);
+            throw std::runtime_error("Truncated gzip stream.");
+        }
+    } while(ret != Z_STREAM_END);
+    result.resize(stream.total_out);
+    inflateEnd(&stream);
+    return result;
+}
+
 void tarFiles(const std::filesystem::path& tarPath, const std::vector<std::filesystem::path>& filesOnDisk, const std::vector<std::string>& filesInTar) {
     assert(filesOnDisk.size() == filesInTar.size());
 
@@ -111,6 +170,196 @@ void tarFiles(const std::filesystem::path& tarPath, const std::vector<std::files
     archive_write_free(a);
 }
 
+namespace {
+
+constexpr uint64_t TAR_BLOCK_SIZE = 512;
+constexpr int TAR_INDEX_VERSION = 1;
+
+// Numeric header fields are octal text, or base-256 big endian when the top bit is set (GNU extension for large files)
+uint64_t parseTarNumber(const char* field, size_t length) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(field);
+    uint64_t value = 0;
+    if(bytes[0] & 0x80) {
+        value = bytes[0] & 0x7f;
+        for(size_t i = 1; i < length; i++) value = (value << 8) | bytes[i];
+        return value;
+    }
+    for(size_t i = 0; i < length && field[i] != '\0'; i++) {
+        if(field[i] == ' ') continue;
+        if(field[i] < '0' || field[i] > '7') break;
+        value = value * 8 + (field[i] - '0');
+    }
+    return value;
+}
+
+std::string tarString(const char* field, size_t length) {
+    return std::string(field, strnlen(field, length));
+}
+
+bool tarChecksumValid(const std::array<char, TAR_BLOCK_SIZE>& header) {
+    uint64_t sum = 0;
+    for(size_t i = 0; i < TAR_BLOCK_SIZE; i++) {
+        // The checksum field itself counts as spaces
+        sum += (i >= 148 && i < 156) ? ' ' : static_cast<unsigned char>(header[i]);
+    }
+    return sum == parseTarNumber(&header[148], 8);
+}
+
+// Applies the "path" and "size" records of a pax extended header
+void parseTarPaxHeader(const std::string& data, std::optional<std::string>& path, std::optional<uint64_t>& size) {
+    size_t pos = 0;
+    while(pos < data.size()) {
+        // Records are "<length> <key>=<value>\n", the length including itself
+        const auto space = data.find(' ', pos);
+        if(space == std::string::npos) break;
+        const auto length = std::stoull(data.substr(pos, space - pos));
+        if(length == 0 || pos + length > data.size()) break;
+        const auto record = data.substr(space + 1, pos + length - space - 2);
+        const auto equals = record.find('=');
+        if(equals != std::string::npos) {
+            const auto key = record.substr(0, equals);
+            if(key == "path") path = record.substr(equals + 1);
+            if(key == "size") size = std::stoull(record.substr(equals + 1));
+        }
+        pos += length;
+    }
+}
+
+std::vector<TarMember> scanTar(const std::filesystem::path& tarPath) {
+    std::ifstream file(tarPath, std::ios::binary);
+    if(!file) {
+        throw std::runtime_error(fmt::format("Could not open archive {}.", tarPath));
+    }
+    const uint64_t fileSize = std::filesystem::file_size(tarPath);
+    auto readData = [&](uint64_t offset, uint64_t size) {
+        std::string data(size, '\0');
+        file.seekg(static_cast<std::streamoff>(offset));
+        file.read(data.data(), static_cast<std::streamsize>(size));
+        return data;
+    };
+
+    std::vector<TarMember> members;
+    std::optional<std::string> nextPath;
+    std::optional<uint64_t> nextSize;
+    std::array<char, TAR_BLOCK_SIZE> header{};
+    uint64_t pos = 0;
+    while(pos + TAR_BLOCK_SIZE <= fileSize) {
+        file.seekg(static_cast<std::streamoff>(pos));
+        if(!file.read(header.data(), header.size())) break;
+        // End of archive
+        if(std::all_of(header.begin(), header.end(), [](char c) { return c == 0; })) break;
+        if(!tarChecksumValid(header)) {
+            throw std::runtime_error(fmt::format("{} is not an uncompressed tar archive.", tarPath));
+        }
+        const char type = header[156];
+        const uint64_t dataOffset = pos + TAR_BLOCK_SIZE;
+        uint64_t size = parseTarNumber(&header[124], 12);
+        if(type == 'x') {
+            parseTarPaxHeader(readData(dataOffset, size), nextPath, nextSize);
+        } else if(type == 'L') {
+            // GNU long name
+            const auto name = readData(dataOffset, size);
+            nextPath = name.substr(0, strnlen(name.data(), name.size()));
+        } else if(type == 'g' || type == 'K') {
+            // Global pax headers and long link names don't affect the member locations
+        } else {
+            if(nextSize) size = *nextSize;
+            if(type == '0' || type == '\0' || type == '7') {
+                TarMember member;
+                if(nextPath) {
+                    member.name = *nextPath;
+                } else {
+                    member.name = tarString(&header[0], 100);
+                    const auto prefix = tarString(&header[345], 155);
+                    if(std::memcmp(&header[257], "ustar", 5) == 0 && !prefix.empty()) member.name = prefix + "/" + member.name;
+                }
+                member.offset = dataOffset;
+                member.size = size;
+                if(member.offset + member.size > fileSize) {
+                    throw std::runtime_error(fmt::format("Archive {} is truncated.", tarPath));
+                }
+                members.push_back(std::move(member));
+            }
+            nextPath.reset();
+            nextSize.reset();
+        }
+        pos = dataOffset + (size + TAR_BLOCK_SIZE - 1) / TAR_BLOCK_SIZE * TAR_BLOCK_SIZE;
+    }
+    return members;
+}
+
+}  // namespace
+
+std::vector<TarMember> indexTar(const std::filesystem::path& tarPath, bool useCache) {
+    const auto indexPath = std::filesystem::path(tarPath).concat(".index");
+    const uint64_t archiveSize = std::filesystem::file_size(tarPath);
+    const int64_t archiveTime = std::filesystem::last_write_time(tarPath).time_since_epoch().count();
+    if(useCache && std::filesystem::exists(indexPath)) {
+        try {
+            std::ifstream indexFile(indexPath);
+            const auto index = nlohmann::json::parse(indexFile);
+            if(index.at("version") == TAR_INDEX_VERSION && index.at("size") == archiveSize && index.at("mtime") == archiveTime) {
+                std::vector<TarMember> members;
+                for(const auto& entry : index.at("members")) {
+                    members.push_back({entry.at("name").get<std::string>(), entry.at("offset").get<uint64_t>(), entry.at("size").get<uint64_t>()});
+                }
+                return members;
+            }
+        } catch(const std::exception&) {
+            // Rebuilt below
+        }
+    }
+
+    auto members = scanTar(tarPath);
+    if(useCache) {
+        nlohmann::json index = {{"version", TAR_INDEX_VERSION}, {"size", archiveSize}, {"mtime", archiveTime}, {"members", nlohmann::json::array()}};
+        for(const auto& member : members) {
+            index["members"].push_back({{"name", member.name}, {"offset", member.offset}, {"size", member.size}});
+        }
+        // Best effort, the archive may be on a read only location
+        const auto tmpPath = std::filesystem::path(indexPath).concat(".tmp");
+        std::ofstream indexFile(tmpPath);
+        indexFile << index.dump();
+        indexFile.close();
+        std::error_code ec;
+        if(indexFile.good()) std::filesystem::rename(tmpPath, indexPath, ec);
+        if(!indexFile.good() || ec) std::filesystem::remove(tmpPath, ec);
+    }
+    return members;
+}
+
+std::vector<uint8_t> readTarMember(const std::filesystem::path& tarPath, const TarMember& member) {
+    std::ifstream file(tarPath, std::ios::binary);
+    std::vector<uint8_t> data(member.size);
+    file.seekg(static_cast<std::streamoff>(member.offset));
+    if(!file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+        throw std::runtime_error(fmt::format("Could not read {} from archive {}.", member.name, tarPath));
+    }
+    return data;
+}
+
+void extractTarMember(const std::filesystem::path& tarPath, const TarMember& member, const std::filesystem::path& outPath) {
+    std::ifstream file(tarPath, std::ios::binary);
+    file.seekg(static_cast<std::streamoff>(member.offset));
+    std::ofstream outFile(outPath, std::ios::binary);
+    if(!file || !outFile) {
+        throw std::runtime_error(fmt::format("Could not extract {} from archive {} to {}.", member.name, tarPath, outPath));
+    }
+    std::vector<char> buffer(1024 * 1024);
+    uint64_t remaining = member.size;
+    while(remaining > 0) {
+        const auto chunk = static_cast<std::streamsize>(std::min<uint64_t>(remaining, buffer.size()));
+        if(!file.read(buffer.data(), chunk)) {
+            throw std::runtime_error(fmt::format("Could not read {} from archive {}.", member.name, tarPath));
+        }
+        outFile.write(buffer.data(), chunk);
+        remaining -= chunk;
+    }
+    if(!outFile.good()) {
+        throw std::runtime_error(fmt::format("Could not write {}.", outPath));
+    }
+}
+
 std::vector<std::string> filenamesInTar(const std::filesystem::path& tarPath) {
     std::vector<std::string> result;
 
@@ -0,0 +1,244 @@
+#include "EdgeDetectorImpl.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <numeric>
+#include <stdexcept>
+
+#if defined(WIN32) || defined(_WIN32)
+    #define _RESTRICT
+#else
+    #define _RESTRICT __restrict__
+#endif
+
+namespace dai {
+namespace impl {
+
+namespace {
+
+// Default Sobel kernels, as documented in EdgeDetectorConfig
+const std::vector<std::vector<int>> DEFAULT_HORIZONTAL_KERNEL = {{1, 0, -1}, {2, 0, -2}, {1, 0, -1}};
+const std::vector<std::vector<int>> DEFAULT_VERTICAL_KERNEL = {{1, 2, 1}, {0, 0, 0}, {-1, -2, -1}};
+
+void loadPaddedRow(const std::uint8_t* _RESTRICT src, std::int32_t* _RESTRICT dst, int width) {
+    dst[0] = src[0];
+    for(int x = 0; x < width; x++) {
+        dst[x + 1] = src[x];
+    }
+    dst[width + 1] = src[width - 1];
+}
+
+void correlateSeparable(const std::int32_t* _RESTRICT p0,
+                        const std::int32_t* _RESTRICT p1,
+                        const std::int32_t* _RESTRICT p2,
+                        std::int32_t* _RESTRICT vertical,
+                        std::int32_t* _RESTRICT out,
+                        const std::array<std::int32_t, 3>& column,
+                        const std::array<std::int32_t, 3>& row,
+                        int width) {
+    const std::int32_t c0 = column[0], c1 = column[1], c2 = column[2];
+    const std::int32_t r0 = row[0], r1 = row[1], r2 = row[2];
+    for(int x = 0; x < width + 2; x++) {
+        vertical[x] = c0 * p0[x] + c1 * p1[x] + c2 * p2[x];
+    }
+    for(int x = 0; x < width; x++) {
+        out[x] = r0 * vertical[x] + r1 * vertical[x + 1] + r2 * vertical[x + 2];
+    }
+}
+
+void correlateFull(const std::int32_t* _RESTRICT p0,
+                   const std::int32_t* _RESTRICT p1,
+                   const std::int32_t* _RESTRICT p2,
+                   std::int32_t* _RESTRICT out,
+                   const std::array<std::int32_t, 9>& k,
+                   int width) {
+    for(int x = 0; x < width; x++) {
+        out[x] = k[0] * p0[x] + k[1] * p0[x + 1] + k[2] * p0[x + 2] + k[3] * p1[x] + k[4] * p1[x + 1] + k[5] * p1[x + 2] + k[6] * p2[x] + k[7] * p2[x + 1]
+                 + k[8] * p2[x + 2];
+    }
+}
+
+void magnitude(const std::int32_t* _RESTRICT gx, const std::int32_t* _RESTRICT gy, std::uint8_t* _RESTRICT dst, int width) {
+    for(int x = 0; x < width; x++) {
+        const float fx = static_cast<float>(gx[x]);
+        const float fy = static_cast<float>(gy[x]);
+        const float m = std::sqrt(fx * fx + fy * fy) + 0.5f;
+        dst[x] = static_cast<std::uint8_t>(std::min(m, 255.0f));
+    }
+}
+
+}  // namespace
+
+TileWorkers::~TileWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    startCv.notify_all();
+    for(auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void TileWorkers::run(int numTiles, const std::function<void(int)>& task) {
+    if(numTiles <= 1) {
+        task(0);
+        return;
+    }
+    // Frames filtered concurrently by the same filter take turns
+    std::lock_guard<std::mutex> runLock(runMtx);
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        while(static_cast<int>(threads.size()) < numTiles - 1) {
+            threads.emplace_back(&TileWorkers::work, this, static_cast<int>(threads.size()) + 1);
+        }
+        currentTask = &task;
+        currentTiles = numTiles;
+        pending = numTiles - 1;
+        error = nullptr;
+        generation++;
+    }
+    startCv.notify_all();
+
+    std::exception_ptr ownError;
+    try {
+        task(0);
+    } catch(...) {
+        ownError = std::current_exception();
+    }
+
+    std::unique_lock<std::mutex> lock(mtx);
+    doneCv.wait(lock, [this]() { return pending == 0; });
+    currentTask = nullptr;
+    if(ownError) std::rethrow_exception(ownError);
+    if(error) std::rethrow_exception(error);
+}
+
+void TileWorkers::work(int tile) {
+    std::unique_lock<std::mutex> lock(mtx);
+    // Threads are started by run, so they take part in the frame being filtered
+    std::uint64_t seen = generation - 1;
+    while(true) {
+        startCv.wait(lock, [&]() { return stopping || generation != seen; });
+        if(stopping) return;
+        seen = generation;
+        if(tile >= currentTiles) continue;
+
+        const auto* task = currentTask;
+        lock.unlock();
+        std::exception_ptr taskError;
+        try {
+            (*task)(tile);
+        } catch(...) {
+            taskError = std::current_exception();
+        }
+        lock.lock();
+        if(taskError && !error) error = taskError;
+        if(--pending == 0) doneCv.notify_one();
+    }
+}
+
+SobelFilter::SobelFilter() {
+    setKernels(DEFAULT_HORIZONTAL_KERNEL, DEFAULT_VERTICAL_KERNEL);
+}
+
+SobelFilter::Kernel SobelFilter::makeKernel(const std::vector<std::vector<int>>& kernel) {
+    if(kernel.size() != 3 || std::any_of(kernel.begin(), kernel.end(), [](const std::vector<int>& row) { return row.size() != 3; })) {
+        throw std::invalid_argument("EdgeDetector: Sobel kernel must be a 3x3 matrix");
+    }
+
+    Kernel k;
+    for(int i = 0; i < 3; i++) {
+        for(int j = 0; j < 3; j++) {
+            k.coeffs[i * 3 + j] = kernel[i][j];
+        }
+    }
+
+    // Try to decompose the kernel as column * row, with integer factors
+    int pivotRow = -1;
+    for(int i = 0; i < 3 && pivotRow < 0; i++) {
+        if(kernel[i][0] != 0 || kernel[i][1] != 0 || kernel[i][2] != 0) pivotRow = i;
+    }
+    if(pivotRow < 0) {
+        // All zero kernel
+        k.separable = true;
+        return k;
+    }
+    const int divisor = std::gcd(std::gcd(std::abs(kernel[pivotRow][0]), std::abs(kernel[pivotRow][1])), std::abs(kernel[pivotRow][2]));
+    int pivotCol = 0;
+    for(int j = 0; j < 3; j++) {
+        k.row[j] = kernel[pivotRow][j] / divisor;
+        if(k.row[j] != 0) pivotCol = j;
+    }
+    for(int i = 0; i < 3; i++) {
+        if(kernel[i][pivotCol] % k.row[pivotCol] != 0) return k;
+        k.column[i] = kernel[i][pivotCol] / k.row[pivotCol];
+        for(int j = 0; j < 3; j++) {
+            if(k.column[i] * k.row[j] != kernel[i][j]) return k;
+        }
+    }
+    k.separable = true;
+    return k;
+}
+
+void SobelFilter::setKernels(const std::vector<std::vector<int>>& horizontalKernel, const std::vector<std::vector<int>>& verticalKernel) {
+    // Empty kernels in config mean defaults
+    kernelX = makeKernel(horizontalKernel.empty() ? DEFAULT_HORIZONTAL_KERNEL : horizontalKernel);
+    kernelY = makeKernel(verticalKernel.empty() ? DEFAULT_VERTICAL_KERNEL : verticalKernel);
+}
+
+bool SobelFilter::isSeparable() const {
+    return kernelX.separable && kernelY.separable;
+}
+
+void SobelFilter::applyRows(
+    const std::uint8_t* src, std::size_t srcStride, std::uint8_t* dst, std::size_t dstStride, int width, int height, int rowStart, int rowEnd) const {
+    const std::size_t paddedWidth = width + 2;
+    std::vector<std::int32_t> scratch(paddedWidth * 4 + width * 2);
+    std::int32_t* rows[3] = {scratch.data(), scratch.data() + paddedWidth, scratch.data() + paddedWidth * 2};
+    std::int32_t* vertical = scratch.data() + paddedWidth * 3;
+    std::int32_t* gx = vertical + paddedWidth;
+    std::int32_t* gy = gx + width;
+
+    auto srcRow = [&](int y) { return src + static_cast<std::size_t>(std::clamp(y, 0, height - 1)) * srcStride; };
+
+    // Prime the sliding window of three padded rows
+    loadPaddedRow(srcRow(rowStart - 1), rows[0], width);
+    loadPaddedRow(srcRow(rowStart), rows[1], width);
+    for(int y = rowStart; y < rowEnd; y++) {
+        loadPaddedRow(srcRow(y + 1), rows[2], width);
+
+        if(kernelX.separable) {
+            correlateSeparable(rows[0], rows[1], rows[2], vertical, gx, kernelX.column, kernelX.row, width);
+        } else {
+            correlateFull(rows[0], rows[1], rows[2], gx, kernelX.coeffs, width);
+        }
+        if(kernelY.separable) {
+            correlateSeparable(rows[0], rows[1], rows[2], vertical, gy, kernelY.column, kernelY.row, width);
+        } else {
+            correlateFull(rows[0], rows[1], rows[2], gy, kernelY.coeffs, width);
+        }
+        magnitude(gx, gy, dst + static_cast<std::size_t>(y) * dstStride, width);
+
+        std::rotate(std::begin(rows), std::begin(rows) + 1, std::end(rows));
+    }
+}
+
+void SobelFilter::apply(
+    const std::uint8_t* src, std::size_t srcStride, std::uint8_t* dst, std::size_t dstStride, int width, int height, int numThreads) const {
+    if(width <= 0 || height <= 0) return;
+
+    const int numTiles = std::max(1, std::min(numThreads, height));
+    const int rowsPerTile = height / numTiles;
+
+    // Tiles are processed by the workers, the first one on the calling thread
+    workers->run(numTiles, [&](int tile) {
+        const int rowStart = tile * rowsPerTile;
+        const int rowEnd = (tile == numTiles - 1) ? height : (rowStart + rowsPerTile);
+        applyRows(src, srcStride, dst, dstStride, width, height, rowStart, rowEnd);
+    });
+}
+
+}  // namespace impl
+}  // namespace dai
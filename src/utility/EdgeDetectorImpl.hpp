@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dai {
+namespace impl {
+
+/**
+ * Fixed set of threads processing the row tiles of successive frames.
+ * Threads are started the first time they are needed and kept until destruction.
+ */
+class TileWorkers {
+   public:
+    TileWorkers() = default;
+    TileWorkers(const TileWorkers&) = delete;
+    TileWorkers& operator=(const TileWorkers&) = delete;
+    ~TileWorkers();
+
+    /**
+     * Runs task for every tile in [0, numTiles) and waits for all of them.
+     * Tile 0 is processed on the calling thread. Exceptions thrown by the task are rethrown
+     */
+    void run(int numTiles, const std::function<void(int)>& task);
+
+   private:
+    void work(int tile);
+
+    std::mutex runMtx;
+    std::mutex mtx;
+    std::condition_variable startCv;
+    std::condition_variable doneCv;
+    std::vector<std::thread> threads;
+    const std::function<void(int)>* currentTask = nullptr;
+    int currentTiles = 0;
+    int pending = 0;
+    std::uint64_t generation = 0;
+    bool stopping = false;
+    std::exception_ptr error;
+};
+
+/**
+ * Host implementation of the EdgeDetector 3x3 Sobel filter.
+ * Computes |G| = sqrt(Gx^2 + Gy^2), saturated to 8 bits, where Gx and Gy are correlations of the input
+ * with the horizontal and vertical kernels. Borders are replicated.
+ *
+ * Kernels which are separable (rank 1, as the default Sobel kernels) are applied as a vertical 3 tap pass
+ * followed by a horizontal 3 tap pass, others fall back to a full 3x3 correlation.
+ * Both paths work on whole rows of 32bit intermediates so the compiler can vectorize the inner loops.
+ */
+class SobelFilter {
+   public:
+    SobelFilter();
+
+    /**
+     * Set 3x3 kernels as given in EdgeDetectorConfig
+     * @throws std::invalid_argument if a kernel is not 3x3
+     */
+    void setKernels(const std::vector<std::vector<int>>& horizontalKernel, const std::vector<std::vector<int>>& verticalKernel);
+
+    /**
+     * Whether both kernels were decomposed into a column and a row vector
+     */
+    bool isSeparable() const;
+
+    /**
+     * Filter a single channel 8 bit image.
+     * @param numThreads Number of row tiles processed concurrently
+     */
+    void apply(const std::uint8_t* src,
+               std::size_t srcStride,
+               std::uint8_t* dst,
+               std::size_t dstStride,
+               int width,
+               int height,
+               int numThreads = 1) const;
+
+   private:
+    struct Kernel {
+        std::array<std::int32_t, 9> coeffs{};
+        bool separable = false;
+        std::array<std::int32_t, 3> column{};
+        std::array<std::int32_t, 3> row{};
+    };
+
+    static Kernel makeKernel(const std::vector<std::vector<int>>& kernel);
+    void applyRows(const std::uint8_t* src, std::size_t srcStride, std::uint8_t* dst, std::size_t dstStride, int width, int height, int rowStart, int rowEnd)
+        const;
+
+    Kernel kernelX;
+    Kernel kernelY;
+    std::unique_ptr<TileWorkers> workers = std::make_unique<TileWorkers>();
+};
+
+}  // namespace impl
+}  // namespace dai
@@ -10,6 +10,7 @@
 #include <optional>
 #include <system_error>
 
+#include "LogUploader.hpp"
 #include "build/version.hpp"
 #include "sha1.hpp"
 #include "utility/Environment.hpp"
@@ -18,8 +19,6 @@
 namespace dai {
 namespace logCollection {
 
-constexpr auto LOG_ENDPOINT = "https://logs.luxonis.com/logs";
-
 struct FileWithSHA1 {
     std::string content;
     std::string sha1Hash;
@@ -87,43 +86,33 @@ std::string calculateSHA1(const std::string& input) {
 }
 
 #ifdef DEPTHAI_ENABLE_CURL
-bool sendLogsToServer(const std::optional<FileWithSHA1>& pipelineData, const std::optional<FileWithSHA1>& crashDumpData, const dai::DeviceInfo& deviceInfo) {
-    (void)deviceInfo;  // Unused for now
+// Hands the logs over to the background uploader, so that slow networks never hold up the caller (eg. device close)
+bool sendLogsToServer(std::optional<FileWithSHA1> pipelineData, std::optional<FileWithSHA1> crashDumpData, const dai::DeviceInfo& deviceInfo) {
     // At least one of the files must be present
     if(!pipelineData && !crashDumpData) {
         logger::error("Incorrect usage of sendLogsToServer, at least one of the files must be present");
         return false;
     }
-    cpr::Multipart multipart{};
+    LogUploader::Upload upload;
     if(pipelineData) {
-        cpr::Buffer pipelineBuffer(pipelineData->content.begin(), pipelineData->content.end(), pipelineData->name);
-        multipart.parts.emplace_back("pipelineFile", pipelineBuffer);
-        multipart.parts.emplace_back("pipelineId", pipelineData->sha1Hash);
+        upload.files.push_back({"pipelineFile", std::move(pipelineData->name), std::move(pipelineData->content)});
+        upload.fields["pipelineId"] = std::move(pipelineData->sha1Hash);
     }
 
     if(crashDumpData) {
-        cpr::Buffer crashDumpBuffer(crashDumpData->content.begin(), crashDumpData->content.end(), crashDumpData->name);
-        multipart.parts.emplace_back("crashDumpFile", crashDumpBuffer);
-        multipart.parts.emplace_back("crashDumpId", crashDumpData->sha1Hash);
-    }
-
-    multipart.parts.emplace_back("platform", platformToString(deviceInfo.platform));
-    multipart.parts.emplace_back("connectionType", protocolToString(deviceInfo.protocol));
-    multipart.parts.emplace_back("osPlatform", getOSPlatform());
-    std::string daiVersion = fmt::format("{}-{}", build::VERSION, build::COMMIT);
-    multipart.parts.emplace_back("depthAiVersion", std::move(daiVersion));
-    multipart.parts.emplace_back("productId", deviceInfo.getDeviceId());
-    auto response = cpr::Post(cpr::Url{LOG_ENDPOINT}, multipart);
-    if(response.status_code != 200) {
-        logger::info("Failed to send logs, status code: {}, {}", response.status_code, response.text);
-        return false;
+        upload.files.push_back({"crashDumpFile", std::move(crashDumpData->name), std::move(crashDumpData->content)});
+        upload.fields["crashDumpId"] = std::move(crashDumpData->sha1Hash);
     }
 
-    logger::info("Logs sent successfully");
-    return true;
+    upload.fields["platform"] = platformToString(deviceInfo.platform);
+    upload.fields["connectionType"] = protocolToString(deviceInfo.protocol);
+    upload.fields["osPlatform"] = getOSPlatform();
+    upload.fields["depthAiVersion"] = fmt::format("{}-{}", build::VERSION, build::COMMIT);
+    upload.fields["productId"] = deviceInfo.getDeviceId();
+    return LogUploader::getInstance().enqueue(std::move(upload));
 }
 #else
-bool sendLogsToServer(const std::optional<FileWithSHA1>&, const std::optional<FileWithSHA1>&, const dai::DeviceInfo&) {
+bool sendLogsToServer(std::optional<FileWithSHA1>, std::optional<FileWithSHA1>, const dai::DeviceInfo&) {
     logger::info("Not sending the logs to the server, as CURL support is disabled");
     return false;
 }
@@ -172,12 +161,12 @@ void logPipeline(const PipelineSchema& pipelineSchema, const dai::DeviceInfo& de
     pipelineData.content = std::move(pipelineJsonStr);
     pipelineData.sha1Hash = std::move(pipelineSHA1);
     pipelineData.name = "pipeline.json";
-    auto success = sendLogsToServer(pipelineData, std::nullopt, deviceInfo);
+    auto success = sendLogsToServer(std::move(pipelineData), std::nullopt, deviceInfo);
     if(!success) {
         // Keep at info level to not spam in case of no internet connection
-        logger::info("Failed to send pipeline logs to server");
+        logger::info("Failed to queue pipeline logs for upload");
     } else {
-        logger::info("Pipeline logs sent to server");
+        logger::info("Pipeline logs queued for upload");
     }
 #endif
 }
@@ -249,16 +238,16 @@ void logCrashDump(const std::optional<PipelineSchema>& pipelineSchema, const Gen
         std::string pipelineSHA1 = calculateSHA1(pipelineJson);
         pipelineData->content = std::move(pipelineJson);
         pipelineData->sha1Hash = std::move(pipelineSHA1);
+        pipelineData->name = "pipeline.json";
     }
 
     // Check if logging is explicitly disabled
     auto loggingDisabled = utility::getEnvAs<std::string>("DEPTHAI_DISABLE_FEEDBACK", "");
     if(loggingDisabled.empty()) {
         logger::info("Logging enabled");
-        auto success = sendLogsToServer(pipelineData, crashDumpData, deviceInfo);
+        auto success = sendLogsToServer(std::move(pipelineData), std::move(crashDumpData), deviceInfo);
         if(!success) {
-            // Keep at info level to not spam in case of no internet connection
-            logger::warn("Failed to send crash dump logs to the server.");
+            logger::warn("Failed to queue crash dump logs for upload to the server.");
         }
     } else {
         logger::info("Logging disabled");
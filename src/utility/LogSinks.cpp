@@ -0,0 +1,275 @@
+#include "LogSinks.hpp"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+
+namespace dai {
+
+LogContext::Fields& LogContext::fields() {
+    static thread_local Fields threadFields;
+    return threadFields;
+}
+
+LogContext::Scope::Scope(std::string key, std::string value) {
+    fields().emplace_back(std::move(key), std::move(value));
+}
+
+LogContext::Scope::~Scope() {
+    fields().pop_back();
+}
+
+AsyncLogSink::AsyncLogSink(std::vector<spdlog::sink_ptr> sinks, std::size_t capacity, OverflowPolicy overflowPolicy)
+    : sinks(std::move(sinks)), overflowPolicy(overflowPolicy), ring(std::max<std::size_t>(capacity, 1)) {
+    thread = std::thread(&AsyncLogSink::worker, this);
+}
+
+AsyncLogSink::~AsyncLogSink() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    canPop.notify_all();
+    canPush.notify_all();
+    thread.join();
+    for(auto& sink : sinks) sink->flush();
+}
+
+void AsyncLogSink::log(const spdlog::details::log_msg& msg) {
+    std::unique_lock<std::mutex> lock(mtx);
+    if(size == ring.size()) {
+        switch(overflowPolicy) {
+            case OverflowPolicy::BLOCK:
+                canPush.wait(lock, [this]() { return stopping || size < ring.size(); });
+                if(stopping) return;
+                break;
+            case OverflowPolicy::DROP_NEWEST:
+                dropped++;
+                return;
+            case OverflowPolicy::DROP_OLDEST:
+                head = (head + 1) % ring.size();
+                size--;
+                sunk++;
+                dropped++;
+                break;
+        }
+    }
+    auto& entry = ring[(head + size) % ring.size()];
+    entry.level = msg.level;
+    entry.time = msg.time;
+    entry.threadId = msg.thread_id;
+    entry.source = msg.source;
+    entry.loggerName.assign(msg.logger_name.data(), msg.logger_name.size());
+    entry.payload.assign(msg.payload.data(), msg.payload.size());
+    entry.fields = LogContext::fields();
+    size++;
+    pushed++;
+    lock.unlock();
+    canPop.notify_one();
+}
+
+void AsyncLogSink::worker() {
+    std::vector<Entry> batch;
+    std::unique_lock<std::mutex> lock(mtx);
+    while(true) {
+        canPop.wait(lock, [this]() { return stopping || size > 0; });
+        if(size == 0) return;
+
+        // Swapped out, so that both the ring and the batch keep their allocations
+        const auto count = size;
+        if(batch.size() < count) batch.resize(count);
+        for(std::size_t i = 0; i < count; i++) std::swap(batch[i], ring[(head + i) % ring.size()]);
+        head = (head + count) % ring.size();
+        size = 0;
+        lock.unlock();
+        canPush.notify_all();
+
+        for(std::size_t i = 0; i < count; i++) {
+            auto& entry = batch[i];
+            spdlog::details::log_msg msg(entry.time, entry.source, entry.loggerName, entry.level, entry.payload);
+            msg.thread_id = entry.threadId;
+            // Sinks see the fields of the thread which logged the message
+            std::swap(LogContext::fields(), entry.fields);
+            for(auto& sink : sinks) {
+                if(!sink->should_log(msg.level)) continue;
+                try {
+                    sink->log(msg);
+                } catch(const std::exception& ex) {
+                    std::fprintf(stderr, "AsyncLogSink: sink failed - %s\n", ex.what());
+                }
+            }
+            std::swap(LogContext::fields(), entry.fields);
+        }
+
+        lock.lock();
+        sunk += count;
+        sinkProgress.notify_all();
+    }
+}
+
+void AsyncLogSink::flush() {
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        const auto target = pushed;
+        sinkProgress.wait(lock, [this, target]() { return sunk >= target; });
+    }
+    for(auto& sink : sinks) sink->flush();
+}
+
+void AsyncLogSink::set_pattern(const std::string& pattern) {
+    for(auto& sink : sinks) sink->set_pattern(pattern);
+}
+
+void AsyncLogSink::set_formatter(std::unique_ptr<spdlog::formatter> sinkFormatter) {
+    for(auto& sink : sinks) sink->set_formatter(sinkFormatter->clone());
+}
+
+std::uint64_t AsyncLogSink::getDropped() const {
+    return dropped;
+}
+
+const std::vector<spdlog::sink_ptr>& AsyncLogSink::getSinks() const {
+    return sinks;
+}
+
+RateLimitLogSink::RateLimitLogSink(double messagesPerSecond, double burst, std::chrono::milliseconds dedupWindow)
+    : messagesPerSecond(messagesPerSecond), burst(std::max(burst, 1.0)), dedupWindow(dedupWindow) {}
+
+void RateLimitLogSink::report(const spdlog::details::log_msg& msg, LoggerState& state) {
+    if(state.repeated > 0) {
+        const auto text = fmt::format("Last message repeated {} times", state.repeated);
+        spdlog::details::log_msg summary(msg.time, spdlog::source_loc{}, msg.logger_name, state.lastLevel, text);
+        dist_sink<std::mutex>::sink_it_(summary);
+        state.repeated = 0;
+    }
+    if(state.limited > 0) {
+        const auto text = fmt::format("{} messages suppressed by the log rate limit", state.limited);
+        spdlog::details::log_msg summary(msg.time, spdlog::source_loc{}, msg.logger_name, spdlog::level::warn, text);
+        dist_sink<std::mutex>::sink_it_(summary);
+        state.limited = 0;
+    }
+}
+
+void RateLimitLogSink::sink_it_(const spdlog::details::log_msg& msg) {
+    auto it = loggers.find(std::string(msg.logger_name.data(), msg.logger_name.size()));
+    if(it == loggers.end()) {
+        it = loggers.emplace(std::string(msg.logger_name.data(), msg.logger_name.size()), LoggerState{}).first;
+        it->second.tokens = burst;
+        it->second.lastRefill = msg.time;
+    }
+    auto& state = it->second;
+
+    const bool same = msg.level == state.lastLevel && msg.time - state.lastTime < dedupWindow
+                      && std::equal(msg.payload.begin(), msg.payload.end(), state.lastPayload.begin(), state.lastPayload.end());
+    if(same) {
+        state.repeated++;
+        return;
+    }
+
+    if(msg.level < spdlog::level::err) {
+        const std::chrono::duration<double> elapsed = msg.time - state.lastRefill;
+        state.tokens = std::min(burst, state.tokens + std::max(elapsed.count(), 0.0) * messagesPerSecond);
+        state.lastRefill = msg.time;
+        if(state.tokens < 1.0) {
+            state.limited++;
+            return;
+        }
+        state.tokens -= 1.0;
+    }
+
+    report(msg, state);
+    dist_sink<std::mutex>::sink_it_(msg);
+    state.lastPayload.assign(msg.payload.data(), msg.payload.size());
+    state.lastLevel = msg.level;
+    state.lastTime = msg.time;
+}
+
+void RateLimitLogSink::flush_() {
+    // Loggers which went quiet still get their counts reported
+    for(auto& [name, state] : loggers) {
+        if(state.repeated == 0 && state.limited == 0) continue;
+        spdlog::details::log_msg msg(spdlog::log_clock::now(), spdlog::source_loc{}, name, spdlog::level::info, {});
+        report(msg, state);
+    }
+    dist_sink<std::mutex>::flush_();
+}
+
+namespace {
+
+void appendJsonString(spdlog::memory_buf_t& buf, spdlog::string_view_t text) {
+    buf.push_back('"');
+    for(const char c : text) {
+        switch(c) {
+            case '"':
+                buf.append(spdlog::string_view_t("\\\""));
+                break;
+            case '\\':
+                buf.append(spdlog::string_view_t("\\\\"));
+                break;
+            case '\n':
+                buf.append(spdlog::string_view_t("\\n"));
+                break;
+            case '\r':
+                buf.append(spdlog::string_view_t("\\r"));
+                break;
+            case '\t':
+                buf.append(spdlog::string_view_t("\\t"));
+                break;
+            default:
+                if(static_cast<unsigned char>(c) < 0x20) {
+                    fmt::format_to(std::back_inserter(buf), "\\u{:04x}", static_cast<unsigned>(c));
+                } else {
+                    buf.push_back(c);
+                }
+        }
+    }
+    buf.push_back('"');
+}
+
+}  // namespace
+
+JsonLinesLogSink::JsonLinesLogSink(const std::string& filename, bool truncate) {
+    file.open(filename, truncate);
+}
+
+JsonLinesLogSink::JsonLinesLogSink(std::ostream& stream) : stream(&stream) {}
+
+void JsonLinesLogSink::sink_it_(const spdlog::details::log_msg& msg) {
+    spdlog::memory_buf_t buf;
+    const auto timeUs = std::chrono::duration_cast<std::chrono::microseconds>(msg.time.time_since_epoch()).count();
+    fmt::format_to(std::back_inserter(buf), "{{\"time_us\":{},\"level\":", timeUs);
+    appendJsonString(buf, spdlog::level::to_string_view(msg.level));
+    buf.append(spdlog::string_view_t(",\"logger\":"));
+    appendJsonString(buf, msg.logger_name);
+    fmt::format_to(std::back_inserter(buf), ",\"thread\":{},\"msg\":", msg.thread_id);
+    appendJsonString(buf, msg.payload);
+    if(!msg.source.empty()) {
+        buf.append(spdlog::string_view_t(",\"source\":"));
+        appendJsonString(buf, fmt::format("{}:{}", msg.source.filename, msg.source.line));
+    }
+    for(const auto& [key, value] : LogContext::fields()) {
+        buf.push_back(',');
+        appendJsonString(buf, key);
+        buf.push_back(':');
+        appendJsonString(buf, value);
+    }
+    buf.append(spdlog::string_view_t("}\n"));
+
+    if(stream) {
+        stream->write(buf.data(), static_cast<std::streamsize>(buf.size()));
+    } else {
+        file.write(buf);
+    }
+}
+
+void JsonLinesLogSink::flush_() {
+    if(stream) {
+        stream->flush();
+    } else {
+        file.flush();
+    }
+}
+
+}  // namespace dai
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <spdlog/details/file_helper.h>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/sinks/dist_sink.h>
+#include <spdlog/sinks/sink.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace dai {
+
+/**
+ * Structured fields attached to the messages logged from the current thread, such as the node or stream a thread serves.
+ * Sinks read the fields of the message being logged with LogContext::fields(), also when the message is sunk by AsyncLogSink on its worker.
+ */
+class LogContext {
+   public:
+    using Fields = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * Adds a field for as long as the scope lives
+     */
+    class Scope {
+       public:
+        Scope(std::string key, std::string value);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /// Fields of the current thread, innermost scope last
+    static Fields& fields();
+};
+
+/**
+ * Sink which hands messages over to a worker thread through a bounded ring, so that logging from hot paths doesn't wait on I/O.
+ * Messages keep the LogContext fields of the thread that logged them.
+ */
+class AsyncLogSink : public spdlog::sinks::sink {
+   public:
+    enum class OverflowPolicy {
+        /// Wait for room in the ring
+        BLOCK,
+        /// Drop the message being logged
+        DROP_NEWEST,
+        /// Overwrite the oldest message in the ring
+        DROP_OLDEST
+    };
+
+    explicit AsyncLogSink(std::vector<spdlog::sink_ptr> sinks, std::size_t capacity = 8192, OverflowPolicy overflowPolicy = OverflowPolicy::DROP_OLDEST);
+    ~AsyncLogSink() override;
+    AsyncLogSink(const AsyncLogSink&) = delete;
+    AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+    void log(const spdlog::details::log_msg& msg) override;
+    /// Waits for the queued messages to be sunk, then flushes the sinks
+    void flush() override;
+    void set_pattern(const std::string& pattern) override;
+    void set_formatter(std::unique_ptr<spdlog::formatter> sinkFormatter) override;
+
+    /// Number of messages dropped because the ring was full
+    std::uint64_t getDropped() const;
+    const std::vector<spdlog::sink_ptr>& getSinks() const;
+
+   private:
+    struct Entry {
+        spdlog::level::level_enum level = spdlog::level::off;
+        spdlog::log_clock::time_point time;
+        std::size_t threadId = 0;
+        spdlog::source_loc source;
+        std::string loggerName;
+        std::string payload;
+        LogContext::Fields fields;
+    };
+
+    void worker();
+
+    const std::vector<spdlog::sink_ptr> sinks;
+    const OverflowPolicy overflowPolicy;
+    // Entries are reused, so their strings keep their capacity
+    std::vector<Entry> ring;
+    std::size_t head = 0;
+    std::size_t size = 0;
+    std::uint64_t pushed = 0;
+    std::uint64_t sunk = 0;
+    std::atomic<std::uint64_t> dropped{0};
+    bool stopping = false;
+    mutable std::mutex mtx;
+    std::condition_variable canPop;
+    std::condition_variable canPush;
+    std::condition_variable sinkProgress;
+    std::thread thread;
+};
+
+/**
+ * Sink which limits the rate of messages of each logger and collapses repeated messages.
+ *
+ * Each logger may log `messagesPerSecond` messages on average, in bursts of up to `burst` messages; errors and critical messages aren't limited.
+ * A message identical to the previous one of the same logger within `dedupWindow` is counted instead of logged. The number of
+ * repeated and rate limited messages is reported before the next message of that logger which goes through.
+ */
+class RateLimitLogSink : public spdlog::sinks::dist_sink<std::mutex> {
+   public:
+    RateLimitLogSink(double messagesPerSecond, double burst, std::chrono::milliseconds dedupWindow = std::chrono::seconds(5));
+
+   protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override;
+    void flush_() override;
+
+   private:
+    struct LoggerState {
+        double tokens = 0.0;
+        spdlog::log_clock::time_point lastRefill;
+        std::uint64_t limited = 0;
+        std::string lastPayload;
+        spdlog::level::level_enum lastLevel = spdlog::level::off;
+        spdlog::log_clock::time_point lastTime;
+        std::uint64_t repeated = 0;
+    };
+
+    void report(const spdlog::details::log_msg& msg, LoggerState& state);
+
+    const double messagesPerSecond;
+    const double burst;
+    const std::chrono::milliseconds dedupWindow;
+    std::unordered_map<std::string, LoggerState> loggers;
+};
+
+/**
+ * Sink writing each message as a line of JSON with the time, level, logger, thread, message and the LogContext fields, for example
+ * {"time_us":1718000000000000,"level":"warning","logger":"depthai","thread":1234,"msg":"...","node":"Camera(0)","stream":"__x_0_out"}
+ */
+class JsonLinesLogSink : public spdlog::sinks::base_sink<std::mutex> {
+   public:
+    /// Appends to the file, or truncates it first
+    explicit JsonLinesLogSink(const std::string& filename, bool truncate = false);
+    /// Writes into the stream, which must outlive the sink
+    explicit JsonLinesLogSink(std::ostream& stream);
+
+   protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override;
+    void flush_() override;
+
+   private:
+    spdlog::details::file_helper file;
+    std::ostream* stream = nullptr;
+};
+
+}  // namespace dai
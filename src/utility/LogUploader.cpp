@@ -0,0 +1,367 @@
+#include "LogUploader.hpp"
+
+#ifdef DEPTHAI_ENABLE_CURL
+    #include <cpr/cpr.h>
+#endif
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <system_error>
+
+#include "depthai/utility/Compression.hpp"
+#include "utility/Logging.hpp"
+
+namespace dai {
+namespace logCollection {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr auto LOG_ENDPOINT = "https://logs.luxonis.com/logs";
+constexpr auto MANIFEST_NAME = "manifest.json";
+constexpr auto TMP_SUFFIX = ".tmp";
+constexpr auto CLAIMED_SUFFIX = ".claimed";
+constexpr auto STALE_TMP_AGE = std::chrono::hours(1);
+// Far longer than sending an upload takes
+constexpr auto STALE_CLAIM_AGE = std::chrono::hours(1);
+
+bool hasSuffix(const std::string& str, const char* suffix) {
+    const std::size_t suffixSize = std::strlen(suffix);
+    return str.size() >= suffixSize && str.compare(str.size() - suffixSize, suffixSize, suffix) == 0;
+}
+
+bool writeFile(const fs::path& path, const void* data, std::size_t size) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    file.close();
+    return file.good();
+}
+
+// Replaces the manifest atomically, so that a crash never leaves a partially written one behind
+bool writeManifest(const fs::path& dir, const nlohmann::json& manifest) {
+    const std::string str = manifest.dump();
+    const auto tmpPath = dir / (std::string(MANIFEST_NAME) + TMP_SUFFIX);
+    if(!writeFile(tmpPath, str.data(), str.size())) return false;
+    std::error_code ec;
+    fs::rename(tmpPath, dir / MANIFEST_NAME, ec);
+    return !ec;
+}
+
+}  // namespace
+
+struct LogUploader::Entry {
+    std::string id;
+    fs::path dir;
+    // Where the upload was moved to while this process sends it, empty if not claimed
+    fs::path claimedDir;
+    nlohmann::json manifest;
+    std::size_t size = 0;
+    int attempts = 0;
+    std::chrono::steady_clock::time_point nextAttempt;
+};
+
+LogUploader& LogUploader::getInstance() {
+    static LogUploader instance([]() {
+        Config config;
+        config.url = LOG_ENDPOINT;
+        config.spoolDir = fs::current_path() / ".cache" / "depthai" / "uploads";
+        return config;
+    }());
+    return instance;
+}
+
+LogUploader::LogUploader(Config config) : config(std::move(config)) {
+    std::error_code ec;
+    fs::create_directories(this->config.spoolDir, ec);
+    if(ec) {
+        logger::warn("Failed to create log upload directory {}: {}", this->config.spoolDir.string(), ec.message());
+    }
+    // A directory scan only, the uploads themselves are read when sent
+    loadSpool();
+    thread = std::thread([this]() { run(); });
+}
+
+LogUploader::~LogUploader() {
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        running = false;
+    }
+    cv.notify_all();
+    if(thread.joinable()) thread.join();
+}
+
+bool LogUploader::enqueue(Upload upload) {
+    auto entry = std::make_shared<Entry>();
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        const auto now = std::chrono::system_clock::now().time_since_epoch();
+        // Sorts by creation time. Only this process' uploads are sent in order, uploads of other processes
+        // sharing the spool directory are interleaved depending on which process claims them first
+        entry->id = fmt::format("{:020}-{:06}", std::chrono::duration_cast<std::chrono::nanoseconds>(now).count(), counter++ % 1000000);
+    }
+    entry->dir = config.spoolDir / entry->id;
+    const fs::path tmpDir = config.spoolDir / (entry->id + TMP_SUFFIX);
+
+    // Compress before writing anything, to check the size
+    std::vector<std::vector<uint8_t>> compressed(upload.files.size());
+    std::size_t size = 0;
+    for(std::size_t i = 0; i < upload.files.size(); i++) {
+        const auto& content = upload.files[i].content;
+        if(config.compress) {
+            compressed[i] = utility::gzip(reinterpret_cast<const uint8_t*>(content.data()), content.size());
+            size += compressed[i].size();
+        } else {
+            size += content.size();
+        }
+    }
+    if(size > config.maxUploadSize) {
+        logger::warn("Log upload of {} bytes exceeds the limit of {} bytes, dropping it", size, config.maxUploadSize);
+        return false;
+    }
+
+    std::error_code ec;
+    fs::create_directories(tmpDir, ec);
+    if(ec) {
+        logger::warn("Failed to create log upload directory {}: {}", tmpDir.string(), ec.message());
+        return false;
+    }
+    nlohmann::json manifest;
+    manifest["fields"] = upload.fields;
+    manifest["files"] = nlohmann::json::array();
+    manifest["attempts"] = 0;
+    bool written = true;
+    for(std::size_t i = 0; i < upload.files.size() && written; i++) {
+        auto& file = upload.files[i];
+        const std::string path = std::to_string(i);
+        if(config.compress) {
+            written = writeFile(tmpDir / path, compressed[i].data(), compressed[i].size());
+            manifest["files"].push_back({{"field", file.field}, {"name", file.name + ".gz"}, {"path", path}, {"contentType", "application/gzip"}});
+        } else {
+            written = writeFile(tmpDir / path, file.content.data(), file.content.size());
+            manifest["files"].push_back({{"field", file.field}, {"name", file.name}, {"path", path}, {"contentType", ""}});
+        }
+    }
+    written = written && writeManifest(tmpDir, manifest);
+    // The entry only becomes visible to other processes once complete
+    if(written) fs::rename(tmpDir, entry->dir, ec);
+    if(!written || ec) {
+        logger::warn("Failed to write log upload to {}", tmpDir.string());
+        fs::remove_all(tmpDir, ec);
+        return false;
+    }
+    entry->manifest = std::move(manifest);
+    entry->size = size;
+
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        pending.push_back(entry);
+        spoolSize += entry->size;
+        // Keep the spool below its cap by dropping the oldest uploads
+        for(std::size_t i = 0; spoolSize > config.maxSpoolSize && i + 1 < pending.size();) {
+            if(pending[i] == inFlight) {
+                i++;
+                continue;
+            }
+            // Not deleted if another process is sending it
+            if(claim(*pending[i])) logger::info("Log upload spool exceeds {} bytes, dropping {}", config.maxSpoolSize, pending[i]->id);
+            remove(pending[i]);
+        }
+    }
+    cv.notify_all();
+    return true;
+}
+
+bool LogUploader::waitIdle(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mtx);
+    return cv.wait_for(lock, timeout, [this]() { return pending.empty(); });
+}
+
+std::size_t LogUploader::getNumPending() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    return pending.size();
+}
+
+std::size_t LogUploader::getNumUploaded() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    return numUploaded;
+}
+
+void LogUploader::loadSpool() {
+    std::vector<std::shared_ptr<Entry>> loaded;
+    std::error_code ec;
+    for(const auto& dirEntry : fs::directory_iterator(config.spoolDir, ec)) {
+        if(!dirEntry.is_directory()) continue;
+        auto dir = dirEntry.path();
+        auto id = dir.filename().string();
+        if(hasSuffix(id, TMP_SUFFIX)) {
+            // Left behind by a process that exited while writing it, unless another process is writing it right now
+            const auto modified = fs::last_write_time(dir, ec);
+            if(!ec && fs::file_time_type::clock::now() - modified > STALE_TMP_AGE) fs::remove_all(dir, ec);
+            continue;
+        }
+        if(hasSuffix(id, CLAIMED_SUFFIX)) {
+            // Being sent by another process, unless that process exited while sending it
+            const auto modified = fs::last_write_time(dir, ec);
+            if(ec || fs::file_time_type::clock::now() - modified <= STALE_CLAIM_AGE) continue;
+            id.resize(id.size() - std::strlen(CLAIMED_SUFFIX));
+            const auto unclaimedDir = config.spoolDir / id;
+            fs::rename(dir, unclaimedDir, ec);
+            if(ec) continue;
+            dir = unclaimedDir;
+        }
+        auto entry = std::make_shared<Entry>();
+        entry->id = id;
+        entry->dir = dir;
+        try {
+            std::ifstream manifestFile(dir / MANIFEST_NAME);
+            entry->manifest = nlohmann::json::parse(manifestFile);
+            entry->attempts = entry->manifest.at("attempts").get<int>();
+            for(const auto& file : entry->manifest.at("files")) {
+                entry->size += fs::file_size(dir / file.at("path").get<std::string>());
+            }
+        } catch(const std::exception& ex) {
+            logger::debug("Dropping unreadable log upload {}: {}", dir.string(), ex.what());
+            fs::remove_all(dir, ec);
+            continue;
+        }
+        loaded.push_back(std::move(entry));
+    }
+    if(loaded.empty()) return;
+    std::sort(loaded.begin(), loaded.end(), [](const auto& a, const auto& b) { return a->id < b->id; });
+    logger::debug("Found {} pending log uploads in {}", loaded.size(), config.spoolDir.string());
+    for(const auto& entry : loaded) spoolSize += entry->size;
+    pending = std::move(loaded);
+}
+
+void LogUploader::run() {
+    std::unique_lock<std::mutex> lock(mtx);
+    while(running) {
+        if(pending.empty()) {
+            cv.wait(lock, [this]() { return !running || !pending.empty(); });
+            continue;
+        }
+        // Uploads are sent in order, one failing means the server is likely unreachable for the others as well
+        auto entry = pending.front();
+        if(std::chrono::steady_clock::now() < entry->nextAttempt) {
+            cv.wait_until(lock, entry->nextAttempt, [this]() { return !running; });
+            continue;
+        }
+        inFlight = entry;
+        lock.unlock();
+        // Another process sharing the spool directory may have sent or claimed it already
+        const bool claimed = claim(*entry);
+        const auto result = claimed ? send(*entry) : SendResult::RETRY;
+        lock.lock();
+        inFlight = nullptr;
+
+        if(!claimed) {
+            logger::debug("Log upload {} was taken by another process", entry->id);
+            remove(entry);
+        } else if(result == SendResult::SENT) {
+            logger::info("Logs sent successfully");
+            numUploaded++;
+            remove(entry);
+        } else if(result == SendResult::REJECTED) {
+            remove(entry);
+        } else {
+            if(running) {
+                entry->attempts++;
+                if(entry->attempts >= config.maxAttempts) {
+                    // Keep at info level to not spam in case of no internet connection
+                    logger::info("Giving up on log upload {} after {} attempts", entry->id, entry->attempts);
+                    remove(entry);
+                } else {
+                    const auto delay = retryDelay(entry->attempts);
+                    logger::debug("Retrying log upload {} (attempt {}/{}) in {} ms", entry->id, entry->attempts + 1, config.maxAttempts, delay.count());
+                    entry->nextAttempt = std::chrono::steady_clock::now() + delay;
+                    entry->manifest["attempts"] = entry->attempts;
+                    writeManifest(entry->claimedDir, entry->manifest);
+                }
+            }
+            // Back to the spool directory for the retry, by this or another process
+            if(!entry->claimedDir.empty()) unclaim(*entry);
+        }
+        cv.notify_all();
+    }
+}
+
+void LogUploader::remove(const std::shared_ptr<Entry>& entry) {
+    auto it = std::find(pending.begin(), pending.end(), entry);
+    if(it == pending.end()) return;
+    pending.erase(it);
+    spoolSize -= entry->size;
+    // Uploads not claimed by this process belong to the process that claimed them
+    if(entry->claimedDir.empty()) return;
+    std::error_code ec;
+    fs::remove_all(entry->claimedDir, ec);
+    if(ec) logger::debug("Failed to remove log upload {}: {}", entry->claimedDir.string(), ec.message());
+    entry->claimedDir.clear();
+}
+
+bool LogUploader::claim(Entry& entry) {
+    const auto claimedDir = config.spoolDir / (entry.id + CLAIMED_SUFFIX);
+    std::error_code ec;
+    // Atomic, so that only one of the processes sharing the spool directory reads, sends and deletes the upload
+    fs::rename(entry.dir, claimedDir, ec);
+    if(ec) return false;
+    // Renaming keeps the modification time, which tells stale claims apart
+    fs::last_write_time(claimedDir, fs::file_time_type::clock::now(), ec);
+    entry.claimedDir = claimedDir;
+    return true;
+}
+
+void LogUploader::unclaim(Entry& entry) {
+    std::error_code ec;
+    fs::rename(entry.claimedDir, entry.dir, ec);
+    // Otherwise picked up again once the claim is stale
+    if(ec) logger::debug("Failed to return log upload {} to the spool: {}", entry.id, ec.message());
+    entry.claimedDir.clear();
+}
+
+std::chrono::milliseconds LogUploader::retryDelay(int attempts) const {
+    const double delay = config.baseDelay.count() * std::pow(config.factor, attempts - 1);
+    return std::chrono::milliseconds(static_cast<int64_t>(std::min(delay, static_cast<double>(config.maxDelay.count()))));
+}
+
+#ifdef DEPTHAI_ENABLE_CURL
+LogUploader::SendResult LogUploader::send(const Entry& entry) {
+    cpr::Multipart multipart{};
+    for(const auto& field : entry.manifest.at("fields").items()) {
+        multipart.parts.emplace_back(field.key(), field.value().get<std::string>());
+    }
+    // Streamed from the spool directory rather than loaded into memory
+    for(const auto& file : entry.manifest.at("files")) {
+        const auto path = (entry.claimedDir / file.at("path").get<std::string>()).string();
+        multipart.parts.emplace_back(
+            file.at("field").get<std::string>(), cpr::Files{cpr::File{path, file.at("name").get<std::string>()}}, file.at("contentType").get<std::string>());
+    }
+    auto response = cpr::Post(cpr::Url{config.url},
+                              multipart,
+                              cpr::Timeout{config.requestTimeout},
+                              cpr::ProgressCallback([this](cpr::cpr_off_t, cpr::cpr_off_t, cpr::cpr_off_t, cpr::cpr_off_t, intptr_t) -> bool {
+                                  // Aborts the upload when stopping
+                                  return running.load();
+                              }));
+    const auto status = response.status_code;
+    if(status >= 200 && status < 300) return SendResult::SENT;
+    // Keep at info level to not spam in case of no internet connection
+    logger::info("Failed to send logs, status code: {}, {}", status, response.error.message.empty() ? response.text : response.error.message);
+    // The server won't accept this upload on a retry either
+    if(status >= 400 && status < 500 && status != 408 && status != 429) return SendResult::REJECTED;
+    return SendResult::RETRY;
+}
+#else
+LogUploader::SendResult LogUploader::send(const Entry&) {
+    logger::info("Not sending the logs to the server, as CURL support is disabled");
+    return SendResult::RETRY;
+}
+#endif
+
+}  // namespace logCollection
+}  // namespace dai
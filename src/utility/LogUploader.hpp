@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dai {
+namespace logCollection {
+
+/**
+ * Uploads logs to the log collection server on a background thread.
+ *
+ * Uploads are first written to a spool directory, so enqueueing never waits on the network and
+ * uploads that didn't make it (no connection, the process exited) are retried later, including by
+ * the next process using the same spool directory. Failed uploads are retried with exponential backoff.
+ *
+ * Processes may share the spool directory. Each upload is claimed by atomically renaming it before it is
+ * sent, so that it is sent and deleted by one process only.
+ */
+class LogUploader {
+   public:
+    struct File {
+        /// Multipart field name
+        std::string field;
+        /// File name sent to the server, ".gz" is appended if the file is compressed
+        std::string name;
+        std::string content;
+    };
+
+    struct Upload {
+        /// Plain multipart fields
+        std::map<std::string, std::string> fields;
+        std::vector<File> files;
+    };
+
+    struct Config {
+        std::string url;
+        std::filesystem::path spoolDir;
+        /// Uploads larger than this, after compression, are dropped
+        std::size_t maxUploadSize = 32 * 1024 * 1024;
+        /// Oldest uploads are dropped to keep the spool directory below this size
+        std::size_t maxSpoolSize = 128 * 1024 * 1024;
+        /// Attempts before an upload is dropped
+        int maxAttempts = 8;
+        std::chrono::milliseconds baseDelay{1000};
+        float factor = 2.0f;
+        std::chrono::milliseconds maxDelay{5 * 60 * 1000};
+        std::chrono::milliseconds requestTimeout{30 * 1000};
+        /// gzip the files
+        bool compress = true;
+    };
+
+    /**
+     * Shared uploader for the default log endpoint, spooling to .cache/depthai/uploads.
+     * Started on first use.
+     */
+    static LogUploader& getInstance();
+
+    /**
+     * Picks up anything left in the spool directory and starts the upload thread
+     */
+    explicit LogUploader(Config config);
+
+    /**
+     * Stops the upload thread, aborting an upload in progress. Pending uploads stay in the spool directory.
+     */
+    ~LogUploader();
+
+    LogUploader(const LogUploader&) = delete;
+    LogUploader& operator=(const LogUploader&) = delete;
+
+    /**
+     * Writes the upload to the spool directory to be sent in the background
+     * @returns false if the upload was dropped, as it is too large or couldn't be written
+     */
+    bool enqueue(Upload upload);
+
+    /**
+     * Waits until the spool directory is empty, for tests and tools
+     * @returns true if everything was uploaded or dropped before the timeout
+     */
+    bool waitIdle(std::chrono::milliseconds timeout);
+
+    /// Number of uploads in the spool directory
+    std::size_t getNumPending() const;
+
+    /// Number of uploads sent successfully since start
+    std::size_t getNumUploaded() const;
+
+   private:
+    struct Entry;
+    enum class SendResult { SENT, RETRY, REJECTED };
+
+    Config config;
+    mutable std::mutex mtx;
+    std::condition_variable cv;
+    std::vector<std::shared_ptr<Entry>> pending;
+    std::size_t spoolSize = 0;
+    std::size_t numUploaded = 0;
+    uint64_t counter = 0;
+    std::atomic<bool> running{true};
+    // Entry being uploaded, which isn't evicted to keep the spool size cap
+    std::shared_ptr<Entry> inFlight;
+    std::thread thread;
+
+    void loadSpool();
+    void run();
+    SendResult send(const Entry& entry);
+    void remove(const std::shared_ptr<Entry>& entry);
+    bool claim(Entry& entry);
+    void unclaim(Entry& entry);
+    std::chrono::milliseconds retryDelay(int attempts) const;
+};
+
+}  // namespace logCollection
+}  // namespace dai
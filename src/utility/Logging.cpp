@@ -1,6 +1,7 @@
 #include "Logging.hpp"
 
 #include "Environment.hpp"
+#include "LogSinks.hpp"
 
 namespace dai {
 
@@ -75,6 +76,28 @@ Logging::Logging() : logger("depthai", {std::make_shared<spdlog::sinks::stdout_c
             logger.warn("DEPTHAI_DEBUG value invalid: {}, should be a number (non-zero to enable)", e.what());
         }
     }
+
+    // Sinks shared by the library and node loggers
+    auto sinks = logger.sinks();
+    auto jsonPath = utility::getEnvAs<std::string>("DEPTHAI_LOG_JSON", "", logger);
+    if(!jsonPath.empty()) {
+        try {
+            sinks.push_back(std::make_shared<JsonLinesLogSink>(jsonPath));
+        } catch(const spdlog::spdlog_ex& e) {
+            logger.warn("DEPTHAI_LOG_JSON can't be opened: {}", e.what());
+        }
+    }
+    auto rateLimit = utility::getEnvAs<double>("DEPTHAI_LOG_RATE_LIMIT", 0.0, logger);
+    if(rateLimit > 0.0) {
+        // Bursts of up to a second worth of messages
+        auto rateLimitSink = std::make_shared<RateLimitLogSink>(rateLimit, rateLimit);
+        rateLimitSink->set_sinks(sinks);
+        sinks = {rateLimitSink};
+    }
+    if(utility::getEnvAs<bool>("DEPTHAI_LOG_ASYNC", false, logger)) {
+        sinks = {std::make_shared<AsyncLogSink>(sinks)};
+    }
+    logger.sinks() = sinks;
 }
 
 spdlog::level::level_enum Logging::parseLevel(std::string lvl) {
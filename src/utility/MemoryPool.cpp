@@ -0,0 +1,42 @@
+#include "MemoryPool.hpp"
+
+namespace dai {
+namespace utility {
+
+MemoryPool::MemoryPool(std::size_t numBuffers) {
+    setNumBuffers(numBuffers);
+}
+
+std::shared_ptr<Memory> MemoryPool::acquire(std::size_t size) {
+    // Round robin over the pool, so recently released buffers get a chance to drain from consumers
+    for(std::size_t i = 0; i < buffers.size(); i++) {
+        auto& buffer = buffers[(next + i) % buffers.size()];
+        // Only the pool holds a reference - no message uses the buffer anymore
+        if(buffer.use_count() == 1) {
+            next = (next + i + 1) % buffers.size();
+            buffer->resize(size);
+            return buffer;
+        }
+    }
+    misses++;
+    return std::make_shared<VectorMemory>(std::vector<std::uint8_t>(size));
+}
+
+void MemoryPool::setNumBuffers(std::size_t numBuffers) {
+    buffers.resize(numBuffers);
+    for(auto& buffer : buffers) {
+        if(!buffer) buffer = std::make_shared<VectorMemory>();
+    }
+    next = 0;
+}
+
+std::size_t MemoryPool::getNumBuffers() const {
+    return buffers.size();
+}
+
+std::size_t MemoryPool::getNumMisses() const {
+    return misses;
+}
+
+}  // namespace utility
+}  // namespace dai
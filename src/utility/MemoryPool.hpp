@@ -0,0 +1,49 @@
+#pragma once
+
+// std
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// project
+#include "depthai/utility/VectorMemory.hpp"
+
+namespace dai {
+namespace utility {
+
+/**
+ * Fixed set of reusable host buffers for producing message payloads.
+ * A buffer is handed out again once every message referencing it was released.
+ * Not thread-safe - meant to be owned and used by a single producer (eg. a host node run loop).
+ */
+class MemoryPool {
+   public:
+    explicit MemoryPool(std::size_t numBuffers = 4);
+
+    /**
+     * Acquire a buffer of given size. If all pooled buffers are still in use,
+     * a standalone buffer is allocated instead so the producer never stalls.
+     * @param size Size in bytes of the returned buffer
+     * @returns Memory which can be assigned directly to a message's data
+     */
+    std::shared_ptr<Memory> acquire(std::size_t size);
+
+    /**
+     * Change number of pooled buffers. Buffers currently in use stay valid.
+     */
+    void setNumBuffers(std::size_t numBuffers);
+    std::size_t getNumBuffers() const;
+
+    /**
+     * Number of acquisitions that could not be served from the pool
+     */
+    std::size_t getNumMisses() const;
+
+   private:
+    std::vector<std::shared_ptr<VectorMemory>> buffers;
+    std::size_t next = 0;
+    std::size_t misses = 0;
+};
+
+}  // namespace utility
+}  // namespace dai
@@ -0,0 +1,407 @@
+#include "OnnxRuntimeInference.hpp"
+
+#include <onnxruntime_cxx_api.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+#include "fp16/fp16.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace dai {
+namespace impl {
+
+namespace {
+
+TensorInfo::DataType toDataType(ONNXTensorElementDataType type) {
+    switch(type) {
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+            return TensorInfo::DataType::FP32;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+            return TensorInfo::DataType::FP16;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+            return TensorInfo::DataType::FP64;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+            return TensorInfo::DataType::U8F;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+            return TensorInfo::DataType::I8;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:  // narrowed when copied
+            return TensorInfo::DataType::INT;
+        default:
+            throw std::runtime_error(fmt::format("Unsupported ONNX tensor element type {}", static_cast<int>(type)));
+    }
+}
+
+std::size_t elementSize(TensorInfo::DataType type) {
+    switch(type) {
+        case TensorInfo::DataType::U8F:
+        case TensorInfo::DataType::I8:
+            return 1;
+        case TensorInfo::DataType::FP16:
+            return 2;
+        case TensorInfo::DataType::INT:
+        case TensorInfo::DataType::FP32:
+            return 4;
+        case TensorInfo::DataType::FP64:
+            return 8;
+    }
+    return 0;
+}
+
+TensorInfo::StorageOrder defaultOrder(std::size_t numDims) {
+    switch(numDims) {
+        case 4:
+            return TensorInfo::StorageOrder::NCHW;
+        case 3:
+            return TensorInfo::StorageOrder::CHW;
+        case 2:
+            return TensorInfo::StorageOrder::NC;
+        default:
+            return TensorInfo::StorageOrder::C;
+    }
+}
+
+// Tensors are aligned the same way as by NNData::addTensor
+constexpr std::size_t TENSOR_ALIGNMENT = 64;
+
+std::size_t alignUp(std::size_t value) {
+    return (value + TENSOR_ALIGNMENT - 1) / TENSOR_ALIGNMENT * TENSOR_ALIGNMENT;
+}
+
+/// Describes one batch item of a dense output tensor, with batch dimension 1 and byte strides
+TensorInfo describeItem(const std::string& name, TensorInfo::DataType dataType, std::vector<int64_t> shape, std::size_t offset) {
+    TensorInfo info;
+    info.name = name;
+    info.dataType = dataType;
+    if(shape.empty()) shape.push_back(1);
+    shape[0] = 1;
+    info.dims.assign(shape.begin(), shape.end());
+    info.numDimensions = static_cast<unsigned>(info.dims.size());
+    info.order = defaultOrder(info.dims.size());
+    info.strides.resize(info.dims.size());
+    std::size_t stride = elementSize(dataType);
+    for(std::size_t i = info.dims.size(); i-- > 0;) {
+        info.strides[i] = static_cast<unsigned>(stride);
+        stride *= info.dims[i];
+    }
+    info.offset = static_cast<unsigned>(offset);
+    return info;
+}
+
+float readElement(const std::uint8_t* data, TensorInfo::DataType type, std::size_t index) {
+    switch(type) {
+        case TensorInfo::DataType::U8F:
+            return data[index];
+        case TensorInfo::DataType::I8:
+            return reinterpret_cast<const std::int8_t*>(data)[index];
+        case TensorInfo::DataType::FP16:
+            return fp16_ieee_to_fp32_value(reinterpret_cast<const std::uint16_t*>(data)[index]);
+        case TensorInfo::DataType::INT:
+            return static_cast<float>(reinterpret_cast<const std::int32_t*>(data)[index]);
+        case TensorInfo::DataType::FP32:
+            return reinterpret_cast<const float*>(data)[index];
+        case TensorInfo::DataType::FP64:
+            return static_cast<float>(reinterpret_cast<const double*>(data)[index]);
+    }
+    return 0.0f;
+}
+
+}  // namespace
+
+class OnnxRuntimeInference::Impl {
+   public:
+    struct TensorDesc {
+        std::string name;
+        ONNXTensorElementDataType elementType;
+        std::vector<int64_t> shape;  // batch dimension (if any) first, -1 for dynamic dimensions
+        bool isStatic = true;        // all non batch dimensions known
+        std::size_t itemElements = 0;
+        HostInferencePreprocessing preprocessing;
+        bool nchw = true;
+    };
+
+    Ort::Env env{ORT_LOGGING_LEVEL_WARNING, "depthai"};
+    Ort::Session session{nullptr};
+    Ort::MemoryInfo memoryInfo = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    std::vector<TensorDesc> inputs;
+    std::vector<TensorDesc> outputs;
+    bool dynamicBatch = false;
+    bool staticOutputs = true;
+
+    static TensorDesc describe(const std::string& name, const Ort::TypeInfo& typeInfo) {
+        auto tensorInfo = typeInfo.GetTensorTypeAndShapeInfo();
+        TensorDesc desc;
+        desc.name = name;
+        desc.elementType = tensorInfo.GetElementType();
+        desc.shape = tensorInfo.GetShape();
+        desc.itemElements = 1;
+        for(std::size_t i = 1; i < desc.shape.size(); i++) {
+            if(desc.shape[i] <= 0) {
+                desc.isStatic = false;
+            } else {
+                desc.itemElements *= static_cast<std::size_t>(desc.shape[i]);
+            }
+        }
+        if(desc.shape.empty()) desc.isStatic = false;
+        return desc;
+    }
+
+    void fillFromFrame(const TensorDesc& desc, const ImgFrame& frame, std::uint8_t* dst) const {
+        if(desc.shape.size() != 4) {
+            throw std::runtime_error(fmt::format("Model input '{}' must be a 4D image tensor to be fed with ImgFrame", desc.name));
+        }
+        const auto channels = static_cast<unsigned>(desc.nchw ? desc.shape[1] : desc.shape[3]);
+        const auto height = static_cast<unsigned>(desc.nchw ? desc.shape[2] : desc.shape[1]);
+        const auto width = static_cast<unsigned>(desc.nchw ? desc.shape[3] : desc.shape[2]);
+        if(frame.getWidth() != width || frame.getHeight() != height) {
+            throw std::runtime_error(
+                fmt::format("Frame size {}x{} doesn't match model input '{}' size {}x{}", frame.getWidth(), frame.getHeight(), desc.name, width, height));
+        }
+
+        const auto type = frame.getType();
+        const bool interleaved = ImgFrame::isInterleaved(type);
+        unsigned frameChannels = 0;
+        bool frameRgb = false;
+        switch(type) {
+            case ImgFrame::Type::GRAY8:
+            case ImgFrame::Type::RAW8:
+                frameChannels = 1;
+                break;
+            case ImgFrame::Type::RGB888p:
+            case ImgFrame::Type::RGB888i:
+                frameRgb = true;
+                frameChannels = 3;
+                break;
+            case ImgFrame::Type::BGR888p:
+            case ImgFrame::Type::BGR888i:
+                frameChannels = 3;
+                break;
+            default:
+                throw std::runtime_error(fmt::format("Frame type {} is not supported for host inference", static_cast<int>(type)));
+        }
+        if(frameChannels != channels) {
+            throw std::runtime_error(fmt::format("Frame has {} channels, model input '{}' expects {}", frameChannels, desc.name, channels));
+        }
+
+        const std::uint8_t* src = frame.getData().data() + frame.fb.p1Offset;
+        const std::size_t stride = frame.getStride();
+        const std::size_t planeStride = frame.getPlaneStride();
+        const auto& pre = desc.preprocessing;
+        // Model expects BGR unless reverseChannels is set
+        const bool swap = channels == 3 && (frameRgb != pre.reverseChannels);
+        const bool asFloat = desc.elementType == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT;
+        const std::size_t planeSize = static_cast<std::size_t>(width) * height;
+
+        for(unsigned c = 0; c < channels; c++) {
+            const unsigned srcC = swap ? 2 - c : c;
+            const float mean = c < pre.mean.size() ? pre.mean[c] : 0.0f;
+            const float scale = c < pre.scale.size() && pre.scale[c] != 0.0f ? pre.scale[c] : 1.0f;
+            for(unsigned y = 0; y < height; y++) {
+                const std::uint8_t* row = interleaved ? src + y * stride + srcC : src + srcC * planeStride + y * stride;
+                const std::size_t step = interleaved ? channels : 1;
+                for(unsigned x = 0; x < width; x++) {
+                    const std::size_t dstIndex = desc.nchw ? c * planeSize + y * width + x : (static_cast<std::size_t>(y) * width + x) * channels + c;
+                    const std::uint8_t value = row[x * step];
+                    if(asFloat) {
+                        reinterpret_cast<float*>(dst)[dstIndex] = (static_cast<float>(value) - mean) / scale;
+                    } else {
+                        dst[dstIndex] = value;
+                    }
+                }
+            }
+        }
+    }
+
+    void fillFromNNData(const TensorDesc& desc, const NNData& data, std::uint8_t* dst) const {
+        auto info = data.getTensorInfo(desc.name);
+        if(!info && inputs.size() == 1 && data.tensors.size() == 1) info = data.tensors.front();
+        if(!info) throw std::runtime_error(fmt::format("NNData has no tensor for model input '{}'", desc.name));
+
+        std::size_t numElements = 1;
+        for(auto d : info->dims) numElements *= d;
+        if(numElements != desc.itemElements) {
+            throw std::runtime_error(fmt::format("Tensor '{}' has {} elements, model expects {}", desc.name, numElements, desc.itemElements));
+        }
+        const std::uint8_t* src = data.getData().data() + info->offset;
+        for(std::size_t i = 0; i < numElements; i++) {
+            const float value = readElement(src, info->dataType, i);
+            if(desc.elementType == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
+                reinterpret_cast<float*>(dst)[i] = value;
+            } else {
+                dst[i] = static_cast<std::uint8_t>(std::clamp(value, 0.0f, 255.0f));
+            }
+        }
+    }
+};
+
+OnnxRuntimeInference::OnnxRuntimeInference(span<const std::uint8_t> model,
+                                           int intraOpThreads,
+                                           std::map<std::string, HostInferencePreprocessing> preprocessing)
+    : pimpl(std::make_unique<Impl>()) {
+    Ort::SessionOptions options;
+    if(intraOpThreads > 0) options.SetIntraOpNumThreads(intraOpThreads);
+    options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+    pimpl->session = Ort::Session(pimpl->env, model.data(), model.size(), options);
+
+    Ort::AllocatorWithDefaultOptions allocator;
+    pimpl->dynamicBatch = true;
+    for(std::size_t i = 0; i < pimpl->session.GetInputCount(); i++) {
+        auto name = pimpl->session.GetInputNameAllocated(i, allocator);
+        auto desc = Impl::describe(name.get(), pimpl->session.GetInputTypeInfo(i));
+        if(!desc.isStatic) throw std::runtime_error(fmt::format("Model input '{}' has dynamic dimensions, which are not supported", desc.name));
+        if(desc.elementType != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT && desc.elementType != ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8) {
+            throw std::runtime_error(fmt::format("Model input '{}' must be float32 or uint8", desc.name));
+        }
+        pimpl->dynamicBatch = pimpl->dynamicBatch && desc.shape[0] <= 0;
+        if(preprocessing.count(desc.name)) desc.preprocessing = preprocessing.at(desc.name);
+        if(desc.preprocessing.layout.empty()) {
+            // Deduce from channel position
+            desc.nchw = !(desc.shape.size() == 4 && desc.shape[3] <= 4 && desc.shape[1] > 4);
+        } else {
+            desc.nchw = desc.preprocessing.layout != "NHWC";
+        }
+        pimpl->inputs.push_back(std::move(desc));
+    }
+    for(std::size_t i = 0; i < pimpl->session.GetOutputCount(); i++) {
+        auto name = pimpl->session.GetOutputNameAllocated(i, allocator);
+        auto desc = Impl::describe(name.get(), pimpl->session.GetOutputTypeInfo(i));
+        toDataType(desc.elementType);  // throws on unsupported types
+        // int64 outputs are narrowed, which requires a copy
+        pimpl->staticOutputs = pimpl->staticOutputs && desc.isStatic && desc.elementType != ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64;
+        pimpl->outputs.push_back(std::move(desc));
+    }
+}
+
+OnnxRuntimeInference::~OnnxRuntimeInference() = default;
+
+int OnnxRuntimeInference::getMaxBatchSize() const {
+    return pimpl->dynamicBatch ? std::numeric_limits<int>::max() : 1;
+}
+
+std::vector<std::string> OnnxRuntimeInference::getInputNames() const {
+    std::vector<std::string> names;
+    for(const auto& input : pimpl->inputs) names.push_back(input.name);
+    return names;
+}
+
+std::vector<std::shared_ptr<NNData>> OnnxRuntimeInference::infer(const std::vector<std::shared_ptr<Buffer>>& batch) {
+    auto& impl = *pimpl;
+    if(batch.empty()) return {};
+    if(static_cast<int>(batch.size()) > getMaxBatchSize()) throw std::invalid_argument("Batch is larger than the model supports");
+    const auto batchSize = static_cast<int64_t>(batch.size());
+
+    Ort::IoBinding binding(impl.session);
+
+    // Inputs
+    std::vector<std::vector<std::uint8_t>> inputStorage(impl.inputs.size());
+    for(std::size_t i = 0; i < impl.inputs.size(); i++) {
+        const auto& desc = impl.inputs[i];
+        const std::size_t itemBytes = desc.itemElements * (desc.elementType == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT ? sizeof(float) : 1);
+        inputStorage[i].resize(itemBytes * batch.size());
+        for(std::size_t b = 0; b < batch.size(); b++) {
+            std::uint8_t* dst = inputStorage[i].data() + b * itemBytes;
+            if(auto frame = std::dynamic_pointer_cast<ImgFrame>(batch[b])) {
+                if(impl.inputs.size() != 1) throw std::runtime_error("ImgFrame can only be inferred on single input models, use NNData instead");
+                impl.fillFromFrame(desc, *frame, dst);
+            } else if(auto data = std::dynamic_pointer_cast<NNData>(batch[b])) {
+                impl.fillFromNNData(desc, *data, dst);
+            } else {
+                throw std::runtime_error("Host inference expects ImgFrame or NNData messages");
+            }
+        }
+        auto shape = desc.shape;
+        shape[0] = batchSize;
+        binding.BindInput(desc.name.c_str(),
+                          Ort::Value::CreateTensor(impl.memoryInfo, inputStorage[i].data(), inputStorage[i].size(), shape.data(), shape.size(), desc.elementType));
+    }
+
+    // Outputs - with static shapes each message gets its own buffer, laid out output by output.
+    // A single message is inferred straight into its buffer, a batch into shared storage which is then split
+    std::vector<std::vector<std::uint8_t>> perMessage(batch.size());
+    std::vector<std::size_t> itemOffsets(impl.outputs.size());
+    std::vector<std::size_t> batchOffsets(impl.outputs.size());
+    std::vector<std::uint8_t> batchStorage;
+    if(impl.staticOutputs) {
+        std::size_t itemTotal = 0;
+        std::size_t batchTotal = 0;
+        for(std::size_t o = 0; o < impl.outputs.size(); o++) {
+            const std::size_t itemBytes = impl.outputs[o].itemElements * elementSize(toDataType(impl.outputs[o].elementType));
+            itemOffsets[o] = itemTotal;
+            itemTotal += alignUp(itemBytes);
+            batchOffsets[o] = batchTotal;
+            batchTotal += alignUp(itemBytes * batch.size());
+        }
+        for(auto& buffer : perMessage) buffer.resize(itemTotal);
+        if(batch.size() > 1) batchStorage.resize(batchTotal);
+        for(std::size_t o = 0; o < impl.outputs.size(); o++) {
+            const auto& desc = impl.outputs[o];
+            auto shape = desc.shape;
+            shape[0] = batchSize;
+            const std::size_t bytes = desc.itemElements * elementSize(toDataType(desc.elementType)) * batch.size();
+            std::uint8_t* dst = batch.size() > 1 ? batchStorage.data() + batchOffsets[o] : perMessage.front().data() + itemOffsets[o];
+            binding.BindOutput(desc.name.c_str(), Ort::Value::CreateTensor(impl.memoryInfo, dst, bytes, shape.data(), shape.size(), desc.elementType));
+        }
+    } else {
+        for(const auto& desc : impl.outputs) binding.BindOutput(desc.name.c_str(), impl.memoryInfo);
+    }
+
+    impl.session.Run(Ort::RunOptions{nullptr}, binding);
+
+    std::vector<std::shared_ptr<NNData>> results(batch.size());
+    for(auto& nnData : results) nnData = std::make_shared<NNData>();
+
+    if(impl.staticOutputs) {
+        for(std::size_t o = 0; o < impl.outputs.size(); o++) {
+            const auto& desc = impl.outputs[o];
+            const auto dataType = toDataType(desc.elementType);
+            const std::size_t itemBytes = desc.itemElements * elementSize(dataType);
+            for(std::size_t b = 0; b < batch.size(); b++) {
+                if(batch.size() > 1) {
+                    std::copy_n(batchStorage.data() + batchOffsets[o] + b * itemBytes, itemBytes, perMessage[b].data() + itemOffsets[o]);
+                }
+                results[b]->tensors.push_back(describeItem(desc.name, dataType, desc.shape, itemOffsets[o]));
+            }
+        }
+    } else {
+        // Copy runtime allocated outputs
+        auto values = binding.GetOutputValues();
+        for(std::size_t o = 0; o < values.size(); o++) {
+            const auto& desc = impl.outputs[o];
+            const auto dataType = toDataType(desc.elementType);
+            auto shapeInfo = values[o].GetTensorTypeAndShapeInfo();
+            const std::size_t itemElements = shapeInfo.GetElementCount() / batch.size();
+            const std::size_t itemBytes = itemElements * elementSize(dataType);
+            for(std::size_t b = 0; b < batch.size(); b++) {
+                auto& buffer = perMessage[b];
+                const std::size_t offset = alignUp(buffer.size());
+                buffer.resize(offset + itemBytes);
+                if(desc.elementType == ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64) {
+                    const auto* src = values[o].GetTensorData<int64_t>() + b * itemElements;
+                    auto* dst = reinterpret_cast<std::int32_t*>(buffer.data() + offset);
+                    for(std::size_t e = 0; e < itemElements; e++) dst[e] = static_cast<std::int32_t>(src[e]);
+                } else {
+                    const auto* src = static_cast<const std::uint8_t*>(values[o].GetTensorRawData()) + b * itemBytes;
+                    std::copy_n(src, itemBytes, buffer.data() + offset);
+                }
+                results[b]->tensors.push_back(describeItem(desc.name, dataType, shapeInfo.GetShape(), offset));
+            }
+        }
+    }
+    for(std::size_t b = 0; b < batch.size(); b++) results[b]->setData(std::move(perMessage[b]));
+
+    for(std::size_t b = 0; b < batch.size(); b++) {
+        auto& nnData = results[b];
+        nnData->batchSize = 1;
+        nnData->setSequenceNum(batch[b]->getSequenceNum());
+        nnData->setTimestamp(batch[b]->getTimestamp());
+        nnData->setTimestampDevice(batch[b]->getTimestampDevice());
+        if(auto frame = std::dynamic_pointer_cast<ImgFrame>(batch[b])) nnData->transformation = frame->transformation;
+    }
+    return results;
+}
+
+}  // namespace impl
+}  // namespace dai
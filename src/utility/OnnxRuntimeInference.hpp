@@ -0,0 +1,71 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "depthai/pipeline/datatype/Buffer.hpp"
+#include "depthai/pipeline/datatype/NNData.hpp"
+#include "depthai/utility/span.hpp"
+
+namespace dai {
+namespace impl {
+
+/**
+ * Preprocessing applied when converting an ImgFrame into a model input tensor.
+ * Mirrors the preprocessing block of an NNArchive input: value = (pixel - mean[c]) / scale[c]
+ */
+struct HostInferencePreprocessing {
+    std::vector<float> mean;
+    std::vector<float> scale;
+    bool reverseChannels = false;
+    /// Input layout override ("NCHW" or "NHWC"), deduced from the model input shape if empty
+    std::string layout;
+};
+
+/**
+ * CPU inference of ONNX models through ONNX Runtime, used by NeuralNetwork when running on host.
+ *
+ * Inputs are ImgFrame or NNData messages; several messages may be inferred in one call if the model
+ * has a dynamic batch dimension. Each produced NNData owns the data of its tensors. When all outputs have
+ * static shapes, a single message is inferred straight into the buffer of its NNData, without copies.
+ */
+class OnnxRuntimeInference {
+   public:
+    /**
+     * @param model Serialized ONNX model
+     * @param intraOpThreads Number of threads ONNX Runtime may use within an operator, 0 for its default
+     * @param preprocessing Preprocessing per model input name
+     */
+    OnnxRuntimeInference(span<const std::uint8_t> model, int intraOpThreads, std::map<std::string, HostInferencePreprocessing> preprocessing);
+    ~OnnxRuntimeInference();
+
+    OnnxRuntimeInference(const OnnxRuntimeInference&) = delete;
+    OnnxRuntimeInference& operator=(const OnnxRuntimeInference&) = delete;
+
+    /**
+     * Maximum number of messages which can be inferred in a single call.
+     * 1 for models with a static batch dimension.
+     */
+    int getMaxBatchSize() const;
+
+    /**
+     * Names of the model inputs
+     */
+    std::vector<std::string> getInputNames() const;
+
+    /**
+     * Run inference on a batch of messages. Each message provides all inputs of the model,
+     * an ImgFrame is only accepted for single input models.
+     * @returns One NNData per input message, carrying its sequence number, timestamps and transformation
+     */
+    std::vector<std::shared_ptr<NNData>> infer(const std::vector<std::shared_ptr<Buffer>>& batch);
+
+   private:
+    class Impl;
+    std::unique_ptr<Impl> pimpl;
+};
+
+}  // namespace impl
+}  // namespace dai
@@ -445,9 +445,9 @@ std::unique_ptr<google::protobuf::Message> getProtoMessage(const ImgDetections*
     }
 
     if(!metadataOnly) {
-        std::optional<std::vector<std::uint8_t>> segMaskData = message->getMaskData();
-        if(segMaskData) {
-            imgDetections->set_data((*segMaskData).data(), (*segMaskData).size());
+        const auto segMaskData = message->getMaskDataView();
+        if(!segMaskData.empty()) {
+            imgDetections->set_data(segMaskData.data(), segMaskData.size());
         }
     }
     return imgDetections;
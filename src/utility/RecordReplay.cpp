@@ -2,6 +2,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <mcap/types.hpp>
 #include <optional>
 #include <stdexcept>
@@ -106,6 +107,24 @@ std::string BytePlayer::init(const std::string& filePath) {
             throw std::runtime_error("Failed to open file for reading: " + res.message);
         }
     }
+    return initMessages();
+}
+
+std::string BytePlayer::init(const std::filesystem::path& archivePath, const TarMember& member) {
+    if(initialized) {
+        throw std::runtime_error("BytePlayer already initialized");
+    }
+    source = std::make_unique<TarMemberReader>(archivePath, member);
+    {
+        const auto res = reader.open(*source);
+        if(!res.ok()) {
+            throw std::runtime_error("Failed to open " + member.name + " for reading: " + res.message);
+        }
+    }
+    return initMessages();
+}
+
+std::string BytePlayer::initMessages() {
     messageView = std::make_unique<mcap::LinearMessageView>(reader.readMessages());
     if(messageView->begin() == messageView->end()) {
         throw std::runtime_error("No messages in file");
@@ -125,12 +144,12 @@ void BytePlayer::restart() {
 void BytePlayer::close() {
     if(initialized) {
         reader.close();
+        source.reset();
         initialized = false;
     }
 }
 
 std::optional<std::tuple<uint32_t, uint32_t>> BytePlayer::getVideoSize(const std::string& filePath) {
-#ifdef DEPTHAI_ENABLE_PROTOBUF
     if(filePath.empty()) {
         throw std::runtime_error("File path is empty in BytePlayer::getVideoSize");
     }
@@ -141,6 +160,23 @@ std::optional<std::tuple<uint32_t, uint32_t>> BytePlayer::getVideoSize(const std
             throw std::runtime_error("Failed to open file for reading: " + res.message);
         }
     }
+    return getVideoSize(reader);
+}
+
+std::optional<std::tuple<uint32_t, uint32_t>> BytePlayer::getVideoSize(const std::filesystem::path& archivePath, const TarMember& member) {
+    TarMemberReader source(archivePath, member);
+    mcap::McapReader reader;
+    {
+        const auto res = reader.open(source);
+        if(!res.ok()) {
+            throw std::runtime_error("Failed to open " + member.name + " for reading: " + res.message);
+        }
+    }
+    return getVideoSize(reader);
+}
+
+std::optional<std::tuple<uint32_t, uint32_t>> BytePlayer::getVideoSize(mcap::McapReader& reader) {
+#ifdef DEPTHAI_ENABLE_PROTOBUF
     auto messageView = reader.readMessages();
     if(messageView.begin() == messageView.end()) {
         return std::nullopt;
@@ -159,11 +195,33 @@ std::optional<std::tuple<uint32_t, uint32_t>> BytePlayer::getVideoSize(const std
     return std::nullopt;
 #else
     // Avoid warning for an unused parameter
-    (void)filePath;
+    (void)reader;
     throw std::runtime_error("BytePlayer::getVideoSize requires protobuf support");
 #endif
 }
 
+TarMemberReader::TarMemberReader(const std::filesystem::path& archivePath, const TarMember& member)
+    : stream(archivePath, std::ios::binary), begin(member.offset), length(member.size) {
+    if(!stream) {
+        throw std::runtime_error("Failed to open archive " + archivePath.string());
+    }
+}
+
+uint64_t TarMemberReader::size() const {
+    return length;
+}
+
+uint64_t TarMemberReader::read(std::byte** output, uint64_t offset, uint64_t size) {
+    if(offset >= length) return 0;
+    size = std::min(size, length - offset);
+    buffer.resize(size);
+    stream.clear();
+    stream.seekg(static_cast<std::streamoff>(begin + offset));
+    if(!stream.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(size))) return 0;
+    *output = buffer.data();
+    return size;
+}
+
 bool checkRecordConfig(std::filesystem::path& recordPath, RecordConfig& config) {
     if(!platform::checkPathExists(recordPath)) {
         spdlog::warn("DEPTHAI_RECORD path does not exist or is invalid. Record disabled.");
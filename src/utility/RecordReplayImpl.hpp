@@ -1,3 +1,6 @@
+#include <fstream>
+
+#include "depthai/utility/Compression.hpp"
 #include "depthai/utility/RecordReplay.hpp"
 #include "mcap/mcap.hpp"
 #ifdef DEPTHAI_ENABLE_MP4V2
@@ -14,6 +17,23 @@ namespace utility {
 mcap::Schema createSchema(const google::protobuf::Descriptor* d);
 #endif
 
+/**
+ * MCAP source reading a file in place from an uncompressed tar archive
+ */
+class TarMemberReader final : public mcap::IReadable {
+   public:
+    TarMemberReader(const std::filesystem::path& archivePath, const TarMember& member);
+
+    uint64_t size() const override;
+    uint64_t read(std::byte** output, uint64_t offset, uint64_t size) override;
+
+   private:
+    std::ifstream stream;
+    uint64_t begin = 0;
+    uint64_t length = 0;
+    std::vector<std::byte> buffer;
+};
+
 class VideoRecorder {
    public:
     enum class VideoCodec { H264, MJPEG, RAW };
@@ -101,6 +121,10 @@ class VideoPlayer {
    public:
     ~VideoPlayer();
     void init(const std::string& filePath);
+    /**
+     * Plays a video stored in an uncompressed tar archive, in place where the video backend supports it
+     */
+    void init(const std::filesystem::path& archivePath, const TarMember& member);
     void setSize(uint32_t width, uint32_t height);
     std::optional<std::vector<uint8_t>> next();
     std::tuple<uint32_t, uint32_t> size();
@@ -114,6 +138,8 @@ class VideoPlayer {
     uint32_t width = 0;
     uint32_t height = 0;
     bool initialized = false;
+    // Copy of a video from an archive, for backends that can't read it in place
+    std::filesystem::path extractedFile;
 #ifdef DEPTHAI_HAVE_OPENCV_SUPPORT
     std::unique_ptr<cv::VideoCapture> cvReader;
 #else
@@ -125,6 +151,7 @@ class BytePlayer {
    public:
     ~BytePlayer();
     std::string init(const std::string& filePath);
+    std::string init(const std::filesystem::path& archivePath, const TarMember& member);
     template <typename T>
     std::optional<T> next() {
         if(!initialized) {
@@ -147,11 +174,17 @@ class BytePlayer {
     void restart();
     void close();
     static std::optional<std::tuple<uint32_t, uint32_t>> getVideoSize(const std::string& filePath);
+    static std::optional<std::tuple<uint32_t, uint32_t>> getVideoSize(const std::filesystem::path& archivePath, const TarMember& member);
     bool isInitialized() const {
         return initialized;
     }
 
    private:
+    std::string initMessages();
+    static std::optional<std::tuple<uint32_t, uint32_t>> getVideoSize(mcap::McapReader& reader);
+
+    // Declared before the reader, which reads from it
+    std::unique_ptr<mcap::IReadable> source;
     mcap::McapReader reader;
     std::unique_ptr<mcap::LinearMessageView> messageView;
     std::unique_ptr<mcap::LinearMessageView::Iterator> it;
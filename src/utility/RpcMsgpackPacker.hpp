@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// nanorpc/core/hash.h relies on type.h being included first
+#include "nanorpc/core/type.h"
+
+#include "nanorpc/core/detail/pack_meta.h"
+#include "nanorpc/core/exception.h"
+#include "nanorpc/core/hash.h"
+#include "nanorpc/version/core.h"
+#include "nlohmann/json.hpp"
+
+namespace dai {
+namespace utility {
+
+/**
+ * nanorpc packer producing the same msgpack wire format as nanorpc::packer::nlohmann_msgpack,
+ * but without the intermediate copies: values are appended directly into a single JSON array
+ * which is serialized into a preallocated buffer, and unpacking walks the parsed array by index
+ * instead of copying it into a vector and erasing its front on every value.
+ */
+class RpcMsgpackPacker final {
+    class serializer;
+    class deserializer;
+
+   public:
+    using serializer_type = serializer;
+    using deserializer_type = deserializer;
+
+    template <typename T>
+    serializer pack(const T& value) {
+        return serializer{}.pack(value);
+    }
+
+    deserializer from_buffer(nanorpc::core::type::buffer buffer) {
+        return deserializer{std::move(buffer)};
+    }
+
+   private:
+    class serializer final {
+       public:
+        serializer(serializer&&) noexcept = default;
+        serializer& operator=(serializer&&) noexcept = default;
+        ~serializer() noexcept = default;
+
+        template <typename T>
+        serializer pack(const T& value) {
+            data.emplace_back(value);
+            return std::move(*this);
+        }
+
+        nanorpc::core::type::buffer to_buffer() {
+            if(data.empty()) throw nanorpc::core::exception::packer{"[dai::utility::RpcMsgpackPacker::serializer::to_buffer] Empty data."};
+            nanorpc::core::type::buffer buffer;
+            nlohmann::json::to_msgpack(data, buffer);
+            return buffer;
+        }
+
+       private:
+        friend class RpcMsgpackPacker;
+        serializer() = default;
+
+        nlohmann::json data = nlohmann::json::array();
+    };
+
+    class deserializer final {
+       public:
+        deserializer(deserializer&&) noexcept = default;
+        deserializer& operator=(deserializer&&) noexcept = default;
+        ~deserializer() noexcept = default;
+
+        explicit deserializer(const nanorpc::core::type::buffer& buffer) : data(nlohmann::json::from_msgpack(buffer)) {
+            if(!data.is_array()) throw nanorpc::core::exception::packer{"[dai::utility::RpcMsgpackPacker::deserializer] Malformed stream."};
+        }
+
+        template <typename T>
+        deserializer unpack(T& value) {
+            if(index >= data.size()) throw nanorpc::core::exception::packer{"[dai::utility::RpcMsgpackPacker::deserializer] Empty stream."};
+            nlohmann::from_json(data[index++], value);
+            return std::move(*this);
+        }
+
+       private:
+        nlohmann::json data;
+        std::size_t index = 0;
+    };
+};
+
+/**
+ * Packs a nanorpc request, as nanorpc::core::client::call would
+ */
+template <typename... Args>
+nanorpc::core::type::buffer packRpcRequest(const std::string& name, Args&&... args) {
+    return RpcMsgpackPacker{}
+        .pack(nanorpc::version::core::protocol::value)
+        .pack(nanorpc::core::detail::pack::meta::type::request)
+        .pack(nanorpc::core::hash_id(name))
+        .pack(std::make_tuple(std::forward<Args>(args)...))
+        .to_buffer();
+}
+
+/**
+ * Checks a nanorpc response and unpacks its result, as nanorpc::core::client::call would
+ */
+template <typename T>
+T unpackRpcResponse(const std::string& name, nanorpc::core::type::buffer buffer) {
+    using namespace nanorpc::core;
+    auto response = RpcMsgpackPacker{}.from_buffer(std::move(buffer));
+
+    nanorpc::version::core::protocol::value_type protocol{};
+    response = response.unpack(protocol);
+    if(protocol != nanorpc::version::core::protocol::value) {
+        throw exception::client{"Unsupported protocol version \"" + std::to_string(protocol) + "\". (" + name + ")"};
+    }
+
+    detail::pack::meta::type type{};
+    response = response.unpack(type);
+    if(type != detail::pack::meta::type::response) throw exception::client{"Bad response type. (" + name + ")"};
+
+    detail::pack::meta::status status{};
+    response = response.unpack(status);
+    if(status != detail::pack::meta::status::good) {
+        std::string message;
+        response = response.unpack(message);
+        throw exception::logic{message + " (" + name + ")"};
+    }
+
+    T value{};
+    response = response.unpack(value);
+    return value;
+}
+
+}  // namespace utility
+}  // namespace dai
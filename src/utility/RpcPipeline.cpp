@@ -0,0 +1,111 @@
+#include "RpcPipeline.hpp"
+
+#include <stdexcept>
+
+namespace dai {
+namespace utility {
+
+RpcPipeline::RpcPipeline(WriteFn write, ReadFn read) : write(std::move(write)), read(std::move(read)) {
+    reader = std::thread(&RpcPipeline::readerThread, this);
+}
+
+RpcPipeline::~RpcPipeline() {
+    close();
+}
+
+std::uint64_t RpcPipeline::submit(Buffer request, std::chrono::milliseconds timeout, Callback callback) {
+    std::lock_guard<std::mutex> writeLock(writeMtx);
+    std::uint64_t id = 0;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        if(error || !running) {
+            auto e = error ? error : std::make_exception_ptr(std::runtime_error("RPC pipeline closed"));
+            lock.unlock();
+            callback({}, e);
+            return id;
+        }
+        id = nextId++;
+        // Registered before writing, as the response may arrive before write returns
+        pending.push_back({id, timeout, std::move(callback)});
+    }
+    cv.notify_one();
+
+    try {
+        write(std::move(request));
+    } catch(...) {
+        fail(std::current_exception());
+    }
+    return id;
+}
+
+std::future<RpcPipeline::Buffer> RpcPipeline::submit(Buffer request, std::chrono::milliseconds timeout) {
+    auto promise = std::make_shared<std::promise<Buffer>>();
+    auto future = promise->get_future();
+    submit(std::move(request), timeout, [promise](Buffer response, std::exception_ptr error) {
+        if(error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value(std::move(response));
+        }
+    });
+    return future;
+}
+
+std::size_t RpcPipeline::getNumInFlight() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return pending.size();
+}
+
+void RpcPipeline::close() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        running = false;
+    }
+    cv.notify_all();
+    fail(std::make_exception_ptr(std::runtime_error("RPC pipeline closed")));
+    if(reader.joinable() && reader.get_id() != std::this_thread::get_id()) reader.join();
+}
+
+void RpcPipeline::fail(std::exception_ptr e) {
+    std::deque<Pending> failed;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if(!error) error = e;
+        failed.swap(pending);
+    }
+    cv.notify_all();
+    for(auto& p : failed) p.callback({}, e);
+}
+
+void RpcPipeline::readerThread() {
+    while(true) {
+        std::chrono::milliseconds timeout;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [this]() { return !running || error || !pending.empty(); });
+            if(!running || error) return;
+            timeout = pending.front().timeout;
+        }
+
+        Buffer response;
+        try {
+            response = read(timeout);
+        } catch(...) {
+            fail(std::current_exception());
+            return;
+        }
+
+        Pending done;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            // Already failed by close()
+            if(pending.empty()) return;
+            done = std::move(pending.front());
+            pending.pop_front();
+        }
+        done.callback(std::move(response), nullptr);
+    }
+}
+
+}  // namespace utility
+}  // namespace dai
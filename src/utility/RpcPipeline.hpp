@@ -0,0 +1,95 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dai {
+namespace utility {
+
+/**
+ * Pipelined request/response transport for RPC over a single ordered stream.
+ *
+ * Requests are written as soon as they are submitted, without waiting for the responses of
+ * previously submitted requests. Each request is tagged with an increasing id and kept in a
+ * FIFO of in-flight requests; since the remote end serves requests in order, a dedicated reader
+ * thread matches each response to the oldest in-flight request and completes it.
+ *
+ * A read timeout or stream error desynchronizes the stream, so it fails all in-flight requests and
+ * every request submitted afterwards with the same error.
+ */
+class RpcPipeline {
+   public:
+    using Buffer = std::vector<std::uint8_t>;
+    /// Writes one request to the stream
+    using WriteFn = std::function<void(Buffer)>;
+    /// Reads one response from the stream, waiting at most the given timeout (zero waits indefinitely)
+    using ReadFn = std::function<Buffer(std::chrono::milliseconds)>;
+    /// Called from the reader thread with either the response or the error
+    using Callback = std::function<void(Buffer response, std::exception_ptr error)>;
+
+    RpcPipeline(WriteFn write, ReadFn read);
+    ~RpcPipeline();
+
+    RpcPipeline(const RpcPipeline&) = delete;
+    RpcPipeline& operator=(const RpcPipeline&) = delete;
+
+    /**
+     * Submits a request. The callback is invoked exactly once, from the reader thread, or from the calling
+     * thread if the request couldn't be written.
+     * @param request Request to write
+     * @param timeout Time the response may take once all earlier requests were answered, zero waits indefinitely
+     * @returns Id assigned to the request
+     */
+    std::uint64_t submit(Buffer request, std::chrono::milliseconds timeout, Callback callback);
+
+    /**
+     * Submits a request
+     * @returns Future holding the response
+     */
+    std::future<Buffer> submit(Buffer request, std::chrono::milliseconds timeout);
+
+    /**
+     * @returns Number of requests written and not yet answered
+     */
+    std::size_t getNumInFlight() const;
+
+    /**
+     * Fails all in-flight and future requests and stops the reader thread.
+     * The stream must be closed beforehand if the reader may be blocked in a read.
+     */
+    void close();
+
+   private:
+    struct Pending {
+        std::uint64_t id;
+        std::chrono::milliseconds timeout;
+        Callback callback;
+    };
+
+    void readerThread();
+    void fail(std::exception_ptr error);
+
+    WriteFn write;
+    ReadFn read;
+
+    // Serializes writes, so that the order of ids matches the order on the stream
+    std::mutex writeMtx;
+    mutable std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<Pending> pending;
+    std::uint64_t nextId = 0;
+    std::exception_ptr error;
+    bool running = true;
+    std::thread reader;
+};
+
+}  // namespace utility
+}  // namespace dai
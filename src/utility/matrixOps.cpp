@@ -1,5 +1,8 @@
 #include "depthai/utility/matrixOps.hpp"
 
+#include <stdexcept>
+#include <string>
+
 namespace dai {
 namespace matrix {
 
@@ -224,5 +227,98 @@ std::vector<std::vector<float>> rvecToRotationMatrix(const double rvec[3]) {
     return R;
 }
 
+namespace {
+
+template <std::size_t N>
+std::array<std::array<float, N>, N> identity() {
+    std::array<std::array<float, N>, N> res{};
+    for(std::size_t i = 0; i < N; ++i) res[i][i] = 1;
+    return res;
+}
+
+// Same summation order as the vector matMul, so that both give identical results
+template <std::size_t N>
+std::array<std::array<float, N>, N> multiply(const std::array<std::array<float, N>, N>& a, const std::array<std::array<float, N>, N>& b) {
+    std::array<std::array<float, N>, N> res{};
+    for(std::size_t i = 0; i < N; ++i) {
+        for(std::size_t j = 0; j < N; ++j) {
+            for(std::size_t k = 0; k < N; ++k) {
+                res[i][j] += a[i][k] * b[k][j];
+            }
+        }
+    }
+    return res;
+}
+
+template <std::size_t N>
+std::array<std::array<float, N>, N> fromVector(const std::vector<std::vector<float>>& matrix) {
+    if(matrix.size() != N) {
+        throw std::runtime_error("Matrix should have " + std::to_string(N) + " rows");
+    }
+    std::array<std::array<float, N>, N> res{};
+    for(std::size_t i = 0; i < N; ++i) {
+        if(matrix[i].size() != N) {
+            throw std::runtime_error("Matrix should have " + std::to_string(N) + " columns");
+        }
+        for(std::size_t j = 0; j < N; ++j) res[i][j] = matrix[i][j];
+    }
+    return res;
+}
+
+template <std::size_t N>
+std::vector<std::vector<float>> toNestedVector(const std::array<std::array<float, N>, N>& matrix) {
+    std::vector<std::vector<float>> res(N);
+    for(std::size_t i = 0; i < N; ++i) res[i].assign(matrix[i].begin(), matrix[i].end());
+    return res;
+}
+
+}  // namespace
+
+Mat3f identity3f() {
+    return identity<3>();
+}
+
+Mat4f identity4f() {
+    return identity<4>();
+}
+
+Mat3f matMul(const Mat3f& firstMatrix, const Mat3f& secondMatrix) {
+    return multiply(firstMatrix, secondMatrix);
+}
+
+Mat4f matMul(const Mat4f& firstMatrix, const Mat4f& secondMatrix) {
+    return multiply(firstMatrix, secondMatrix);
+}
+
+Mat4f invertSe3(const Mat4f& matrix) {
+    Mat4f res = identity4f();
+    for(int i = 0; i < 3; ++i) {
+        for(int j = 0; j < 3; ++j) res[i][j] = matrix[j][i];
+    }
+    for(int i = 0; i < 3; ++i) {
+        res[i][3] = 0;
+        for(int j = 0; j < 3; ++j) {
+            res[i][3] -= res[i][j] * matrix[j][3];
+        }
+    }
+    return res;
+}
+
+Mat3f toMat3f(const std::vector<std::vector<float>>& matrix) {
+    return fromVector<3>(matrix);
+}
+
+Mat4f toMat4f(const std::vector<std::vector<float>>& matrix) {
+    return fromVector<4>(matrix);
+}
+
+std::vector<std::vector<float>> toVector(const Mat3f& matrix) {
+    return toNestedVector(matrix);
+}
+
+std::vector<std::vector<float>> toVector(const Mat4f& matrix) {
+    return toNestedVector(matrix);
+}
+
 }  // namespace matrix
 }  // namespace dai
@@ -0,0 +1,111 @@
+#include "depthai/xlink/LoopbackConnection.hpp"
+
+// project
+#include "depthai/xlink/XLinkStream.hpp"
+
+namespace dai {
+
+constexpr std::chrono::milliseconds LoopbackStream::INFINITE_TIMEOUT;
+
+static XLinkTimespec getTimespecNow() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(now);
+    XLinkTimespec ts;
+    ts.tv_sec = seconds.count();
+    ts.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(now - seconds).count();
+    return ts;
+}
+
+LoopbackStream::LoopbackStream(std::string name, std::size_t maxQueuedPackets) : name(std::move(name)), maxQueuedPackets(maxQueuedPackets) {
+    if(maxQueuedPackets == 0) throw std::invalid_argument("LoopbackStream must be able to queue at least one packet");
+}
+
+template <typename Predicate>
+bool LoopbackStream::waitFor(std::unique_lock<std::mutex>& lock, std::condition_variable& condition, std::chrono::milliseconds timeout, Predicate predicate) {
+    if(timeout == INFINITE_TIMEOUT) {
+        condition.wait(lock, predicate);
+        return true;
+    }
+    return condition.wait_for(lock, timeout, predicate);
+}
+
+XLinkError_t LoopbackStream::write(
+    span<const std::uint8_t> data, span<const std::uint8_t> data2, long fd, std::size_t maxWriteSize, std::chrono::milliseconds timeout) {
+    // As XLink, refuse packets the reading end hasn't got the buffer for
+    if(data.size() + data2.size() > maxWriteSize) return X_LINK_ERROR;
+
+    Packet packet;
+    packet.data.reserve(data.size() + data2.size());
+    packet.data.insert(packet.data.end(), data.begin(), data.end());
+    packet.data.insert(packet.data.end(), data2.begin(), data2.end());
+    packet.fd = fd;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        if(!waitFor(lock, canWrite, timeout, [this]() { return closed || packets.size() < maxQueuedPackets; })) return X_LINK_TIMEOUT;
+        if(closed) return X_LINK_COMMUNICATION_NOT_OPEN;
+        packet.tSent = getTimespecNow();
+        packets.push_back(std::move(packet));
+    }
+    canRead.notify_one();
+    return X_LINK_SUCCESS;
+}
+
+XLinkError_t LoopbackStream::read(StreamPacketDesc& packet, std::chrono::milliseconds timeout) {
+    Packet received;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        if(!waitFor(lock, canRead, timeout, [this]() { return closed || !packets.empty(); })) return X_LINK_TIMEOUT;
+        if(closed) return X_LINK_COMMUNICATION_NOT_OPEN;
+        received = std::move(packets.front());
+        packets.pop_front();
+    }
+    canWrite.notify_one();
+
+    StreamPacketDesc desc;
+    desc.loopbackData = std::move(received.data);
+    desc.data = desc.loopbackData.data();
+    desc.length = static_cast<std::uint32_t>(desc.loopbackData.size());
+    desc.fd = received.fd;
+    desc.tRemoteSent = received.tSent;
+    desc.tReceived = getTimespecNow();
+    packet = std::move(desc);
+    return X_LINK_SUCCESS;
+}
+
+void LoopbackStream::close() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        closed = true;
+    }
+    canRead.notify_all();
+    canWrite.notify_all();
+}
+
+const std::string& LoopbackStream::getName() const {
+    return name;
+}
+
+LoopbackConnection::LoopbackConnection(std::size_t maxQueuedPackets) : maxQueuedPackets(maxQueuedPackets) {}
+
+LoopbackConnection::~LoopbackConnection() {
+    close();
+}
+
+std::shared_ptr<LoopbackStream> LoopbackConnection::openStream(const std::string& name) {
+    std::lock_guard<std::mutex> lock(streamsMtx);
+    if(streamsClosed) throw std::runtime_error("Cannot open stream on a closed LoopbackConnection");
+    auto& stream = streams[name];
+    if(!stream) stream = std::make_shared<LoopbackStream>(name, maxQueuedPackets);
+    return stream;
+}
+
+void LoopbackConnection::close() {
+    {
+        std::lock_guard<std::mutex> lock(streamsMtx);
+        streamsClosed = true;
+        for(auto& kv : streams) kv.second->close();
+    }
+    XLinkConnection::close();
+}
+
+}  // namespace dai
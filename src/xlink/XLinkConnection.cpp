@@ -409,6 +409,8 @@ XLinkConnection::XLinkConnection(const DeviceInfo& deviceDesc, XLinkDeviceState_
     initDevice(deviceDesc, expectedState);
 }
 
+XLinkConnection::XLinkConnection() : bootDevice(false), rebootOnDestruction(false) {}
+
 // This function is thread-unsafe. The `closed` value is only known and valid
 // within the context of the lock_guard. The value is immediately invalid and outdated
 // when it is returned by value to the caller
@@ -6,6 +6,7 @@
 
 // project
 #include "depthai/utility/SharedMemory.hpp"
+#include "depthai/xlink/LoopbackConnection.hpp"
 #include "depthai/xlink/XLinkConnection.hpp"
 
 namespace dai {
@@ -14,8 +15,13 @@ namespace dai {
 constexpr std::chrono::milliseconds XLinkStream::WAIT_FOR_STREAM_RETRY;
 constexpr int XLinkStream::STREAM_OPEN_RETRIES;
 
-XLinkStream::XLinkStream(const std::shared_ptr<XLinkConnection> conn, const std::string& name, std::size_t maxWriteSize) : connection(conn), streamName(name) {
+XLinkStream::XLinkStream(const std::shared_ptr<XLinkConnection> conn, const std::string& name, std::size_t maxWriteSize)
+    : connection(conn), streamName(name), maxWriteSize(maxWriteSize) {
     if(name.empty()) throw std::invalid_argument("Cannot create XLinkStream using empty stream name");
+    if(auto loopbackConnection = std::dynamic_pointer_cast<LoopbackConnection>(connection)) {
+        loopback = loopbackConnection->openStream(streamName);
+        return;
+    }
     if(!connection || connection->getLinkId() == -1) throw std::invalid_argument("Cannot create XLinkStream using unconnected XLinkConnection");
 
     streamId = INVALID_STREAM_ID;
@@ -35,7 +41,11 @@ XLinkStream::XLinkStream(const std::shared_ptr<XLinkConnection> conn, const std:
 
 // Move constructor
 XLinkStream::XLinkStream(XLinkStream&& other)
-    : connection(std::move(other.connection)), streamName(std::exchange(other.streamName, {})), streamId(std::exchange(other.streamId, INVALID_STREAM_ID)) {
+    : connection(std::move(other.connection)),
+      streamName(std::exchange(other.streamName, {})),
+      streamId(std::exchange(other.streamId, INVALID_STREAM_ID)),
+      loopback(std::move(other.loopback)),
+      maxWriteSize(other.maxWriteSize) {
     // Set other's streamId to INVALID_STREAM_ID to prevent closing
 }
 
@@ -44,6 +54,8 @@ XLinkStream& XLinkStream::operator=(XLinkStream&& other) {
         connection = std::move(other.connection);
         streamId = std::exchange(other.streamId, INVALID_STREAM_ID);
         streamName = std::exchange(other.streamName, {});
+        loopback = std::move(other.loopback);
+        maxWriteSize = other.maxWriteSize;
     }
     return *this;
 }
@@ -56,7 +68,7 @@ XLinkStream::~XLinkStream() {
 }
 
 StreamPacketDesc::StreamPacketDesc(StreamPacketDesc&& other) noexcept
-    : streamPacketDesc_t{other.data, other.length, other.fd, other.tRemoteSent, other.tReceived} {
+    : streamPacketDesc_t{other.data, other.length, other.fd, other.tRemoteSent, other.tReceived}, loopbackData(std::move(other.loopbackData)) {
     other.data = nullptr;
     other.length = 0;
 }
@@ -68,11 +80,13 @@ StreamPacketDesc& StreamPacketDesc::operator=(StreamPacketDesc&& other) noexcept
         fd = std::exchange(other.fd, -1);
         tRemoteSent = std::exchange(other.tRemoteSent, {});
         tReceived = std::exchange(other.tReceived, {});
+        loopbackData = std::move(other.loopbackData);
     }
     return *this;
 }
 
 StreamPacketDesc::~StreamPacketDesc() noexcept {
+    if(data == loopbackData.data()) return;
     XLinkDeallocateMoveData(data, length);
 }
 
@@ -104,14 +118,15 @@ void StreamPacketMemory::setSize(size_t size) {
 ////////////////////
 
 void XLinkStream::write(span<const uint8_t> data, span<const uint8_t> data2) {
-    auto status = XLinkWriteData2(streamId, data.data(), static_cast<int>(data.size()), data2.data(), data2.size());
+    auto status = loopback ? loopback->write(data, data2, -1, maxWriteSize)
+                           : XLinkWriteData2(streamId, data.data(), static_cast<int>(data.size()), data2.data(), data2.size());
     if(status != X_LINK_SUCCESS) {
         throw XLinkWriteError(status, streamName);
     }
 }
 
 void XLinkStream::write(span<const uint8_t> data) {
-    auto status = XLinkWriteData(streamId, data.data(), static_cast<int>(data.size()));
+    auto status = loopback ? loopback->write(data, {}, -1, maxWriteSize) : XLinkWriteData(streamId, data.data(), static_cast<int>(data.size()));
     if(status != X_LINK_SUCCESS) {
         throw XLinkWriteError(status, streamName);
     }
@@ -121,7 +136,7 @@ void XLinkStream::write(const void* data, std::size_t size) {
 }
 
 void XLinkStream::write(long fd) {
-    auto status = XLinkWriteFd(streamId, fd);
+    auto status = loopback ? loopback->write({}, {}, fd, maxWriteSize) : XLinkWriteFd(streamId, fd);
 
     if(status != X_LINK_SUCCESS) {
         throw XLinkWriteError(status, streamName);
@@ -129,7 +144,7 @@ void XLinkStream::write(long fd) {
 }
 
 void XLinkStream::write(long fd, span<const uint8_t> data) {
-    auto status = XLinkWriteFdData(streamId, fd, data.data(), data.size());
+    auto status = loopback ? loopback->write(data, {}, fd, maxWriteSize) : XLinkWriteFdData(streamId, fd, data.data(), data.size());
 
     if(status != X_LINK_SUCCESS) {
         throw XLinkWriteError(status, streamName);
@@ -160,7 +175,7 @@ void XLinkStream::read(std::vector<std::uint8_t>& data, long& fd) {
 
 void XLinkStream::read(std::vector<std::uint8_t>& data, long& fd, XLinkTimespec& timestampReceived) {
     StreamPacketDesc packet;
-    const auto status = XLinkReadMoveData(streamId, &packet);
+    const auto status = loopback ? loopback->read(packet) : XLinkReadMoveData(streamId, &packet);
     if(status != X_LINK_SUCCESS) {
         throw XLinkReadError(status, streamName);
     }
@@ -183,7 +198,7 @@ std::vector<std::uint8_t> XLinkStream::read(XLinkTimespec& timestampReceived) {
 
 StreamPacketDesc XLinkStream::readMove() {
     StreamPacketDesc packet;
-    const auto status = XLinkReadMoveData(streamId, &packet);
+    const auto status = loopback ? loopback->read(packet) : XLinkReadMoveData(streamId, &packet);
     if(status != X_LINK_SUCCESS) {
         throw XLinkReadError(status, streamName);
     }
@@ -192,6 +207,7 @@ StreamPacketDesc XLinkStream::readMove() {
 
 // USE ONLY WHEN COPYING DATA AT LATER STAGES
 streamPacketDesc_t* XLinkStream::readRaw() {
+    if(loopback) throw XLinkReadError(X_LINK_NOT_IMPLEMENTED, streamName);
     streamPacketDesc_t* pPacket = nullptr;
     auto status = XLinkReadData(streamId, &pPacket);
     if(status != X_LINK_SUCCESS) {
@@ -202,6 +218,7 @@ streamPacketDesc_t* XLinkStream::readRaw() {
 
 // USE ONLY WHEN COPYING DATA AT LATER STAGES
 void XLinkStream::readRawRelease() {
+    if(loopback) throw XLinkReadError(X_LINK_NOT_IMPLEMENTED, streamName);
     XLinkError_t status;
     if((status = XLinkReleaseData(streamId)) != X_LINK_SUCCESS) throw XLinkReadError(status, streamName);
 }
@@ -215,7 +232,8 @@ void XLinkStream::writeSplit(const void* d, std::size_t size, std::size_t split)
     XLinkError_t ret = X_LINK_SUCCESS;
     while(remaining > 0) {
         sizeToTransmit = remaining > split ? split : remaining;
-        ret = XLinkWriteData(streamId, data + currentOffset, static_cast<int>(sizeToTransmit));
+        ret = loopback ? loopback->write({data + currentOffset, sizeToTransmit}, {}, -1, maxWriteSize)
+                       : XLinkWriteData(streamId, data + currentOffset, static_cast<int>(sizeToTransmit));
         if(ret != X_LINK_SUCCESS) {
             throw XLinkWriteError(ret, streamName);
         }
@@ -233,7 +251,8 @@ void XLinkStream::writeSplit(const std::vector<uint8_t>& data, std::size_t split
 //////////////////////
 
 bool XLinkStream::write(const std::uint8_t* data, std::size_t size, std::chrono::milliseconds timeout) {
-    auto status = XLinkWriteDataWithTimeout(streamId, data, static_cast<int>(size), static_cast<unsigned int>(timeout.count()));
+    auto status = loopback ? loopback->write({data, size}, {}, -1, maxWriteSize, timeout)
+                           : XLinkWriteDataWithTimeout(streamId, data, static_cast<int>(size), static_cast<unsigned int>(timeout.count()));
     if(status == X_LINK_SUCCESS) {
         return true;
     } else if(status == X_LINK_TIMEOUT) {
@@ -261,7 +280,8 @@ std::vector<std::uint8_t> XLinkStream::read(std::chrono::milliseconds timeout) {
 
 bool XLinkStream::read(std::vector<std::uint8_t>& data, std::chrono::milliseconds timeout) {
     StreamPacketDesc packet;
-    const auto status = XLinkReadMoveDataWithTimeout(streamId, &packet, static_cast<unsigned int>(timeout.count()));
+    const auto status =
+        loopback ? loopback->read(packet, timeout) : XLinkReadMoveDataWithTimeout(streamId, &packet, static_cast<unsigned int>(timeout.count()));
     if(status == X_LINK_SUCCESS) {
         data = std::vector<std::uint8_t>(packet.data, packet.data + packet.length);
         return true;
@@ -273,7 +293,8 @@ bool XLinkStream::read(std::vector<std::uint8_t>& data, std::chrono::millisecond
 }
 
 bool XLinkStream::readMove(StreamPacketDesc& packet, const std::chrono::milliseconds timeout) {
-    const auto status = XLinkReadMoveDataWithTimeout(streamId, &packet, static_cast<unsigned int>(timeout.count()));
+    const auto status =
+        loopback ? loopback->read(packet, timeout) : XLinkReadMoveDataWithTimeout(streamId, &packet, static_cast<unsigned int>(timeout.count()));
     if(status == X_LINK_SUCCESS) {
         return true;
     } else if(status == X_LINK_TIMEOUT) {
@@ -284,6 +305,7 @@ bool XLinkStream::readMove(StreamPacketDesc& packet, const std::chrono::millisec
 }
 
 bool XLinkStream::readRaw(streamPacketDesc_t*& pPacket, std::chrono::milliseconds timeout) {
+    if(loopback) throw XLinkReadError(X_LINK_NOT_IMPLEMENTED, streamName);
     auto status = XLinkReadDataWithTimeout(streamId, &pPacket, static_cast<unsigned int>(timeout.count()));
     if(status == X_LINK_SUCCESS) {
         return true;
@@ -0,0 +1,284 @@
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "utility/AnnotationRasterizer.hpp"
+
+using dai::Color;
+using dai::Point2f;
+using dai::impl::AnnotationRasterizer;
+
+namespace {
+
+const Color white(1.f, 1.f, 1.f, 1.f);
+const Color gray(0.5f, 0.5f, 0.5f, 1.f);
+
+struct Gray8Image {
+    int width;
+    int height;
+    std::vector<std::uint8_t> pixels;
+
+    Gray8Image(int width, int height, std::uint8_t value = 0) : width(width), height(height), pixels(width * height, value) {}
+
+    AnnotationRasterizer::Canvas canvas() {
+        AnnotationRasterizer::Canvas canvas;
+        canvas.format = AnnotationRasterizer::Format::GRAY8;
+        canvas.width = width;
+        canvas.height = height;
+        canvas.luma = pixels.data();
+        canvas.lumaStride = width;
+        return canvas;
+    }
+
+    // Background as '.', white as '#', anything else as '+'
+    std::vector<std::string> toAscii() const {
+        std::vector<std::string> rows;
+        for(int y = 0; y < height; y++) {
+            std::string row;
+            for(int x = 0; x < width; x++) {
+                const auto value = pixels[y * width + x];
+                row += value == 0 ? '.' : value == 255 ? '#' : '+';
+            }
+            rows.push_back(row);
+        }
+        return rows;
+    }
+};
+
+struct Nv12Image {
+    int width;
+    int height;
+    std::size_t stride;
+    std::vector<std::uint8_t> pixels;
+
+    Nv12Image(int width, int height, std::size_t stride) : width(width), height(height), stride(stride), pixels(stride * (height + height / 2), 0) {
+        std::fill(pixels.begin() + stride * height, pixels.end(), 128);
+    }
+
+    AnnotationRasterizer::Canvas canvas() {
+        AnnotationRasterizer::Canvas canvas;
+        canvas.format = AnnotationRasterizer::Format::NV12;
+        canvas.width = width;
+        canvas.height = height;
+        canvas.luma = pixels.data();
+        canvas.lumaStride = stride;
+        canvas.chroma = pixels.data() + stride * height;
+        canvas.chromaStride = stride;
+        return canvas;
+    }
+
+    std::uint8_t luma(int x, int y) const {
+        return pixels[y * stride + x];
+    }
+    std::uint8_t u(int x, int y) const {
+        return pixels[stride * height + y * stride + 2 * x];
+    }
+    std::uint8_t v(int x, int y) const {
+        return pixels[stride * height + y * stride + 2 * x + 1];
+    }
+};
+
+// Many overlapping primitives of every kind, spread over the whole frame
+void drawScene(AnnotationRasterizer& rasterizer, int width, int height, int count) {
+    for(int i = 0; i < count; i++) {
+        const float x = static_cast<float>((i * 97) % width);
+        const float y = static_cast<float>((i * 61) % height);
+        const Color color((i % 3) / 2.f, (i % 5) / 4.f, (i % 7) / 6.f, (i % 4 + 1) / 4.f);
+        rasterizer.drawRectangle(Point2f(x, y), Point2f(x + 120.f, y + 80.f), 2.f, color);
+        rasterizer.drawCircle(Point2f(x + 60.f, y + 40.f), 25.f, 3.f, color, Color(0.f, 0.f, 1.f, 0.25f));
+        rasterizer.drawLine(Point2f(x, y), Point2f(x + 200.f, y + 150.f), 4.f, color);
+        rasterizer.drawText(Point2f(x, y - 17.f), "person 87%", 16.f, white, color);
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Rectangles and circles on GRAY8") {
+    AnnotationRasterizer rasterizer;
+    rasterizer.drawRectangle(Point2f(2.f, 1.f), Point2f(13.f, 8.f), 1.f, white, gray);
+    rasterizer.drawCircle(Point2f(7.5f, 4.5f), 2.f, 1.f, white);
+    REQUIRE(rasterizer.size() == 3);
+
+    Gray8Image image(16, 10);
+    rasterizer.render(image.canvas());
+    const std::vector<std::string> golden{
+        "................",
+        "..############..",
+        "..#++++++++++#..",
+        "..#+++####+++#..",
+        "..#+++#++#+++#..",
+        "..#+++#++#+++#..",
+        "..#+++####+++#..",
+        "..#++++++++++#..",
+        "..############..",
+        "................",
+    };
+    REQUIRE(image.toAscii() == golden);
+    REQUIRE(image.pixels[2 * 16 + 4] == 128);
+}
+
+TEST_CASE("Lines, polylines and polygons on GRAY8") {
+    AnnotationRasterizer rasterizer;
+    rasterizer.drawLine(Point2f(1.f, 1.f), Point2f(12.f, 4.f), 1.f, white);
+    rasterizer.drawPolyline({Point2f(1.f, 10.f), Point2f(6.f, 6.f), Point2f(12.f, 10.f)}, false, 3.f, white);
+
+    Gray8Image lines(14, 13);
+    rasterizer.render(lines.canvas());
+    const std::vector<std::string> linesGolden{
+        "..............",
+        ".##...........",
+        "...####.......",
+        ".......####...",
+        "...........##.",
+        ".....###......",
+        "....#####.....",
+        "...########...",
+        "..####.#####..",
+        "#####...######",
+        "####......####",
+        "###........###",
+        "..............",
+    };
+    REQUIRE(lines.toAscii() == linesGolden);
+
+    rasterizer.clear();
+    REQUIRE(rasterizer.size() == 0);
+    rasterizer.fillPolygon({Point2f(1.f, 8.f), Point2f(7.f, 1.f), Point2f(13.f, 8.f)}, white);
+
+    Gray8Image polygon(15, 10);
+    rasterizer.render(polygon.canvas());
+    const std::vector<std::string> polygonGolden{
+        "...............",
+        "...............",
+        ".......#.......",
+        "......###......",
+        ".....#####.....",
+        "....#######....",
+        "...#########...",
+        "..###########..",
+        "...............",
+        "...............",
+    };
+    REQUIRE(polygon.toAscii() == polygonGolden);
+}
+
+TEST_CASE("Text from the glyph atlas") {
+    AnnotationRasterizer rasterizer;
+    // Characters outside of printable ASCII are drawn as '?'
+    rasterizer.drawText(Point2f(1.f, 1.f), "Hi\t\n0", 8.f, white);
+
+    Gray8Image image(20, 18);
+    rasterizer.render(image.canvas());
+    const std::vector<std::string> golden{
+        "....................",
+        ".#...#...#....###...",
+        ".#...#.......#...#..",
+        ".#...#..##.......#..",
+        ".#####...#......#...",
+        ".#...#...#.....#....",
+        ".#...#...#..........",
+        ".#...#..###....#....",
+        "....................",
+        "..###...............",
+        ".#...#..............",
+        ".#..##..............",
+        ".#.#.#..............",
+        ".##..#..............",
+        ".#...#..............",
+        "..###...............",
+        "....................",
+        "....................",
+    };
+    REQUIRE(image.toAscii() == golden);
+
+    // Font sizes are rounded to a multiple of the 8 pixel cell
+    REQUIRE(AnnotationRasterizer::getLineHeight(12.f) == 16);
+    REQUIRE(AnnotationRasterizer::getTextWidth("ab", 12.f) == 24);
+    rasterizer.clear();
+    rasterizer.drawText(Point2f(0.f, 0.f), "l", 16.f, white, gray);
+    Gray8Image scaled(12, 16);
+    rasterizer.render(scaled.canvas());
+    REQUIRE(scaled.toAscii()[0] == "++####++++++");
+    REQUIRE(scaled.toAscii()[15] == "++++++++++++");
+}
+
+TEST_CASE("NV12 chroma is painted per 2x2 block") {
+    AnnotationRasterizer rasterizer;
+    const Color red(1.f, 0.f, 0.f, 1.f);
+    // Covers luma rows 1 to 2 and columns 1 to 4, which touches chroma rows 0 and 1 and columns 0 to 2
+    rasterizer.drawRectangle(Point2f(1.f, 1.f), Point2f(5.f, 3.f), 1.f, Color{}, red);
+
+    Nv12Image image(8, 6, 10);
+    rasterizer.render(image.canvas());
+    for(int y = 0; y < image.height; y++) {
+        for(int x = 0; x < image.width; x++) {
+            const bool inside = x >= 1 && x <= 4 && y >= 1 && y <= 2;
+            REQUIRE(image.luma(x, y) == (inside ? 81 : 0));
+        }
+    }
+    for(int y = 0; y < image.height / 2; y++) {
+        for(int x = 0; x < image.width / 2; x++) {
+            const bool inside = x <= 2 && y <= 1;
+            REQUIRE(image.u(x, y) == (inside ? 90 : 128));
+            REQUIRE(image.v(x, y) == (inside ? 240 : 128));
+        }
+    }
+    // Padding past the row width is left alone
+    REQUIRE(image.pixels[8] == 0);
+    REQUIRE(image.pixels[9] == 0);
+}
+
+TEST_CASE("Colors are blended by their alpha") {
+    AnnotationRasterizer rasterizer;
+    rasterizer.drawCircle(Point2f(2.f, 2.f), 2.f, 1.f, Color{}, Color(1.f, 1.f, 1.f, 0.5f));
+    rasterizer.drawLine(Point2f(0.f, 0.f), Point2f(4.f, 4.f), 1.f, Color(1.f, 1.f, 1.f, 0.f));
+    // Fully transparent primitives aren't recorded
+    REQUIRE(rasterizer.size() == 1);
+
+    Gray8Image image(5, 5, 100);
+    rasterizer.render(image.canvas());
+    REQUIRE(image.pixels[2 * 5 + 2] == (100 * 127 + 255 * 128 + 127) / 255);
+    REQUIRE(image.pixels[0] == 100);
+}
+
+TEST_CASE("Result doesn't depend on the number of tiles") {
+    constexpr int width = 640;
+    constexpr int height = 360;
+    AnnotationRasterizer rasterizer;
+    drawScene(rasterizer, width, height, 40);
+    // Partially outside of the frame
+    rasterizer.drawCircle(Point2f(-10.f, 350.f), 40.f, 5.f, white);
+    rasterizer.drawText(Point2f(600.f, -4.f), "clipped", 16.f, white, gray);
+
+    Nv12Image single(width, height, width + 32);
+    rasterizer.render(single.canvas(), 1);
+    for(int numThreads : {2, 3, 4, 7}) {
+        Nv12Image tiled(width, height, width + 32);
+        rasterizer.render(tiled.canvas(), numThreads);
+        REQUIRE(tiled.pixels == single.pixels);
+    }
+
+    Gray8Image gray8(width, height);
+    rasterizer.render(gray8.canvas(), 4);
+    REQUIRE(std::count(gray8.pixels.begin(), gray8.pixels.end(), 0) < static_cast<long>(gray8.pixels.size()));
+}
+
+TEST_CASE("AnnotationRenderer benchmark", "[.benchmark]") {
+    constexpr int width = 1920;
+    constexpr int height = 1080;
+    AnnotationRasterizer rasterizer;
+    drawScene(rasterizer, width, height, 50);
+    Nv12Image image(width, height, width);
+
+    BENCHMARK("Render 1080p NV12, 1 thread") {
+        rasterizer.render(image.canvas(), 1);
+        return image.pixels[0];
+    };
+    BENCHMARK("Render 1080p NV12, 4 threads") {
+        rasterizer.render(image.canvas(), 4);
+        return image.pixels[0];
+    };
+}
@@ -1,7 +1,9 @@
 #include <catch2/catch_all.hpp>
+#include <cmath>
 #include <depthai/device/CalibrationHandler.hpp>
 #include <nlohmann/json.hpp>
 #include <stdexcept>
+#include <tuple>
 #include <vector>
 
 using namespace dai;
@@ -131,3 +133,153 @@ TEST_CASE("Long chain extrinsics composition", "[getCameraExtrinsics]") {
         {0.025600001f, 0.0f, 0.0f, -0.025600001f}, {0.0f, 0.008100001f, 0.0f, 0.003240019f}, {0.0f, 0.0f, 1.464100122f, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}};
     REQUIRE(M == expected);
 }
+
+static void requireApprox(const std::vector<float>& actual, const std::vector<float>& expected) {
+    REQUIRE(actual.size() == expected.size());
+    for(size_t i = 0; i < actual.size(); i++) {
+        REQUIRE(actual[i] == Catch::Approx(expected[i]).margin(1e-4));
+    }
+}
+
+// Reference: the transformation from src to dst composed link by link from the raw calibration data, with the nested vector math
+static std::vector<std::vector<float>> referenceExtrinsics(const CalibrationHandler& handler, CameraBoardSocket src, CameraBoardSocket dst) {
+    auto eeprom = handler.getEepromData();
+    auto toOrigin = [&eeprom](CameraBoardSocket socket, CameraBoardSocket& origin) {
+        std::vector<std::vector<float>> result = {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}};
+        origin = socket;
+        while(eeprom.cameraData.at(origin).extrinsics.toCameraSocket != CameraBoardSocket::AUTO) {
+            const auto& extrinsics = eeprom.cameraData.at(origin).extrinsics;
+            std::vector<std::vector<float>> link = extrinsics.rotationMatrix;
+            link[0].push_back(extrinsics.translation.x);
+            link[1].push_back(extrinsics.translation.y);
+            link[2].push_back(extrinsics.translation.z);
+            link.push_back({0, 0, 0, 1});
+            result = matrix::matMul(link, result);
+            origin = extrinsics.toCameraSocket;
+        }
+        return result;
+    };
+    CameraBoardSocket srcOrigin, dstOrigin;
+    auto srcToOrigin = toOrigin(src, srcOrigin);
+    auto dstToOrigin = toOrigin(dst, dstOrigin);
+    REQUIRE(srcOrigin == dstOrigin);
+    auto originToDst = matrix::toVector(matrix::invertSe3(matrix::toMat4f(dstToOrigin)));
+    return matrix::matMul(originToDst, srcToOrigin);
+}
+
+static CalibrationHandler loadChainHandler() {
+    auto handler = loadHandler();
+    auto rotation = [](float angle) {
+        return std::vector<std::vector<float>>{{std::cos(angle), 0, std::sin(angle)}, {0, 1, 0}, {-std::sin(angle), 0, std::cos(angle)}};
+    };
+    // D→C→B→A (origin), with small rotations on every link
+    handler.setCameraExtrinsics(CameraBoardSocket::CAM_D, CameraBoardSocket::CAM_C, rotation(0.1f), {1, 2, 3}, {1, 2, 3});
+    handler.setCameraExtrinsics(CameraBoardSocket::CAM_C, CameraBoardSocket::CAM_B, rotation(-0.05f), {7.5f, 0, 0.2f}, {7.5f, 0, 0});
+    handler.setCameraExtrinsics(CameraBoardSocket::CAM_B, CameraBoardSocket::CAM_A, rotation(0.02f), {-3.75f, 0.1f, 0}, {-3.75f, 0, 0});
+    return handler;
+}
+
+TEST_CASE("Cached extrinsics match link by link composition", "[getCameraExtrinsics]") {
+    auto handler = loadChainHandler();
+    const std::vector<CameraBoardSocket> sockets = {CameraBoardSocket::CAM_A, CameraBoardSocket::CAM_B, CameraBoardSocket::CAM_C, CameraBoardSocket::CAM_D};
+    for(auto src : sockets) {
+        for(auto dst : sockets) {
+            auto M = handler.getCameraExtrinsics(src, dst, false);
+            auto expected = referenceExtrinsics(handler, src, dst);
+            auto fixed = handler.getCameraExtrinsicsMat4f(src, dst, false);
+            REQUIRE(M == matrix::toVector(fixed));
+            for(int i = 0; i < 4; i++) {
+                for(int j = 0; j < 4; j++) {
+                    REQUIRE(M[i][j] == Catch::Approx(expected[i][j]).margin(1e-4));
+                }
+            }
+        }
+    }
+    // Cached results stay the same on repeated queries and in copies
+    auto copy = handler;
+    REQUIRE(copy.getCameraExtrinsics(CameraBoardSocket::CAM_D, CameraBoardSocket::CAM_A)
+            == handler.getCameraExtrinsics(CameraBoardSocket::CAM_D, CameraBoardSocket::CAM_A));
+    // Spec translation is cached separately
+    requireApprox(handler.getCameraTranslationVector(CameraBoardSocket::CAM_C, CameraBoardSocket::CAM_B, true), std::vector<float>{7.5f, 0, 0});
+    requireApprox(handler.getCameraTranslationVector(CameraBoardSocket::CAM_C, CameraBoardSocket::CAM_B, false), std::vector<float>{7.5f, 0, 0.2f});
+}
+
+TEST_CASE("Modifying extrinsics invalidates the cache", "[getCameraExtrinsics]") {
+    auto handler = loadChainHandler();
+    auto copy = handler;
+    auto before = handler.getCameraTranslationVector(CameraBoardSocket::CAM_C, CameraBoardSocket::CAM_B, false);
+    auto R3 = std::vector<std::vector<float>>{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    handler.setCameraExtrinsics(CameraBoardSocket::CAM_C, CameraBoardSocket::CAM_B, R3, {0, 0, 10}, {0, 0, 10});
+    requireApprox(handler.getCameraTranslationVector(CameraBoardSocket::CAM_C, CameraBoardSocket::CAM_B, false), std::vector<float>{0, 0, 10});
+    // Copies taken before keep their own data
+    requireApprox(copy.getCameraTranslationVector(CameraBoardSocket::CAM_C, CameraBoardSocket::CAM_B, false), before);
+
+    // Cameras added later are known as well
+    handler.setCameraExtrinsics(CameraBoardSocket::CAM_E, CameraBoardSocket::CAM_A, R3, {1, 0, 0}, {1, 0, 0});
+    requireApprox(handler.getCameraTranslationVector(CameraBoardSocket::CAM_E, CameraBoardSocket::CAM_A, false), std::vector<float>{1, 0, 0});
+    REQUIRE_THROWS_AS(copy.getCameraExtrinsics(CameraBoardSocket::CAM_E, CameraBoardSocket::CAM_A), std::runtime_error);
+}
+
+TEST_CASE("Fixed-size intrinsics match", "[getCameraIntrinsics]") {
+    auto handler = loadHandler();
+    for(auto keepAspectRatio : {true, false}) {
+        for(auto size : std::vector<std::tuple<int, int>>{{-1, -1}, {1280, 800}, {640, 480}, {640, -1}}) {
+            auto M = handler.getCameraIntrinsics(CameraBoardSocket::CAM_B, std::get<0>(size), std::get<1>(size), Point2f(), Point2f(), keepAspectRatio);
+            auto fixed =
+                handler.getCameraIntrinsicsMat3f(CameraBoardSocket::CAM_B, std::get<0>(size), std::get<1>(size), Point2f(), Point2f(), keepAspectRatio);
+            REQUIRE(M == matrix::toVector(fixed));
+        }
+    }
+    auto scaled = handler.getCameraIntrinsics(CameraBoardSocket::CAM_B, 960, 600, Point2f(), Point2f(), false);
+    REQUIRE(scaled[0][0] == Catch::Approx(618.7698974609375f / 2));
+    REQUIRE(scaled[1][2] == Catch::Approx(548.0191040039062f / 2));
+}
+
+TEST_CASE("Project and undistort points", "[projectPoints]") {
+    auto handler = loadHandler();
+    const std::vector<Point3f> points = {{0, 0, 100}, {10, -5, 100}, {-30, 20, 80}, {25, 25, 60}};
+    for(auto model : {CameraModel::Perspective, CameraModel::Fisheye}) {
+        handler.setCameraType(CameraBoardSocket::CAM_B, model);
+
+        // Without distortion it's a pinhole projection, or an equidistant one for fisheye
+        handler.setDistortionCoefficients(CameraBoardSocket::CAM_B, std::vector<float>(14, 0.0f));
+        auto K = handler.getCameraIntrinsics(CameraBoardSocket::CAM_B);
+        auto ideal = handler.projectPoints(CameraBoardSocket::CAM_B, points);
+        std::vector<Point2f> pinhole;
+        for(size_t i = 0; i < points.size(); i++) {
+            const float x = points[i].x / points[i].z;
+            const float y = points[i].y / points[i].z;
+            const float r = std::sqrt(x * x + y * y);
+            const float scale = model == CameraModel::Fisheye && r > 0 ? std::atan(r) / r : 1.0f;
+            REQUIRE(ideal[i].x == Catch::Approx(K[0][0] * x * scale + K[0][2]).margin(1e-3));
+            REQUIRE(ideal[i].y == Catch::Approx(K[1][1] * y * scale + K[1][2]).margin(1e-3));
+            pinhole.emplace_back(K[0][0] * x + K[0][2], K[1][1] * y + K[1][2]);
+        }
+
+        // Undistorting the distorted projection gives back the pinhole projection
+        handler.setDistortionCoefficients(CameraBoardSocket::CAM_B, {-0.05f, 0.01f, 0.001f, -0.0005f, 0.002f, 0, 0, 0, 0, 0, 0, 0, 0, 0});
+        auto distorted = handler.projectPoints(CameraBoardSocket::CAM_B, points);
+        REQUIRE(distorted[1].x != Catch::Approx(ideal[1].x).margin(1e-3));
+        auto undistorted = handler.undistortPoints(CameraBoardSocket::CAM_B, distorted);
+        REQUIRE(undistorted.size() == points.size());
+        for(size_t i = 0; i < points.size(); i++) {
+            REQUIRE(undistorted[i].x == Catch::Approx(pinhole[i].x).margin(1e-2));
+            REQUIRE(undistorted[i].y == Catch::Approx(pinhole[i].y).margin(1e-2));
+        }
+
+        // Resized images scale the pixel coordinates
+        auto half = handler.projectPoints(CameraBoardSocket::CAM_B, points, 960, 600);
+        REQUIRE(half[2].x == Catch::Approx(distorted[2].x / 2).margin(1e-2));
+        REQUIRE(half[2].y == Catch::Approx(distorted[2].y / 2).margin(1e-2));
+    }
+
+    // Moved into another camera's coordinate system first
+    handler = loadChainHandler();
+    auto transformed = handler.transformPoints(CameraBoardSocket::CAM_C, CameraBoardSocket::CAM_A, points);
+    auto M = handler.getCameraExtrinsics(CameraBoardSocket::CAM_C, CameraBoardSocket::CAM_A);
+    REQUIRE(transformed[1].x == Catch::Approx(M[0][0] * 10 + M[0][1] * -5 + M[0][2] * 100 + M[0][3]));
+    REQUIRE(transformed[1].z == Catch::Approx(M[2][0] * 10 + M[2][1] * -5 + M[2][2] * 100 + M[2][3]));
+
+    handler.setCameraType(CameraBoardSocket::CAM_B, CameraModel::Equirectangular);
+    REQUIRE_THROWS_AS(handler.projectPoints(CameraBoardSocket::CAM_B, points), std::runtime_error);
+}
@@ -0,0 +1,129 @@
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "depthai/device/CallbackHandler.hpp"
+#include "depthai/pipeline/datatype/Buffer.hpp"
+#include "depthai/pipeline/datatype/StreamMessageParser.hpp"
+#include "depthai/xlink/LoopbackConnection.hpp"
+#include "depthai/xlink/XLinkStream.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+void sendBuffer(dai::XLinkStream& stream, int64_t sequenceNum) {
+    auto buffer = std::make_shared<dai::Buffer>();
+    buffer->setSequenceNum(sequenceNum);
+    buffer->setData(std::vector<std::uint8_t>{static_cast<std::uint8_t>(sequenceNum), 1, 2});
+    stream.write(buffer->data->getData(), dai::StreamMessageParser::serializeMetadata(buffer));
+}
+
+std::shared_ptr<dai::Buffer> receiveBuffer(dai::XLinkStream& stream) {
+    dai::StreamPacketDesc packet;
+    if(!stream.readMove(packet, 5s)) return nullptr;
+    return std::dynamic_pointer_cast<dai::Buffer>(dai::StreamMessageParser::parseMessage(std::move(packet)));
+}
+
+// Answers with the sequence number doubled, taking longer for the earlier messages
+std::shared_ptr<dai::ADatatype> slowDouble(std::shared_ptr<dai::ADatatype> message) {
+    // Called from the workers, where the test assertions can't be used
+    auto buffer = std::dynamic_pointer_cast<dai::Buffer>(message);
+    if(buffer == nullptr) throw std::runtime_error("Expected a Buffer");
+    std::this_thread::sleep_for(std::chrono::milliseconds(10 * (8 - buffer->getSequenceNum() % 8)));
+    auto response = std::make_shared<dai::Buffer>();
+    response->setSequenceNum(buffer->getSequenceNum() * 2);
+    const auto data = buffer->getData();
+    response->setData(std::vector<std::uint8_t>(data.begin(), data.end()));
+    return response;
+}
+
+}  // namespace
+
+TEST_CASE("Responses keep the order of the requests") {
+    auto conn = std::make_shared<dai::LoopbackConnection>();
+    dai::XLinkStream requests(conn, "request", 1024);
+    dai::XLinkStream responses(conn, "response", 1);
+    std::atomic<int> concurrent{0};
+    std::atomic<int> maxConcurrent{0};
+    dai::CallbackHandler handler(
+        conn,
+        "request",
+        "response",
+        [&](std::shared_ptr<dai::ADatatype> message) {
+            const int now = ++concurrent;
+            int expected = maxConcurrent;
+            while(now > expected && !maxConcurrent.compare_exchange_weak(expected, now)) {
+            }
+            auto response = slowDouble(std::move(message));
+            concurrent--;
+            return response;
+        },
+        4);
+
+    for(int64_t i = 0; i < 16; i++) sendBuffer(requests, i);
+    for(int64_t i = 0; i < 16; i++) {
+        auto response = receiveBuffer(responses);
+        REQUIRE(response != nullptr);
+        REQUIRE(response->getSequenceNum() == 2 * i);
+        REQUIRE(response->getData().size() == 3);
+        REQUIRE(response->getData()[0] == static_cast<std::uint8_t>(i));
+    }
+    REQUIRE(maxConcurrent > 1);
+    REQUIRE(maxConcurrent <= 4);
+    REQUIRE(handler.isRunning());
+}
+
+TEST_CASE("Callbacks without a response and replaced callbacks") {
+    auto conn = std::make_shared<dai::LoopbackConnection>();
+    dai::XLinkStream requests(conn, "request", 1024);
+    dai::XLinkStream responses(conn, "response", 1);
+    dai::CallbackHandler handler(conn, "request", "response", [](std::shared_ptr<dai::ADatatype>) { return std::shared_ptr<dai::ADatatype>(); });
+
+    sendBuffer(requests, 1);
+    dai::StreamPacketDesc packet;
+    REQUIRE_FALSE(responses.readMove(packet, 50ms));
+
+    handler.setCallback(slowDouble);
+    sendBuffer(requests, 2);
+    REQUIRE(receiveBuffer(responses)->getSequenceNum() == 4);
+}
+
+TEST_CASE("Callback errors stop the handler") {
+    auto conn = std::make_shared<dai::LoopbackConnection>();
+    dai::XLinkStream requests(conn, "request", 1024);
+    dai::CallbackHandler handler(conn, "request", "response", [](std::shared_ptr<dai::ADatatype>) -> std::shared_ptr<dai::ADatatype> {
+        throw std::runtime_error("callback failed");
+    });
+
+    sendBuffer(requests, 0);
+    for(int i = 0; i < 500 && handler.isRunning(); i++) std::this_thread::sleep_for(10ms);
+    REQUIRE_FALSE(handler.isRunning());
+    REQUIRE(handler.getError() != nullptr);
+    REQUIRE_THROWS_WITH(std::rethrow_exception(handler.getError()), "callback failed");
+}
+
+TEST_CASE("Close doesn't wait for messages") {
+    auto conn = std::make_shared<dai::LoopbackConnection>();
+    auto handler = std::make_unique<dai::CallbackHandler>(conn, "request", "response", slowDouble, 2);
+    std::this_thread::sleep_for(20ms);
+
+    const auto start = std::chrono::steady_clock::now();
+    handler->close();
+    REQUIRE(std::chrono::steady_clock::now() - start < 1s);
+    REQUIRE_FALSE(handler->isRunning());
+    REQUIRE(handler->getError() == nullptr);
+    handler.reset();
+
+    // Closing the connection stops the handler with the read error
+    dai::CallbackHandler closed(conn, "request", "response", slowDouble);
+    conn->close();
+    for(int i = 0; i < 500 && closed.isRunning(); i++) std::this_thread::sleep_for(10ms);
+    REQUIRE_FALSE(closed.isRunning());
+    REQUIRE_THROWS_AS(std::rethrow_exception(closed.getError()), dai::XLinkReadError);
+}
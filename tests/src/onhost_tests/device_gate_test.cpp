@@ -0,0 +1,220 @@
+#include <httplib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "depthai/device/DeviceGate.hpp"
+
+using SessionState = dai::DeviceGate::SessionState;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Stand-in for the gate running on the device, serving a single session
+class GateServer {
+   public:
+    explicit GateServer(bool withEvents) {
+        for(size_t i = 0; i < 100000; i++) dump.push_back(static_cast<char>(i * 31 % 251));
+        server.Post("/api/v1/sessions", [](const httplib::Request&, httplib::Response& res) {
+            res.set_content(R"({"id":"s1","fwp_exists":true})", "application/json");
+        });
+        server.Get("/api/v1/version", [](const httplib::Request&, httplib::Response& res) {
+            res.set_content(R"({"version_gate":"0.0.14","version_os":"1.0.0"})", "application/json");
+        });
+        server.Get("/api/v1/sessions/s1", [this](const httplib::Request&, httplib::Response& res) {
+            stateRequests++;
+            std::unique_lock<std::mutex> lock(mtx);
+            res.set_content(R"({"state":")" + state + R"("})", "application/json");
+        });
+        if(withEvents) {
+            server.Get("/api/v1/sessions/s1/events", [this](const httplib::Request&, httplib::Response& res) {
+                res.set_chunked_content_provider("text/event-stream", [this, sent = std::string()](size_t, httplib::DataSink& sink) mutable {
+                    std::unique_lock<std::mutex> lock(mtx);
+                    cv.wait_for(lock, 100ms, [&]() { return state != sent || stopped; });
+                    if(stopped) return false;
+                    if(state == sent) {
+                        // Keep alive
+                        const std::string comment = ": ping\r\n\r\n";
+                        return sink.write(comment.data(), comment.size());
+                    }
+                    sent = state;
+                    // Split in the middle of the event, like a partial read
+                    const std::string event = "event: state\r\ndata: {\"state\":\"" + state + "\"}\r\n\r\n";
+                    const auto half = event.size() / 2;
+                    if(!sink.write(event.data(), half) || !sink.write(event.data() + half, event.size() - half)) return false;
+                    if(state == "CRASHED" || state == "STOPPED") sink.done();
+                    return true;
+                });
+            });
+        }
+        server.Get("/api/v1/sessions/s1/core_dump", [this](const httplib::Request&, httplib::Response& res) {
+            // Still being generated for the first few requests
+            if(dumpRequests++ < 2) {
+                res.status = 404;
+                return;
+            }
+            res.set_header("X-Filename", "../crash_dump_s1.tar.gz");
+            res.set_content(dump, "application/octet-stream");
+        });
+        server.Get("/api/v1/sessions/s1/logs", [this](const httplib::Request&, httplib::Response& res) {
+            res.set_chunked_content_provider("application/octet-stream", [this](size_t offset, httplib::DataSink& sink) {
+                if(offset >= dump.size()) {
+                    sink.done();
+                    return true;
+                }
+                return sink.write(dump.data() + offset, std::min<size_t>(4096, dump.size() - offset));
+            });
+        });
+        port = server.bind_to_any_port("127.0.0.1");
+        thread = std::thread([this]() { server.listen_after_bind(); });
+        server.wait_until_ready();
+    }
+    ~GateServer() {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            stopped = true;
+        }
+        cv.notify_all();
+        server.stop();
+        thread.join();
+    }
+
+    void setState(const std::string& newState) {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            state = newState;
+        }
+        cv.notify_all();
+    }
+
+    std::unique_ptr<dai::DeviceGate> connect() {
+        dai::DeviceInfo info;
+        info.name = "127.0.0.1";
+        info.state = X_LINK_GATE;
+        info.platform = X_LINK_RVC4;
+        auto gate = std::make_unique<dai::DeviceGate>(info, port);
+        REQUIRE(gate->createSession());
+        return gate;
+    }
+
+    std::string dump;
+    std::atomic<int> stateRequests{0};
+    std::atomic<int> dumpRequests{0};
+
+   private:
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::string state = "RUNNING";
+    bool stopped = false;
+    httplib::Server server;
+    std::thread thread;
+    int port = 0;
+};
+
+std::string readFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+}  // namespace
+
+TEST_CASE("Session exit is followed by events") {
+    GateServer server(true);
+    auto gate = server.connect();
+
+    std::thread crash([&]() {
+        std::this_thread::sleep_for(200ms);
+        server.setState("CRASHED");
+    });
+    const auto start = std::chrono::steady_clock::now();
+    REQUIRE(gate->waitForSessionExit() == SessionState::CRASHED);
+    crash.join();
+    // Picked up from the stream, without waiting for a poll interval
+    REQUIRE(std::chrono::steady_clock::now() - start < 900ms);
+    REQUIRE(server.stateRequests == 1);
+
+    // Already ended
+    REQUIRE(gate->waitForSessionExit() == SessionState::CRASHED);
+}
+
+TEST_CASE("Session exit is polled without the events endpoint") {
+    GateServer server(false);
+    auto gate = server.connect();
+
+    std::thread stop([&]() {
+        std::this_thread::sleep_for(200ms);
+        server.setState("STOPPED");
+    });
+    REQUIRE(gate->waitForSessionExit() == SessionState::STOPPED);
+    stop.join();
+    REQUIRE(server.stateRequests >= 2);
+}
+
+TEST_CASE("Crash dump is downloaded once it is ready") {
+    GateServer server(true);
+    auto gate = server.connect();
+    server.setState("CRASHED");
+
+    std::uint64_t lastReceived = 0;
+    std::uint64_t lastTotal = 0;
+    auto crashDump = gate->getCrashDump([&](std::uint64_t received, std::uint64_t total) {
+        REQUIRE(received >= lastReceived);
+        lastReceived = received;
+        lastTotal = total;
+    });
+    REQUIRE(crashDump.has_value());
+    REQUIRE(server.dumpRequests == 3);
+    REQUIRE(crashDump->filename == "../crash_dump_s1.tar.gz");
+    REQUIRE(std::string(crashDump->data.begin(), crashDump->data.end()) == server.dump);
+    REQUIRE(lastReceived == server.dump.size());
+    REQUIRE(lastTotal == server.dump.size());
+
+    // No fixed wait before asking for the dump
+    server.dumpRequests = 0;
+    const auto start = std::chrono::steady_clock::now();
+    crashDump = gate->waitForSessionEnd();
+    REQUIRE(crashDump.has_value());
+    REQUIRE(crashDump->data.size() == server.dump.size());
+    REQUIRE(std::chrono::steady_clock::now() - start < 2s);
+}
+
+TEST_CASE("Crash dump and logs are streamed to files") {
+    GateServer server(true);
+    auto gate = server.connect();
+    const auto dir = std::filesystem::temp_directory_path() / "depthai_device_gate_test";
+    std::filesystem::remove_all(dir);
+
+    auto dumpPath = gate->saveCrashDump(dir);
+    REQUIRE(dumpPath.has_value());
+    // The name sent by the gate can't point outside of the directory
+    REQUIRE(*dumpPath == dir / "crash_dump_s1.tar.gz");
+    REQUIRE(readFile(*dumpPath) == server.dump);
+
+    std::uint64_t lastReceived = 0;
+    auto logsPath = gate->saveLogs(dir, [&](std::uint64_t received, std::uint64_t) { lastReceived = received; });
+    REQUIRE(logsPath.has_value());
+    REQUIRE(*logsPath == dir / "session_logs.tar.gz");
+    REQUIRE(readFile(*logsPath) == server.dump);
+    REQUIRE(lastReceived == server.dump.size());
+
+    // Nothing left behind from the downloads
+    size_t numFiles = 0;
+    for(const auto& entry : std::filesystem::directory_iterator(dir)) {
+        REQUIRE(entry.path().extension() != ".part");
+        numFiles++;
+    }
+    REQUIRE(numFiles == 2);
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,264 @@
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_all.hpp>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#ifdef DEPTHAI_HAVE_OPENCV_SUPPORT
+    #include <opencv2/core.hpp>
+    #include <opencv2/imgproc.hpp>
+#endif
+
+#include "depthai/depthai.hpp"
+#include "depthai/pipeline/node/EdgeDetector.hpp"
+#include "utility/EdgeDetectorImpl.hpp"
+#include "utility/MemoryPool.hpp"
+
+namespace {
+
+std::vector<uint8_t> makePattern(int width, int height) {
+    std::vector<uint8_t> img(static_cast<size_t>(width) * height);
+    for(int y = 0; y < height; y++) {
+        for(int x = 0; x < width; x++) {
+            img[y * width + x] = static_cast<uint8_t>((x * 7 + y * 13 + (x * y) % 31) & 0xFF);
+        }
+    }
+    return img;
+}
+
+// Straightforward 3x3 correlation with replicated borders
+std::vector<uint8_t> referenceSobel(
+    const std::vector<uint8_t>& src, int width, int height, const std::vector<std::vector<int>>& kx, const std::vector<std::vector<int>>& ky) {
+    std::vector<uint8_t> dst(src.size());
+    for(int y = 0; y < height; y++) {
+        for(int x = 0; x < width; x++) {
+            int gx = 0, gy = 0;
+            for(int i = 0; i < 3; i++) {
+                for(int j = 0; j < 3; j++) {
+                    int yy = std::clamp(y + i - 1, 0, height - 1);
+                    int xx = std::clamp(x + j - 1, 0, width - 1);
+                    gx += kx[i][j] * src[yy * width + xx];
+                    gy += ky[i][j] * src[yy * width + xx];
+                }
+            }
+            float m = std::sqrt(static_cast<float>(gx) * gx + static_cast<float>(gy) * gy) + 0.5f;
+            dst[y * width + x] = static_cast<uint8_t>(std::min(m, 255.0f));
+        }
+    }
+    return dst;
+}
+
+const std::vector<std::vector<int>> SOBEL_X = {{1, 0, -1}, {2, 0, -2}, {1, 0, -1}};
+const std::vector<std::vector<int>> SOBEL_Y = {{1, 2, 1}, {0, 0, 0}, {-1, -2, -1}};
+
+}  // namespace
+
+TEST_CASE("SobelFilter matches reference for default kernels", "[EdgeDetector]") {
+    const int width = 101, height = 67;
+    auto src = makePattern(width, height);
+    auto expected = referenceSobel(src, width, height, SOBEL_X, SOBEL_Y);
+
+    dai::impl::SobelFilter filter;
+    REQUIRE(filter.isSeparable());
+
+    for(int threads : {1, 2, 3, 8}) {
+        std::vector<uint8_t> out(src.size());
+        filter.apply(src.data(), width, out.data(), width, width, height, threads);
+        REQUIRE(out == expected);
+    }
+}
+
+TEST_CASE("SobelFilter honors custom kernels", "[EdgeDetector]") {
+    const int width = 64, height = 48;
+    auto src = makePattern(width, height);
+
+    SECTION("Separable (Scharr)") {
+        const std::vector<std::vector<int>> kx = {{3, 0, -3}, {10, 0, -10}, {3, 0, -3}};
+        const std::vector<std::vector<int>> ky = {{3, 10, 3}, {0, 0, 0}, {-3, -10, -3}};
+        dai::impl::SobelFilter filter;
+        filter.setKernels(kx, ky);
+        REQUIRE(filter.isSeparable());
+        std::vector<uint8_t> out(src.size());
+        filter.apply(src.data(), width, out.data(), width, width, height, 4);
+        REQUIRE(out == referenceSobel(src, width, height, kx, ky));
+    }
+
+    SECTION("Non separable") {
+        const std::vector<std::vector<int>> kx = {{1, 0, -1}, {3, 0, -2}, {1, 0, -1}};
+        dai::impl::SobelFilter filter;
+        filter.setKernels(kx, SOBEL_Y);
+        REQUIRE_FALSE(filter.isSeparable());
+        std::vector<uint8_t> out(src.size());
+        filter.apply(src.data(), width, out.data(), width, width, height, 4);
+        REQUIRE(out == referenceSobel(src, width, height, kx, SOBEL_Y));
+    }
+
+    SECTION("Invalid kernel") {
+        dai::impl::SobelFilter filter;
+        REQUIRE_THROWS_AS(filter.setKernels({{1, 0}, {2, 0}}, SOBEL_Y), std::invalid_argument);
+    }
+}
+
+TEST_CASE("SobelFilter respects strides", "[EdgeDetector]") {
+    const int width = 40, height = 30, srcStride = 48, dstStride = 56;
+    auto packed = makePattern(width, height);
+    std::vector<uint8_t> src(static_cast<size_t>(srcStride) * height, 0xAA);
+    for(int y = 0; y < height; y++) std::copy_n(packed.begin() + y * width, width, src.begin() + y * srcStride);
+
+    std::vector<uint8_t> out(static_cast<size_t>(dstStride) * height, 0x55);
+    dai::impl::SobelFilter filter;
+    filter.apply(src.data(), srcStride, out.data(), dstStride, width, height, 2);
+
+    auto expected = referenceSobel(packed, width, height, SOBEL_X, SOBEL_Y);
+    for(int y = 0; y < height; y++) {
+        REQUIRE(std::equal(expected.begin() + y * width, expected.begin() + (y + 1) * width, out.begin() + y * dstStride));
+        // Padding is left untouched
+        REQUIRE(std::all_of(out.begin() + y * dstStride + width, out.begin() + (y + 1) * dstStride, [](uint8_t v) { return v == 0x55; }));
+    }
+}
+
+TEST_CASE("MemoryPool reuses released buffers", "[EdgeDetector]") {
+    dai::utility::MemoryPool pool(2);
+    auto a = pool.acquire(16);
+    auto b = pool.acquire(16);
+    auto* aPtr = a.get();
+    REQUIRE(a->getSize() == 16);
+
+    // Pool exhausted - falls back to a standalone allocation
+    auto c = pool.acquire(16);
+    REQUIRE(pool.getNumMisses() == 1);
+
+    a.reset();
+    auto d = pool.acquire(32);
+    REQUIRE(d.get() == aPtr);
+    REQUIRE(d->getSize() == 32);
+}
+
+TEST_CASE("EdgeDetector runs on host", "[EdgeDetector]") {
+    const int width = 320, height = 240;
+    auto pattern = makePattern(width, height);
+
+    dai::Pipeline p(false);
+    auto edgeDetector = p.create<dai::node::EdgeDetector>();
+    edgeDetector->setRunOnHost(true);
+    edgeDetector->setNumThreads(2);
+    auto inputQueue = edgeDetector->inputImage.createInputQueue();
+    auto outputQueue = edgeDetector->outputImage.createOutputQueue();
+    p.start();
+
+    SECTION("GRAY8") {
+        auto frame = std::make_shared<dai::ImgFrame>();
+        frame->setType(dai::ImgFrame::Type::GRAY8);
+        frame->setSize(width, height);
+        frame->setStride(width);
+        frame->setData(pattern);
+        inputQueue->send(frame);
+
+        auto out = outputQueue->get<dai::ImgFrame>();
+        REQUIRE(out->getType() == dai::ImgFrame::Type::GRAY8);
+        REQUIRE(out->getWidth() == static_cast<unsigned>(width));
+        REQUIRE(out->getHeight() == static_cast<unsigned>(height));
+        auto expected = referenceSobel(pattern, width, height, SOBEL_X, SOBEL_Y);
+        REQUIRE(std::equal(expected.begin(), expected.end(), out->getData().begin()));
+    }
+
+    SECTION("NV12 filters the luma plane") {
+        std::vector<uint8_t> nv12(pattern);
+        nv12.resize(width * height * 3 / 2, 128);
+        auto frame = std::make_shared<dai::ImgFrame>();
+        frame->setType(dai::ImgFrame::Type::NV12);
+        frame->setSize(width, height);
+        frame->setStride(width);
+        frame->fb.p2Offset = width * height;
+        frame->setData(nv12);
+        inputQueue->send(frame);
+
+        auto out = outputQueue->get<dai::ImgFrame>();
+        REQUIRE(out->getType() == dai::ImgFrame::Type::GRAY8);
+        REQUIRE(out->getData().size() == pattern.size());
+        auto expected = referenceSobel(pattern, width, height, SOBEL_X, SOBEL_Y);
+        REQUIRE(std::equal(expected.begin(), expected.end(), out->getData().begin()));
+    }
+
+    SECTION("Frames with too little data are skipped") {
+        auto truncated = std::make_shared<dai::ImgFrame>();
+        truncated->setType(dai::ImgFrame::Type::GRAY8);
+        truncated->setSize(width, height);
+        truncated->setStride(width);
+        truncated->setData(std::vector<uint8_t>(pattern.begin(), pattern.begin() + pattern.size() / 2));
+        inputQueue->send(truncated);
+        auto narrow = std::make_shared<dai::ImgFrame>();
+        narrow->setType(dai::ImgFrame::Type::GRAY8);
+        narrow->setSize(width, height);
+        narrow->setStride(width / 2);
+        narrow->setData(pattern);
+        inputQueue->send(narrow);
+
+        auto frame = std::make_shared<dai::ImgFrame>();
+        frame->setType(dai::ImgFrame::Type::GRAY8);
+        frame->setSize(width, height);
+        frame->setStride(width);
+        frame->setData(pattern);
+        frame->setSequenceNum(7);
+        inputQueue->send(frame);
+
+        // Only the valid frame comes out
+        auto out = outputQueue->get<dai::ImgFrame>();
+        REQUIRE(out->getSequenceNum() == 7);
+        auto expected = referenceSobel(pattern, width, height, SOBEL_X, SOBEL_Y);
+        REQUIRE(std::equal(expected.begin(), expected.end(), out->getData().begin()));
+    }
+
+    p.stop();
+}
+
+#ifdef DEPTHAI_HAVE_OPENCV_SUPPORT
+TEST_CASE("SobelFilter matches cv::Sobel", "[EdgeDetector]") {
+    const int width = 640, height = 400;
+    auto pattern = makePattern(width, height);
+    cv::Mat src(height, width, CV_8UC1, pattern.data());
+
+    cv::Mat gx, gy, magnitude, expected;
+    // OpenCV uses convolution orientation, which only flips the sign of the gradient
+    cv::Sobel(src, gx, CV_32F, 1, 0, 3, 1, 0, cv::BORDER_REPLICATE);
+    cv::Sobel(src, gy, CV_32F, 0, 1, 3, 1, 0, cv::BORDER_REPLICATE);
+    cv::magnitude(gx, gy, magnitude);
+    magnitude.convertTo(expected, CV_8U);
+
+    cv::Mat out(height, width, CV_8UC1);
+    dai::impl::SobelFilter filter;
+    filter.apply(src.data, src.step, out.data, out.step, width, height, 4);
+
+    cv::Mat diff;
+    cv::absdiff(out, expected, diff);
+    double maxDiff = 0;
+    cv::minMaxLoc(diff, nullptr, &maxDiff);
+    REQUIRE(maxDiff <= 1.0);
+}
+
+TEST_CASE("SobelFilter benchmark", "[EdgeDetector][.benchmark]") {
+    const int width = 1920, height = 1080;
+    auto pattern = makePattern(width, height);
+    cv::Mat src(height, width, CV_8UC1, pattern.data());
+    cv::Mat out(height, width, CV_8UC1);
+    dai::impl::SobelFilter filter;
+
+    BENCHMARK("SobelFilter 1 thread") {
+        filter.apply(src.data, src.step, out.data, out.step, width, height, 1);
+        return out.data[0];
+    };
+    BENCHMARK("SobelFilter 4 threads") {
+        filter.apply(src.data, src.step, out.data, out.step, width, height, 4);
+        return out.data[0];
+    };
+    BENCHMARK("cv::Sobel + cv::magnitude") {
+        cv::Mat gx, gy, magnitude;
+        cv::Sobel(src, gx, CV_32F, 1, 0, 3, 1, 0, cv::BORDER_REPLICATE);
+        cv::Sobel(src, gy, CV_32F, 0, 1, 3, 1, 0, cv::BORDER_REPLICATE);
+        cv::magnitude(gx, gy, magnitude);
+        magnitude.convertTo(out, CV_8U);
+        return out.data[0];
+    };
+}
+#endif
@@ -0,0 +1,90 @@
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <filesystem>
+#include <opencv2/opencv.hpp>
+
+#include "depthai/pipeline/Pipeline.hpp"
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+#include "depthai/pipeline/node/host/HostCamera.hpp"
+
+using namespace std::chrono_literals;
+
+TEST_CASE("HostCamera synthetic source") {
+    const auto type = GENERATE(dai::ImgFrame::Type::BGR888i, dai::ImgFrame::Type::RGB888i, dai::ImgFrame::Type::GRAY8, dai::ImgFrame::Type::NV12);
+    constexpr int NUM_FRAMES = 10;
+
+    dai::Pipeline pipeline(false);
+    auto camera = pipeline.create<dai::node::HostCamera>();
+    camera->setSynthetic().setSize(320, 240).setOutFrameType(type).setFps(100);
+    auto queue = camera->out.createOutputQueue(NUM_FRAMES, true);
+    pipeline.start();
+
+    std::shared_ptr<dai::ImgFrame> previous;
+    for(int i = 0; i < NUM_FRAMES; i++) {
+        auto frame = queue->get<dai::ImgFrame>();
+        REQUIRE(frame != nullptr);
+        REQUIRE(frame->getType() == type);
+        REQUIRE(frame->getWidth() == 320);
+        REQUIRE(frame->getHeight() == 240);
+        REQUIRE(frame->getSequenceNum() == static_cast<std::int64_t>(i));
+        const std::size_t pixels = 320 * 240;
+        const std::size_t expectedSize = type == dai::ImgFrame::Type::GRAY8 ? pixels : type == dai::ImgFrame::Type::NV12 ? pixels * 3 / 2 : pixels * 3;
+        REQUIRE(frame->getData().size() == expectedSize);
+
+        // Decodes back to the pattern
+        auto bgr = frame->getCvFrame();
+        REQUIRE(bgr.cols == 320);
+        REQUIRE(bgr.rows == 240);
+
+        if(previous) {
+            // Paced at the requested rate
+            const auto interval = frame->getTimestamp() - previous->getTimestamp();
+            REQUIRE(interval > 5ms);
+            REQUIRE(interval < 100ms);
+        }
+        previous = frame;
+    }
+    pipeline.stop();
+}
+
+TEST_CASE("HostCamera image sequence source") {
+    const auto dir = std::filesystem::temp_directory_path() / "depthai_host_camera_test";
+    std::filesystem::create_directories(dir);
+    constexpr int NUM_IMAGES = 3;
+    for(int i = 0; i < NUM_IMAGES; i++) {
+        cv::Mat image(60, 80, CV_8UC3, cv::Scalar(i * 50, 0, 0));
+        cv::imwrite((dir / ("img_" + std::to_string(i) + ".png")).string(), image);
+    }
+
+    dai::Pipeline pipeline(false);
+    auto camera = pipeline.create<dai::node::HostCamera>();
+    camera->setFile(dir / "img_%d.png").setSize(40, 30).setFps(200).setLoop(false);
+    auto queue = camera->out.createOutputQueue(NUM_IMAGES, true);
+    pipeline.start();
+
+    for(int i = 0; i < NUM_IMAGES; i++) {
+        auto frame = queue->get<dai::ImgFrame>();
+        REQUIRE(frame->getWidth() == 40);
+        REQUIRE(frame->getHeight() == 30);
+        REQUIRE(frame->getType() == dai::ImgFrame::Type::BGR888i);
+        // Blue channel carries the image index
+        REQUIRE(frame->getData()[0] == i * 50);
+    }
+    // Ends without looping
+    bool timedOut = false;
+    REQUIRE(queue->get<dai::ImgFrame>(200ms, timedOut) == nullptr);
+    REQUIRE(timedOut);
+    pipeline.stop();
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("HostCamera rejects unsupported settings") {
+    dai::Pipeline pipeline(false);
+    auto camera = pipeline.create<dai::node::HostCamera>();
+    REQUIRE_THROWS_AS(camera->setOutFrameType(dai::ImgFrame::Type::RAW16), std::invalid_argument);
+    REQUIRE_THROWS_AS(camera->setFps(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(camera->setSize(0, 10), std::invalid_argument);
+    REQUIRE(camera->getSourceType() == dai::node::HostCamera::SourceType::DEVICE);
+    camera->setSynthetic();
+    REQUIRE(camera->getSourceType() == dai::node::HostCamera::SourceType::SYNTHETIC);
+}
@@ -0,0 +1,88 @@
+#include <catch2/catch_all.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "depthai/pipeline/InputQueue.hpp"
+#include "depthai/pipeline/Pipeline.hpp"
+#include "depthai/pipeline/node/host/HostNode.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+class BatchCounter : public dai::node::CustomNode<BatchCounter> {
+   public:
+    std::atomic<int> groupCalls{0};
+    std::atomic<int> batchCalls{0};
+    std::atomic<std::size_t> largestBatch{0};
+
+    std::shared_ptr<dai::Buffer> processGroup(std::shared_ptr<dai::MessageGroup> in) override {
+        groupCalls++;
+        return in->get<dai::Buffer>("in");
+    }
+
+    std::vector<std::shared_ptr<dai::Buffer>> processBatch(std::vector<std::shared_ptr<dai::MessageGroup>> groups) override {
+        // The first batch is slow, so that groups queue up behind it
+        if(batchCalls++ == 0) std::this_thread::sleep_for(200ms);
+        if(groups.size() > largestBatch) largestBatch = groups.size();
+        auto outputs = HostNode::processBatch(std::move(groups));
+        // Null outputs aren't sent
+        outputs.push_back(nullptr);
+        return outputs;
+    }
+};
+
+}  // namespace
+
+TEST_CASE("HostNode processes one group at a time by default") {
+    dai::Pipeline p(false);
+    auto node = p.create<BatchCounter>();
+    REQUIRE(node->getMaxBatchSize() == 1);
+    REQUIRE_THROWS_AS(node->setMaxBatchSize(0), std::invalid_argument);
+    auto input = node->inputs["in"].createInputQueue();
+    auto output = node->out.createOutputQueue(16, true);
+
+    p.start();
+    for(int i = 0; i < 5; i++) {
+        auto buffer = std::make_shared<dai::Buffer>();
+        buffer->setSequenceNum(i);
+        input->send(buffer);
+        REQUIRE(output->get<dai::Buffer>()->getSequenceNum() == i);
+    }
+    p.stop();
+    REQUIRE(node->groupCalls == 5);
+    REQUIRE(node->batchCalls == 0);
+}
+
+TEST_CASE("HostNode batches the groups waiting for it") {
+    constexpr int numMessages = 20;
+    dai::Pipeline p(false);
+    auto node = p.create<BatchCounter>();
+    node->setMaxBatchSize(8);
+    node->inputs["in"].setBlocking(true);
+    node->inputs["in"].setMaxSize(8);
+    // Waits rather than drops while the first batch holds up the node
+    auto input = node->inputs["in"].createInputQueue(numMessages, true);
+    auto output = node->out.createOutputQueue(numMessages, true);
+
+    p.start();
+    for(int i = 0; i < numMessages; i++) {
+        auto buffer = std::make_shared<dai::Buffer>();
+        buffer->setSequenceNum(i);
+        input->send(buffer);
+    }
+    // Every group is processed once and the outputs keep their order
+    for(int i = 0; i < numMessages; i++) {
+        REQUIRE(output->get<dai::Buffer>()->getSequenceNum() == i);
+    }
+    p.stop();
+    REQUIRE(node->groupCalls == numMessages);
+    REQUIRE(node->batchCalls < numMessages);
+    // More than the default queue of synced groups holds
+    REQUIRE(node->largestBatch > 4);
+    REQUIRE(node->largestBatch <= 8);
+}
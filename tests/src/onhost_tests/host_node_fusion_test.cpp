@@ -0,0 +1,131 @@
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+#include "depthai/pipeline/Pipeline.hpp"
+#include "depthai/pipeline/ThreadedHostNode.hpp"
+#include "depthai/pipeline/node/host/HostNode.hpp"
+#include "test_nodes.hpp"
+
+using test::Source;
+using test::makeBuffer;
+
+namespace {
+
+// Increments the sequence number and records the threads it ran on
+class Increment : public dai::node::CustomNode<Increment> {
+   public:
+    std::mutex mtx;
+    std::set<std::thread::id> threads;
+    std::atomic<int> processed{0};
+    // Throws on the message with this sequence number
+    int64_t failOn = -1;
+
+    std::shared_ptr<Increment> build(Output& input) {
+        input.link(inputs["in"]);
+        return std::static_pointer_cast<Increment>(shared_from_this());
+    }
+
+    std::shared_ptr<dai::Buffer> processGroup(std::shared_ptr<dai::MessageGroup> in) override {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            threads.insert(std::this_thread::get_id());
+        }
+        const auto sequenceNum = in->get<dai::Buffer>("in")->getSequenceNum();
+        if(sequenceNum == failOn) throw std::runtime_error("Increment failed");
+        processed++;
+        auto buffer = std::make_shared<dai::Buffer>();
+        buffer->setSequenceNum(sequenceNum + 1);
+        return buffer;
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Fused host nodes produce the same outputs") {
+    constexpr int numMessages = 50;
+    for(const bool fuse : {false, true}) {
+        dai::Pipeline p(false);
+        p.setHostNodeFusion(fuse);
+        REQUIRE(p.getHostNodeFusion() == fuse);
+        auto source = p.create<Source>();
+        auto first = p.create<Increment>()->build(source->out);
+        auto second = p.create<Increment>()->build(first->out);
+        auto third = p.create<Increment>()->build(second->out);
+        auto output = third->out.createOutputQueue(numMessages, true);
+
+        p.start();
+        for(int i = 0; i < numMessages; i++) source->out.send(makeBuffer(i));
+        for(int i = 0; i < numMessages; i++) {
+            auto buffer = output->get<dai::Buffer>();
+            REQUIRE(buffer->getSequenceNum() == i + 3);
+        }
+        REQUIRE(second->isRunning());
+        p.stop();
+
+        // The fused nodes ran in the thread of the first one
+        REQUIRE(first->threads.size() == 1);
+        const auto firstThread = *first->threads.begin();
+        REQUIRE((*second->threads.begin() == firstThread) == fuse);
+        REQUIRE((*third->threads.begin() == firstThread) == fuse);
+    }
+}
+
+TEST_CASE("Only single producer, single consumer host nodes are fused") {
+    dai::Pipeline p(false);
+    p.setHostNodeFusion(true);
+    auto source = p.create<Source>();
+    auto first = p.create<Increment>()->build(source->out);
+    // The output of the first node goes to two nodes
+    auto second = p.create<Increment>()->build(first->out);
+    auto other = p.create<Increment>()->build(first->out);
+    auto fused = p.create<Increment>()->build(second->out);
+    auto output = fused->out.createOutputQueue(4, true);
+    auto otherOutput = other->out.createOutputQueue(4, true);
+
+    p.start();
+    REQUIRE_THROWS_AS(p.setHostNodeFusion(false), std::runtime_error);
+    source->out.send(makeBuffer(0));
+    REQUIRE(output->get<dai::Buffer>()->getSequenceNum() == 3);
+    REQUIRE(otherOutput->get<dai::Buffer>()->getSequenceNum() == 2);
+    REQUIRE(*second->threads.begin() != *first->threads.begin());
+    REQUIRE(*fused->threads.begin() == *second->threads.begin());
+
+    // Fused nodes keep their place while running
+    REQUIRE_THROWS_AS(p.remove(fused), std::runtime_error);
+    REQUIRE_THROWS_AS(source->out.link(fused->inputs["in"]), std::runtime_error);
+    p.stop();
+}
+
+TEST_CASE("An exception of a fused host node stops only that node") {
+    dai::Pipeline p(false);
+    p.setHostNodeFusion(true);
+    auto source = p.create<Source>();
+    auto first = p.create<Increment>()->build(source->out);
+    auto second = p.create<Increment>()->build(first->out);
+    second->failOn = 3;
+    auto output = second->out.createOutputQueue(8, true);
+
+    p.start();
+    for(int i = 0; i < 5; i++) source->out.send(makeBuffer(i));
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(first->processed < 5 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // The producer went on with every message, the consumer stopped at the one it failed on
+    REQUIRE(first->processed == 5);
+    REQUIRE(first->isRunning());
+    REQUIRE_FALSE(second->isRunning());
+    REQUIRE(second->processed == 2);
+    REQUIRE(output->get<dai::Buffer>()->getSequenceNum() == 3);
+    REQUIRE(output->get<dai::Buffer>()->getSequenceNum() == 4);
+    REQUIRE(output->tryGet() == nullptr);
+    REQUIRE(*second->threads.begin() == *first->threads.begin());
+    p.stop();
+}
@@ -0,0 +1,162 @@
+#include <atomic>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "depthai/pipeline/InputQueue.hpp"
+#include "depthai/pipeline/Pipeline.hpp"
+#include "depthai/pipeline/ThreadedHostNode.hpp"
+#include "depthai/pipeline/datatype/Buffer.hpp"
+#include "test_nodes.hpp"
+
+using namespace std::chrono_literals;
+using test::Sink;
+using test::Source;
+using test::makeBuffer;
+
+namespace {
+
+// What InputQueue used to be, a thread relaying from its own queue into the connected input
+class Relay : public dai::node::CustomThreadedNode<Relay> {
+   public:
+    Input input{*this, {"input", DEFAULT_GROUP, false, 16, {{{dai::DatatypeEnum::Buffer, true}}}, DEFAULT_WAIT_FOR_MESSAGE}};
+    Output output{*this, {"output", DEFAULT_GROUP, {{{dai::DatatypeEnum::Buffer, true}}}}};
+
+    void run() override {
+        while(isRunning()) output.send(input.get());
+    }
+};
+
+}  // namespace
+
+TEST_CASE("InputQueue delivers into the connected input") {
+    dai::Pipeline p(false);
+    auto sink = p.create<Sink>();
+    auto queue = sink->input.createInputQueue(4, true);
+    p.start();
+    // Including the input queue node, without a thread of its own
+    for(const auto& node : p.getAllNodes()) REQUIRE(std::dynamic_pointer_cast<dai::ThreadedNode>(node)->isRunning());
+
+    queue->send(makeBuffer(0));
+    queue->send(makeBuffer(1));
+    // Already in the input's queue when send returns
+    REQUIRE(sink->input.tryGet<dai::Buffer>()->getSequenceNum() == 0);
+    REQUIRE(sink->input.tryGet<dai::Buffer>()->getSequenceNum() == 1);
+    REQUIRE(sink->input.tryGet() == nullptr);
+    p.stop();
+}
+
+TEST_CASE("InputQueue keeps messages sent before the start") {
+    dai::Pipeline p(false);
+    auto sink = p.create<Sink>();
+    auto queue = sink->input.createInputQueue(4, false);
+    for(int i = 0; i < 6; i++) queue->send(makeBuffer(i));
+    REQUIRE(sink->input.tryGet() == nullptr);
+
+    p.start();
+    // The oldest ones didn't fit into the input queue, nor into the sink's input
+    REQUIRE(sink->input.tryGet<dai::Buffer>()->getSequenceNum() == 4);
+    REQUIRE(sink->input.tryGet<dai::Buffer>()->getSequenceNum() == 5);
+    REQUIRE(sink->input.tryGet() == nullptr);
+    p.stop();
+}
+
+TEST_CASE("Non blocking InputQueue drops the oldest messages when the input is full") {
+    dai::Pipeline p(false);
+    auto sink = p.create<Sink>();
+    auto queue = sink->input.createInputQueue(4, false);
+    p.start();
+
+    for(int i = 0; i < 5; i++) queue->send(makeBuffer(i));
+    // The newest messages survive
+    REQUIRE(sink->input.tryGet<dai::Buffer>()->getSequenceNum() == 3);
+    REQUIRE(sink->input.tryGet<dai::Buffer>()->getSequenceNum() == 4);
+    REQUIRE(sink->input.tryGet() == nullptr);
+
+    // The policy of its link stays unset
+    for(const auto& node : p.getAllNodes()) {
+        if(std::string(node->getName()) == "InputQueue") {
+            REQUIRE(node->getOutputRefs().front()->getLinkPolicy(sink->input) == dai::Node::Output::LinkPolicy::QUEUE_DEFAULT);
+        }
+    }
+    p.stop();
+}
+
+TEST_CASE("Non blocking InputQueue keeps the messages of other senders to the input") {
+    dai::Pipeline p(false);
+    auto sink = p.create<Sink>();
+    auto source = p.create<Source>();
+    source->out.link(sink->input);
+    auto queue = sink->input.createInputQueue(4, false);
+    p.start();
+
+    source->out.send(makeBuffer(0));
+    source->out.send(makeBuffer(1));
+    // The input is full, the new message of the queue is dropped instead
+    queue->send(makeBuffer(2));
+    REQUIRE(sink->input.tryGet<dai::Buffer>()->getSequenceNum() == 0);
+    REQUIRE(sink->input.tryGet<dai::Buffer>()->getSequenceNum() == 1);
+    REQUIRE(sink->input.tryGet() == nullptr);
+    p.stop();
+}
+
+TEST_CASE("Blocking InputQueue waits for room in the input") {
+    dai::Pipeline p(false);
+    auto sink = p.create<Sink>();
+    auto queue = sink->input.createInputQueue(4, true);
+    p.start();
+
+    std::atomic<int> sent{0};
+    std::thread sender([&]() {
+        for(int i = 0; i < 4; i++) {
+            queue->send(makeBuffer(i));
+            sent++;
+        }
+    });
+    std::this_thread::sleep_for(50ms);
+    REQUIRE(sent == 2);
+    for(int i = 0; i < 4; i++) REQUIRE(sink->input.get<dai::Buffer>()->getSequenceNum() == i);
+    sender.join();
+    REQUIRE(sent == 4);
+
+    // Unblocked and throws when stopped
+    queue->send(makeBuffer(4));
+    queue->send(makeBuffer(5));
+    std::atomic<bool> threw{false};
+    std::thread blocked([&]() {
+        try {
+            queue->send(makeBuffer(6));
+        } catch(const dai::MessageQueue::QueueException&) {
+            threw = true;
+        }
+    });
+    std::this_thread::sleep_for(20ms);
+    p.stop();
+    blocked.join();
+    REQUIRE(threw);
+    REQUIRE_THROWS_AS(queue->send(makeBuffer(7)), dai::MessageQueue::QueueException);
+}
+
+TEST_CASE("InputQueue benchmark", "[.benchmark]") {
+    dai::Pipeline p(false);
+    auto directSink = p.create<Sink>();
+    auto relaySink = p.create<Sink>();
+    auto relay = p.create<Relay>();
+    relay->output.link(relaySink->input);
+    auto direct = directSink->input.createInputQueue();
+    p.start();
+
+    auto buffer = makeBuffer(0);
+    BENCHMARK("InputQueue send to get") {
+        direct->send(buffer);
+        return directSink->input.get();
+    };
+    BENCHMARK("Relay thread send to get") {
+        relay->input.send(buffer);
+        return relaySink->input.get();
+    };
+    p.stop();
+}
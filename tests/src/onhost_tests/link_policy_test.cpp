@@ -0,0 +1,181 @@
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "depthai/pipeline/Pipeline.hpp"
+#include "depthai/pipeline/ThreadedHostNode.hpp"
+#include "depthai/pipeline/datatype/Buffer.hpp"
+#include "test_nodes.hpp"
+
+using namespace std::chrono_literals;
+using LinkPolicy = dai::Node::Output::LinkPolicy;
+using test::Sink;
+using test::Source;
+using test::drain;
+using test::makeBuffer;
+
+TEST_CASE("A full blocking input doesn't delay the other inputs") {
+    dai::Pipeline p(false);
+    auto source = p.create<Source>();
+    auto slow = p.create<Sink>();
+    auto fast = p.create<Sink>();
+    slow->input.setMaxSize(1);
+    // Linked first, so that it would be served first
+    source->out.link(slow->input);
+    source->out.link(fast->input);
+    source->out.setLinkPolicy(fast->input, LinkPolicy::BLOCK);
+
+    source->out.send(makeBuffer(0));
+    REQUIRE(drain(fast->input) == std::vector<int64_t>{0});
+
+    std::atomic<bool> sent{false};
+    std::thread sender([&]() {
+        source->out.send(makeBuffer(1));
+        sent = true;
+    });
+    // Delivered to the fast input while still waiting for the slow one
+    auto buffer = fast->input.get<dai::Buffer>();
+    REQUIRE(buffer->getSequenceNum() == 1);
+    std::this_thread::sleep_for(20ms);
+    REQUIRE_FALSE(sent);
+
+    REQUIRE(slow->input.get<dai::Buffer>()->getSequenceNum() == 0);
+    sender.join();
+    REQUIRE(drain(slow->input) == std::vector<int64_t>{1});
+    REQUIRE(source->out.getLinkStats(slow->input).sent == 2);
+    REQUIRE(source->out.getLinkStats(slow->input).dropped == 0);
+}
+
+TEST_CASE("Link policies when the input is full") {
+    dai::Pipeline p(false);
+    auto source = p.create<Source>();
+    auto sink = p.create<Sink>();
+    source->out.link(sink->input);
+    REQUIRE(source->out.getLinkPolicy(sink->input) == LinkPolicy::QUEUE_DEFAULT);
+
+    const auto requireStats = [&](uint64_t sent, uint64_t dropped) {
+        const auto stats = source->out.getLinkStats(sink->input);
+        REQUIRE(stats.sent == sent);
+        REQUIRE(stats.dropped == dropped);
+    };
+
+    SECTION("BLOCK_TIMEOUT") {
+        source->out.setLinkPolicy(sink->input, LinkPolicy::BLOCK_TIMEOUT, 20ms);
+        for(int i = 0; i < 2; i++) source->out.send(makeBuffer(i));
+        const auto start = std::chrono::steady_clock::now();
+        source->out.send(makeBuffer(2));
+        REQUIRE(std::chrono::steady_clock::now() - start >= 20ms);
+        REQUIRE(drain(sink->input) == std::vector<int64_t>{0, 1});
+        requireStats(2, 1);
+    }
+    SECTION("DROP_NEWEST") {
+        source->out.setLinkPolicy(sink->input, LinkPolicy::DROP_NEWEST);
+        for(int i = 0; i < 3; i++) source->out.send(makeBuffer(i));
+        REQUIRE(drain(sink->input) == std::vector<int64_t>{0, 1});
+        requireStats(2, 1);
+    }
+    SECTION("DROP_OLDEST") {
+        source->out.setLinkPolicy(sink->input, LinkPolicy::DROP_OLDEST);
+        for(int i = 0; i < 3; i++) source->out.send(makeBuffer(i));
+        REQUIRE(drain(sink->input) == std::vector<int64_t>{1, 2});
+        requireStats(3, 1);
+    }
+    SECTION("QUEUE_DEFAULT follows a non blocking input") {
+        sink->input.setBlocking(false);
+        for(int i = 0; i < 3; i++) source->out.send(makeBuffer(i));
+        REQUIRE(drain(sink->input) == std::vector<int64_t>{1, 2});
+        requireStats(3, 1);
+    }
+    SECTION("KEEP_LATEST") {
+        source->out.setLinkPolicy(sink->input, LinkPolicy::KEEP_LATEST);
+        source->out.send(makeBuffer(0));
+        source->out.send(makeBuffer(1));
+        REQUIRE(drain(sink->input) == std::vector<int64_t>{1});
+        source->out.send(makeBuffer(2));
+        REQUIRE(drain(sink->input) == std::vector<int64_t>{2});
+        requireStats(3, 1);
+    }
+}
+
+TEST_CASE("Input callbacks only see delivered messages") {
+    dai::Pipeline p(false);
+    auto source = p.create<Source>();
+    auto sink = p.create<Sink>();
+    source->out.link(sink->input);
+    std::vector<int64_t> seen;
+    sink->input.addCallback([&seen](std::shared_ptr<dai::ADatatype> msg) { seen.push_back(std::static_pointer_cast<dai::Buffer>(msg)->getSequenceNum()); });
+
+    source->out.setLinkPolicy(sink->input, LinkPolicy::DROP_NEWEST);
+    for(int i = 0; i < 3; i++) source->out.send(makeBuffer(i));
+    REQUIRE(seen == std::vector<int64_t>{0, 1});
+
+    source->out.setLinkPolicy(sink->input, LinkPolicy::BLOCK_TIMEOUT, 1ms);
+    source->out.send(makeBuffer(3));
+    REQUIRE(seen == std::vector<int64_t>{0, 1});
+
+    source->out.setLinkPolicy(sink->input, LinkPolicy::DROP_OLDEST);
+    source->out.send(makeBuffer(4));
+    REQUIRE(seen == std::vector<int64_t>{0, 1, 4});
+    REQUIRE(drain(sink->input) == std::vector<int64_t>{1, 4});
+}
+
+TEST_CASE("Linked queues of size 0 pass every message to their callbacks") {
+    dai::Pipeline p(false);
+    auto source = p.create<Source>();
+    auto sink = p.create<Sink>();
+    sink->input.setMaxSize(0);
+    source->out.link(sink->input);
+    auto queue = source->out.createOutputQueue(0, false);
+    std::vector<int64_t> inputSeen, queueSeen;
+    sink->input.addCallback([&inputSeen](std::shared_ptr<dai::ADatatype> msg) { inputSeen.push_back(std::static_pointer_cast<dai::Buffer>(msg)->getSequenceNum()); });
+    queue->addCallback([&queueSeen](std::shared_ptr<dai::ADatatype> msg) { queueSeen.push_back(std::static_pointer_cast<dai::Buffer>(msg)->getSequenceNum()); });
+
+    int64_t sequenceNum = 0;
+    std::vector<int64_t> expected;
+    for(const auto policy : {LinkPolicy::QUEUE_DEFAULT, LinkPolicy::BLOCK, LinkPolicy::DROP_NEWEST, LinkPolicy::DROP_OLDEST, LinkPolicy::KEEP_LATEST}) {
+        source->out.setLinkPolicy(sink->input, policy);
+        source->out.setLinkPolicy(*queue, policy);
+        source->out.send(makeBuffer(sequenceNum));
+        expected.push_back(sequenceNum++);
+    }
+    REQUIRE(inputSeen == expected);
+    REQUIRE(queueSeen == expected);
+    REQUIRE(sink->input.tryGet() == nullptr);
+}
+
+TEST_CASE("trySend doesn't wait on blocking links") {
+    dai::Pipeline p(false);
+    auto source = p.create<Source>();
+    auto sink = p.create<Sink>();
+    auto other = p.create<Sink>();
+    source->out.link(sink->input);
+    source->out.link(other->input);
+    source->out.setLinkPolicy(sink->input, LinkPolicy::BLOCK);
+    source->out.setLinkPolicy(other->input, LinkPolicy::DROP_OLDEST);
+
+    REQUIRE(source->out.trySend(makeBuffer(0)));
+    REQUIRE(source->out.trySend(makeBuffer(1)));
+    REQUIRE_FALSE(source->out.trySend(makeBuffer(2)));
+    REQUIRE(drain(sink->input) == std::vector<int64_t>{0, 1});
+    REQUIRE(drain(other->input) == std::vector<int64_t>{1, 2});
+    REQUIRE(source->out.getLinkStats(sink->input).dropped == 1);
+    REQUIRE(source->out.getLinkStats(other->input).dropped == 1);
+}
+
+TEST_CASE("Link policies apply to output queues") {
+    dai::Pipeline p(false);
+    auto source = p.create<Source>();
+    auto queue = source->out.createOutputQueue(4, true);
+    source->out.setLinkPolicy(*queue, LinkPolicy::KEEP_LATEST);
+    for(int i = 0; i < 3; i++) source->out.send(makeBuffer(i));
+    REQUIRE(drain(*queue) == std::vector<int64_t>{2});
+    REQUIRE(source->out.getLinkStats(*queue).dropped == 2);
+
+    auto unlinked = p.create<Sink>();
+    REQUIRE_THROWS_AS(source->out.setLinkPolicy(unlinked->input, LinkPolicy::BLOCK), std::logic_error);
+    REQUIRE_THROWS_AS(source->out.getLinkStats(unlinked->input), std::logic_error);
+}
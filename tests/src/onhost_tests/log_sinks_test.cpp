@@ -0,0 +1,228 @@
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/spdlog.h>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utility/LogSinks.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Logged {
+    spdlog::level::level_enum level;
+    std::string logger;
+    std::string payload;
+    dai::LogContext::Fields fields;
+};
+
+// Keeps the sunk messages, optionally holding the sinking thread until released
+class CollectSink : public spdlog::sinks::base_sink<std::mutex> {
+   public:
+    std::vector<Logged> messages() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return logged;
+    }
+    void hold() {
+        std::lock_guard<std::mutex> lock(holdMtx);
+        held = true;
+    }
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(holdMtx);
+            held = false;
+        }
+        holdCv.notify_all();
+    }
+    // Waits until the sinking thread got a message, it stays there while held
+    bool waitEntered(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(holdMtx);
+        return holdCv.wait_for(lock, timeout, [this]() { return entered; });
+    }
+
+   protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override {
+        {
+            std::unique_lock<std::mutex> lock(holdMtx);
+            entered = true;
+            holdCv.notify_all();
+            holdCv.wait(lock, [this]() { return !held; });
+        }
+        logged.push_back({msg.level, std::string(msg.logger_name.data(), msg.logger_name.size()), std::string(msg.payload.data(), msg.payload.size()),
+                          dai::LogContext::fields()});
+    }
+    void flush_() override {}
+
+   private:
+    std::vector<Logged> logged;
+    std::mutex holdMtx;
+    std::condition_variable holdCv;
+    bool held = false;
+    bool entered = false;
+};
+
+std::vector<std::string> payloads(const std::vector<Logged>& messages) {
+    std::vector<std::string> result;
+    for(const auto& message : messages) result.push_back(message.payload);
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("Async sink keeps order and context fields") {
+    auto collect = std::make_shared<CollectSink>();
+    auto async = std::make_shared<dai::AsyncLogSink>(std::vector<spdlog::sink_ptr>{collect}, 64, dai::AsyncLogSink::OverflowPolicy::BLOCK);
+    spdlog::logger logger("test", async);
+    logger.set_level(spdlog::level::trace);
+
+    std::thread node([&]() {
+        dai::LogContext::Scope nodeScope("node", "Camera(0)");
+        dai::LogContext::Scope streamScope("stream", "out");
+        for(int i = 0; i < 200; i++) logger.debug("message {}", i);
+    });
+    node.join();
+    logger.info("from the test");
+    async->flush();
+
+    const auto messages = collect->messages();
+    REQUIRE(messages.size() == 201);
+    for(int i = 0; i < 200; i++) {
+        REQUIRE(messages[i].payload == "message " + std::to_string(i));
+        REQUIRE(messages[i].fields == dai::LogContext::Fields{{"node", "Camera(0)"}, {"stream", "out"}});
+    }
+    REQUIRE(messages[200].fields.empty());
+    REQUIRE(async->getDropped() == 0);
+}
+
+TEST_CASE("Async sink overflow policies") {
+    SECTION("DROP_NEWEST") {
+        auto collect = std::make_shared<CollectSink>();
+        collect->hold();
+        auto async = std::make_shared<dai::AsyncLogSink>(std::vector<spdlog::sink_ptr>{collect}, 4, dai::AsyncLogSink::OverflowPolicy::DROP_NEWEST);
+        spdlog::logger logger("test", async);
+        logger.info("first");
+        // Fills the ring while the worker is stuck on the first message
+        std::size_t numLogged = 1;
+        while(async->getDropped() == 0) {
+            logger.info("message {}", numLogged++);
+            std::this_thread::sleep_for(1ms);
+        }
+        collect->release();
+        async->flush();
+        const auto messages = payloads(collect->messages());
+        REQUIRE(messages.front() == "first");
+        // Only the last message didn't fit
+        REQUIRE(messages.size() == numLogged - 1);
+        REQUIRE(messages.back() == "message " + std::to_string(numLogged - 2));
+    }
+    SECTION("DROP_OLDEST") {
+        auto collect = std::make_shared<CollectSink>();
+        collect->hold();
+        auto async = std::make_shared<dai::AsyncLogSink>(std::vector<spdlog::sink_ptr>{collect}, 4, dai::AsyncLogSink::OverflowPolicy::DROP_OLDEST);
+        spdlog::logger logger("test", async);
+        logger.info("first");
+        // The worker holds on to the first message, the ring is empty again
+        REQUIRE(collect->waitEntered(5s));
+        for(int i = 0; i < 10; i++) logger.info("message {}", i);
+        REQUIRE(async->getDropped() == 6);
+        collect->release();
+        async->flush();
+        REQUIRE(payloads(collect->messages()) == std::vector<std::string>{"first", "message 6", "message 7", "message 8", "message 9"});
+    }
+}
+
+TEST_CASE("Rate limit and repeated messages") {
+    auto collect = std::make_shared<CollectSink>();
+    auto rateLimit = std::make_shared<dai::RateLimitLogSink>(1.0, 3.0);
+    rateLimit->add_sink(collect);
+    spdlog::logger logger("limited", rateLimit);
+    spdlog::logger other("other", rateLimit);
+
+    for(int i = 0; i < 4; i++) logger.info("same");
+    logger.info("different");
+    REQUIRE(payloads(collect->messages()) == std::vector<std::string>{"same", "Last message repeated 3 times", "different"});
+
+    // The burst of three is used up, errors still get through
+    for(int i = 0; i < 5; i++) logger.info("message {}", i);
+    logger.error("error");
+    auto messages = payloads(collect->messages());
+    REQUIRE(messages.size() == 6);
+    REQUIRE(messages[3] == "message 0");
+    REQUIRE(messages[4] == "4 messages suppressed by the log rate limit");
+    REQUIRE(messages[5] == "error");
+
+    // Other loggers have their own budget
+    other.info("other logger");
+    REQUIRE(collect->messages().back().logger == "other");
+
+    // Counts of loggers which went quiet are reported on flush
+    for(int i = 0; i < 2; i++) logger.info("quiet {}", i);
+    logger.flush();
+    messages = payloads(collect->messages());
+    REQUIRE(messages.back() == "2 messages suppressed by the log rate limit");
+}
+
+TEST_CASE("JSON lines sink") {
+    std::ostringstream out;
+    auto json = std::make_shared<dai::JsonLinesLogSink>(out);
+    spdlog::logger logger("depthai", json);
+    {
+        dai::LogContext::Scope nodeScope("node", "XLinkInHost(3)");
+        logger.warn("quote \" backslash \\ newline \n tab \t");
+    }
+    logger.info("plain");
+
+    std::istringstream lines(out.str());
+    std::string line;
+    REQUIRE(std::getline(lines, line));
+    auto first = nlohmann::json::parse(line);
+    REQUIRE(first["level"] == "warning");
+    REQUIRE(first["logger"] == "depthai");
+    REQUIRE(first["msg"] == "quote \" backslash \\ newline \n tab \t");
+    REQUIRE(first["node"] == "XLinkInHost(3)");
+    REQUIRE(first["time_us"].get<int64_t>() > 0);
+    REQUIRE(first.contains("thread"));
+    REQUIRE(std::getline(lines, line));
+    auto second = nlohmann::json::parse(line);
+    REQUIRE(second["msg"] == "plain");
+    REQUIRE_FALSE(second.contains("node"));
+    REQUIRE_FALSE(std::getline(lines, line));
+}
+
+TEST_CASE("Suppressed log call cost", "[.benchmark]") {
+    auto null = std::make_shared<spdlog::sinks::null_sink_mt>();
+    spdlog::logger filtered("filtered", null);
+    filtered.set_level(spdlog::level::warn);
+    auto rateLimit = std::make_shared<dai::RateLimitLogSink>(1.0, 1.0);
+    rateLimit->add_sink(null);
+    spdlog::logger limited("limited", rateLimit);
+    limited.set_level(spdlog::level::trace);
+    auto async = std::make_shared<dai::AsyncLogSink>(std::vector<spdlog::sink_ptr>{null});
+    spdlog::logger asyncLogger("async", async);
+    asyncLogger.set_level(spdlog::level::trace);
+
+    int i = 0;
+    BENCHMARK("Below the logger level") {
+        filtered.debug("frame {} dropped", i++);
+    };
+    BENCHMARK("Rate limited") {
+        limited.debug("frame {} dropped", i++);
+    };
+    BENCHMARK("Repeated") {
+        limited.debug("frame dropped");
+    };
+    BENCHMARK("Async enqueue") {
+        asyncLogger.debug("frame {} dropped", i++);
+    };
+}
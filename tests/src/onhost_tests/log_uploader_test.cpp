@@ -0,0 +1,287 @@
+#include <httplib.h>
+
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "depthai/utility/Compression.hpp"
+#include "utility/LogUploader.hpp"
+
+using dai::logCollection::LogUploader;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Received {
+    std::string pipelineId;
+    std::string fileName;
+    std::string contentType;
+    std::string content;
+};
+
+// Stand-in for the log collection server, answering with the status returned by the handler
+class LogServer {
+   public:
+    explicit LogServer(std::function<int(int)> status = [](int) { return 200; }) : status(std::move(status)) {
+        server.Post("/logs", [this](const httplib::Request& req, httplib::Response& res) {
+            int request = 0;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                request = numRequests++;
+                if(req.has_file("pipelineFile")) {
+                    const auto file = req.get_file_value("pipelineFile");
+                    received.push_back({req.get_file_value("pipelineId").content, file.filename, file.content_type, file.content});
+                }
+            }
+            cv.notify_all();
+            if(hold) {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait_for(lock, 10s, [this]() { return !hold; });
+            }
+            res.status = this->status(request);
+        });
+        port = server.bind_to_any_port("127.0.0.1");
+        thread = std::thread([this]() { server.listen_after_bind(); });
+        server.wait_until_ready();
+    }
+    ~LogServer() {
+        release();
+        server.stop();
+        thread.join();
+    }
+
+    std::string url() const {
+        return "http://127.0.0.1:" + std::to_string(port) + "/logs";
+    }
+    bool waitForRequests(int num) {
+        std::unique_lock<std::mutex> lock(mtx);
+        return cv.wait_for(lock, 10s, [&]() { return numRequests >= num; });
+    }
+    // Keeps requests hanging until released, like a stalled connection
+    void holdRequests() {
+        hold = true;
+    }
+    void release() {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            hold = false;
+        }
+        cv.notify_all();
+    }
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::vector<Received> received;
+    std::atomic<int> numRequests{0};
+
+   private:
+    std::function<int(int)> status;
+    std::atomic<bool> hold{false};
+    httplib::Server server;
+    std::thread thread;
+    int port = 0;
+};
+
+std::filesystem::path makeSpoolDir(const std::string& name) {
+    auto dir = std::filesystem::temp_directory_path() / ("depthai_log_uploader_" + name);
+    std::filesystem::remove_all(dir);
+    return dir;
+}
+
+LogUploader::Config makeConfig(const std::string& url, const std::filesystem::path& spoolDir) {
+    LogUploader::Config config;
+    config.url = url;
+    config.spoolDir = spoolDir;
+    config.baseDelay = 10ms;
+    config.maxDelay = 100ms;
+    config.requestTimeout = 5s;
+    return config;
+}
+
+LogUploader::Upload makeUpload(const std::string& id, const std::string& content) {
+    LogUploader::Upload upload;
+    upload.fields["pipelineId"] = id;
+    upload.files.push_back({"pipelineFile", "pipeline.json", content});
+    return upload;
+}
+
+std::size_t numSpooled(const std::filesystem::path& dir) {
+    std::size_t num = 0;
+    for(const auto& entry : std::filesystem::directory_iterator(dir)) num += entry.is_directory() ? 1 : 0;
+    return num;
+}
+
+}  // namespace
+
+TEST_CASE("LogUploader sends gzipped uploads in the background") {
+    LogServer server;
+    const auto spoolDir = makeSpoolDir("send");
+    const std::string content(100000, 'x');
+    {
+        LogUploader uploader(makeConfig(server.url(), spoolDir));
+        REQUIRE(uploader.enqueue(makeUpload("first", content)));
+        REQUIRE(uploader.enqueue(makeUpload("second", "{}")));
+        REQUIRE(uploader.waitIdle(10s));
+        REQUIRE(uploader.getNumUploaded() == 2);
+    }
+    REQUIRE(server.received.size() == 2);
+    // In order
+    REQUIRE(server.received[0].pipelineId == "first");
+    REQUIRE(server.received[1].pipelineId == "second");
+    const auto& received = server.received[0];
+    REQUIRE(received.fileName == "pipeline.json.gz");
+    REQUIRE(received.contentType == "application/gzip");
+    REQUIRE(received.content.size() < content.size() / 10);
+    auto decompressed = dai::utility::gunzip(reinterpret_cast<const uint8_t*>(received.content.data()), received.content.size());
+    REQUIRE(std::string(decompressed.begin(), decompressed.end()) == content);
+    REQUIRE(numSpooled(spoolDir) == 0);
+    std::filesystem::remove_all(spoolDir);
+}
+
+TEST_CASE("LogUploader retries with backoff") {
+    // Unavailable twice, then accepted
+    LogServer server([](int request) { return request < 2 ? 503 : 200; });
+    const auto spoolDir = makeSpoolDir("retry");
+    LogUploader uploader(makeConfig(server.url(), spoolDir));
+    REQUIRE(uploader.enqueue(makeUpload("retried", "{}")));
+    REQUIRE(uploader.waitIdle(10s));
+    REQUIRE(server.numRequests == 3);
+    REQUIRE(uploader.getNumUploaded() == 1);
+    std::filesystem::remove_all(spoolDir);
+}
+
+TEST_CASE("LogUploader drops rejected uploads and gives up after max attempts") {
+    LogServer server([](int request) { return request == 0 ? 400 : 500; });
+    const auto spoolDir = makeSpoolDir("give_up");
+    auto config = makeConfig(server.url(), spoolDir);
+    config.maxAttempts = 3;
+    LogUploader uploader(config);
+    REQUIRE(uploader.enqueue(makeUpload("rejected", "{}")));
+    REQUIRE(uploader.enqueue(makeUpload("failing", "{}")));
+    REQUIRE(uploader.waitIdle(10s));
+    // Rejected once, failing three times
+    REQUIRE(server.numRequests == 4);
+    REQUIRE(uploader.getNumUploaded() == 0);
+    REQUIRE(numSpooled(spoolDir) == 0);
+    std::filesystem::remove_all(spoolDir);
+}
+
+TEST_CASE("LogUploader resumes pending uploads from the spool directory") {
+    const auto spoolDir = makeSpoolDir("resume");
+    {
+        LogServer unavailable([](int) { return 503; });
+        auto config = makeConfig(unavailable.url(), spoolDir);
+        config.baseDelay = 10s;
+        LogUploader uploader(config);
+        REQUIRE(uploader.enqueue(makeUpload("resumed", "{\"a\": 1}")));
+        REQUIRE(unavailable.waitForRequests(1));
+    }
+    REQUIRE(numSpooled(spoolDir) == 1);
+
+    LogServer server;
+    LogUploader uploader(makeConfig(server.url(), spoolDir));
+    REQUIRE(uploader.waitIdle(10s));
+    REQUIRE(server.received.size() == 1);
+    REQUIRE(server.received[0].pipelineId == "resumed");
+    REQUIRE(numSpooled(spoolDir) == 0);
+    std::filesystem::remove_all(spoolDir);
+}
+
+TEST_CASE("LogUploader sends each upload once when processes share the spool directory") {
+    const auto spoolDir = makeSpoolDir("shared");
+    constexpr int numUploads = 20;
+    {
+        LogServer unavailable([](int) { return 503; });
+        auto config = makeConfig(unavailable.url(), spoolDir);
+        config.baseDelay = 10s;
+        LogUploader uploader(config);
+        for(int i = 0; i < numUploads; i++) REQUIRE(uploader.enqueue(makeUpload(std::to_string(i), "{}")));
+        REQUIRE(unavailable.waitForRequests(1));
+    }
+    REQUIRE(numSpooled(spoolDir) == numUploads);
+
+    // Both pick up all uploads from the spool directory
+    LogServer server;
+    LogUploader first(makeConfig(server.url(), spoolDir));
+    LogUploader second(makeConfig(server.url(), spoolDir));
+    REQUIRE(first.waitIdle(10s));
+    REQUIRE(second.waitIdle(10s));
+    REQUIRE(first.getNumUploaded() + second.getNumUploaded() == numUploads);
+    REQUIRE(server.received.size() == numUploads);
+    std::set<std::string> ids;
+    for(const auto& received : server.received) ids.insert(received.pipelineId);
+    REQUIRE(ids.size() == numUploads);
+    REQUIRE(numSpooled(spoolDir) == 0);
+    std::filesystem::remove_all(spoolDir);
+}
+
+TEST_CASE("LogUploader resumes uploads claimed by a process that exited") {
+    const auto spoolDir = makeSpoolDir("stale_claim");
+    {
+        LogServer unavailable([](int) { return 503; });
+        auto config = makeConfig(unavailable.url(), spoolDir);
+        config.baseDelay = 10s;
+        LogUploader uploader(config);
+        REQUIRE(uploader.enqueue(makeUpload("claimed", "{}")));
+        REQUIRE(unavailable.waitForRequests(1));
+    }
+    // As if the process exited while sending it a while ago
+    std::filesystem::path dir;
+    for(const auto& entry : std::filesystem::directory_iterator(spoolDir)) dir = entry.path();
+    const auto claimedDir = dir.string() + ".claimed";
+    std::filesystem::rename(dir, claimedDir);
+    std::filesystem::last_write_time(claimedDir, std::filesystem::file_time_type::clock::now() - std::chrono::hours(2));
+
+    LogServer server;
+    LogUploader uploader(makeConfig(server.url(), spoolDir));
+    REQUIRE(uploader.waitIdle(10s));
+    REQUIRE(server.received.size() == 1);
+    REQUIRE(server.received[0].pipelineId == "claimed");
+    REQUIRE(numSpooled(spoolDir) == 0);
+    std::filesystem::remove_all(spoolDir);
+}
+
+TEST_CASE("LogUploader enforces size caps") {
+    const auto spoolDir = makeSpoolDir("caps");
+    LogServer unavailable([](int) { return 503; });
+    auto config = makeConfig(unavailable.url(), spoolDir);
+    config.compress = false;
+    config.baseDelay = 10s;
+    config.maxUploadSize = 1000;
+    config.maxSpoolSize = 2500;
+    LogUploader uploader(config);
+
+    REQUIRE_FALSE(uploader.enqueue(makeUpload("too_large", std::string(1001, 'x'))));
+    for(int i = 0; i < 5; i++) {
+        REQUIRE(uploader.enqueue(makeUpload(std::to_string(i), std::string(1000, 'x'))));
+    }
+    // The oldest ones are dropped, apart from one that may be uploading
+    REQUIRE(uploader.getNumPending() <= 3);
+    REQUIRE(numSpooled(spoolDir) == uploader.getNumPending());
+    std::filesystem::remove_all(spoolDir);
+}
+
+TEST_CASE("LogUploader doesn't wait for stalled uploads when stopping") {
+    LogServer server;
+    server.holdRequests();
+    const auto spoolDir = makeSpoolDir("stop");
+    auto uploader = std::make_unique<LogUploader>(makeConfig(server.url(), spoolDir));
+    REQUIRE(uploader->enqueue(makeUpload("stalled", "{}")));
+    REQUIRE(server.waitForRequests(1));
+
+    const auto start = std::chrono::steady_clock::now();
+    uploader.reset();
+    REQUIRE(std::chrono::steady_clock::now() - start < 3s);
+    // Kept for the next run
+    REQUIRE(numSpooled(spoolDir) == 1);
+    server.release();
+    std::filesystem::remove_all(spoolDir);
+}
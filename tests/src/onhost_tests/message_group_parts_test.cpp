@@ -0,0 +1,157 @@
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "depthai/pipeline/datatype/Buffer.hpp"
+#include "depthai/pipeline/datatype/MessageGroup.hpp"
+#include "depthai/utility/Serialization.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+std::shared_ptr<dai::Buffer> bufferAt(std::chrono::milliseconds tsDevice) {
+    auto buffer = std::make_shared<dai::Buffer>();
+    buffer->setTimestampDevice(std::chrono::steady_clock::time_point(tsDevice));
+    return buffer;
+}
+
+// The layout MessageGroup had when the parts were stored in a std::map
+struct MapMessageGroup {
+    std::map<std::string, std::shared_ptr<dai::ADatatype>> group;
+    dai::Timestamp ts = {};
+    dai::Timestamp tsDevice = {};
+    int64_t sequenceNum = 0;
+    DEPTHAI_SERIALIZE(MapMessageGroup, group, ts, tsDevice, sequenceNum);
+};
+
+}  // namespace
+
+TEST_CASE("Parts iterate by name like a map") {
+    dai::MessageGroup group;
+    auto right = bufferAt(3ms);
+    auto left = bufferAt(1ms);
+    auto rgb = bufferAt(2ms);
+    group.add("right", right);
+    group.add("left", left);
+    group.add("rgb", rgb);
+
+    std::vector<std::string> names;
+    for(const auto& [name, msg] : group) names.push_back(name);
+    REQUIRE(names == std::vector<std::string>{"left", "rgb", "right"});
+    REQUIRE(group.getMessageNames() == names);
+    REQUIRE(group.getNumMessages() == 3);
+
+    REQUIRE(group["left"] == left);
+    REQUIRE(group.get<dai::Buffer>("rgb") == rgb);
+    REQUIRE(group.group.at("right") == right);
+    REQUIRE_THROWS_AS(group["depth"], std::out_of_range);
+    REQUIRE(group.group.count("depth") == 0);
+
+    // Replacing keeps a single part
+    auto newLeft = bufferAt(1ms);
+    group.add("left", newLeft);
+    REQUIRE(group.getNumMessages() == 3);
+    REQUIRE(group["left"] == newLeft);
+
+    // Parts can be replaced through the iterators, as the device parser does
+    for(auto& part : group.group) part.second = nullptr;
+    REQUIRE(group.group.at("rgb") == nullptr);
+    REQUIRE(group.group.erase("rgb") == 1);
+    REQUIRE(group.getMessageNames() == std::vector<std::string>{"left", "right"});
+}
+
+TEST_CASE("Interval follows added and replaced parts") {
+    dai::MessageGroup group;
+    REQUIRE(group.getIntervalNs() == 0);
+    group.add("a", bufferAt(10ms));
+    REQUIRE(group.getIntervalNs() == 0);
+    group.add("b", bufferAt(14ms));
+    group.add("c", bufferAt(12ms));
+    REQUIRE(group.getIntervalNs() == std::chrono::nanoseconds(4ms).count());
+    REQUIRE(group.isSynced(std::chrono::nanoseconds(4ms).count()));
+    REQUIRE_FALSE(group.isSynced(std::chrono::nanoseconds(3ms).count()));
+
+    // Replacing the latest part shrinks the interval
+    group.add("b", bufferAt(11ms));
+    REQUIRE(group.getIntervalNs() == std::chrono::nanoseconds(2ms).count());
+
+    // Parts set without add() are still accounted for
+    group.group["d"] = bufferAt(20ms);
+    REQUIRE(group.getIntervalNs() == std::chrono::nanoseconds(10ms).count());
+
+    // Parts which aren't a Buffer don't count
+    group.add("e", std::make_shared<dai::ADatatype>());
+    REQUIRE(group.getIntervalNs() == std::chrono::nanoseconds(10ms).count());
+}
+
+TEST_CASE("Interval follows parts changed after being added") {
+    dai::MessageGroup group;
+    auto a = bufferAt(10ms);
+    group.add("a", a);
+    group.add("b", bufferAt(12ms));
+    REQUIRE(group.getIntervalNs() == std::chrono::nanoseconds(2ms).count());
+
+    a->setTimestampDevice(std::chrono::steady_clock::time_point(5ms));
+    REQUIRE(group.getIntervalNs() == std::chrono::nanoseconds(7ms).count());
+    REQUIRE_FALSE(group.isSynced(std::chrono::nanoseconds(2ms).count()));
+
+    a->setTimestampDevice(std::chrono::steady_clock::time_point(12ms));
+    REQUIRE(group.getIntervalNs() == 0);
+}
+
+TEST_CASE("Serialization matches the map layout") {
+    dai::MessageGroup group;
+    group.add("right", bufferAt(3ms));
+    group.add("left", bufferAt(1ms));
+    group.setSequenceNum(42);
+    group.setTimestampDevice(std::chrono::steady_clock::time_point(3ms));
+
+    MapMessageGroup mapGroup;
+    mapGroup.group = {{"left", nullptr}, {"right", nullptr}};
+    mapGroup.tsDevice = group.tsDevice;
+    mapGroup.sequenceNum = 42;
+
+    REQUIRE(dai::utility::serialize(group) == dai::utility::serialize(mapGroup));
+    auto json = nlohmann::json(group);
+    REQUIRE(json["group"] == nlohmann::json(mapGroup.group));
+
+    dai::MessageGroup parsed;
+    REQUIRE(dai::utility::deserialize(dai::utility::serialize(group), parsed));
+    REQUIRE(parsed.getMessageNames() == std::vector<std::string>{"left", "right"});
+    REQUIRE(parsed.getSequenceNum() == 42);
+
+    auto fromJson = json.get<dai::MessageGroup>();
+    REQUIRE(fromJson.getMessageNames() == std::vector<std::string>{"left", "right"});
+}
+
+TEST_CASE("Pooled groups are reused once released") {
+    dai::MessageGroupPool pool(1);
+    auto first = pool.acquire();
+    dai::MessageGroup* firstAddress = first.get();
+    first->add("a", bufferAt(1ms));
+    first->setSequenceNum(7);
+    auto second = pool.acquire();
+    REQUIRE(second.get() != firstAddress);
+
+    first.reset();
+    second.reset();
+    // Only one group is kept
+    REQUIRE(pool.getNumIdle() == 1);
+
+    auto reused = pool.acquire();
+    REQUIRE(reused.get() == firstAddress);
+    REQUIRE(reused->getNumMessages() == 0);
+    REQUIRE(reused->getSequenceNum() == 0);
+    REQUIRE(reused->getIntervalNs() == 0);
+    REQUIRE(pool.getNumIdle() == 0);
+
+    // Groups outliving the pool are deleted normally
+    auto outliving = std::make_unique<dai::MessageGroupPool>()->acquire();
+    outliving->add("a", bufferAt(1ms));
+    outliving.reset();
+}
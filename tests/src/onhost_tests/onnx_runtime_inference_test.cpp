@@ -0,0 +1,129 @@
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "depthai/pipeline/datatype/NNData.hpp"
+#include "utility/OnnxRuntimeInference.hpp"
+
+namespace {
+
+// Alignment of the tensors in NNData
+constexpr unsigned TENSOR_ALIGNMENT = 64;
+
+// Minimal protobuf encoding, enough to write a small ONNX model
+void writeVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    while(value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+void writeInt(std::vector<std::uint8_t>& out, int field, std::uint64_t value) {
+    writeVarint(out, static_cast<std::uint64_t>(field) << 3);
+    writeVarint(out, value);
+}
+
+void writeBytes(std::vector<std::uint8_t>& out, int field, const std::vector<std::uint8_t>& bytes) {
+    writeVarint(out, (static_cast<std::uint64_t>(field) << 3) | 2);
+    writeVarint(out, bytes.size());
+    out.insert(out.end(), bytes.begin(), bytes.end());
+}
+
+void writeString(std::vector<std::uint8_t>& out, int field, const std::string& value) {
+    writeBytes(out, field, std::vector<std::uint8_t>(value.begin(), value.end()));
+}
+
+// ValueInfoProto of a float tensor of shape [N, width], with a dynamic batch dimension
+std::vector<std::uint8_t> floatTensorInfo(const std::string& name, int width) {
+    std::vector<std::uint8_t> batchDim, widthDim, shape, tensorType, type, info;
+    writeString(batchDim, 2, "N");
+    writeInt(widthDim, 1, width);
+    writeBytes(shape, 1, batchDim);
+    writeBytes(shape, 1, widthDim);
+    writeInt(tensorType, 1, 1);  // FLOAT
+    writeBytes(tensorType, 2, shape);
+    writeBytes(type, 1, tensorType);
+    writeString(info, 1, name);
+    writeBytes(info, 2, type);
+    return info;
+}
+
+std::vector<std::uint8_t> node(const std::string& opType, const std::string& input, const std::string& output) {
+    std::vector<std::uint8_t> out;
+    writeString(out, 1, input);
+    writeString(out, 2, output);
+    writeString(out, 4, opType);
+    return out;
+}
+
+// Model with input x [N, 4] and outputs a = x and b = -x
+std::vector<std::uint8_t> makeModel() {
+    std::vector<std::uint8_t> graph, opset, model;
+    writeBytes(graph, 1, node("Identity", "x", "a"));
+    writeBytes(graph, 1, node("Neg", "x", "b"));
+    writeString(graph, 2, "test");
+    writeBytes(graph, 11, floatTensorInfo("x", 4));
+    writeBytes(graph, 12, floatTensorInfo("a", 4));
+    writeBytes(graph, 12, floatTensorInfo("b", 4));
+    writeInt(opset, 2, 13);
+    writeInt(model, 1, 7);  // IR version
+    writeBytes(model, 7, graph);
+    writeBytes(model, 8, opset);
+    return model;
+}
+
+std::shared_ptr<dai::NNData> makeInput(int item) {
+    auto data = std::make_shared<dai::NNData>();
+    data->addTensor("x", std::vector<float>{1.0f * item, 2.0f * item, 3.0f * item, 4.0f * item});
+    data->setSequenceNum(item);
+    return data;
+}
+
+}  // namespace
+
+TEST_CASE("Batches are split into one message per input") {
+    const auto model = makeModel();
+    dai::impl::OnnxRuntimeInference inference(model, 1, {});
+    REQUIRE(inference.getMaxBatchSize() > 1);
+    REQUIRE(inference.getInputNames() == std::vector<std::string>{"x"});
+
+    for(const int batchSize : {1, 3}) {
+        std::vector<std::shared_ptr<dai::Buffer>> batch;
+        for(int i = 0; i < batchSize; i++) batch.push_back(makeInput(i + 1));
+        const auto results = inference.infer(batch);
+        REQUIRE(results.size() == batch.size());
+
+        for(int i = 0; i < batchSize; i++) {
+            const auto& result = results[i];
+            REQUIRE(result->getSequenceNum() == i + 1);
+            // Each message holds only its own tensors, each output aligned
+            REQUIRE(result->getData().size() == 2 * TENSOR_ALIGNMENT);
+            REQUIRE(result->getTensorInfo("a")->offset == 0);
+            REQUIRE(result->getTensorInfo("b")->offset == TENSOR_ALIGNMENT);
+            REQUIRE(result->getTensorInfo("a")->dims == std::vector<unsigned>{1, 4});
+
+            const auto a = result->getTensor<float>("a");
+            const auto b = result->getTensor<float>("b");
+            for(int e = 0; e < 4; e++) {
+                REQUIRE(a(0, e) == Catch::Approx((e + 1) * (i + 1)));
+                REQUIRE(b(0, e) == Catch::Approx(-(e + 1) * (i + 1)));
+            }
+        }
+    }
+}
+
+TEST_CASE("Inferred messages can be extended") {
+    const auto model = makeModel();
+    dai::impl::OnnxRuntimeInference inference(model, 1, {});
+    const auto results = inference.infer({makeInput(1), makeInput(2)});
+
+    results[0]->addTensor("extra", std::vector<float>{5.0f, 6.0f});
+    REQUIRE(results[0]->getTensor<float>("extra")(0, 1) == Catch::Approx(6.0f));
+    REQUIRE(results[0]->getTensor<float>("a")(0, 3) == Catch::Approx(4.0f));
+    // The other message of the batch is unaffected
+    REQUIRE_FALSE(results[1]->getTensorInfo("extra").has_value());
+    REQUIRE(results[1]->getTensor<float>("b")(0, 3) == Catch::Approx(-8.0f));
+}
@@ -0,0 +1,140 @@
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <numeric>
+#include <vector>
+
+#include "depthai/pipeline/AssetManager.hpp"
+#include "depthai/pipeline/Pipeline.hpp"
+
+// Track heap usage of the whole test binary, to measure the peak memory of asset serialization
+namespace {
+std::atomic<std::size_t> currentBytes{0};
+std::atomic<std::size_t> peakBytes{0};
+constexpr std::size_t HEADER = alignof(std::max_align_t);
+
+void resetPeak() {
+    peakBytes = currentBytes.load();
+}
+std::size_t peakIncrease(std::size_t baseline) {
+    return peakBytes - baseline;
+}
+}  // namespace
+
+void* operator new(std::size_t size) {
+    auto* p = static_cast<char*>(std::malloc(size + HEADER));
+    if(p == nullptr) throw std::bad_alloc();
+    *reinterpret_cast<std::size_t*>(p) = size;
+    auto now = currentBytes += size;
+    auto peak = peakBytes.load();
+    while(now > peak && !peakBytes.compare_exchange_weak(peak, now)) {
+    }
+    return p + HEADER;
+}
+void operator delete(void* ptr) noexcept {
+    if(ptr == nullptr) return;
+    auto* p = static_cast<char*>(ptr) - HEADER;
+    currentBytes -= *reinterpret_cast<std::size_t*>(p);
+    std::free(p);
+}
+void operator delete(void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+namespace {
+
+constexpr std::size_t MB = 1024 * 1024;
+
+std::vector<std::uint8_t> syntheticAsset(std::size_t size, std::uint8_t seed) {
+    std::vector<std::uint8_t> data(size);
+    for(std::size_t i = 0; i < size; i++) data[i] = static_cast<std::uint8_t>(i * 31 + seed);
+    return data;
+}
+
+}  // namespace
+
+TEST_CASE("AssetScatterList matches contiguous serialization") {
+    dai::AssetManager manager;
+    manager.set("a", syntheticAsset(1000, 1), 64);
+    manager.set("b", syntheticAsset(3, 2), 1);
+    manager.set("c", std::vector<std::uint8_t>{}, 64);
+    manager.set("d", syntheticAsset(4097, 3), 4096);
+
+    dai::AssetsMutable vectorAssets, scatterAssets;
+    std::vector<std::uint8_t> storage;
+    manager.serialize(vectorAssets, storage, "/p/");
+    dai::AssetScatterList scatterList;
+    manager.serialize(scatterAssets, scatterList, "/p/");
+
+    REQUIRE(scatterList.size() == storage.size());
+    REQUIRE(scatterList.toVector() == storage);
+    for(const auto& kv : vectorAssets.map) {
+        REQUIRE(scatterAssets.map.at(kv.first).offset == kv.second.offset);
+        REQUIRE(scatterAssets.map.at(kv.first).size == kv.second.size);
+    }
+
+    // Entries reference the assets' own data
+    REQUIRE(scatterList.getEntries().front().data.data() == manager.get("a")->data.data());
+
+    // Streamed packets concatenate to the same storage, for packet sizes hitting and straddling boundaries
+    for(std::size_t packetSize : {1, 7, 64, 1000, 4096, 100000}) {
+        std::vector<std::uint8_t> streamed;
+        std::size_t numPackets = 0;
+        scatterList.stream(packetSize, [&](dai::span<const std::uint8_t> packet) {
+            REQUIRE(packet.size() <= packetSize);
+            streamed.insert(streamed.end(), packet.begin(), packet.end());
+            numPackets++;
+        });
+        REQUIRE(streamed == storage);
+        REQUIRE(numPackets == (storage.size() + packetSize - 1) / packetSize);
+    }
+}
+
+TEST_CASE("Pipeline asset serialization peak memory") {
+    constexpr std::size_t ASSET_SIZE = 32 * MB;
+    constexpr std::size_t NUM_ASSETS = 4;
+    constexpr std::size_t PACKET_SIZE = 5 * MB;
+
+    dai::Pipeline pipeline(false);
+    for(std::size_t i = 0; i < NUM_ASSETS; i++) {
+        pipeline.getAssetManager().set("blob" + std::to_string(i), syntheticAsset(ASSET_SIZE, static_cast<std::uint8_t>(i)));
+    }
+
+    // Scatter list, streamed in packets as on pipeline start
+    std::uint64_t streamedSum = 0;
+    std::size_t baseline = currentBytes;
+    resetPeak();
+    {
+        dai::PipelineSchema schema;
+        dai::Assets assets;
+        dai::AssetScatterList assetStorage;
+        pipeline.serialize(schema, assets, assetStorage);
+        REQUIRE(assetStorage.size() >= NUM_ASSETS * ASSET_SIZE);
+        assetStorage.stream(PACKET_SIZE, [&](dai::span<const std::uint8_t> packet) {
+            streamedSum = std::accumulate(packet.begin(), packet.end(), streamedSum);
+        });
+    }
+    const auto scatterPeak = peakIncrease(baseline);
+
+    // Contiguous storage
+    std::uint64_t contiguousSum = 0;
+    baseline = currentBytes;
+    resetPeak();
+    {
+        dai::PipelineSchema schema;
+        dai::Assets assets;
+        std::vector<std::uint8_t> assetStorage;
+        pipeline.serialize(schema, assets, assetStorage);
+        contiguousSum = std::accumulate(assetStorage.begin(), assetStorage.end(), contiguousSum);
+    }
+    const auto contiguousPeak = peakIncrease(baseline);
+
+    INFO("Peak memory increase: scatter list " << scatterPeak / MB << " MB, contiguous " << contiguousPeak / MB << " MB");
+    REQUIRE(streamedSum == contiguousSum);
+    REQUIRE(contiguousPeak >= NUM_ASSETS * ASSET_SIZE);
+    // At most one staging packet, independent of asset sizes
+    REQUIRE(scatterPeak < PACKET_SIZE + 4 * MB);
+}
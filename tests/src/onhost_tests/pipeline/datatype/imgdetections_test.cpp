@@ -273,6 +273,87 @@ TEST_CASE("ImgDetections segmentation mask operations", "[ImgDetections][Segment
         REQUIRE_THROWS_AS(detections.setSegmentationMask(mask, 4, 4), std::runtime_error);
     }
 
+    SECTION("Run-length encoding round trips") {
+        ImgDetections detections;
+        const std::size_t width = 5;
+        const std::size_t height = 3;
+        // Instance 1 continues over the end of the first row
+        const std::vector<uint8_t> mask = {255, 0, 0, 1, 1, 1, 1, 255, 255, 2, 2, 255, 255, 255, 2};
+        detections.setSegmentationMask(mask, width, height);
+
+        const auto rle = detections.getSegmentationMaskRLE();
+        REQUIRE(rle.has_value());
+        REQUIRE(rle->width == width);
+        REQUIRE(rle->height == height);
+        REQUIRE(rle->runs.size() == 4);
+        REQUIRE(rle->runs[1].offset == 3);
+        REQUIRE(rle->runs[1].length == 4);
+        REQUIRE(rle->runs[1].value == 1);
+
+        ImgDetections decoded;
+        decoded.setSegmentationMask(*rle);
+        REQUIRE(decoded.getSegmentationMaskWidth() == width);
+        REQUIRE(decoded.getSegmentationMaskHeight() == height);
+        REQUIRE(decoded.getMaskData() == mask);
+
+        SegmentationMaskRLE outOfBounds = *rle;
+        outOfBounds.runs.back().length = 2;
+        REQUIRE_THROWS_AS(decoded.setSegmentationMask(outOfBounds), std::runtime_error);
+        REQUIRE_FALSE(ImgDetections{}.getSegmentationMaskRLE().has_value());
+    }
+
+    SECTION("Instance bounds match a full scan") {
+        ImgDetections detections;
+        const std::size_t width = 13;
+        const std::size_t height = 7;
+        std::vector<uint8_t> mask(width * height, 255);
+        for(std::size_t i = 0; i < mask.size(); ++i) {
+            if(i % 3 != 0) mask[i] = static_cast<uint8_t>((i * 7) % 11);
+        }
+        detections.setSegmentationMask(mask, width, height);
+
+        const auto bounds = detections.getSegmentationMaskBounds();
+        std::size_t previousIndex = 0;
+        for(const auto& b : bounds) {
+            REQUIRE((&b == &bounds.front() || b.index > previousIndex));
+            previousIndex = b.index;
+            std::size_t minX = width, minY = height, maxX = 0, maxY = 0, area = 0;
+            for(std::size_t y = 0; y < height; ++y) {
+                for(std::size_t x = 0; x < width; ++x) {
+                    if(mask[y * width + x] != b.index) continue;
+                    minX = std::min(minX, x);
+                    minY = std::min(minY, y);
+                    maxX = std::max(maxX, x);
+                    maxY = std::max(maxY, y);
+                    ++area;
+                }
+            }
+            REQUIRE(area > 0);
+            REQUIRE(b.area == area);
+            REQUIRE(b.x == minX);
+            REQUIRE(b.y == minY);
+            REQUIRE(b.width == maxX - minX + 1);
+            REQUIRE(b.height == maxY - minY + 1);
+        }
+        REQUIRE(bounds.size() == 11);
+    }
+
+    SECTION("Mask data view and moved masks avoid copies") {
+        ImgDetections detections;
+        const std::size_t width = 4;
+        const std::size_t height = 3;
+        auto mask = makeSequentialMask(width, height);
+        const auto expected = mask;
+        const auto* storage = mask.data();
+
+        detections.setSegmentationMask(std::move(mask), width, height);
+        const auto view = detections.getMaskDataView();
+        REQUIRE(view.data() == storage);
+        REQUIRE(std::equal(view.begin(), view.end(), expected.begin(), expected.end()));
+        REQUIRE(ImgDetections{}.getMaskDataView().empty());
+        REQUIRE_THROWS_AS(detections.setSegmentationMask(std::vector<uint8_t>(3), width, height), std::runtime_error);
+    }
+
 #ifdef DEPTHAI_HAVE_OPENCV_SUPPORT
     SECTION("OpenCV segmentation mask copy semantics") {
         ImgDetections detections;
@@ -408,5 +489,44 @@ TEST_CASE("ImgDetections segmentation mask operations", "[ImgDetections][Segment
         cv::compare(missingClass, 255, allBackground, cv::CmpTypes::CMP_EQ);
         REQUIRE(cv::countNonZero(allBackground) == missingClass.rows * missingClass.cols);
     }
+
+    SECTION("OpenCV instance masks match per index extraction") {
+        ImgDetections detections;
+        constexpr int rows = 48;
+        constexpr int cols = 64;
+        constexpr int instances = 60;
+        cv::Mat mask(rows, cols, CV_8UC1, cv::Scalar(255));
+        for(int i = 0; i < instances; ++i) {
+            const int x = (i * 13) % (cols - 6);
+            const int y = (i * 7) % (rows - 4);
+            cv::rectangle(mask, cv::Rect(x, y, 6, 4), cv::Scalar(i), cv::FILLED);
+        }
+        detections.setCvSegmentationMask(mask);
+        detections.detections.resize(instances + 1);
+        for(int i = 0; i <= instances; ++i) detections.detections[i].label = i % 5;
+
+        const auto view = detections.getCvSegmentationMaskView();
+        REQUIRE(view.has_value());
+        REQUIRE(cv::countNonZero(*view != mask) == 0);
+
+        const auto instanceMasks = detections.getCvInstanceSegmentationMasks();
+        REQUIRE(instanceMasks.size() == detections.detections.size());
+        for(int i = 0; i <= instances; ++i) {
+            const auto byIndex = detections.getCvSegmentationMaskByIndex(static_cast<uint8_t>(i));
+            REQUIRE(byIndex.has_value());
+            REQUIRE(instanceMasks[i].type() == CV_8UC1);
+            REQUIRE(cv::countNonZero(instanceMasks[i] != *byIndex) == 0);
+        }
+
+        for(int semanticClass = 0; semanticClass < 6; ++semanticClass) {
+            cv::Mat expected(rows, cols, CV_8UC1, cv::Scalar(255));
+            for(std::size_t i = 0; i < detections.detections.size(); ++i) {
+                if(detections.detections[i].label == semanticClass) expected.setTo(0, mask == static_cast<int>(i));
+            }
+            const auto byClass = detections.getCvSegmentationMaskByClass(static_cast<uint8_t>(semanticClass));
+            REQUIRE(byClass.has_value());
+            REQUIRE(cv::countNonZero(*byClass != expected) == 0);
+        }
+    }
 #endif
 }
@@ -0,0 +1,86 @@
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+
+#include "depthai/pipeline/InputQueue.hpp"
+#include "depthai/pipeline/Pipeline.hpp"
+#include "depthai/pipeline/ThreadedHostNode.hpp"
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+#include "depthai/pipeline/node/BenchmarkOut.hpp"
+#include "depthai/utility/Clock.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+class Idle : public dai::node::CustomThreadedNode<Idle> {
+   public:
+    void run() override {}
+};
+
+}  // namespace
+
+TEST_CASE("Simulated clock only moves forward when advanced") {
+    const dai::PipelineClock::time_point start(10s);
+    dai::SimulatedPipelineClock clock(start);
+    REQUIRE(clock.isSimulated());
+    REQUIRE(clock.now() == start);
+
+    clock.advance(5ms);
+    REQUIRE(clock.now() == start + 5ms);
+    clock.advanceTo(start + 2ms);
+    REQUIRE(clock.now() == start + 5ms);
+    clock.advance(-1ms);
+    REQUIRE(clock.now() == start + 5ms);
+
+    // Sleeping advances the time instead of blocking
+    const auto wallStart = std::chrono::steady_clock::now();
+    clock.sleepFor(1h);
+    clock.sleepUntil(start + 2h);
+    REQUIRE(clock.now() == start + 2h);
+    REQUIRE(std::chrono::steady_clock::now() - wallStart < 1s);
+}
+
+TEST_CASE("Pipeline distributes its clock to the host nodes") {
+    dai::Pipeline p(false);
+    auto idle = p.create<Idle>();
+    REQUIRE(p.getClock() == dai::PipelineClock::steady());
+    REQUIRE(idle->getClock() == dai::PipelineClock::steady());
+    REQUIRE_FALSE(idle->getClock()->isSimulated());
+
+    auto clock = std::make_shared<dai::SimulatedPipelineClock>();
+    p.setClock(clock);
+    REQUIRE(idle->getClock() == clock);
+    REQUIRE_THROWS_AS(p.setClock(nullptr), std::invalid_argument);
+
+    p.start();
+    REQUIRE_THROWS_AS(p.setClock(dai::PipelineClock::steady()), std::runtime_error);
+    p.stop();
+}
+
+TEST_CASE("Host BenchmarkOut paces and timestamps by a simulated clock") {
+    dai::Pipeline p(false);
+    auto clock = std::make_shared<dai::SimulatedPipelineClock>(dai::PipelineClock::time_point(1s));
+    p.setClock(clock);
+
+    auto benchmarkOut = p.create<dai::node::BenchmarkOut>();
+    benchmarkOut->setRunOnHost(true);
+    // Would take ten seconds on the steady clock
+    benchmarkOut->setFps(1.0f);
+    benchmarkOut->setNumMessagesToSend(10);
+    auto input = benchmarkOut->input.createInputQueue();
+    auto output = benchmarkOut->out.createOutputQueue(16, true);
+
+    const auto wallStart = std::chrono::steady_clock::now();
+    p.start();
+    input->send(std::make_shared<dai::ImgFrame>());
+    for(int i = 0; i < 10; i++) {
+        auto frame = output->get<dai::ImgFrame>();
+        REQUIRE(frame != nullptr);
+        REQUIRE(frame->getTimestamp() == dai::PipelineClock::time_point(1s + std::chrono::seconds(i)));
+    }
+    p.stop();
+    REQUIRE(std::chrono::steady_clock::now() - wallStart < 5s);
+    REQUIRE(clock->now() == dai::PipelineClock::time_point(11s));
+}
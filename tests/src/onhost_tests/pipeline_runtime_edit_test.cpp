@@ -0,0 +1,187 @@
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "depthai/pipeline/InputQueue.hpp"
+#include "depthai/pipeline/Pipeline.hpp"
+#include "depthai/pipeline/ThreadedHostNode.hpp"
+#include "depthai/pipeline/datatype/Buffer.hpp"
+#include "test_nodes.hpp"
+
+using namespace std::chrono_literals;
+using test::Source;
+using test::makeBuffer;
+
+namespace {
+
+// Keeps sending messages with increasing sequence numbers
+class Generator : public dai::node::CustomThreadedNode<Generator> {
+   public:
+    Output out{*this, {"out", DEFAULT_GROUP, {{{dai::DatatypeEnum::Buffer, true}}}}};
+
+    void run() override {
+        for(int64_t i = 0; isRunning(); i++) {
+            auto buffer = std::make_shared<dai::Buffer>();
+            buffer->setSequenceNum(i);
+            out.send(buffer);
+            std::this_thread::sleep_for(1ms);
+        }
+    }
+};
+
+class Passthrough : public dai::node::CustomThreadedNode<Passthrough> {
+   public:
+    Input input{*this, {"input", DEFAULT_GROUP, true, 8, {{{dai::DatatypeEnum::Buffer, true}}}, DEFAULT_WAIT_FOR_MESSAGE}};
+    Output out{*this, {"out", DEFAULT_GROUP, {{{dai::DatatypeEnum::Buffer, true}}}}};
+    std::chrono::milliseconds delay{0};
+    std::atomic<int> processed{0};
+
+    void run() override {
+        while(isRunning()) {
+            auto buffer = input.get<dai::Buffer>();
+            std::this_thread::sleep_for(delay);
+            processed++;
+            out.send(buffer);
+        }
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Host nodes are added and relinked while running") {
+    dai::Pipeline p(false);
+    auto generator = p.create<Generator>();
+    auto first = p.create<Passthrough>();
+    generator->out.link(first->input);
+    auto firstQueue = first->out.createOutputQueue(8, false);
+    p.start();
+    REQUIRE(firstQueue->get<dai::Buffer>() != nullptr);
+
+    // Added nodes and queues start with the next start call
+    auto second = p.create<Passthrough>();
+    generator->out.link(second->input);
+    auto secondQueue = second->out.createOutputQueue(8, false);
+    REQUIRE_FALSE(second->isRunning());
+    p.start();
+    REQUIRE(second->isRunning());
+    const auto previous = secondQueue->get<dai::Buffer>()->getSequenceNum();
+    REQUIRE(secondQueue->get<dai::Buffer>()->getSequenceNum() > previous);
+
+    // The unlinked node doesn't get anything new
+    generator->out.unlink(first->input);
+    std::this_thread::sleep_for(50ms);
+    firstQueue->tryGetAll();
+    std::this_thread::sleep_for(50ms);
+    REQUIRE(firstQueue->tryGet() == nullptr);
+    REQUIRE(secondQueue->get<dai::Buffer>() != nullptr);
+
+    // And an input queue created while running feeds it again
+    auto input = first->input.createInputQueue();
+    p.start();
+    input->send(makeBuffer(-1));
+    REQUIRE(firstQueue->get<dai::Buffer>()->getSequenceNum() == -1);
+    p.stop();
+}
+
+TEST_CASE("A removed node processes the messages already sent to it") {
+    dai::Pipeline p(false);
+    auto source = p.create<Source>();
+    auto slow = p.create<Passthrough>();
+    slow->delay = 5ms;
+    source->out.link(slow->input);
+    auto queue = slow->out.createOutputQueue(16, true);
+    p.start();
+
+    for(int i = 0; i < 8; i++) source->out.send(makeBuffer(i));
+    p.remove(slow);
+    REQUIRE(slow->processed == 8);
+    REQUIRE_FALSE(slow->isRunning());
+    REQUIRE(queue->isClosed());
+    REQUIRE(source->out.getConnections().empty());
+    for(const auto& node : p.getAllNodes()) REQUIRE(node != slow);
+
+    // Sending goes on without the removed node
+    source->out.send(makeBuffer(8));
+    p.stop();
+}
+
+TEST_CASE("Removing a node releases a sender waiting on it") {
+    dai::Pipeline p(false);
+    auto source = p.create<Source>();
+    auto slow = p.create<Passthrough>();
+    slow->delay = 20ms;
+    slow->input.setMaxSize(1);
+    source->out.link(slow->input);
+    p.start();
+
+    std::atomic<bool> sent{false};
+    std::thread sender([&]() {
+        for(int i = 0; i < 20; i++) source->out.send(makeBuffer(i));
+        sent = true;
+    });
+    std::this_thread::sleep_for(50ms);
+    REQUIRE_FALSE(sent);
+    p.remove(slow);
+    sender.join();
+    REQUIRE(sent);
+    REQUIRE(slow->processed < 20);
+    p.stop();
+}
+
+TEST_CASE("A producer keeps running when a removed node outlasts the drain") {
+    dai::Pipeline p(false);
+    auto generator = p.create<Generator>();
+    auto slow = p.create<Passthrough>();
+    slow->delay = 1500ms;
+    slow->input.setMaxSize(1);
+    generator->out.link(slow->input);
+    auto queue = generator->out.createOutputQueue(4, false);
+    p.start();
+
+    // The generator is blocked on the full input when the removed node gets closed
+    std::this_thread::sleep_for(50ms);
+    p.remove(slow);
+    queue->tryGetAll();
+    bool timedOut = false;
+    const auto previous = queue->get<dai::Buffer>(1s, timedOut);
+    REQUIRE_FALSE(timedOut);
+    const auto next = queue->get<dai::Buffer>(1s, timedOut);
+    REQUIRE_FALSE(timedOut);
+    REQUIRE(next->getSequenceNum() > previous->getSequenceNum());
+    REQUIRE(generator->isRunning());
+    p.stop();
+}
+
+TEST_CASE("Removing a node doesn't hold up other changes of the pipeline") {
+    dai::Pipeline p(false);
+    auto generator = p.create<Generator>();
+    auto slow = p.create<Passthrough>();
+    slow->delay = 1500ms;
+    slow->input.setMaxSize(1);
+    generator->out.link(slow->input);
+    p.start();
+
+    std::this_thread::sleep_for(50ms);
+    std::thread remover([&]() { p.remove(slow); });
+    std::this_thread::sleep_for(50ms);
+    const auto start = std::chrono::steady_clock::now();
+    auto added = p.create<Passthrough>();
+    generator->out.link(added->input);
+    p.start();
+    REQUIRE(std::chrono::steady_clock::now() - start < 500ms);
+    REQUIRE(added->isRunning());
+    remover.join();
+
+    // Once nothing sends to it anymore, the pipeline doesn't keep the removed node
+    std::weak_ptr<Passthrough> removed = slow;
+    slow.reset();
+    const auto deadline = std::chrono::steady_clock::now() + 1s;
+    do {
+        std::this_thread::sleep_for(1ms);
+        p.start();
+    } while(!removed.expired() && std::chrono::steady_clock::now() < deadline);
+    REQUIRE(removed.expired());
+    p.stop();
+}
@@ -1,11 +1,15 @@
 #include "depthai/pipeline/node/host/Replay.hpp"
 
+#include <algorithm>
 #include <catch2/catch_all.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <cstdlib>
 #include <ctime>
 #include <exception>
 #include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "../../src/utility/Platform.hpp"
 #include "depthai/depthai.hpp"
@@ -112,3 +116,92 @@ TEST_CASE("ReplayVideo no metadata") {
         p.stop();
     }
 }
+
+TEST_CASE("Replay nodes from an archive") {
+    {
+        // Replayed in place - nothing but the index is written next to the archive
+        const auto testFolder = std::filesystem::path(dai::platform::getTempPath()).append("replay_archive");
+        std::filesystem::create_directories(testFolder);
+        const auto archive = std::filesystem::path(testFolder).append("recording.tar");
+        std::filesystem::copy_file(RECORDING_PATH, archive);
+
+        dai::Pipeline p(false);
+
+        auto replayVideo = p.create<dai::node::ReplayVideo>();
+        replayVideo->setReplayArchive(archive);
+        replayVideo->setReplayMetadataFile("CameraCAM_A.mcap");
+        replayVideo->setReplayVideoFile("CameraCAM_A.mp4");
+        replayVideo->setLoop(true);
+        auto replayImu = p.create<dai::node::ReplayMetadataOnly>();
+        replayImu->setReplayArchive(archive);
+        replayImu->setReplayFile("IMU.mcap");
+        replayImu->setLoop(true);
+
+        auto videoQueue = replayVideo->out.createOutputQueue();
+        auto imuQueue = replayImu->out.createOutputQueue();
+
+        p.start();
+        for(auto i = 0U; i < NUM_MSGS; i++) {
+            if(!p.isRunning()) break;
+            REQUIRE(videoQueue->get<dai::ImgFrame>() != nullptr);
+            REQUIRE(imuQueue->get<dai::IMUData>() != nullptr);
+        }
+        p.stop();
+
+        std::vector<std::filesystem::path> files;
+        for(const auto& entry : std::filesystem::directory_iterator(testFolder)) files.push_back(entry.path().filename());
+        std::sort(files.begin(), files.end());
+        REQUIRE(files == std::vector<std::filesystem::path>{"recording.tar", "recording.tar.index"});
+        std::filesystem::remove_all(testFolder);
+    }
+}
+
+TEST_CASE("Replay nodes sharing a simulated clock keep their own pace") {
+    {
+        using namespace std::chrono_literals;
+        TestHelper helper;
+
+        dai::Pipeline p(false);
+        auto clock = std::make_shared<dai::SimulatedPipelineClock>();
+        p.setClock(clock);
+        const auto start = clock->now();
+
+        auto replayVideo = p.create<dai::node::ReplayVideo>();
+        replayVideo->setReplayMetadataFile(std::filesystem::path(helper.testFolder).append("extracted").append("CameraCAM_A.mcap"));
+        replayVideo->setReplayVideoFile(std::filesystem::path(helper.testFolder).append("extracted").append("CameraCAM_A.mp4"));
+        replayVideo->setLoop(false);
+        auto replayImu = p.create<dai::node::ReplayMetadataOnly>();
+        replayImu->setReplayFile(std::filesystem::path(helper.testFolder).append("extracted").append("IMU.mcap"));
+        replayImu->setLoop(false);
+
+        // Recorded timestamps of the replayed messages, per node
+        std::mutex mtx;
+        std::vector<std::chrono::steady_clock::time_point> videoTs, imuTs;
+        auto videoQueue = replayVideo->out.createOutputQueue(1, false);
+        auto imuQueue = replayImu->out.createOutputQueue(1, false);
+        videoQueue->addCallback([&](std::shared_ptr<dai::ADatatype> msg) {
+            std::lock_guard<std::mutex> lock(mtx);
+            videoTs.push_back(std::static_pointer_cast<dai::Buffer>(msg)->getTimestampDevice());
+        });
+        imuQueue->addCallback([&](std::shared_ptr<dai::ADatatype> msg) {
+            std::lock_guard<std::mutex> lock(mtx);
+            imuTs.push_back(std::static_pointer_cast<dai::Buffer>(msg)->getTimestampDevice());
+        });
+
+        p.start();
+        // Stopped once the video is replayed
+        const auto wallStart = std::chrono::steady_clock::now();
+        while(p.isRunning() && std::chrono::steady_clock::now() - wallStart < 60s) std::this_thread::sleep_for(10ms);
+        p.stop();
+
+        std::lock_guard<std::mutex> lock(mtx);
+        REQUIRE(videoTs.size() > 1);
+        REQUIRE(imuTs.size() > 1);
+        const auto replayed = std::max(videoTs.back() - videoTs.front(), imuTs.back() - imuTs.front());
+        // The clock follows the node furthest ahead, each by its own recorded timestamps. Nodes pacing themselves from the
+        // time the other node moved the clock to would move it further.
+        const auto elapsed = clock->now() - start;
+        REQUIRE(elapsed >= replayed);
+        REQUIRE(elapsed <= replayed + 100ms);
+    }
+}
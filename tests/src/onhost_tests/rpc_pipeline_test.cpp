@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "nanorpc/core/client.h"
+#include "nanorpc/core/server.h"
+#include "nanorpc/packer/nlohmann_msgpack.h"
+#include "utility/RpcMsgpackPacker.hpp"
+#include "utility/RpcPipeline.hpp"
+
+using namespace std::chrono_literals;
+using dai::utility::RpcPipeline;
+
+namespace {
+
+// Blocking queue of messages, one per direction of the loopback stream
+class MessageQueue {
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<RpcPipeline::Buffer> queue;
+    bool closed = false;
+
+   public:
+    void push(RpcPipeline::Buffer msg) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if(closed) throw std::runtime_error("stream closed");
+            queue.push_back(std::move(msg));
+        }
+        cv.notify_all();
+    }
+    RpcPipeline::Buffer pop(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mtx);
+        auto ready = [this]() { return closed || !queue.empty(); };
+        if(timeout.count() > 0) {
+            if(!cv.wait_for(lock, timeout, ready)) throw std::runtime_error("read timeout");
+        } else {
+            cv.wait(lock, ready);
+        }
+        if(queue.empty()) throw std::runtime_error("stream closed");
+        auto msg = std::move(queue.front());
+        queue.pop_front();
+        return msg;
+    }
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            closed = true;
+        }
+        cv.notify_all();
+    }
+    std::size_t size() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return queue.size();
+    }
+};
+
+// In-process stream with a "device" thread answering requests in order
+class LoopbackStream {
+   public:
+    MessageQueue requests;
+    MessageQueue responses;
+    std::atomic<std::size_t> maxQueuedRequests{0};
+
+    explicit LoopbackStream(std::function<RpcPipeline::Buffer(RpcPipeline::Buffer)> handler, std::chrono::milliseconds delay = 0ms) {
+        device = std::thread([this, handler, delay]() {
+            try {
+                while(true) {
+                    auto request = requests.pop(0ms);
+                    maxQueuedRequests = std::max<std::size_t>(maxQueuedRequests, requests.size() + 1);
+                    std::this_thread::sleep_for(delay);
+                    responses.push(handler(std::move(request)));
+                }
+            } catch(const std::exception&) {
+                // closed
+            }
+        });
+    }
+    ~LoopbackStream() {
+        close();
+        device.join();
+    }
+    void close() {
+        requests.close();
+        responses.close();
+    }
+    RpcPipeline::WriteFn writer() {
+        return [this](RpcPipeline::Buffer request) { requests.push(std::move(request)); };
+    }
+    RpcPipeline::ReadFn reader() {
+        return [this](std::chrono::milliseconds timeout) { return responses.pop(timeout); };
+    }
+
+   private:
+    std::thread device;
+};
+
+RpcPipeline::Buffer echo(RpcPipeline::Buffer request) {
+    return request;
+}
+
+}  // namespace
+
+TEST_CASE("RpcPipeline matches responses to requests in order") {
+    LoopbackStream stream(echo);
+    RpcPipeline pipeline(stream.writer(), stream.reader());
+
+    std::vector<std::future<RpcPipeline::Buffer>> futures;
+    for(std::uint8_t i = 0; i < 100; i++) {
+        futures.push_back(pipeline.submit({i, static_cast<std::uint8_t>(i * 2)}, 1000ms));
+    }
+    for(std::uint8_t i = 0; i < 100; i++) {
+        REQUIRE(futures[i].get() == RpcPipeline::Buffer{i, static_cast<std::uint8_t>(i * 2)});
+    }
+    REQUIRE(pipeline.getNumInFlight() == 0);
+}
+
+TEST_CASE("RpcPipeline keeps multiple requests in flight") {
+    // Slow device - requests keep being written while it processes earlier ones
+    LoopbackStream stream(echo, 20ms);
+    RpcPipeline pipeline(stream.writer(), stream.reader());
+
+    std::vector<std::future<RpcPipeline::Buffer>> futures;
+    for(std::uint8_t i = 0; i < 8; i++) futures.push_back(pipeline.submit({i}, 1000ms));
+    REQUIRE(pipeline.getNumInFlight() > 1);
+    for(auto& f : futures) f.get();
+    REQUIRE(stream.maxQueuedRequests > 1);
+}
+
+TEST_CASE("RpcPipeline serves concurrent callers") {
+    LoopbackStream stream(echo);
+    RpcPipeline pipeline(stream.writer(), stream.reader());
+
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> threads;
+    for(std::uint8_t t = 0; t < 4; t++) {
+        threads.emplace_back([&, t]() {
+            for(std::uint8_t i = 0; i < 50; i++) {
+                RpcPipeline::Buffer request{t, i};
+                if(pipeline.submit(request, 1000ms).get() != request) mismatches++;
+            }
+        });
+    }
+    for(auto& thread : threads) thread.join();
+    REQUIRE(mismatches == 0);
+}
+
+TEST_CASE("RpcPipeline fails in-flight and later requests on timeout") {
+    LoopbackStream stream([](RpcPipeline::Buffer request) {
+        std::this_thread::sleep_for(200ms);
+        return request;
+    });
+    RpcPipeline pipeline(stream.writer(), stream.reader());
+
+    auto first = pipeline.submit({1}, 20ms);
+    auto second = pipeline.submit({2}, 1000ms);
+    REQUIRE_THROWS(first.get());
+    REQUIRE_THROWS(second.get());
+    REQUIRE_THROWS(pipeline.submit({3}, 1000ms).get());
+}
+
+TEST_CASE("RpcPipeline close fails pending requests") {
+    LoopbackStream stream([](RpcPipeline::Buffer request) {
+        std::this_thread::sleep_for(100ms);
+        return request;
+    });
+    RpcPipeline pipeline(stream.writer(), stream.reader());
+    auto future = pipeline.submit({1}, 0ms);
+    // As on device close, the stream is closed first which unblocks the reader
+    stream.close();
+    pipeline.close();
+    REQUIRE_THROWS(future.get());
+}
+
+TEST_CASE("RpcMsgpackPacker is wire compatible with nlohmann_msgpack") {
+    auto request = dai::utility::packRpcRequest("setIrLaserDotProjectorBrightness", 0.5f, -1, true);
+    auto reference = nanorpc::packer::nlohmann_msgpack{}
+                         .pack(nanorpc::version::core::protocol::value)
+                         .pack(nanorpc::core::detail::pack::meta::type::request)
+                         .pack(nanorpc::core::hash_id("setIrLaserDotProjectorBrightness"))
+                         .pack(std::make_tuple(0.5f, -1, true))
+                         .to_buffer();
+    REQUIRE(request == reference);
+}
+
+TEST_CASE("RPC client over pipelined loopback") {
+    nanorpc::core::server<dai::utility::RpcMsgpackPacker> server;
+    server.handle("add", [](int a, int b) { return a + b; });
+    server.handle("concat", [](std::string a, std::vector<std::string> b) {
+        for(const auto& s : b) a += s;
+        return a;
+    });
+    server.handle("fail", []() -> int { throw std::runtime_error("failed on device"); });
+
+    LoopbackStream stream([&server](RpcPipeline::Buffer request) { return server.execute(std::move(request)); });
+    RpcPipeline pipeline(stream.writer(), stream.reader());
+    nanorpc::core::client<dai::utility::RpcMsgpackPacker> client(
+        [&pipeline](nanorpc::core::type::buffer request) { return pipeline.submit(std::move(request), 1000ms).get(); });
+
+    REQUIRE(client.call("add", 2, 3).as<int>() == 5);
+    REQUIRE(client.call("concat", std::string("a"), std::vector<std::string>{"b", "c"}).as<std::string>() == "abc");
+    REQUIRE_THROWS_AS(client.call("fail").as<int>(), nanorpc::core::exception::logic);
+
+    // Async calls, unpacked with the same result checks as the client
+    std::vector<std::future<RpcPipeline::Buffer>> futures;
+    for(int i = 0; i < 10; i++) futures.push_back(pipeline.submit(dai::utility::packRpcRequest("add", i, i), 1000ms));
+    for(int i = 0; i < 10; i++) {
+        REQUIRE(dai::utility::unpackRpcResponse<int>("add", futures[i].get()) == 2 * i);
+    }
+    REQUIRE_THROWS_AS(dai::utility::unpackRpcResponse<int>("fail", pipeline.submit(dai::utility::packRpcRequest("fail"), 1000ms).get()),
+                      nanorpc::core::exception::logic);
+}
@@ -0,0 +1,206 @@
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "depthai/pipeline/SharedMemoryQueue.hpp"
+#include "depthai/pipeline/datatype/Buffer.hpp"
+#include "test_nodes.hpp"
+
+using namespace std::chrono_literals;
+using test::makeBuffer;
+
+namespace {
+
+std::string uniqueName(const std::string& test) {
+    return "/depthai_test_" + test + "_" + std::to_string(getpid());
+}
+
+bool isExpected(const std::shared_ptr<dai::Buffer>& buffer, int sequence, std::size_t size) {
+    if(!buffer || buffer->getSequenceNum() != sequence) return false;
+    const auto data = buffer->getData();
+    if(data.size() != size) return false;
+    for(std::size_t i = 0; i < data.size(); i++) {
+        if(data[i] != static_cast<std::uint8_t>(sequence + i)) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST_CASE("Messages pass between two processes") {
+    constexpr int numMessages = 50;
+    constexpr std::size_t size = 64 * 1024;
+    const auto name = uniqueName("processes");
+
+    const pid_t child = fork();
+    REQUIRE(child >= 0);
+    if(child == 0) {
+        // Only the exit status of the child is checked, Catch2 must not run in it
+        int status = 1;
+        try {
+            dai::SharedMemoryQueueReceiver receiver(name, 4, 5s);
+            auto queue = receiver.getQueue();
+            int received = 0;
+            for(; received < numMessages; received++) {
+                if(!isExpected(queue->get<dai::Buffer>(), received, size)) break;
+            }
+            if(received == numMessages) status = 0;
+        } catch(...) {
+            status = 2;
+        }
+        _exit(status);
+    }
+
+    {
+        dai::SharedMemoryQueueSender sender(name, 3, 2 * size);
+        for(int i = 0; i < numMessages; i++) {
+            REQUIRE(sender.send(makeBuffer(i, size), 5000ms));
+        }
+        sender.close();
+        REQUIRE(sender.isClosed());
+    }
+    int status = 0;
+    REQUIRE(waitpid(child, &status, 0) == child);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+}
+
+TEST_CASE("Received messages hold their slots") {
+    const auto name = uniqueName("slots");
+    dai::SharedMemoryQueueSender sender(name, 2, 4096);
+    dai::SharedMemoryQueueReceiver receiver(name, 4);
+    auto queue = receiver.getQueue();
+
+    REQUIRE(sender.send(makeBuffer(0, 1024)));
+    REQUIRE(sender.send(makeBuffer(1, 1024)));
+    auto first = queue->get<dai::Buffer>();
+    auto second = queue->get<dai::Buffer>();
+    REQUIRE(isExpected(first, 0, 1024));
+    REQUIRE(isExpected(second, 1, 1024));
+
+    // Both slots are referenced by the received messages
+    REQUIRE_FALSE(sender.send(makeBuffer(2, 1024), 100ms));
+    first.reset();
+    REQUIRE(sender.send(makeBuffer(2, 1024), 1000ms));
+    REQUIRE(isExpected(queue->get<dai::Buffer>(), 2, 1024));
+    REQUIRE(isExpected(second, 1, 1024));
+}
+
+TEST_CASE("Messages linked to the sender queue are forwarded") {
+    const auto name = uniqueName("forward");
+    dai::SharedMemoryQueueSender sender(name, 4, 4096);
+    dai::SharedMemoryQueueReceiver receiver(name, 8);
+
+    for(int i = 0; i < 5; i++) sender.getQueue()->send(makeBuffer(i, 100));
+    for(int i = 0; i < 5; i++) REQUIRE(isExpected(receiver.getQueue()->get<dai::Buffer>(), i, 100));
+
+    // Closing the sender closes the receiving queue once it's drained
+    sender.close();
+    REQUIRE_THROWS_AS(receiver.getQueue()->get(), dai::MessageQueue::QueueException);
+    REQUIRE_THROWS_AS(sender.send(makeBuffer(5, 100)), dai::MessageQueue::QueueException);
+}
+
+TEST_CASE("Closing the sender sends the messages already queued") {
+    const auto name = uniqueName("drain");
+    dai::SharedMemoryQueueSender sender(name, 1, 4096);
+    dai::SharedMemoryQueueReceiver receiver(name, 1);
+
+    // More than the ring and the receiving queue hold, the rest waits in the sender's queue
+    for(int i = 0; i < 4; i++) sender.getQueue()->send(makeBuffer(i, 100));
+    std::thread closer([&]() { sender.close(); });
+    for(int i = 0; i < 4; i++) REQUIRE(isExpected(receiver.getQueue()->get<dai::Buffer>(), i, 100));
+    closer.join();
+    REQUIRE_THROWS_AS(receiver.getQueue()->get(), dai::MessageQueue::QueueException);
+}
+
+TEST_CASE("Sending fails once the receiver closed") {
+    const auto name = uniqueName("receiver_closed");
+    dai::SharedMemoryQueueSender sender(name, 2, 4096);
+    dai::SharedMemoryQueueReceiver receiver(name, 4);
+    REQUIRE(sender.send(makeBuffer(0, 100)));
+    // One receiver at a time
+    REQUIRE_THROWS_AS((dai::SharedMemoryQueueReceiver{name, 4}), std::runtime_error);
+    receiver.close();
+    REQUIRE_THROWS_AS(sender.send(makeBuffer(1, 100)), dai::MessageQueue::QueueException);
+}
+
+TEST_CASE("Sending fails once the receiving process exited") {
+    const auto name = uniqueName("receiver_exited");
+    const pid_t child = fork();
+    REQUIRE(child >= 0);
+    if(child == 0) {
+        // Exits holding both slots, without closing
+        int status = 1;
+        try {
+            dai::SharedMemoryQueueReceiver receiver(name, 4, 5s);
+            auto first = receiver.getQueue()->get();
+            auto second = receiver.getQueue()->get();
+            if(first && second) status = 0;
+        } catch(...) {
+            status = 2;
+        }
+        _exit(status);
+    }
+    dai::SharedMemoryQueueSender sender(name, 2, 4096);
+    REQUIRE(sender.send(makeBuffer(0, 100), 5000ms));
+    REQUIRE(sender.send(makeBuffer(1, 100), 5000ms));
+    int status = 0;
+    REQUIRE(waitpid(child, &status, 0) == child);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+    REQUIRE_THROWS_AS(sender.send(makeBuffer(2, 100), 5000ms), dai::MessageQueue::QueueException);
+
+    // A new receiver gets the slots back
+    dai::SharedMemoryQueueReceiver receiver(name, 4);
+    REQUIRE(sender.send(makeBuffer(2, 100), 1000ms));
+    REQUIRE(sender.send(makeBuffer(3, 100), 1000ms));
+    REQUIRE(isExpected(receiver.getQueue()->get<dai::Buffer>(), 2, 100));
+    REQUIRE(isExpected(receiver.getQueue()->get<dai::Buffer>(), 3, 100));
+}
+
+TEST_CASE("Receiving ends once the sending process exited") {
+    const auto name = uniqueName("sender_exited");
+    const pid_t child = fork();
+    REQUIRE(child >= 0);
+    if(child == 0) {
+        // Exits while the sender is still open
+        int status = 1;
+        try {
+            dai::SharedMemoryQueueSender sender(name, 4, 4096);
+            if(sender.send(makeBuffer(0, 100), 5000ms) && sender.send(makeBuffer(1, 100), 5000ms)) status = 0;
+            _exit(status);
+        } catch(...) {
+            status = 2;
+        }
+        _exit(status);
+    }
+    int status = 0;
+    REQUIRE(waitpid(child, &status, 0) == child);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+
+    // The messages written before it exited are still received, then the queue closes
+    dai::SharedMemoryQueueReceiver receiver(name, 4, 5s);
+    auto queue = receiver.getQueue();
+    REQUIRE(isExpected(queue->get<dai::Buffer>(), 0, 100));
+    REQUIRE(isExpected(queue->get<dai::Buffer>(), 1, 100));
+    REQUIRE_THROWS_AS(queue->get(), dai::MessageQueue::QueueException);
+    shm_unlink(name.c_str());
+}
+
+TEST_CASE("Oversized messages and duplicate names are rejected") {
+    const auto name = uniqueName("limits");
+    dai::SharedMemoryQueueSender sender(name, 1, 1024);
+    REQUIRE_THROWS_AS(sender.send(makeBuffer(0, 2048)), std::runtime_error);
+    REQUIRE_THROWS_AS(dai::SharedMemoryQueueSender{name}, std::runtime_error);
+    REQUIRE_THROWS_AS((dai::SharedMemoryQueueReceiver{uniqueName("missing"), 4, 50ms}), std::runtime_error);
+}
@@ -130,4 +130,80 @@ TEST_CASE("Raw - Incorrect message too small size 2") {
     packet.length = ser.size();
 
     REQUIRE_THROWS(dai::StreamMessageParser::parseMessage(&packet));
-}
\ No newline at end of file
+}
+namespace {
+// In-memory stream of packets, as written by XLinkOutHost and read by XLinkInHost
+std::vector<std::shared_ptr<dai::ADatatype>> readAll(std::vector<std::vector<uint8_t>>& stream) {
+    std::vector<std::shared_ptr<dai::ADatatype>> messages;
+    for(auto& buffer : stream) {
+        streamPacketDesc_t packet{buffer.data(), static_cast<uint32_t>(buffer.size()), -1, {}, {}};
+        if(dai::StreamMessageParser::isCoalesced(&packet)) {
+            auto split = dai::StreamMessageParser::parseCoalesced(&packet);
+            messages.insert(messages.end(), split.begin(), split.end());
+        } else {
+            messages.push_back(dai::StreamMessageParser::parseMessage(&packet));
+        }
+    }
+    return messages;
+}
+}  // namespace
+
+TEST_CASE("Coalesced messages round trip") {
+    auto frame = std::make_shared<dai::ImgFrame>();
+    frame->setSequenceNum(7);
+    frame->setData(std::vector<uint8_t>{1, 2, 3, 4, 5});
+    auto imu = std::make_shared<dai::IMUData>();
+    imu->setSequenceNum(8);
+    auto control = std::make_shared<dai::CameraControl>();
+    control->setManualExposure(1000, 200);
+    std::vector<std::shared_ptr<dai::ADatatype>> sent = {frame, imu, control};
+
+    std::vector<uint8_t> coalesced;
+    std::vector<uint32_t> sizes;
+    for(const auto& msg : sent) {
+        dai::StreamMessageParser::appendCoalesced(coalesced, sizes, msg->data->getData(), dai::StreamMessageParser::serializeMetadata(msg));
+    }
+    dai::StreamMessageParser::finalizeCoalesced(coalesced, sizes);
+    REQUIRE(sizes.size() == 3);
+
+    // Coalesced and single packets interleaved on the same stream
+    std::vector<std::vector<uint8_t>> stream = {coalesced, dai::StreamMessageParser::serializeMetadata(imu), coalesced};
+    auto received = readAll(stream);
+    REQUIRE(received.size() == 7);
+    for(std::size_t i = 0; i < received.size(); i++) {
+        const auto& expected = i == 3 ? std::static_pointer_cast<dai::ADatatype>(imu) : sent[i < 3 ? i : i - 4];
+        REQUIRE(dai::StreamMessageParser::serializeMetadata(received[i]) == dai::StreamMessageParser::serializeMetadata(expected));
+        auto data = received[i]->data->getData();
+        auto expectedData = expected->data->getData();
+        REQUIRE(std::vector<uint8_t>(data.begin(), data.end()) == std::vector<uint8_t>(expectedData.begin(), expectedData.end()));
+    }
+    REQUIRE(std::dynamic_pointer_cast<dai::ImgFrame>(received[0])->getSequenceNum() == 7);
+}
+
+TEST_CASE("Single message is not coalesced") {
+    dai::ImgFrame frm;
+    auto ser = dai::StreamMessageParser::serializeMetadata(frm);
+    streamPacketDesc_t packet{ser.data(), static_cast<uint32_t>(ser.size()), -1, {}, {}};
+    REQUIRE_FALSE(dai::StreamMessageParser::isCoalesced(&packet));
+    REQUIRE_THROWS(dai::StreamMessageParser::parseCoalesced(&packet));
+}
+
+TEST_CASE("Incorrect coalesced message") {
+    auto imu = std::make_shared<dai::IMUData>();
+    std::vector<uint8_t> coalesced;
+    std::vector<uint32_t> sizes;
+    dai::StreamMessageParser::appendCoalesced(coalesced, sizes, imu->data->getData(), dai::StreamMessageParser::serializeMetadata(imu));
+    dai::StreamMessageParser::appendCoalesced(coalesced, sizes, imu->data->getData(), dai::StreamMessageParser::serializeMetadata(imu));
+
+    SECTION("Bad count") {
+        dai::StreamMessageParser::finalizeCoalesced(coalesced, sizes);
+        coalesced[coalesced.size() - MARKER_SIZE - 1] = 0x7F;
+    }
+    SECTION("Bad size") {
+        sizes[1] += 1;
+        dai::StreamMessageParser::finalizeCoalesced(coalesced, sizes);
+    }
+    streamPacketDesc_t packet{coalesced.data(), static_cast<uint32_t>(coalesced.size()), -1, {}, {}};
+    REQUIRE(dai::StreamMessageParser::isCoalesced(&packet));
+    REQUIRE_THROWS(dai::StreamMessageParser::parseCoalesced(&packet));
+}
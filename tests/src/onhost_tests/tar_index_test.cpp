@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "depthai/utility/Compression.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+uint8_t pattern(std::size_t index, std::size_t file) {
+    return static_cast<uint8_t>((index * 31 + file) % 251);
+}
+
+// Synthetic recording tarball, with names long enough to need pax headers and a file spanning many blocks
+struct SyntheticTar {
+    fs::path dir;
+    fs::path archive;
+    std::vector<std::string> names = {"IMU.mcap", std::string(150, 'n') + ".mp4", "recording/" + std::string(120, 'p') + ".mcap", "empty.json"};
+    std::vector<std::size_t> sizes = {1000, 8 * 1024 * 1024 + 3, 512, 0};
+
+    SyntheticTar() {
+        dir = fs::temp_directory_path() / "depthai_tar_index_test";
+        fs::remove_all(dir);
+        fs::create_directories(dir);
+        archive = dir / "recording.tar";
+        std::vector<fs::path> filesOnDisk;
+        for(std::size_t i = 0; i < names.size(); i++) {
+            filesOnDisk.push_back(dir / std::to_string(i));
+            std::vector<uint8_t> content(sizes[i]);
+            for(std::size_t j = 0; j < content.size(); j++) content[j] = pattern(j, i);
+            std::ofstream file(filesOnDisk.back(), std::ios::binary);
+            file.write(reinterpret_cast<const char*>(content.data()), content.size());
+        }
+        dai::utility::tarFiles(archive, filesOnDisk, names);
+        for(const auto& file : filesOnDisk) fs::remove(file);
+    }
+    ~SyntheticTar() {
+        fs::remove_all(dir);
+    }
+};
+
+}  // namespace
+
+TEST_CASE("indexTar locates files without extracting them") {
+    SyntheticTar tar;
+    const auto members = dai::utility::indexTar(tar.archive);
+    REQUIRE(members.size() == tar.names.size());
+    for(std::size_t i = 0; i < members.size(); i++) {
+        REQUIRE(members[i].name == tar.names[i]);
+        REQUIRE(members[i].size == tar.sizes[i]);
+        REQUIRE(members[i].offset % 512 == 0);
+        const auto content = dai::utility::readTarMember(tar.archive, members[i]);
+        REQUIRE(content.size() == tar.sizes[i]);
+        bool matches = true;
+        for(std::size_t j = 0; j < content.size(); j++) matches = matches && content[j] == pattern(j, i);
+        REQUIRE(matches);
+    }
+    // Same listing as libarchive
+    REQUIRE(dai::utility::filenamesInTar(tar.archive) == tar.names);
+
+    // Nothing is extracted, only the index is written
+    std::vector<fs::path> files;
+    for(const auto& entry : fs::directory_iterator(tar.dir)) files.push_back(entry.path().filename());
+    std::sort(files.begin(), files.end());
+    REQUIRE(files == std::vector<fs::path>{"recording.tar", "recording.tar.index"});
+
+    dai::utility::extractTarMember(tar.archive, members[1], tar.dir / "video.mp4");
+    REQUIRE(fs::file_size(tar.dir / "video.mp4") == tar.sizes[1]);
+}
+
+TEST_CASE("indexTar caches the index next to the archive") {
+    SyntheticTar tar;
+    const auto indexPath = fs::path(tar.archive).concat(".index");
+    const auto members = dai::utility::indexTar(tar.archive);
+    REQUIRE(fs::exists(indexPath));
+    const auto indexTime = fs::last_write_time(indexPath);
+
+    // Reused while the archive is unchanged
+    const auto cached = dai::utility::indexTar(tar.archive);
+    REQUIRE(fs::last_write_time(indexPath) == indexTime);
+    REQUIRE(cached.size() == members.size());
+    for(std::size_t i = 0; i < members.size(); i++) {
+        REQUIRE(cached[i].name == members[i].name);
+        REQUIRE(cached[i].offset == members[i].offset);
+        REQUIRE(cached[i].size == members[i].size);
+    }
+
+    // Rebuilt once it changes
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    dai::utility::tarFiles(tar.archive, {indexPath}, {"index.json"});
+    const auto rebuilt = dai::utility::indexTar(tar.archive);
+    REQUIRE(rebuilt.size() == 1);
+    REQUIRE(rebuilt[0].name == "index.json");
+
+    // Without the cache nothing is written
+    fs::remove(indexPath);
+    REQUIRE(dai::utility::indexTar(tar.archive, false).size() == 1);
+    REQUIRE_FALSE(fs::exists(indexPath));
+}
+
+TEST_CASE("indexTar rejects compressed archives") {
+    SyntheticTar tar;
+    std::ifstream file(tar.archive, std::ios::binary);
+    std::vector<uint8_t> content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const auto compressed = dai::utility::gzip(content.data(), content.size());
+    const auto compressedPath = tar.dir / "recording.tar.gz";
+    std::ofstream(compressedPath, std::ios::binary).write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+    REQUIRE_THROWS_AS(dai::utility::indexTar(compressedPath), std::runtime_error);
+}
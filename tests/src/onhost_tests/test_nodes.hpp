@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "depthai/pipeline/MessageQueue.hpp"
+#include "depthai/pipeline/ThreadedHostNode.hpp"
+#include "depthai/pipeline/datatype/Buffer.hpp"
+
+// Nodes and messages shared by the on host tests
+namespace test {
+
+// Messages are sent from the tests, through the output directly
+class Source : public dai::node::CustomThreadedNode<Source> {
+   public:
+    Output out{*this, {"out", DEFAULT_GROUP, {{{dai::DatatypeEnum::Buffer, true}}}}};
+
+    void run() override {}
+};
+
+// Doesn't consume anything itself, the tests read its input to control how full it is
+class Sink : public dai::node::CustomThreadedNode<Sink> {
+   public:
+    Input input{*this, {"input", DEFAULT_GROUP, true, 2, {{{dai::DatatypeEnum::Buffer, true}}}, DEFAULT_WAIT_FOR_MESSAGE}};
+
+    void run() override {
+        while(isRunning()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+};
+
+inline std::shared_ptr<dai::Buffer> makeBuffer(int64_t sequenceNum) {
+    auto buffer = std::make_shared<dai::Buffer>();
+    buffer->setSequenceNum(sequenceNum);
+    return buffer;
+}
+
+// Data filled with the sequence number plus the offset of each byte
+inline std::shared_ptr<dai::Buffer> makeBuffer(int64_t sequenceNum, std::size_t size) {
+    auto buffer = std::make_shared<dai::Buffer>(size);
+    auto data = buffer->getData();
+    for(std::size_t i = 0; i < data.size(); i++) data[i] = static_cast<std::uint8_t>(sequenceNum + i);
+    buffer->setSequenceNum(sequenceNum);
+    return buffer;
+}
+
+// Sequence numbers of the messages waiting in the queue, taking them out
+inline std::vector<int64_t> drain(dai::MessageQueue& queue) {
+    std::vector<int64_t> sequenceNums;
+    while(auto buffer = queue.tryGet<dai::Buffer>()) sequenceNums.push_back(buffer->getSequenceNum());
+    return sequenceNums;
+}
+
+}  // namespace test
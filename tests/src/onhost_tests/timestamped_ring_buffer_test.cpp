@@ -0,0 +1,133 @@
+#include <catch2/catch_all.hpp>
+#include <cmath>
+#include <map>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "depthai/utility/TimestampedRingBuffer.hpp"
+
+using dai::utility::TimestampedRingBuffer;
+
+namespace {
+
+// Samples of a synthetic IMU stream at the given rate
+constexpr double RATE = 400.0;
+float sample(int i) {
+    return std::sin(i * 0.1f) * 9.81f;
+}
+
+// Interpolation as RTABMapVIO did it on a std::map, used as the reference
+std::optional<float> interpolateMap(const std::map<double, float>& buffer, double stamp) {
+    if(buffer.empty() || buffer.rbegin()->first < stamp) return std::nullopt;
+    auto iterB = buffer.lower_bound(stamp);
+    auto iterA = iterB;
+    if(iterA != buffer.begin()) --iterA;
+    if(iterA == iterB || stamp == iterB->first) return iterB->second;
+    float t = (stamp - iterA->first) / (iterB->first - iterA->first);
+    return iterA->second + t * (iterB->second - iterA->second);
+}
+
+}  // namespace
+
+TEST_CASE("TimestampedRingBuffer interpolates in order samples") {
+    TimestampedRingBuffer<float> buffer(64);
+    REQUIRE(buffer.empty());
+    REQUIRE_FALSE(buffer.interpolate(0.0).has_value());
+
+    std::map<double, float> reference;
+    for(int i = 0; i < 32; i++) {
+        REQUIRE(buffer.push(i / RATE, sample(i)));
+        reference.emplace(i / RATE, sample(i));
+    }
+    REQUIRE(buffer.size() == 32);
+    for(double stamp = -0.01; stamp < 32 / RATE; stamp += 0.0007) {
+        auto expected = interpolateMap(reference, stamp);
+        auto actual = buffer.interpolate(stamp);
+        REQUIRE(actual.has_value() == expected.has_value());
+        if(actual) REQUIRE(*actual == *expected);
+    }
+    // Exactly on a sample
+    REQUIRE(*buffer.interpolate(5 / RATE) == sample(5));
+    // Before the oldest sample clamps, after the newest one isn't known yet
+    REQUIRE(*buffer.interpolate(-1.0) == sample(0));
+    REQUIRE_FALSE(buffer.interpolate(32 / RATE).has_value());
+}
+
+TEST_CASE("TimestampedRingBuffer overwrites the oldest samples when full") {
+    TimestampedRingBuffer<float> buffer(16);
+    for(int i = 0; i < 100; i++) buffer.push(i / RATE, sample(i));
+    REQUIRE(buffer.size() == 16);
+    REQUIRE(buffer.capacity() == 16);
+    REQUIRE(buffer.front().timestamp == 84 / RATE);
+    REQUIRE(buffer.back().timestamp == 99 / RATE);
+    for(std::size_t i = 1; i < buffer.size(); i++) REQUIRE(buffer[i - 1].timestamp < buffer[i].timestamp);
+}
+
+TEST_CASE("TimestampedRingBuffer handles out of order and duplicate timestamps") {
+    TimestampedRingBuffer<float> buffer(256);
+    std::map<double, float> reference;
+    std::mt19937 rng(42);
+    // Packets of a few samples each, delivered with occasional swaps and repeats
+    std::vector<int> order;
+    for(int i = 0; i < 200; i++) order.push_back(i);
+    for(std::size_t i = 0; i + 1 < order.size(); i += 7) std::swap(order[i], order[i + 1]);
+    for(std::size_t i = 0; i < order.size(); i += 13) order.insert(order.begin() + i + 1, order[i]);
+
+    for(int i : order) {
+        const bool inserted = buffer.push(i / RATE, sample(i));
+        REQUIRE(inserted == reference.emplace(i / RATE, sample(i)).second);
+    }
+    REQUIRE(buffer.size() == reference.size());
+    std::size_t index = 0;
+    for(const auto& kv : reference) {
+        REQUIRE(buffer[index].timestamp == kv.first);
+        REQUIRE(buffer[index].value == kv.second);
+        index++;
+    }
+
+    std::uniform_real_distribution<double> stamps(0.0, 200 / RATE);
+    for(int i = 0; i < 500; i++) {
+        const double stamp = stamps(rng);
+        auto expected = interpolateMap(reference, stamp);
+        auto actual = buffer.interpolate(stamp);
+        REQUIRE(actual.has_value() == expected.has_value());
+        if(actual) REQUIRE(*actual == *expected);
+    }
+}
+
+TEST_CASE("TimestampedRingBuffer out of order samples when full") {
+    TimestampedRingBuffer<float> buffer(4);
+    for(int i : {0, 1, 2, 3}) buffer.push(i, static_cast<float>(i));
+    // Older than everything kept
+    REQUIRE_FALSE(buffer.push(-1, -1.0f));
+    // Inserted, dropping the oldest sample
+    REQUIRE(buffer.push(1.5, 1.5f));
+    REQUIRE(buffer.size() == 4);
+    REQUIRE(buffer.front().timestamp == 1);
+    REQUIRE(buffer[1].timestamp == 1.5);
+    REQUIRE(buffer.back().timestamp == 3);
+}
+
+TEST_CASE("TimestampedRingBuffer prunes in bulk") {
+    TimestampedRingBuffer<float> buffer(1024);
+    // Frames at 30 FPS consume a 1 kHz stream
+    int next = 0;
+    for(int frame = 1; frame < 100; frame++) {
+        const double stamp = frame / 30.0;
+        for(; next / 1000.0 <= stamp + 0.005; next++) buffer.push(next / 1000.0, sample(next));
+        auto value = buffer.interpolate(stamp);
+        REQUIRE(value.has_value());
+        buffer.pruneBefore(stamp);
+        // Only the sample before the frame and the newer ones are kept, and interpolation still works
+        REQUIRE(buffer.front().timestamp <= stamp);
+        REQUIRE(buffer[1].timestamp >= stamp);
+        REQUIRE(*buffer.interpolate(stamp) == *value);
+        REQUIRE(buffer.size() < 16);
+    }
+    buffer.clear();
+    REQUIRE(buffer.empty());
+    REQUIRE_THROWS_AS(TimestampedRingBuffer<float>(0), std::invalid_argument);
+}
@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "depthai/pipeline/InputQueue.hpp"
+#include "depthai/pipeline/Pipeline.hpp"
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+#include "depthai/pipeline/datatype/StreamMessageParser.hpp"
+#include "depthai/pipeline/node/internal/XLinkInHost.hpp"
+#include "depthai/pipeline/node/internal/XLinkOutHost.hpp"
+#include "depthai/xlink/LoopbackConnection.hpp"
+#include "depthai/xlink/XLinkStream.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+std::vector<std::uint8_t> toVector(const dai::StreamPacketDesc& packet) {
+    return {packet.data, packet.data + packet.length};
+}
+
+}  // namespace
+
+TEST_CASE("Loopback stream round trip") {
+    auto conn = std::make_shared<dai::LoopbackConnection>();
+    dai::XLinkStream writer(conn, "stream", 1024);
+    dai::XLinkStream reader(conn, "stream", 1);
+
+    std::vector<std::uint8_t> a{1, 2, 3}, b{4, 5};
+    writer.write(a, b);
+    writer.write(a);
+    auto packet = reader.readMove();
+    REQUIRE(toVector(packet) == std::vector<std::uint8_t>{1, 2, 3, 4, 5});
+    REQUIRE(packet.fd == -1);
+    REQUIRE(reader.read() == a);
+
+    // Streams of other names are independent
+    dai::XLinkStream other(conn, "other", 1024);
+    dai::StreamPacketDesc empty;
+    REQUIRE_FALSE(other.readMove(empty, 10ms));
+}
+
+TEST_CASE("Loopback stream enforces write size") {
+    auto conn = std::make_shared<dai::LoopbackConnection>();
+    dai::XLinkStream writer(conn, "stream", 4);
+    REQUIRE_THROWS_AS(writer.write(std::vector<std::uint8_t>(5)), dai::XLinkWriteError);
+    writer.write(std::vector<std::uint8_t>(4));
+
+    // Reopening with a larger size, as XLinkOutHost does when resizing, keeps queued packets
+    writer = dai::XLinkStream(conn, "stream", 8);
+    writer.write(std::vector<std::uint8_t>(8));
+    REQUIRE(writer.read().size() == 4);
+    REQUIRE(writer.read().size() == 8);
+}
+
+TEST_CASE("Loopback stream blocks writes when full") {
+    auto conn = std::make_shared<dai::LoopbackConnection>(2);
+    dai::XLinkStream stream(conn, "stream", 16);
+    std::vector<std::uint8_t> data{1};
+    REQUIRE(stream.write(data, 10ms));
+    REQUIRE(stream.write(data, 10ms));
+    REQUIRE_FALSE(stream.write(data, 10ms));
+    stream.read();
+    REQUIRE(stream.write(data, 10ms));
+}
+
+TEST_CASE("Loopback connection close unblocks readers") {
+    auto conn = std::make_shared<dai::LoopbackConnection>();
+    dai::XLinkStream stream(conn, "stream", 16);
+    bool threw = false;
+    std::thread reader([&]() {
+        try {
+            stream.readMove();
+        } catch(const dai::XLinkReadError&) {
+            threw = true;
+        }
+    });
+    std::this_thread::sleep_for(20ms);
+    conn->close();
+    reader.join();
+    REQUIRE(threw);
+    REQUIRE(conn->isClosed());
+    REQUIRE_THROWS(dai::XLinkStream(conn, "stream", 16));
+}
+
+TEST_CASE("XLinkOutHost to XLinkInHost over loopback") {
+    constexpr int NUM_MESSAGES = 200;
+    const bool coalesce = GENERATE(false, true);
+
+    auto conn = std::make_shared<dai::LoopbackConnection>();
+    {
+        dai::Pipeline pipeline(false);
+        auto xout = pipeline.create<dai::node::internal::XLinkOutHost>();
+        auto xin = pipeline.create<dai::node::internal::XLinkInHost>();
+        xout->setConnection(conn);
+        xout->setStreamName("loopback");
+        xout->allowStreamResize(true);
+        if(coalesce) xout->setCoalescing(1024 * 1024, 1ms);
+        xin->setConnection(conn);
+        xin->setStreamName("loopback");
+
+        auto input = xout->in.createInputQueue(NUM_MESSAGES, true);
+        auto output = xin->out.createOutputQueue(NUM_MESSAGES, true);
+        pipeline.start();
+
+        for(int i = 0; i < NUM_MESSAGES; i++) {
+            auto frame = std::make_shared<dai::ImgFrame>();
+            frame->setSequenceNum(i);
+            // Sizes increasing past the initial stream size, so that the stream is grown on the way
+            frame->setData(std::vector<std::uint8_t>(i * 1024, static_cast<std::uint8_t>(i)));
+            input->send(frame);
+        }
+        for(int i = 0; i < NUM_MESSAGES; i++) {
+            auto frame = output->get<dai::ImgFrame>();
+            REQUIRE(frame != nullptr);
+            REQUIRE(frame->getSequenceNum() == static_cast<std::int64_t>(i));
+            auto data = frame->getData();
+            REQUIRE(data.size() == static_cast<std::size_t>(i) * 1024);
+            REQUIRE(std::all_of(data.begin(), data.end(), [i](std::uint8_t v) { return v == static_cast<std::uint8_t>(i); }));
+        }
+
+        pipeline.stop();
+        // Unblocks XLinkInHost, as closing the device would
+        conn->close();
+    }
+}
+
+TEST_CASE("XLinkOutHost coalesces within the byte and latency budget") {
+    constexpr int NUM_MESSAGES = 30;
+    constexpr std::size_t MAX_BYTES = 4096;
+
+    auto conn = std::make_shared<dai::LoopbackConnection>(NUM_MESSAGES);
+    dai::XLinkStream reader(conn, "coalesced", 1);
+    {
+        dai::Pipeline pipeline(false);
+        auto xout = pipeline.create<dai::node::internal::XLinkOutHost>();
+        xout->setConnection(conn);
+        xout->setStreamName("coalesced");
+        xout->setCoalescing(MAX_BYTES, 20ms);
+        xout->in.setMaxSize(NUM_MESSAGES);
+
+        // Already queued when the node starts, so the transfers are bounded by the byte budget only
+        for(int i = 0; i < NUM_MESSAGES; i++) {
+            auto buffer = std::make_shared<dai::Buffer>(std::size_t{1000});
+            buffer->setSequenceNum(i);
+            xout->in.send(buffer);
+        }
+        pipeline.start();
+
+        int received = 0;
+        int packets = 0;
+        while(received < NUM_MESSAGES) {
+            auto packet = reader.readMove();
+            REQUIRE(packet.length <= MAX_BYTES);
+            REQUIRE(dai::StreamMessageParser::isCoalesced(&packet));
+            for(const auto& msg : dai::StreamMessageParser::parseCoalesced(&packet)) {
+                REQUIRE(std::dynamic_pointer_cast<dai::Buffer>(msg)->getSequenceNum() == received++);
+            }
+            packets++;
+        }
+        REQUIRE(received == NUM_MESSAGES);
+        REQUIRE(packets > 1);
+        REQUIRE(packets < NUM_MESSAGES);
+
+        // A lone message is flushed once the latency budget runs out
+        auto last = std::make_shared<dai::Buffer>(std::size_t{10});
+        last->setSequenceNum(NUM_MESSAGES);
+        xout->in.send(last);
+        dai::StreamPacketDesc packet;
+        REQUIRE(reader.readMove(packet, 1000ms));
+        const auto messages = dai::StreamMessageParser::parseCoalesced(&packet);
+        REQUIRE(messages.size() == 1);
+        REQUIRE(std::dynamic_pointer_cast<dai::Buffer>(messages.front())->getSequenceNum() == NUM_MESSAGES);
+
+        pipeline.stop();
+        conn->close();
+    }
+}